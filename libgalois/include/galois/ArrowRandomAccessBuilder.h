@@ -3,6 +3,7 @@
 #include "galois/ErrorCode.h"
 #include "galois/LargeArray.h"
 #include "galois/Logging.h"
+#include "galois/NumaMemoryPool.h"
 #include "galois/Properties.h"
 #include "galois/Result.h"
 
@@ -32,9 +33,10 @@ public:
 
   size_t size() const { return data_.size(); }
 
-  galois::Result<std::shared_ptr<arrow::Array>> Finalize() const {
+  galois::Result<std::shared_ptr<arrow::Array>> Finalize(
+      arrow::MemoryPool* pool) const {
     using ArrowBuilder = typename arrow::TypeTraits<ArrowType>::BuilderType;
-    ArrowBuilder builder;
+    ArrowBuilder builder(pool);
     if (data_.size() > 0) {
       if (auto r = builder.AppendValues(data_); !r.ok()) {
         GALOIS_LOG_DEBUG("arrow error: {}", r);
@@ -79,9 +81,10 @@ public:
 
   size_t size() const { return data_.size(); }
 
-  galois::Result<void> Finalize(std::shared_ptr<arrow::Array>* array) const {
+  galois::Result<void> Finalize(
+      std::shared_ptr<arrow::Array>* array, arrow::MemoryPool* pool) const {
     using ArrowBuilder = typename arrow::TypeTraits<ArrowType>::BuilderType;
-    ArrowBuilder builder;
+    ArrowBuilder builder(pool);
     if (data_.size() > 0) {
       if constexpr (std::is_scalar_v<value_type>) {
         // TODO(danielmawhirter) find a better way to handle this
@@ -149,6 +152,8 @@ NULLABLE(std::string, std::string, arrow::LargeStringType);
 /// ArrowRandomAccessBuilder encapsulates the concept of building
 /// an arrow::Array from <index, value> pairs arriving in unknown order
 /// Functions as a wrapper for NullableBuilder currently, TODO(danielmawhirter)
+/// The finalized array is allocated from pool, by default the property pool
+/// (see GetPropertyMemoryPool)
 template <typename ArrowType>
 class ArrowRandomAccessBuilder {
 public:
@@ -156,7 +161,9 @@ public:
       typename ArrowTypeConfig<ArrowType>::RandomBuilderType;
   using value_type = typename RandomBuilderType::value_type;
 
-  ArrowRandomAccessBuilder(size_t length) : builder_(length) {}
+  ArrowRandomAccessBuilder(
+      size_t length, arrow::MemoryPool* pool = GetPropertyMemoryPool())
+      : builder_(length), pool_(pool) {}
 
   void SetValue(size_t index, value_type value) {
     builder_.SetValue(index, value);
@@ -167,7 +174,7 @@ public:
   bool IsValid(size_t index) { return builder_.IsValid(index); }
 
   galois::Result<void> Finalize(std::shared_ptr<arrow::Array>* array) {
-    return builder_.Finalize(array);
+    return builder_.Finalize(array, pool_);
   }
 
   galois::Result<std::shared_ptr<arrow::Array>> Finalize() {
@@ -183,6 +190,7 @@ public:
 
 private:
   RandomBuilderType builder_;
+  arrow::MemoryPool* pool_;
 };
 
 }  // namespace galois
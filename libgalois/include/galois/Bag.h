@@ -21,7 +21,10 @@
 #define GALOIS_LIBGALOIS_GALOIS_BAG_H_
 
 #include <algorithm>
+#include <iterator>
+#include <numeric>
 #include <stdexcept>
+#include <vector>
 
 #include <boost/iterator/iterator_facade.hpp>
 
@@ -36,7 +39,15 @@ namespace galois {
 
 /**
  * Unordered collection of elements. This data structure supports scalable
- * concurrent pushes but reading the bag can only be done serially.
+ * concurrent pushes. Each thread appends to its own list of blocks, which
+ * are taken from the thread's page pool and so are local to its socket.
+ *
+ * The bag can be read serially with begin() and end(), in parallel with
+ * galois::iterate, where each thread reads the elements it pushed, or in
+ * bulk with size(), copy_to() and to_vector(), which work in parallel and
+ * must not be called from a parallel region. All of these visit the
+ * elements in the same order: each thread's elements in the order they were
+ * pushed, by increasing thread id.
  */
 template <typename T, unsigned int BlockSize = 0>
 class InsertBag {
@@ -175,6 +186,23 @@ private:
     }
   }
 
+  //! The number of elements in the list of each thread
+  std::vector<size_t> list_sizes() const {
+    std::vector<size_t> sizes(heads.size());
+    galois::runtime::on_each_gen(
+        [&](const unsigned int tid, const unsigned int num_threads) {
+          // Lists of threads that are not active now are shared out among
+          // the active ones
+          for (unsigned x = tid; x < heads.size(); x += num_threads) {
+            for (header* h = heads.getRemote(x)->first; h; h = h->next) {
+              sizes[x] += h->dend - h->dbegin;
+            }
+          }
+        },
+        std::make_tuple(galois::no_stats()));
+    return sizes;
+  }
+
   void destruct_parallel(void) {
     galois::runtime::on_each_gen(
         [this](const unsigned int tid, const unsigned int) {
@@ -254,6 +282,48 @@ public:
     }
     return true;
   }
+  //! Number of elements; computed in parallel from the blocks of each thread
+  size_t size() const {
+    std::vector<size_t> sizes = list_sizes();
+    return std::accumulate(sizes.begin(), sizes.end(), size_t{0});
+  }
+
+  /**
+   * Copies the elements into [out, out + size()) in iteration order and
+   * returns out + size(). Each thread copies the elements it pushed, at an
+   * offset given by a prefix sum of the number of elements of each thread,
+   * so the copy reads socket-local blocks and first touches the part of
+   * the output it writes.
+   */
+  template <typename RandomIt>
+  RandomIt copy_to(RandomIt out) const {
+    std::vector<size_t> offsets = list_sizes();
+    size_t total = 0;
+    for (size_t& offset : offsets) {
+      size_t count = offset;
+      offset = total;
+      total += count;
+    }
+    galois::runtime::on_each_gen(
+        [&](const unsigned int tid, const unsigned int num_threads) {
+          for (unsigned x = tid; x < heads.size(); x += num_threads) {
+            RandomIt dest = out + offsets[x];
+            for (header* h = heads.getRemote(x)->first; h; h = h->next) {
+              dest = std::copy(h->dbegin, h->dend, dest);
+            }
+          }
+        },
+        std::make_tuple(galois::no_stats()));
+    return out + total;
+  }
+
+  //! The elements in iteration order
+  std::vector<T> to_vector() const {
+    std::vector<T> values(size());
+    copy_to(values.begin());
+    return values;
+  }
+
   //! Thread safe bag insertion
   template <typename... Args>
   reference emplace(Args&&... args) {
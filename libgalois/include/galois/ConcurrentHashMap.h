@@ -0,0 +1,277 @@
+#ifndef GALOIS_LIBGALOIS_GALOIS_CONCURRENTHASHMAP_H_
+#define GALOIS_LIBGALOIS_GALOIS_CONCURRENTHASHMAP_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "galois/LargeArray.h"
+#include "galois/Logging.h"
+#include "galois/Loops.h"
+#include "galois/Range.h"
+#include "galois/Reduction.h"
+#include "galois/config.h"
+
+namespace galois {
+
+/// Hash for integer keys that mixes every bit of the key into the low bits
+/// used to pick a slot (the MurmurHash3 finalizer), so that strided keys do
+/// not collide
+struct IntegerHash {
+  uint64_t operator()(uint64_t key) const {
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    key *= 0xc4ceb9fe1a85ec53ULL;
+    key ^= key >> 33;
+    return key;
+  }
+};
+
+/// A lock-free hash map from integer keys to small trivially copyable
+/// values, using open addressing with linear probing.
+///
+/// The map is phase concurrent: Insert, Upsert and Find may be called
+/// concurrently from a parallel loop, but a Find of a key that is being
+/// inserted in the same loop may see the initial value rather than the
+/// inserted one, and Insert and Upsert should not be mixed on the same key
+/// in the same loop. Keys are never removed. The remaining operations
+/// (construction, ForEach, ToVector, Reserve, Rebuild and Clear) run in
+/// parallel themselves and must be called outside a parallel region.
+///
+/// The table does not grow while keys are inserted. Size it for the
+/// expected number of keys, or call Reserve between loops; inserting into a
+/// full table is fatal. The largest key, kEmptyKey, marks empty slots and
+/// cannot be inserted.
+template <typename Key, typename Value, typename Hash = IntegerHash>
+class ConcurrentHashMap {
+  static_assert(std::is_integral_v<Key>, "keys must be integers");
+  static_assert(
+      std::is_trivially_copyable_v<Value>,
+      "values must be trivially copyable");
+
+public:
+  using key_type = Key;
+  using mapped_type = Value;
+
+  static constexpr Key kEmptyKey = std::numeric_limits<Key>::max();
+
+  /// A map with room for num_keys keys, whose keys start with the value
+  /// initial when they are first upserted
+  explicit ConcurrentHashMap(size_t num_keys = 0, Value initial = Value{})
+      : initial_(initial) {
+    Allocate(CapacityFor(num_keys));
+  }
+
+  /// Insert key with value if key is not in the map; returns true if it was
+  /// inserted
+  bool Insert(Key key, Value value) {
+    bool claimed = false;
+    Slot& slot = Claim(key, &claimed);
+    if (claimed) {
+      slot.value.store(value, std::memory_order_release);
+      num_keys_ += 1;
+    }
+    return claimed;
+  }
+
+  /// Set the value of key to combine(old, value), where old is the current
+  /// value of key, or the initial value if key is not in the map. combine
+  /// may be called more than once if other threads update key concurrently.
+  template <typename Combine>
+  void Upsert(Key key, Value value, const Combine& combine) {
+    bool claimed = false;
+    Slot& slot = Claim(key, &claimed);
+    if (claimed) {
+      num_keys_ += 1;
+    }
+    Value old = slot.value.load(std::memory_order_relaxed);
+    while (!slot.value.compare_exchange_weak(
+        old, combine(old, value), std::memory_order_acq_rel,
+        std::memory_order_relaxed)) {
+    }
+  }
+
+  /// The value of key, if it is in the map
+  std::optional<Value> Find(Key key) const {
+    for (size_t i = Home(key), probes = 0; probes < slots_.size();
+         i = (i + 1) & mask_, ++probes) {
+      const Slot& slot = slots_[i];
+      Key k = slot.key.load(std::memory_order_acquire);
+      if (k == key) {
+        return slot.value.load(std::memory_order_acquire);
+      }
+      if (k == kEmptyKey) {
+        break;
+      }
+    }
+    return std::nullopt;
+  }
+
+  bool Contains(Key key) const { return Find(key).has_value(); }
+
+  /// The number of keys; only valid outside a parallel region
+  size_t Size() { return num_keys_.reduce(); }
+
+  bool Empty() { return Size() == 0; }
+
+  /// The number of slots in the table
+  size_t Capacity() const { return slots_.size(); }
+
+  /// Call fn(key, value) on every key in parallel, in no particular order
+  template <typename F>
+  void ForEach(const F& fn) const {
+    do_all(
+        iterate(size_t{0}, slots_.size()),
+        [&](size_t i) {
+          Key k = slots_[i].key.load(std::memory_order_relaxed);
+          if (k != kEmptyKey) {
+            fn(k, slots_[i].value.load(std::memory_order_relaxed));
+          }
+        },
+        steal(), no_stats());
+  }
+
+  /// The (key, value) pairs of the map, in no particular order
+  std::vector<std::pair<Key, Value>> ToVector() const {
+    // Each thread copies out the keys of an equal share of the slots; a
+    // first pass counts them to find where each share goes
+    std::vector<size_t> offsets(getActiveThreads() + 1);
+    auto share = [&](unsigned tid, unsigned num_threads) {
+      return std::make_pair(
+          slots_.size() * tid / num_threads,
+          slots_.size() * (tid + 1) / num_threads);
+    };
+    on_each([&](unsigned tid, unsigned num_threads) {
+      auto [begin, end] = share(tid, num_threads);
+      size_t count = 0;
+      for (size_t i = begin; i < end; ++i) {
+        count += slots_[i].key.load(std::memory_order_relaxed) != kEmptyKey;
+      }
+      offsets[tid + 1] = count;
+    });
+    for (size_t t = 1; t < offsets.size(); ++t) {
+      offsets[t] += offsets[t - 1];
+    }
+
+    std::vector<std::pair<Key, Value>> pairs(offsets.back());
+    on_each([&](unsigned tid, unsigned num_threads) {
+      auto [begin, end] = share(tid, num_threads);
+      size_t out = offsets[tid];
+      for (size_t i = begin; i < end; ++i) {
+        Key k = slots_[i].key.load(std::memory_order_relaxed);
+        if (k != kEmptyKey) {
+          pairs[out++] = {k, slots_[i].value.load(std::memory_order_relaxed)};
+        }
+      }
+    });
+    return pairs;
+  }
+
+  /// Make room for num_keys keys, rebuilding the table if it is too small
+  void Reserve(size_t num_keys) {
+    if (CapacityFor(num_keys) > Capacity()) {
+      Rebuild(num_keys);
+    }
+  }
+
+  /// Reinsert every key into a new table with room for num_keys keys, or
+  /// the current number of keys if that is larger
+  void Rebuild(size_t num_keys) {
+    LargeArray<Slot> old = std::move(slots_);
+    Allocate(CapacityFor(std::max(num_keys, Size())));
+    do_all(
+        iterate(size_t{0}, old.size()),
+        [&](size_t i) {
+          Key k = old[i].key.load(std::memory_order_relaxed);
+          if (k != kEmptyKey) {
+            bool claimed = false;
+            Claim(k, &claimed)
+                .value.store(
+                    old[i].value.load(std::memory_order_relaxed),
+                    std::memory_order_relaxed);
+          }
+        },
+        steal(), no_stats());
+  }
+
+  /// Remove every key, keeping the capacity
+  void Clear() {
+    Fill();
+    num_keys_.reset();
+  }
+
+private:
+  struct Slot {
+    std::atomic<Key> key;
+    std::atomic<Value> value;
+  };
+
+  LargeArray<Slot> slots_;
+  size_t mask_{0};
+  Value initial_;
+  Hash hash_;
+  GAccumulator<size_t> num_keys_;
+
+  /// Twice the number of keys, so that probes stay short, as a power of two
+  static size_t CapacityFor(size_t num_keys) {
+    size_t capacity = 16;
+    while (capacity < 2 * num_keys) {
+      capacity *= 2;
+    }
+    return capacity;
+  }
+
+  void Allocate(size_t capacity) {
+    slots_.allocateInterleaved(capacity);
+    mask_ = capacity - 1;
+    Fill();
+  }
+
+  void Fill() {
+    do_all(
+        iterate(size_t{0}, slots_.size()),
+        [&](size_t i) {
+          slots_[i].key.store(kEmptyKey, std::memory_order_relaxed);
+          slots_[i].value.store(initial_, std::memory_order_relaxed);
+        },
+        no_stats());
+  }
+
+  size_t Home(Key key) const {
+    return hash_(static_cast<uint64_t>(key)) & mask_;
+  }
+
+  /// The slot of key, which is claimed from the first empty slot in its
+  /// probe sequence if key is not yet in the map
+  Slot& Claim(Key key, bool* claimed) {
+    assert(key != kEmptyKey);
+    for (size_t i = Home(key), probes = 0; probes < slots_.size();
+         i = (i + 1) & mask_, ++probes) {
+      Slot& slot = slots_[i];
+      Key k = slot.key.load(std::memory_order_acquire);
+      if (k == kEmptyKey) {
+        if (slot.key.compare_exchange_strong(
+                k, key, std::memory_order_acq_rel)) {
+          *claimed = true;
+          return slot;
+        }
+        // Lost the slot; k is now the key that won it
+      }
+      if (k == key) {
+        return slot;
+      }
+    }
+    GALOIS_LOG_FATAL("ConcurrentHashMap of capacity {} is full", Capacity());
+  }
+};
+
+}  // namespace galois
+
+#endif
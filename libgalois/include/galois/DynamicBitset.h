@@ -26,8 +26,10 @@
 #ifndef GALOIS_LIBGALOIS_GALOIS_DYNAMICBITSET_H_
 #define GALOIS_LIBGALOIS_GALOIS_DYNAMICBITSET_H_
 
+#include <algorithm>
 #include <cassert>
 #include <climits>
+#include <iterator>
 #include <vector>
 
 #include <boost/iterator/counting_iterator.hpp>
@@ -39,8 +41,33 @@
 #include "galois/config.h"
 
 namespace galois {
+
+namespace internal {
+
+/// The index of the lowest set bit; bits must not be zero
+inline unsigned
+CountTrailingZeros(uint64_t bits) {
+  assert(bits != 0);
+#ifdef __GNUC__
+  return __builtin_ctzll(bits);
+#else
+  unsigned n = 0;
+  while ((bits & 1) == 0) {
+    bits >>= 1;
+    ++n;
+  }
+  return n;
+#endif
+}
+
+}  // namespace internal
+
 /**
  * Concurrent dynamically allocated bitset
+ *
+ * Single bits may be tested, set and reset concurrently. Bulk operations
+ * (bitwise operations between bitsets, counting, and finding set bits) work
+ * a word at a time in parallel and expect no concurrent updates.
  **/
 class GALOIS_EXPORT DynamicBitset {
   galois::PODResizeableArray<galois::CopyableAtomic<uint64_t>> bitvec;
@@ -238,10 +265,100 @@ public:
     return (old_val & bit_offset);
   }
 
-  // assumes bit_vector is not updated (set) in parallel
+  /**
+   * Set every bit in a sorted range of indices. Indices that fall in the same
+   * word are combined into a single atomic update, so this is safe to call
+   * concurrently with set() and other calls of set_sorted().
+   *
+   * Runs in parallel; do NOT call in a parallel region.
+   *
+   * @param begin first index to set
+   * @param end one past the last index to set
+   */
+  template <typename Iter>
+  void set_sorted(Iter begin, Iter end);
+
+  /**
+   * Find the first set bit at or after a position.
+   *
+   * @param pos position to start looking from
+   * @returns the index of the first set bit at or after pos, or size() if
+   * there is none
+   */
+  size_t find_next(size_t pos) const {
+    size_t word = pos / bits_uint64;
+    if (pos >= num_bits) {
+      return num_bits;
+    }
+    uint64_t bits = bitvec[word].load(std::memory_order_relaxed) &
+                    (~uint64_t{0} << (pos % bits_uint64));
+    while (bits == 0) {
+      if (++word == bitvec.size()) {
+        return num_bits;
+      }
+      bits = bitvec[word].load(std::memory_order_relaxed);
+    }
+    return word * bits_uint64 + internal::CountTrailingZeros(bits);
+  }
+
+  /**
+   * Find the first set bit.
+   *
+   * @returns the index of the first set bit, or size() if there is none
+   */
+  size_t find_first() const { return find_next(0); }
+
+  /**
+   * Call fn(index) on every set bit in order. Whole words are skipped when
+   * empty and set bits are found with a count trailing zeros instruction.
+   *
+   * @param fn function to call on the index of each set bit
+   */
+  template <typename F>
+  void for_each_set(const F& fn) const {
+    ForEachSetInWords(0, bitvec.size(), fn);
+  }
+
+  /**
+   * Call fn(index) on every set bit in parallel. The bitset is split into
+   * chunks of words that are distributed with work stealing.
+   *
+   * Do NOT call in a parallel region.
+   *
+   * @param fn function to call on the index of each set bit
+   */
+  template <typename F>
+  void parallel_for_each_set(const F& fn) const {
+    size_t num_chunks = (bitvec.size() + kChunkWords - 1) / kChunkWords;
+    galois::do_all(
+        galois::iterate(size_t{0}, num_chunks),
+        [&](size_t chunk) {
+          size_t begin = chunk * kChunkWords;
+          ForEachSetInWords(
+              begin, std::min(begin + kChunkWords, bitvec.size()), fn);
+        },
+        galois::steal(), galois::no_stats());
+  }
+
+  /**
+   * Does an IN-PLACE bitwise or of this bitset and another bitset
+   *
+   * Like all the bitwise operations below, this works on whole words in
+   * parallel and assumes the bitsets are not updated (set) in parallel.
+   *
+   * @param other Other bitset to do bitwise or with
+   */
   void bitwise_or(const DynamicBitset& other);
 
-  // assumes bit_vector is not updated (set) in parallel
+  /**
+   * Does an IN-PLACE bitwise or of 2 passed in bitsets and saves to this
+   * bitset
+   *
+   * @param other1 Bitset to or with other 2
+   * @param other2 Bitset to or with other 1
+   */
+  void bitwise_or(const DynamicBitset& other1, const DynamicBitset& other2);
+
 
   /**
    * Does an IN-PLACE bitwise and of this bitset and another bitset
@@ -275,6 +392,22 @@ public:
    */
   void bitwise_xor(const DynamicBitset& other1, const DynamicBitset& other2);
 
+  /**
+   * Does an IN-PLACE bitwise and-not of this bitset and another bitset, i.e.,
+   * clears the bits that are set in the other bitset
+   *
+   * @param other Bitset whose set bits are cleared from this one
+   */
+  void bitwise_andnot(const DynamicBitset& other);
+
+  /**
+   * Saves other1 and-not other2 to this bitset
+   *
+   * @param other1 Bitset to take bits from
+   * @param other2 Bitset whose set bits are not taken
+   */
+  void bitwise_andnot(const DynamicBitset& other1, const DynamicBitset& other2);
+
   /**
    * Count how many bits are set in the bitset
    *
@@ -282,6 +415,30 @@ public:
    */
   uint64_t count() const;
 
+  /**
+   * Count how many bits are set in a range of words of the bitset; unlike
+   * count(), this is serial and may be called in a parallel region
+   *
+   * @param begin first word to count
+   * @param end one past the last word to count
+   * @returns number of set bits in words [begin, end)
+   */
+  uint64_t count_words(size_t begin, size_t end) const;
+
+  /**
+   * Check if any bit is set. Stops at the first non-empty word.
+   *
+   * @returns true if some bit is set
+   */
+  bool any() const { return find_first() != num_bits; }
+
+  /**
+   * Check if no bit is set. Stops at the first non-empty word.
+   *
+   * @returns true if no bit is set
+   */
+  bool none() const { return !any(); }
+
   /**
    * Returns a vector containing the set bits in this bitset in order
    * from left to right.
@@ -292,10 +449,64 @@ public:
   template <typename integer>
   std::vector<integer> getOffsets() const;
 
+  /**
+   * Resizes the bitset to n bits and sets exactly the bits in offsets,
+   * the inverse of getOffsets(). Offsets must be sorted.
+   * Do NOT call in a parallel region.
+   *
+   * @param n Size to change the bitset to
+   * @param offsets sorted indices of the bits to set
+   */
+  template <typename integer>
+  void setOffsets(uint64_t n, const std::vector<integer>& offsets) {
+    resize(n);
+    set_sorted(offsets.begin(), offsets.end());
+  }
+
   //! this is defined to
   using tt_is_copyable = int;
+
+private:
+  //! Number of words handed to a thread at a time by parallel operations
+  static constexpr size_t kChunkWords = 256;
+
+  template <typename F>
+  void ForEachSetInWords(size_t begin, size_t end, const F& fn) const {
+    for (size_t word = begin; word < end; ++word) {
+      uint64_t bits = bitvec[word].load(std::memory_order_relaxed);
+      while (bits != 0) {
+        fn(word * bits_uint64 + internal::CountTrailingZeros(bits));
+        // clear the lowest set bit
+        bits &= bits - 1;
+      }
+    }
+  }
 };
 
+template <typename Iter>
+void
+DynamicBitset::set_sorted(Iter begin, Iter end) {
+  size_t size = std::distance(begin, end);
+  size_t num_chunks = (size + kChunkWords - 1) / kChunkWords;
+  galois::do_all(
+      galois::iterate(size_t{0}, num_chunks),
+      [&](size_t chunk) {
+        Iter it = begin + chunk * kChunkWords;
+        Iter chunk_end = begin + std::min(size, (chunk + 1) * kChunkWords);
+        while (it != chunk_end) {
+          assert(static_cast<size_t>(*it) < num_bits);
+          size_t word = *it / bits_uint64;
+          uint64_t mask = 0;
+          for (; it != chunk_end && *it / bits_uint64 == word; ++it) {
+            mask |= uint64_t{1} << (*it % bits_uint64);
+          }
+          // Chunks may share a word at their boundaries
+          bitvec[word].fetch_or(mask, std::memory_order_relaxed);
+        }
+      },
+      galois::no_stats());
+}
+
 template <>
 std::vector<uint32_t> DynamicBitset::getOffsets() const;
 
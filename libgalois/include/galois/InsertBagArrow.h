@@ -0,0 +1,48 @@
+#ifndef GALOIS_LIBGALOIS_GALOIS_INSERTBAGARROW_H_
+#define GALOIS_LIBGALOIS_GALOIS_INSERTBAGARROW_H_
+
+#include <memory>
+
+#include <arrow/api.h>
+
+#include "galois/Bag.h"
+#include "galois/ErrorCode.h"
+#include "galois/Logging.h"
+#include "galois/NumaMemoryPool.h"
+#include "galois/Result.h"
+
+namespace galois {
+
+/// Export the elements of bag, which must be numbers, as an arrow array in
+/// iteration order. The elements are copied in parallel (see
+/// InsertBag::copy_to) straight into the buffer of the array, which is
+/// allocated from pool and not copied again. For example, a bag of result
+/// values can be added as a column with arrow::Table::AddColumn.
+template <typename T, unsigned int BlockSize>
+Result<std::shared_ptr<arrow::Array>>
+ToArrowArray(
+    const InsertBag<T, BlockSize>& bag,
+    arrow::MemoryPool* pool = GetPropertyMemoryPool()) {
+  using ArrowType = typename arrow::CTypeTraits<T>::ArrowType;
+  using ArrayType = typename arrow::TypeTraits<ArrowType>::ArrayType;
+  static_assert(
+      arrow::is_number_type<ArrowType>::value,
+      "only bags of numbers can be exported");
+
+  size_t size = bag.size();
+  auto buffer_result = arrow::AllocateBuffer(size * sizeof(T), pool);
+  if (!buffer_result.ok()) {
+    GALOIS_LOG_DEBUG("arrow error: {}", buffer_result.status());
+    return ErrorCode::ArrowError;
+  }
+  std::shared_ptr<arrow::Buffer> buffer =
+      std::move(buffer_result.ValueOrDie());
+  bag.copy_to(reinterpret_cast<T*>(buffer->mutable_data()));
+  std::shared_ptr<arrow::Array> array =
+      std::make_shared<ArrayType>(size, std::move(buffer));
+  return array;
+}
+
+}  // namespace galois
+
+#endif
@@ -43,23 +43,23 @@ class LargeArray {
   T* data_{};
   size_t size_{};
 
-  void Allocate(size_t n, AllocType t) {
+  void Allocate(size_t n, AllocType t, substrate::PageKind pages) {
     assert(!data_);
     size_ = n;
     switch (t) {
     case AllocType::Blocked:
-      real_data_ =
-          substrate::largeMallocBlocked(n * sizeof(T), runtime::activeThreads);
+      real_data_ = substrate::largeMallocBlocked(
+          n * sizeof(T), runtime::activeThreads, pages);
       break;
     case AllocType::Interleaved:
       real_data_ = substrate::largeMallocInterleaved(
-          n * sizeof(T), runtime::activeThreads);
+          n * sizeof(T), runtime::activeThreads, pages);
       break;
     case AllocType::Local:
-      real_data_ = substrate::largeMallocLocal(n * sizeof(T));
+      real_data_ = substrate::largeMallocLocal(n * sizeof(T), pages);
       break;
     case AllocType::Floating:
-      real_data_ = substrate::largeMallocFloating(n * sizeof(T));
+      real_data_ = substrate::largeMallocFloating(n * sizeof(T), pages);
       break;
     default:
       assert(false);
@@ -128,28 +128,47 @@ public:
 
   //! [allocatefunctions]
   //! Allocates interleaved across NUMA (memory) nodes.
-  void allocateInterleaved(size_type n) { Allocate(n, AllocType::Interleaved); }
+  void allocateInterleaved(
+      size_type n,
+      substrate::PageKind pages = substrate::defaultPageKind()) {
+    Allocate(n, AllocType::Interleaved, pages);
+  }
 
   /**
    * Allocates using blocked memory policy
    *
    * @param  n         number of elements to allocate
+   * @param  pages     kind of pages to back the array with
    */
-  void allocateBlocked(size_type n) { Allocate(n, AllocType::Blocked); }
+  void allocateBlocked(
+      size_type n,
+      substrate::PageKind pages = substrate::defaultPageKind()) {
+    Allocate(n, AllocType::Blocked, pages);
+  }
 
   /**
    * Allocates using Thread Local memory policy
    *
    * @param  n         number of elements to allocate
+   * @param  pages     kind of pages to back the array with
    */
-  void allocateLocal(size_type n) { Allocate(n, AllocType::Local); }
+  void allocateLocal(
+      size_type n,
+      substrate::PageKind pages = substrate::defaultPageKind()) {
+    Allocate(n, AllocType::Local, pages);
+  }
 
   /**
    * Allocates using no memory policy (no pre alloc)
    *
    * @param  n         number of elements to allocate
+   * @param  pages     kind of pages to back the array with
    */
-  void allocateFloating(size_type n) { Allocate(n, AllocType::Floating); }
+  void allocateFloating(
+      size_type n,
+      substrate::PageKind pages = substrate::defaultPageKind()) {
+    Allocate(n, AllocType::Floating, pages);
+  }
 
   /**
    * Allocate memory to threads based on a provided array specifying which
@@ -160,13 +179,16 @@ public:
    * @param num Number of elements to allocate space for
    * @param ranges An array specifying how elements should be split
    * among threads
+   * @param pages Kind of pages to back the array with
    */
   template <typename RangeArray>
-  void allocateSpecified(size_type num, RangeArray& ranges) {
+  void allocateSpecified(
+      size_type num, RangeArray& ranges,
+      substrate::PageKind pages = substrate::defaultPageKind()) {
     assert(!data_);
 
     real_data_ = substrate::largeMallocSpecified(
-        num * sizeof(T), runtime::activeThreads, ranges, sizeof(T));
+        num * sizeof(T), runtime::activeThreads, ranges, sizeof(T), pages);
 
     size_ = num;
     data_ = reinterpret_cast<T*>(real_data_.get());
@@ -250,12 +272,18 @@ public:
   iterator end() { return nullptr; }
   const_iterator end() const { return nullptr; }
 
-  void allocateInterleaved(size_type) {}
-  void allocateBlocked(size_type) {}
-  void allocateLocal(size_type) {}
-  void allocateFloating(size_type) {}
+  void allocateInterleaved(
+      size_type, substrate::PageKind = substrate::PageKind::kHuge2M) {}
+  void allocateBlocked(
+      size_type, substrate::PageKind = substrate::PageKind::kHuge2M) {}
+  void allocateLocal(
+      size_type, substrate::PageKind = substrate::PageKind::kHuge2M) {}
+  void allocateFloating(
+      size_type, substrate::PageKind = substrate::PageKind::kHuge2M) {}
   template <typename RangeArray>
-  void allocateSpecified(size_type, RangeArray) {}
+  void allocateSpecified(
+      size_type, RangeArray,
+      substrate::PageKind = substrate::PageKind::kHuge2M) {}
 
   template <typename... Args>
   void construct(Args&&...) {}
@@ -20,8 +20,23 @@
 #ifndef GALOIS_LIBGALOIS_GALOIS_MEM_H_
 #define GALOIS_LIBGALOIS_GALOIS_MEM_H_
 
+#include <cstdint>
+#include <new>
+#include <utility>
+
+#if __has_include(<version>)
+#include <version>
+#endif
+#ifdef __cpp_lib_memory_resource
+#include <memory_resource>
+#define GALOIS_HAS_MEMORY_RESOURCE 1
+#endif
+
+#include <boost/utility.hpp>
+
 #include "galois/config.h"
 #include "galois/runtime/Mem.h"
+#include "galois/substrate/PerThreadStorage.h"
 
 namespace galois {
 
@@ -39,15 +54,112 @@ void Prealloc(size_t pagesPerThread, size_t bytes);
 GALOIS_EXPORT
 void Prealloc(size_t pages);
 
+/**
+ * A bump-pointer arena for short-lived allocations of one thread.
+ *
+ * Memory comes from the Galois page pool of the thread and is only given
+ * back, all at once, by clear(); deallocate is a no-op. Allocations too big
+ * for a page come from malloc and are also released by clear(). Released
+ * pages stay with the arena, so an arena that is cleared at every iteration
+ * or round allocates nothing from the system once it has warmed up.
+ *
+ * An arena is not thread-safe. Operators reach one through
+ * UserContext::getPerIterAlloc (with galois::per_iter_alloc) or through a
+ * PerThreadArena.
+ */
+class Arena : private boost::noncopyable {
+public:
+  enum { AllocSize = 0 };
+
+  void* allocate(size_t size) { return heap_.allocate(size); }
+
+  //! Allocate size bytes aligned to alignment, a power of two
+  void* allocate(size_t size, size_t alignment) {
+    if (alignment <= alignof(double)) {
+      return heap_.allocate(size);
+    }
+    // The heap aligns to a double; pad so the result can be aligned up
+    uintptr_t ptr = reinterpret_cast<uintptr_t>(
+        heap_.allocate(size + alignment - alignof(double)));
+    return reinterpret_cast<void*>((ptr + alignment - 1) & ~(alignment - 1));
+  }
+
+  void deallocate(void*) {}
+
+  //! Release everything allocated from the arena. Objects in it are not
+  //! destroyed.
+  void clear() { heap_.clear(); }
+
+  //! Construct a T in the arena
+  template <typename T, typename... Args>
+  T* create(Args&&... args) {
+    return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+  }
+
+#ifdef GALOIS_HAS_MEMORY_RESOURCE
+  //! The arena as a std::pmr::memory_resource, e.g., for std::pmr::vector
+  std::pmr::memory_resource* resource() { return &resource_; }
+#endif
+
+private:
+  //! [Arena heap]
+  runtime::BumpWithMallocHeap<runtime::FreeListHeap<runtime::SystemHeap>>
+      heap_;
+  //! [Arena heap]
+
+#ifdef GALOIS_HAS_MEMORY_RESOURCE
+  class Resource : public std::pmr::memory_resource {
+    Arena* arena_;
+
+    void* do_allocate(size_t bytes, size_t alignment) override {
+      return arena_->allocate(bytes, alignment);
+    }
+    void do_deallocate(void*, size_t, size_t) override {}
+    bool do_is_equal(
+        const std::pmr::memory_resource& other) const noexcept override {
+      return this == &other;
+    }
+
+  public:
+    explicit Resource(Arena* arena) : arena_(arena) {}
+  };
+
+  Resource resource_{this};
+#endif
+};
+
+//! STL allocator that allocates from an Arena
+template <typename T>
+using ArenaAllocator = galois::runtime::ExternalHeapAllocator<T, Arena>;
+
+/**
+ * An Arena for each thread, for operators of loops without a UserContext
+ * such as do_all. Operators allocate from getLocal(). An operator whose
+ * allocations die with it can clear its arena when it starts; otherwise,
+ * clear() releases the memory of every thread at a loop or round boundary.
+ */
+class PerThreadArena {
+public:
+  Arena& getLocal() { return *arenas_.getLocal(); }
+
+  //! Clear the arena of every thread. Not to be called inside a parallel
+  //! loop.
+  void clear() {
+    for (unsigned i = 0; i < arenas_.size(); ++i) {
+      arenas_.getRemote(i)->clear();
+    }
+  }
+
+private:
+  substrate::PerThreadStorage<Arena> arenas_;
+};
+
 //! [PerIterAllocTy example]
 //! Base allocator for per-iteration allocator
-typedef galois::runtime::BumpWithMallocHeap<
-    galois::runtime::FreeListHeap<galois::runtime::SystemHeap>>
-    IterAllocBaseTy;
+typedef Arena IterAllocBaseTy;
 
 //! Per-iteration allocator that conforms to STL allocator interface
-typedef galois::runtime::ExternalHeapAllocator<char, IterAllocBaseTy>
-    PerIterAllocTy;
+typedef ArenaAllocator<char> PerIterAllocTy;
 //! [PerIterAllocTy example]
 
 //! Scalable fixed-sized allocator for T that conforms to STL allocator
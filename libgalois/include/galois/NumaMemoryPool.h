@@ -0,0 +1,115 @@
+#ifndef GALOIS_LIBGALOIS_GALOIS_NUMAMEMORYPOOL_H_
+#define GALOIS_LIBGALOIS_GALOIS_NUMAMEMORYPOOL_H_
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <arrow/memory_pool.h>
+#include <arrow/status.h>
+
+#include "galois/config.h"
+#include "galois/substrate/NumaMem.h"
+
+namespace galois {
+
+/// Where the pages of a large buffer are placed, as in the LargeArray
+/// allocation functions (see the NUMA page of the manual)
+enum class NumaPlacement {
+  /// On the socket of the allocating thread
+  kLocal,
+  /// Page by page, round robin over the active threads
+  kInterleaved,
+  /// In one contiguous block per active thread
+  kBlocked,
+};
+
+/// An arrow::MemoryPool that places property arrays on NUMA sockets the way
+/// LargeArray places topology.
+///
+/// Buffers of at least one huge page (substrate::allocSize()) are mapped
+/// with substrate::largeMalloc* and pre-faulted by the active threads
+/// according to the placement. Buffers allocated inside a parallel loop are
+/// placed locally, since the threads cannot be recruited to fault them in.
+/// Smaller buffers are not worth a mapping of their own and come from
+/// malloc; they are counted on the socket of the allocating thread.
+///
+/// Besides the totals every arrow::MemoryPool reports, the pool tracks how
+/// many bytes it has placed on each socket. Placement is computed from the
+/// policy and thread topology at allocation time rather than queried from
+/// the kernel. Allocations must happen while a SharedMemSys is alive.
+/// Buffers may be freed later.
+///
+/// Buffers are charged to memory accounting (see galois/MemoryAccounting.h)
+/// under the current category of the allocating thread, kProperties by
+/// default.
+class GALOIS_EXPORT NumaMemoryPool : public arrow::MemoryPool {
+public:
+  explicit NumaMemoryPool(NumaPlacement placement);
+  ~NumaMemoryPool() override;
+
+  arrow::Status Allocate(int64_t size, uint8_t** out) override;
+  arrow::Status Reallocate(
+      int64_t old_size, int64_t new_size, uint8_t** ptr) override;
+  void Free(uint8_t* buffer, int64_t size) override;
+
+  int64_t bytes_allocated() const override;
+  int64_t max_memory() const override;
+  std::string backend_name() const override;
+
+  NumaPlacement placement() const { return placement_; }
+
+  /// Bytes currently allocated on each socket, indexed by socket
+  std::vector<int64_t> socket_bytes() const;
+
+  /// Report BytesAllocated, MaxBytes and Socket<n>Bytes to StatManager
+  /// under region
+  void ReportStats(const std::string& region) const;
+
+private:
+  /// Bytes of a buffer on each socket
+  using SocketSplit = std::vector<int64_t>;
+
+  SocketSplit Split(int64_t size, NumaPlacement placement) const;
+  /// Add bytes to the totals
+  void Account(int64_t bytes);
+  void AccountSplit(const SocketSplit& split, int64_t sign);
+
+  NumaPlacement placement_;
+  std::atomic<int64_t> bytes_allocated_{0};
+  std::atomic<int64_t> max_memory_{0};
+  std::vector<std::atomic<int64_t>> socket_bytes_;
+
+  /// A large buffer: where its pages were placed, and how to free it
+  struct Placed {
+    SocketSplit split;
+    substrate::internal::largeFreer freer;
+  };
+
+  std::mutex mutex_;
+  std::map<uint8_t*, Placed> placed_;
+};
+
+/// The process-wide pool for placement
+GALOIS_EXPORT NumaMemoryPool* GetNumaMemoryPool(NumaPlacement placement);
+
+/// The pool that property arrays are allocated from: graph construction,
+/// AllocateTable (and so analytics outputs) and ArrowRandomAccessBuilder.
+///
+/// By default, this is arrow::default_memory_pool(), wrapped to charge
+/// memory accounting like a NumaMemoryPool does. If the environment variable
+/// GALOIS_PROPERTY_PLACEMENT is local, interleaved or blocked, it is the
+/// NumaMemoryPool with that placement.
+GALOIS_EXPORT arrow::MemoryPool* GetPropertyMemoryPool();
+
+/// Change the pool returned by GetPropertyMemoryPool. nullptr restores the
+/// default.
+GALOIS_EXPORT void SetPropertyMemoryPool(arrow::MemoryPool* pool);
+
+}  // namespace galois
+
+#endif
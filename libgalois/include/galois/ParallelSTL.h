@@ -20,6 +20,14 @@
 #ifndef GALOIS_LIBGALOIS_GALOIS_PARALLELSTL_H_
 #define GALOIS_LIBGALOIS_GALOIS_PARALLELSTL_H_
 
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <random>
+#include <type_traits>
+#include <vector>
+
 #include "galois/LoopsDecl.h"
 #include "galois/NoDerefIterator.h"
 #include "galois/Range.h"
@@ -391,6 +399,480 @@ partial_sum(InputIt first, InputIt last, OutputIt d_first) {
   }
 }
 
+namespace internal {
+
+/// Below this many elements, the block-based algorithms below run serially
+constexpr size_t kSerialCutoff = 1024;
+
+/// The number of blocks to split size elements into: one per active thread,
+/// or one for small inputs
+inline size_t
+num_blocks(size_t size) {
+  return size < kSerialCutoff ? 1 : getActiveThreads();
+}
+
+/// The half-open range [begin, end) of block out of num_blocks equal blocks
+/// of [0, size)
+inline std::pair<size_t, size_t>
+block_range(size_t size, size_t block, size_t num_blocks) {
+  size_t block_size = (size + num_blocks - 1) / num_blocks;
+  size_t begin = std::min(block * block_size, size);
+  return std::make_pair(begin, std::min(begin + block_size, size));
+}
+
+/// Call fn(block, begin, end) for each of num_blocks contiguous blocks of
+/// [0, size). Block i is always run by thread i, so successive passes over
+/// the same data touch the same memory from the same thread and socket.
+template <typename F>
+void
+for_each_block(size_t size, size_t num_blocks, const F& fn) {
+  if (num_blocks == 1) {
+    fn(size_t{0}, size_t{0}, size);
+    return;
+  }
+  on_each([&](unsigned tid, unsigned num) {
+    assert(num == num_blocks);
+    auto range = block_range(size, tid, num);
+    fn(size_t{tid}, range.first, range.second);
+  });
+}
+
+/// Scratch space for n elements. Trivial types are left uninitialized, so
+/// each page is first touched by the thread that fills it.
+template <typename T>
+std::unique_ptr<T[]>
+make_buffer(size_t n) {
+  return std::unique_ptr<T[]>(new T[n]);
+}
+
+/// Move [buffer, buffer + size) to d_first in parallel
+template <typename T, typename OutputIt>
+void
+move_back(T* buffer, size_t size, OutputIt d_first) {
+  for_each_block(
+      size, num_blocks(size), [&](size_t, size_t begin, size_t end) {
+        std::move(buffer + begin, buffer + end, d_first + begin);
+      });
+}
+
+template <bool Inclusive, typename InputIt, typename OutputIt, typename T,
+          typename BinaryOp>
+OutputIt
+scan(
+    InputIt first, InputIt last, OutputIt d_first, std::optional<T> init,
+    BinaryOp op) {
+  size_t size = std::distance(first, last);
+  size_t blocks = num_blocks(size);
+
+  // carry[b] is the value carried into block b from the blocks before it
+  std::vector<std::optional<T>> carry(blocks);
+  if (blocks > 1) {
+    for_each_block(size, blocks, [&](size_t b, size_t begin, size_t end) {
+      if (begin == end) {
+        return;
+      }
+      T sum = first[begin];
+      for (size_t i = begin + 1; i < end; ++i) {
+        sum = op(sum, first[i]);
+      }
+      carry[b] = std::move(sum);
+    });
+  }
+  std::optional<T> running = std::move(init);
+  for (size_t b = 0; b < blocks; ++b) {
+    std::optional<T> sum = std::move(carry[b]);
+    carry[b] = running;
+    if (sum) {
+      running = running ? op(*running, *sum) : std::move(*sum);
+    }
+  }
+
+  for_each_block(size, blocks, [&](size_t b, size_t begin, size_t end) {
+    if (begin == end) {
+      return;
+    }
+    size_t i = begin;
+    if constexpr (Inclusive) {
+      T acc = carry[b] ? *carry[b] : T(first[i++]);
+      if (i != begin) {
+        d_first[begin] = acc;
+      }
+      for (; i < end; ++i) {
+        acc = op(acc, first[i]);
+        d_first[i] = acc;
+      }
+    } else {
+      T acc = *carry[b];
+      for (; i < end; ++i) {
+        // Read before writing: d_first may alias first
+        T value = first[i];
+        d_first[i] = acc;
+        acc = op(acc, value);
+      }
+    }
+  });
+
+  return d_first + size;
+}
+
+/// Per-block bucket counts of [first, first + size)
+template <typename RandomIt, typename BucketFn>
+std::vector<std::vector<size_t>>
+bucket_counts(
+    RandomIt first, size_t size, size_t blocks, size_t num_buckets,
+    BucketFn& bucket_fn) {
+  std::vector<std::vector<size_t>> counts(blocks);
+  for_each_block(size, blocks, [&](size_t b, size_t begin, size_t end) {
+    std::vector<size_t> local(num_buckets);
+    for (size_t i = begin; i < end; ++i) {
+      ++local[bucket_fn(first[i])];
+    }
+    counts[b] = std::move(local);
+  });
+  return counts;
+}
+
+/// Move [first, first + size) to d_first grouped by bucket, keeping the
+/// relative order of elements in the same bucket. Returns the offset of
+/// each bucket in d_first, followed by size.
+template <typename RandomIt, typename OutputIt, typename BucketFn>
+std::vector<size_t>
+stable_scatter(
+    RandomIt first, size_t size, OutputIt d_first, size_t num_buckets,
+    BucketFn& bucket_fn) {
+  size_t blocks = num_blocks(size);
+  std::vector<std::vector<size_t>> counts =
+      bucket_counts(first, size, blocks, num_buckets, bucket_fn);
+
+  std::vector<size_t> starts(num_buckets + 1);
+  for_each_block(num_buckets, blocks, [&](size_t, size_t begin, size_t end) {
+    for (size_t k = begin; k < end; ++k) {
+      for (const auto& local : counts) {
+        starts[k] += local[k];
+      }
+    }
+  });
+  scan<false>(
+      starts.begin(), starts.end(), starts.begin(),
+      std::optional<size_t>(0), std::plus<size_t>());
+
+  // counts[b][k] becomes where block b writes its next element of bucket k
+  for_each_block(num_buckets, blocks, [&](size_t, size_t begin, size_t end) {
+    for (size_t k = begin; k < end; ++k) {
+      size_t offset = starts[k];
+      for (auto& local : counts) {
+        size_t count = local[k];
+        local[k] = offset;
+        offset += count;
+      }
+    }
+  });
+
+  for_each_block(size, blocks, [&](size_t b, size_t begin, size_t end) {
+    std::vector<size_t>& offsets = counts[b];
+    for (size_t i = begin; i < end; ++i) {
+      d_first[offsets[bucket_fn(first[i])]++] = std::move(first[i]);
+    }
+  });
+
+  return starts;
+}
+
+}  // namespace internal
+
+/**
+ * Parallel std::exclusive_scan: d_first[i] is init combined with
+ * first[0], ..., first[i - 1]. op must be associative. d_first may equal
+ * first.
+ *
+ * Like the other block-based algorithms below, the input is split into one
+ * contiguous block per active thread; each block is reduced, the block sums
+ * are scanned serially and each block is then scanned from its carry-in.
+ */
+template <class InputIt, class OutputIt, class T, class BinaryOp>
+OutputIt
+exclusive_scan(
+    InputIt first, InputIt last, OutputIt d_first, T init, BinaryOp op) {
+  return internal::scan<false>(
+      first, last, d_first, std::optional<T>(std::move(init)), op);
+}
+
+template <class InputIt, class OutputIt, class T>
+OutputIt
+exclusive_scan(InputIt first, InputIt last, OutputIt d_first, T init) {
+  return galois::ParallelSTL::exclusive_scan(
+      first, last, d_first, std::move(init), std::plus<T>());
+}
+
+/**
+ * Parallel std::inclusive_scan: d_first[i] is init (if given) combined with
+ * first[0], ..., first[i]. op must be associative. d_first may equal first.
+ */
+template <class InputIt, class OutputIt, class BinaryOp, class T>
+OutputIt
+inclusive_scan(
+    InputIt first, InputIt last, OutputIt d_first, BinaryOp op, T init) {
+  return internal::scan<true>(
+      first, last, d_first, std::optional<T>(std::move(init)), op);
+}
+
+template <class InputIt, class OutputIt, class BinaryOp>
+OutputIt
+inclusive_scan(InputIt first, InputIt last, OutputIt d_first, BinaryOp op) {
+  using T = typename std::iterator_traits<InputIt>::value_type;
+  return internal::scan<true>(first, last, d_first, std::optional<T>(), op);
+}
+
+template <class InputIt, class OutputIt>
+OutputIt
+inclusive_scan(InputIt first, InputIt last, OutputIt d_first) {
+  using T = typename std::iterator_traits<InputIt>::value_type;
+  return galois::ParallelSTL::inclusive_scan(
+      first, last, d_first, std::plus<T>());
+}
+
+/**
+ * Counts how many elements fall into each bucket. bucket_fn maps an element
+ * to a bucket in [0, num_buckets). Each thread counts its block into a
+ * private array of num_buckets counters, which are then summed.
+ */
+template <class RandomIt, class BucketFn>
+std::vector<size_t>
+histogram(
+    RandomIt first, RandomIt last, size_t num_buckets, BucketFn bucket_fn) {
+  size_t size = std::distance(first, last);
+  size_t blocks = internal::num_blocks(size);
+  std::vector<std::vector<size_t>> counts =
+      internal::bucket_counts(first, size, blocks, num_buckets, bucket_fn);
+
+  std::vector<size_t> totals(num_buckets);
+  internal::for_each_block(
+      num_buckets, blocks, [&](size_t, size_t begin, size_t end) {
+        for (size_t k = begin; k < end; ++k) {
+          for (const auto& local : counts) {
+            totals[k] += local[k];
+          }
+        }
+      });
+  return totals;
+}
+
+/**
+ * Stable counting sort: orders elements by bucket_fn, which maps an element
+ * to a bucket in [0, num_buckets), keeping the relative order of elements in
+ * the same bucket. Returns the offset of each bucket, followed by the number
+ * of elements.
+ *
+ * Takes O(n + num_buckets * threads) work and a scratch copy of the input,
+ * so the value type must be default constructible. bucket_fn is called twice
+ * per element.
+ */
+template <class RandomIt, class BucketFn>
+std::vector<size_t>
+counting_sort(
+    RandomIt first, RandomIt last, size_t num_buckets, BucketFn bucket_fn) {
+  using T = typename std::iterator_traits<RandomIt>::value_type;
+  size_t size = std::distance(first, last);
+  std::unique_ptr<T[]> buffer = internal::make_buffer<T>(size);
+  std::vector<size_t> starts = internal::stable_scatter(
+      first, size, buffer.get(), num_buckets, bucket_fn);
+  internal::move_back(buffer.get(), size, first);
+  return starts;
+}
+
+/**
+ * Stable least-significant-digit radix sort by an unsigned integer key, one
+ * counting sort pass per byte. Bytes above the highest set bit of the
+ * largest key are skipped, so dense ids (e.g., node ids or degrees) take
+ * only a few passes.
+ */
+template <class RandomIt, class KeyFn>
+void
+radix_sort(RandomIt first, RandomIt last, KeyFn key_fn) {
+  using T = typename std::iterator_traits<RandomIt>::value_type;
+  using Key = std::decay_t<std::invoke_result_t<KeyFn&, const T&>>;
+  static_assert(
+      std::is_integral_v<Key> && std::is_unsigned_v<Key>,
+      "radix_sort keys must be unsigned integers");
+  constexpr unsigned kDigitBits = 8;
+  constexpr size_t kRadix = size_t{1} << kDigitBits;
+
+  size_t size = std::distance(first, last);
+  if (size < internal::kSerialCutoff) {
+    std::stable_sort(first, last, [&](const T& a, const T& b) {
+      return key_fn(a) < key_fn(b);
+    });
+    return;
+  }
+
+  GReduceMax<Key> max_key;
+  do_all(iterate(size_t{0}, size), [&](size_t i) {
+    max_key.update(key_fn(first[i]));
+  });
+  uint64_t max = max_key.reduce();
+  unsigned bits = max ? 64 - __builtin_clzll(max) : 0;
+  unsigned passes = (bits + kDigitBits - 1) / kDigitBits;
+  if (!passes) {
+    return;
+  }
+
+  std::unique_ptr<T[]> buffer = internal::make_buffer<T>(size);
+  for (unsigned pass = 0; pass < passes; ++pass) {
+    unsigned shift = pass * kDigitBits;
+    auto digit = [&](const T& v) {
+      return static_cast<size_t>(
+          (static_cast<uint64_t>(key_fn(v)) >> shift) & (kRadix - 1));
+    };
+    if (pass % 2 == 0) {
+      internal::stable_scatter(first, size, buffer.get(), kRadix, digit);
+    } else {
+      internal::stable_scatter(buffer.get(), size, first, kRadix, digit);
+    }
+  }
+  if (passes % 2 == 1) {
+    internal::move_back(buffer.get(), size, first);
+  }
+}
+
+template <class RandomIt>
+void
+radix_sort(RandomIt first, RandomIt last) {
+  using T = typename std::iterator_traits<RandomIt>::value_type;
+  galois::ParallelSTL::radix_sort(first, last, [](const T& v) { return v; });
+}
+
+/**
+ * Parallel sample sort. A random sample of the input picks splitters for a
+ * few buckets per thread; elements are then scattered to their buckets and
+ * the buckets are sorted independently. Not stable. Unlike sort, it needs a
+ * scratch copy of the input, so the value type must be default
+ * constructible, but it moves each element only a constant number of times
+ * outside the final per-bucket sorts.
+ */
+template <class RandomIt, class Compare>
+void
+sample_sort(RandomIt first, RandomIt last, Compare comp) {
+  using T = typename std::iterator_traits<RandomIt>::value_type;
+  // Buckets per thread, so that threads can balance uneven buckets
+  constexpr size_t kBucketsPerThread = 4;
+  // Samples per bucket
+  constexpr size_t kOversample = 16;
+
+  size_t size = std::distance(first, last);
+  size_t threads = getActiveThreads();
+  if (threads == 1 || size < internal::kSerialCutoff * threads) {
+    std::sort(first, last, comp);
+    return;
+  }
+
+  size_t num_buckets = threads * kBucketsPerThread;
+  std::mt19937_64 gen(size);
+  std::uniform_int_distribution<size_t> pick(0, size - 1);
+  std::vector<T> samples;
+  samples.reserve(num_buckets * kOversample);
+  for (size_t i = 0; i < num_buckets * kOversample; ++i) {
+    samples.push_back(first[pick(gen)]);
+  }
+  std::sort(samples.begin(), samples.end(), comp);
+  std::vector<T> splitters;
+  splitters.reserve(num_buckets - 1);
+  for (size_t k = 1; k < num_buckets; ++k) {
+    splitters.push_back(samples[k * kOversample]);
+  }
+
+  auto bucket_fn = [&](const T& v) -> size_t {
+    return std::upper_bound(splitters.begin(), splitters.end(), v, comp) -
+           splitters.begin();
+  };
+  std::unique_ptr<T[]> buffer = internal::make_buffer<T>(size);
+  std::vector<size_t> starts = internal::stable_scatter(
+      first, size, buffer.get(), num_buckets, bucket_fn);
+
+  do_all(
+      iterate(size_t{0}, num_buckets),
+      [&](size_t k) {
+        T* begin = buffer.get() + starts[k];
+        T* end = buffer.get() + starts[k + 1];
+        std::sort(begin, end, comp);
+        std::move(begin, end, first + starts[k]);
+      },
+      steal(), chunk_size<1>());
+}
+
+template <class RandomIt>
+void
+sample_sort(RandomIt first, RandomIt last) {
+  using T = typename std::iterator_traits<RandomIt>::value_type;
+  galois::ParallelSTL::sample_sort(first, last, std::less<T>());
+}
+
+/**
+ * Parallel std::stable_partition: moves the elements satisfying pred before
+ * those that do not, keeping the relative order within each group, and
+ * returns the start of the second group. pred is called twice per element
+ * and must give the same answer both times.
+ */
+template <class RandomIt, class Predicate>
+RandomIt
+stable_partition(RandomIt first, RandomIt last, Predicate pred) {
+  using T = typename std::iterator_traits<RandomIt>::value_type;
+  std::vector<size_t> starts = galois::ParallelSTL::counting_sort(
+      first, last, 2, [&](const T& v) -> size_t { return pred(v) ? 0 : 1; });
+  return first + starts[1];
+}
+
+/**
+ * Parallel std::unique: keeps the first element of each run of consecutive
+ * equivalent elements and returns the new end. pred must be an equivalence
+ * relation. Kept elements are copied rather than moved to scratch space,
+ * because neighboring blocks still compare against them.
+ */
+template <class RandomIt, class BinaryPredicate>
+RandomIt
+unique(RandomIt first, RandomIt last, BinaryPredicate pred) {
+  using T = typename std::iterator_traits<RandomIt>::value_type;
+  size_t size = std::distance(first, last);
+  size_t blocks = internal::num_blocks(size);
+  if (blocks == 1) {
+    return std::unique(first, last, pred);
+  }
+
+  auto keep = [&](size_t i) { return i == 0 || !pred(first[i - 1], first[i]); };
+
+  std::vector<size_t> offsets(blocks + 1);
+  internal::for_each_block(
+      size, blocks, [&](size_t b, size_t begin, size_t end) {
+        size_t kept = 0;
+        for (size_t i = begin; i < end; ++i) {
+          kept += keep(i);
+        }
+        offsets[b] = kept;
+      });
+  galois::ParallelSTL::exclusive_scan(
+      offsets.begin(), offsets.end(), offsets.begin(), size_t{0});
+  size_t new_size = offsets[blocks];
+
+  std::unique_ptr<T[]> buffer = internal::make_buffer<T>(new_size);
+  internal::for_each_block(
+      size, blocks, [&](size_t b, size_t begin, size_t end) {
+        size_t out = offsets[b];
+        for (size_t i = begin; i < end; ++i) {
+          if (keep(i)) {
+            buffer[out++] = first[i];
+          }
+        }
+      });
+  internal::move_back(buffer.get(), new_size, first);
+  return first + new_size;
+}
+
+template <class RandomIt>
+RandomIt
+unique(RandomIt first, RandomIt last) {
+  using T = typename std::iterator_traits<RandomIt>::value_type;
+  return galois::ParallelSTL::unique(first, last, std::equal_to<T>());
+}
+
 }  // end namespace ParallelSTL
 }  // end namespace galois
 #endif
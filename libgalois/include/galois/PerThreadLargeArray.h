@@ -0,0 +1,93 @@
+#ifndef GALOIS_LIBGALOIS_GALOIS_PERTHREADLARGEARRAY_H_
+#define GALOIS_LIBGALOIS_GALOIS_PERTHREADLARGEARRAY_H_
+
+#include <cstddef>
+#include <type_traits>
+
+#include "galois/LargeArray.h"
+#include "galois/Loops.h"
+#include "galois/Threads.h"
+#include "galois/config.h"
+#include "galois/substrate/PerThreadStorage.h"
+
+namespace galois {
+
+/// An array of n elements of T for each active thread, e.g., a per-thread
+/// frontier or per-node scratch array. Each thread allocates and constructs
+/// its own array, so that its pages are on the socket of the thread, rather
+/// than on the socket of the thread that allocates per-thread vectors in a
+/// PerThreadStorage. Arrays are allocated in whole huge pages (see
+/// substrate::largeMallocLocal), so arrays of different threads never share
+/// a cache line, but small arrays waste memory.
+template <typename T>
+class PerThreadLargeArray {
+  substrate::PerThreadStorage<LargeArray<T>> arrays_;
+  size_t size_{0};
+
+public:
+  PerThreadLargeArray() = default;
+
+  /// Arrays of n elements constructed from args; see allocate
+  template <typename... Args>
+  explicit PerThreadLargeArray(size_t n, const Args&... args) {
+    allocate(n, args...);
+  }
+
+  PerThreadLargeArray(const PerThreadLargeArray&) = delete;
+  PerThreadLargeArray& operator=(const PerThreadLargeArray&) = delete;
+
+  ~PerThreadLargeArray() { deallocate(); }
+
+  /// Allocate an array of n elements, each constructed from args, on each
+  /// active thread, replacing any previous arrays. Call it outside of
+  /// parallel regions.
+  template <typename... Args>
+  void allocate(size_t n, const Args&... args) {
+    deallocate();
+    if (n == 0) {
+      return;
+    }
+    size_ = n;
+    on_each([&](unsigned, unsigned) {
+      LargeArray<T>& array = *arrays_.getLocal();
+      array.allocateLocal(n);
+      array.construct(args...);
+    });
+  }
+
+  /// Destroy and free the arrays of all threads
+  void deallocate() {
+    for (unsigned t = 0; t < arrays_.size(); ++t) {
+      LargeArray<T>& array = *arrays_.getRemote(t);
+      // Destroy serially rather than with LargeArray::destroy, which starts
+      // a parallel loop for each array
+      if constexpr (!std::is_trivially_destructible_v<T>) {
+        for (T& x : array) {
+          x.~T();
+        }
+      }
+      array.deallocate();
+    }
+    size_ = 0;
+  }
+
+  /// The array of the calling thread
+  LargeArray<T>& getLocal() { return *arrays_.getLocal(); }
+  const LargeArray<T>& getLocal() const { return *arrays_.getLocal(); }
+
+  /// The array of thread, which is empty if thread was not active when the
+  /// arrays were allocated
+  LargeArray<T>& getRemote(unsigned thread) {
+    return *arrays_.getRemote(thread);
+  }
+  const LargeArray<T>& getRemote(unsigned thread) const {
+    return *arrays_.getRemote(thread);
+  }
+
+  /// The number of elements of each array
+  size_t size() const { return size_; }
+};
+
+}  // namespace galois
+
+#endif
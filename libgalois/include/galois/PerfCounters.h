@@ -0,0 +1,88 @@
+#ifndef GALOIS_LIBGALOIS_GALOIS_PERFCOUNTERS_H_
+#define GALOIS_LIBGALOIS_GALOIS_PERFCOUNTERS_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "galois/config.h"
+
+namespace galois {
+
+/// Hardware event counts of one thread, read from the Linux perf_event
+/// interface without any external library.
+///
+/// Counting is opt-in: set the environment variable GALOIS_PERF_COUNTERS
+/// to count events around every named do_all and for_each. Each thread
+/// reports the events it incurred as statistics of the loop (HwCycles,
+/// HwInstructions, HwLLCMisses, HwDTLBMisses, HwBranchMisses). Together
+/// they tell whether a loop is compute bound (high instructions per cycle),
+/// latency bound (low instructions per cycle, many LLC or dTLB misses) or
+/// bandwidth bound.
+///
+/// Events the processor or kernel does not support are not reported. If
+/// the kernel refuses access altogether (see perf_event_paranoid), counting
+/// is turned off with a warning.
+struct GALOIS_EXPORT PerfCounts {
+  static constexpr size_t kNumEvents = 5;
+
+  /// Event counts; only meaningful for events marked in valid
+  std::array<uint64_t, kNumEvents> values{};
+  std::array<bool, kNumEvents> valid{};
+  /// Time the events were enabled and actually counted. They differ when
+  /// the kernel multiplexes more events than there are hardware counters.
+  uint64_t time_enabled{0};
+  uint64_t time_running{0};
+
+  /// Statistic name of event i
+  static const char* EventName(size_t i);
+
+  /// Read the counters of the calling thread, opening them on first use.
+  /// Returns false if counters are not available.
+  static bool Read(PerfCounts* counts);
+
+  /// Whether GALOIS_PERF_COUNTERS is set and counters have not been found
+  /// unavailable
+  static bool Enabled();
+
+  /// Report the events of the calling thread since begin as statistics of
+  /// region
+  static void ReportSince(const char* region, const PerfCounts& begin);
+};
+
+/// Count the hardware events of the calling thread from construction to
+/// destruction and report them as statistics of region, scaled up if the
+/// counters were multiplexed.
+template <bool enabled>
+class PerfCounterScope {
+  const char* const region_;
+  PerfCounts begin_;
+  bool counting_;
+
+public:
+  explicit PerfCounterScope(const char* region)
+      : region_(region),
+        counting_(PerfCounts::Enabled() && PerfCounts::Read(&begin_)) {}
+
+  PerfCounterScope(const PerfCounterScope&) = delete;
+  PerfCounterScope& operator=(const PerfCounterScope&) = delete;
+
+  ~PerfCounterScope() {
+    if (counting_) {
+      PerfCounts::ReportSince(region_, begin_);
+    }
+  }
+};
+
+template <>
+class PerfCounterScope<false> {
+public:
+  explicit PerfCounterScope(const char*) {}
+
+  PerfCounterScope(const PerfCounterScope&) = delete;
+  PerfCounterScope& operator=(const PerfCounterScope&) = delete;
+};
+
+}  // namespace galois
+
+#endif
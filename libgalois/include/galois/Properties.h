@@ -12,6 +12,7 @@
 
 #include "galois/ErrorCode.h"
 #include "galois/Logging.h"
+#include "galois/NumaMemoryPool.h"
 #include "galois/Result.h"
 #include "galois/Traits.h"
 
@@ -345,17 +346,20 @@ struct LargeStringReadOnlyProperty {
   using ViewType = StringPropertyReadOnlyView<arrow::LargeStringArray>;
 };
 
+/// Allocate a table of num_rows rows of Props from pool, which defaults to
+/// the property pool (see GetPropertyMemoryPool)
 template <typename Props>
 Result<std::shared_ptr<arrow::Table>>
-AllocateTable(uint64_t num_rows, const std::vector<std::string>& names) {
+AllocateTable(
+    uint64_t num_rows, const std::vector<std::string>& names,
+    arrow::MemoryPool* pool = GetPropertyMemoryPool()) {
   constexpr auto num_tuple_elem = std::tuple_size<Props>::value;
   static_assert(num_tuple_elem != 0);
   std::shared_ptr<arrow::Table> table;
   std::vector<galois::PropertyArrowTuple<Props>> rows(num_rows);
   GALOIS_ASSERT(names.size() == num_tuple_elem);
-  // TODO(gill): Replace this with NUMA allocated buffers.
-  if (auto r = arrow::stl::TableFromTupleRange(
-          arrow::default_memory_pool(), std::move(rows), names, &table);
+  if (auto r =
+          arrow::stl::TableFromTupleRange(pool, std::move(rows), names, &table);
       !r.ok()) {
     GALOIS_LOG_DEBUG("arrow error: {}", r);
     return galois::ErrorCode::ArrowError;
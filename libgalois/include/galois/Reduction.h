@@ -20,10 +20,17 @@
 #ifndef GALOIS_LIBGALOIS_GALOIS_REDUCTION_H_
 #define GALOIS_LIBGALOIS_GALOIS_REDUCTION_H_
 
+#include <algorithm>
+#include <cstdint>
 #include <functional>
 #include <limits>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "galois/config.h"
+#include "galois/runtime/Executor_OnEach.h"
 #include "galois/substrate/PerThreadStorage.h"
 
 namespace galois {
@@ -226,5 +233,302 @@ public:
       : base_type(std::logical_or<bool>(), identity_value<bool, false>()) {}
 };
 
+/**
+ * An ArrayReducible reduces an array of size values of type T, like a
+ * Reducible for each element, without atomics on a shared array.
+ *
+ * Each thread updates a private copy of the array, which is allocated (and
+ * so first touched) by the thread on its first update. The final reduction
+ * merges the private copies in parallel, one block of elements at a time,
+ * so that the block of the result stays in cache while the copies of every
+ * thread are merged into it. A block_size of zero merges each thread's
+ * copies over one contiguous slice of the array instead.
+ *
+ * MergeFunc must be a copying merge function:
+ *
+ *   T operator()(const T& lhs, const T& rhs)
+ *
+ * The private copies take size * threads elements, so prefer a
+ * SparseReducible when few of the elements are updated.
+ */
+template <typename T, typename MergeFunc, typename IdFunc>
+class ArrayReducible : public MergeFunc, public IdFunc {
+  galois::substrate::PerThreadStorage<std::vector<T>> data_;
+  std::vector<T> result_;
+  size_t size_;
+  size_t block_size_;
+
+public:
+  using value_type = T;
+
+  /// Elements merged per block by default; about the size of an L1 cache
+  static size_t DefaultBlockSize() {
+    return std::max<size_t>(1, (size_t{1} << 15) / sizeof(T));
+  }
+
+  ArrayReducible(
+      size_t size, MergeFunc merge_func, IdFunc id_func,
+      size_t block_size = DefaultBlockSize())
+      : MergeFunc(merge_func),
+        IdFunc(id_func),
+        result_(size, IdFunc::operator()()),
+        size_(size),
+        block_size_(block_size) {}
+
+  size_t size() const { return size_; }
+
+  /**
+   * Merges rhs into element i of the thread local array
+   */
+  void update(size_t i, const T& rhs) {
+    T& lhs = getLocal()[i];
+    lhs = MergeFunc::operator()(lhs, rhs);
+  }
+
+  /**
+   * Returns a reference to the local array, allocating it if needed.
+   */
+  std::vector<T>& getLocal() {
+    std::vector<T>& local = *data_.getLocal();
+    if (local.size() != size_) {
+      local.assign(size_, IdFunc::operator()());
+    }
+    return local;
+  }
+
+  /**
+   * Merges the thread local arrays into the result, resets them and returns
+   * the result. Only valid outside the parallel region.
+   */
+  std::vector<T>& reduce() {
+    galois::runtime::on_each_gen(
+        [&](unsigned tid, unsigned num_threads) {
+          size_t block = block_size_;
+          if (block == 0) {
+            block = std::max<size_t>(
+                1, (size_ + num_threads - 1) / num_threads);
+          }
+          size_t num_blocks = (size_ + block - 1) / block;
+          for (size_t b = tid; b < num_blocks; b += num_threads) {
+            size_t begin = b * block;
+            size_t end = std::min(size_, begin + block);
+            for (unsigned i = 0; i < data_.size(); ++i) {
+              std::vector<T>& local = *data_.getRemote(i);
+              if (local.size() != size_) {
+                continue;
+              }
+              for (size_t k = begin; k < end; ++k) {
+                result_[k] = MergeFunc::operator()(result_[k], local[k]);
+                local[k] = IdFunc::operator()();
+              }
+            }
+          }
+        },
+        std::make_tuple());
+    return result_;
+  }
+
+  /**
+   * Resets the result and the thread local arrays, which stay allocated for
+   * the next round of updates.
+   */
+  void reset() {
+    galois::runtime::on_each_gen(
+        [&](unsigned tid, unsigned num_threads) {
+          size_t begin = size_ * tid / num_threads;
+          size_t end = size_ * (tid + 1) / num_threads;
+          std::fill(
+              result_.begin() + begin, result_.begin() + end,
+              IdFunc::operator()());
+          for (unsigned i = tid; i < data_.size(); i += num_threads) {
+            std::vector<T>& local = *data_.getRemote(i);
+            std::fill(local.begin(), local.end(), IdFunc::operator()());
+          }
+        },
+        std::make_tuple());
+  }
+};
+
+/**
+ * make_array_reducible creates an ArrayReducible of size elements from a
+ * merge function and identity function.
+ */
+template <typename MergeFn, typename IdFn>
+auto
+make_array_reducible(size_t size, const MergeFn& mergeFn, const IdFn& idFn) {
+  return ArrayReducible<std::invoke_result_t<IdFn>, MergeFn, IdFn>(
+      size, mergeFn, idFn);
+}
+
+/**
+ * A SparseReducible reduces values of type T by key, for key spaces too
+ * large to privatize as an ArrayReducible.
+ *
+ * Each thread updates private hash maps, one for each of num_shards shards
+ * of the keys. The final reduction merges each shard across threads in
+ * parallel and returns the (key, value) pairs in an unspecified order. As
+ * with ArrayReducible, MergeFunc must be a copying merge function.
+ */
+template <
+    typename Key, typename T, typename MergeFunc, typename IdFunc,
+    typename Hash = std::hash<Key>>
+class SparseReducible : public MergeFunc, public IdFunc {
+  using Map = std::unordered_map<Key, T, Hash>;
+
+  galois::substrate::PerThreadStorage<std::vector<Map>> data_;
+  std::vector<Map> merged_;
+  std::vector<std::pair<Key, T>> result_;
+  Hash hash_;
+  unsigned shard_bits_;
+
+  size_t shard(const Key& key) const {
+    if (shard_bits_ == 0) {
+      return 0;
+    }
+    // Take the shard from the high bits of a multiplicative hash, leaving
+    // the low bits that pick buckets within a shard independent of it
+    uint64_t h = static_cast<uint64_t>(hash_(key)) * 0x9e3779b97f4a7c15ULL;
+    return h >> (64 - shard_bits_);
+  }
+
+  std::vector<Map>& localShards() {
+    std::vector<Map>& local = *data_.getLocal();
+    if (local.empty()) {
+      local.resize(merged_.size());
+    }
+    return local;
+  }
+
+public:
+  using key_type = Key;
+  using value_type = T;
+
+  static constexpr unsigned kDefaultShardBits = 8;
+
+  SparseReducible(
+      MergeFunc merge_func, IdFunc id_func,
+      unsigned shard_bits = kDefaultShardBits)
+      : MergeFunc(merge_func),
+        IdFunc(id_func),
+        merged_(size_t{1} << shard_bits),
+        shard_bits_(shard_bits) {}
+
+  /**
+   * Merges rhs into the thread local value of key
+   */
+  void update(const Key& key, const T& rhs) {
+    Map& map = localShards()[shard(key)];
+    auto it = map.find(key);
+    if (it == map.end()) {
+      it = map.emplace(key, IdFunc::operator()()).first;
+    }
+    it->second = MergeFunc::operator()(it->second, rhs);
+  }
+
+  /**
+   * Merges the thread local values into the result, resets them and returns
+   * the merged value of every key updated since the last reset. Only valid
+   * outside the parallel region.
+   */
+  std::vector<std::pair<Key, T>>& reduce() {
+    size_t num_shards = merged_.size();
+    galois::runtime::on_each_gen(
+        [&](unsigned tid, unsigned num_threads) {
+          for (size_t s = tid; s < num_shards; s += num_threads) {
+            Map& merged = merged_[s];
+            for (unsigned i = 0; i < data_.size(); ++i) {
+              std::vector<Map>& local = *data_.getRemote(i);
+              if (local.empty()) {
+                continue;
+              }
+              for (auto& kv : local[s]) {
+                auto it = merged.find(kv.first);
+                if (it == merged.end()) {
+                  merged.emplace(kv.first, kv.second);
+                } else {
+                  it->second = MergeFunc::operator()(it->second, kv.second);
+                }
+              }
+              local[s].clear();
+            }
+          }
+        },
+        std::make_tuple());
+
+    std::vector<size_t> offsets(num_shards + 1);
+    for (size_t s = 0; s < num_shards; ++s) {
+      offsets[s + 1] = offsets[s] + merged_[s].size();
+    }
+    result_.resize(offsets[num_shards]);
+    galois::runtime::on_each_gen(
+        [&](unsigned tid, unsigned num_threads) {
+          for (size_t s = tid; s < num_shards; s += num_threads) {
+            std::copy(
+                merged_[s].begin(), merged_[s].end(),
+                result_.begin() + offsets[s]);
+          }
+        },
+        std::make_tuple());
+    return result_;
+  }
+
+  void reset() {
+    for (Map& merged : merged_) {
+      merged.clear();
+    }
+    for (unsigned i = 0; i < data_.size(); ++i) {
+      for (Map& map : *data_.getRemote(i)) {
+        map.clear();
+      }
+    }
+    result_.clear();
+  }
+};
+
+/**
+ * make_sparse_reducible creates a SparseReducible keyed by Key from a merge
+ * function and identity function.
+ */
+template <typename Key, typename MergeFn, typename IdFn>
+auto
+make_sparse_reducible(const MergeFn& mergeFn, const IdFn& idFn) {
+  return SparseReducible<Key, std::invoke_result_t<IdFn>, MergeFn, IdFn>(
+      mergeFn, idFn);
+}
+
+//! Accumulator for an array of T where accumulation is plus
+template <typename T>
+class GArrayAccumulator
+    : public ArrayReducible<T, std::plus<T>, identity_value_zero<T>> {
+  using base_type = ArrayReducible<T, std::plus<T>, identity_value_zero<T>>;
+
+public:
+  explicit GArrayAccumulator(
+      size_t size, size_t block_size = base_type::DefaultBlockSize())
+      : base_type(
+            size, std::plus<T>(), identity_value_zero<T>(), block_size) {}
+};
+
+//! Counts of the number of times each of size bins is added
+template <typename T = uint64_t>
+class GHistogram : public GArrayAccumulator<T> {
+public:
+  using GArrayAccumulator<T>::GArrayAccumulator;
+
+  void add(size_t bin) { this->update(bin, T{1}); }
+};
+
+//! Accumulator for T by key where accumulation is plus
+template <typename Key, typename T, typename Hash = std::hash<Key>>
+class GSparseAccumulator
+    : public SparseReducible<
+          Key, T, std::plus<T>, identity_value_zero<T>, Hash> {
+  using base_type =
+      SparseReducible<Key, T, std::plus<T>, identity_value_zero<T>, Hash>;
+
+public:
+  GSparseAccumulator() : base_type(std::plus<T>(), identity_value_zero<T>()) {}
+};
+
 }  // namespace galois
 #endif
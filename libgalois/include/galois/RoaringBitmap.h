@@ -0,0 +1,337 @@
+#ifndef GALOIS_LIBGALOIS_GALOIS_ROARINGBITMAP_H_
+#define GALOIS_LIBGALOIS_GALOIS_ROARINGBITMAP_H_
+
+#include <cassert>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <arrow/type_fwd.h>
+#include <boost/iterator/iterator_facade.hpp>
+
+#include "galois/DynamicBitset.h"
+#include "galois/Result.h"
+#include "galois/config.h"
+
+namespace galois {
+
+class RoaringBitmap;
+
+namespace internal {
+
+/// The values of a RoaringBitmap that share their upper 16 bits, stored by
+/// their lower 16 bits in whichever of three forms is the smallest.
+class GALOIS_EXPORT RoaringContainer {
+public:
+  enum class Type : uint8_t {
+    /// A sorted array of at most kMaxArray values
+    kArray,
+    /// One bit for each of the kRange possible values
+    kBitmap,
+    /// Sorted runs of consecutive values, as (start, length - 1) pairs
+    kRun,
+  };
+
+  /// Past this many values, a bitmap is smaller than an array
+  static constexpr uint32_t kMaxArray = 4096;
+  static constexpr uint32_t kRange = 1 << 16;
+  static constexpr uint32_t kBitmapWords = kRange / 64;
+
+  /// A position in the container while iterating
+  struct Cursor {
+    /// Index into the array, bit of the bitmap or index of the run
+    uint32_t index{0};
+    /// Offset into the run
+    uint32_t offset{0};
+  };
+
+  /// A container holding the sorted values, which may repeat
+  static RoaringContainer FromSorted(
+      const uint16_t* begin, const uint16_t* end);
+  /// A container holding the set bits of a bitmap of kBitmapWords words
+  static RoaringContainer FromWords(std::vector<uint64_t> words);
+
+  static RoaringContainer And(
+      const RoaringContainer& a, const RoaringContainer& b);
+  static RoaringContainer Or(
+      const RoaringContainer& a, const RoaringContainer& b);
+  static RoaringContainer AndNot(
+      const RoaringContainer& a, const RoaringContainer& b);
+  static RoaringContainer Xor(
+      const RoaringContainer& a, const RoaringContainer& b);
+
+  Type type() const { return type_; }
+  uint32_t cardinality() const { return cardinality_; }
+  bool empty() const { return cardinality_ == 0; }
+
+  bool Contains(uint16_t value) const;
+
+  /// Add value; returns true if it was not already present
+  bool Add(uint16_t value);
+
+  /// Add the values [begin, end), where end <= kRange
+  void AddRange(uint32_t begin, uint32_t end);
+
+  /// Convert to the smallest of the three forms
+  void Optimize();
+
+  /// The largest value; the container must not be empty
+  uint16_t Maximum() const;
+
+  size_t SizeInBytes() const;
+
+  /// The values of the container as a bitmap of kBitmapWords words
+  std::vector<uint64_t> ToWords() const;
+
+  /// Call fn(value) on every value in order
+  template <typename F>
+  void ForEach(const F& fn) const {
+    switch (type_) {
+    case Type::kArray:
+      for (uint16_t value : values_) {
+        fn(value);
+      }
+      break;
+    case Type::kBitmap:
+      for (uint32_t word = 0; word < kBitmapWords; ++word) {
+        for (uint64_t bits = words_[word]; bits != 0; bits &= bits - 1) {
+          fn(static_cast<uint16_t>(word * 64 + __builtin_ctzll(bits)));
+        }
+      }
+      break;
+    case Type::kRun:
+      for (size_t run = 0; run < values_.size(); run += 2) {
+        uint32_t last = uint32_t{values_[run]} + values_[run + 1];
+        for (uint32_t value = values_[run]; value <= last; ++value) {
+          fn(static_cast<uint16_t>(value));
+        }
+      }
+      break;
+    }
+  }
+
+  /// The position of the value with the given rank, i.e., the rank-th
+  /// smallest value, counting from zero
+  Cursor Seek(uint32_t rank) const;
+
+  uint16_t At(const Cursor& cursor) const {
+    switch (type_) {
+    case Type::kArray:
+      return values_[cursor.index];
+    case Type::kBitmap:
+      return cursor.index;
+    case Type::kRun:
+      return values_[2 * cursor.index] + cursor.offset;
+    }
+    return 0;
+  }
+
+  /// Move cursor to the next value, which must exist
+  void Advance(Cursor* cursor) const {
+    switch (type_) {
+    case Type::kArray:
+      ++cursor->index;
+      break;
+    case Type::kBitmap: {
+      uint32_t next = cursor->index + 1;
+      uint32_t word = next / 64;
+      uint64_t bits = words_[word] & (~uint64_t{0} << (next % 64));
+      while (bits == 0) {
+        bits = words_[++word];
+      }
+      cursor->index = word * 64 + __builtin_ctzll(bits);
+      break;
+    }
+    case Type::kRun:
+      if (cursor->offset < values_[2 * cursor->index + 1]) {
+        ++cursor->offset;
+      } else {
+        ++cursor->index;
+        cursor->offset = 0;
+      }
+      break;
+    }
+  }
+
+private:
+  friend class galois::RoaringBitmap;
+
+  Type type_{Type::kArray};
+  uint32_t cardinality_{0};
+  /// Array values or run pairs
+  std::vector<uint16_t> values_;
+  /// Bitmap words
+  std::vector<uint64_t> words_;
+};
+
+}  // namespace internal
+
+/// A compressed set of 32-bit values, such as node ids, in the style of
+/// Roaring bitmaps (Chambi et al., "Better bitmap performance with Roaring
+/// bitmaps", 2016).
+///
+/// Values are grouped by their upper 16 bits into containers, and each
+/// container stores its lower 16 bits as a sorted array, a 65536-bit bitmap
+/// or a list of runs, whichever is smallest. Memory therefore scales with
+/// the size (and clustering) of the set rather than with the range of
+/// values: a handful of nodes takes a few bytes, a contiguous range of a
+/// billion nodes a few hundred kilobytes, and a dense random set about one
+/// bit per possible value.
+///
+/// Set operations, conversions and RunOptimize work on containers in
+/// parallel and must not be called in a parallel region. Add and AddRange
+/// are serial and not thread safe. The bitmap may be passed to
+/// galois::iterate, which gives each thread an equal share of its values.
+class GALOIS_EXPORT RoaringBitmap {
+  using Container = internal::RoaringContainer;
+
+  /// Upper 16 bits of the values of each container, in increasing order
+  std::vector<uint16_t> keys_;
+  std::vector<Container> containers_;
+
+  template <typename Op>
+  static RoaringBitmap Combine(
+      const RoaringBitmap& a, const RoaringBitmap& b, bool keep_a,
+      bool keep_b, const Op& op);
+
+public:
+  /// Forward iterator over the values of the bitmap in increasing order
+  class Iterator : public boost::iterator_facade<
+                       Iterator, uint32_t, std::forward_iterator_tag,
+                       uint32_t> {
+    friend class boost::iterator_core_access;
+    friend class RoaringBitmap;
+
+    const RoaringBitmap* bitmap_{};
+    size_t container_{};
+    uint32_t rank_{};
+    Container::Cursor cursor_;
+
+    Iterator(const RoaringBitmap* bitmap, size_t container, uint32_t rank)
+        : bitmap_(bitmap), container_(container), rank_(rank) {
+      if (container_ < bitmap_->containers_.size()) {
+        cursor_ = bitmap_->containers_[container_].Seek(rank_);
+      }
+    }
+
+    void increment() {
+      const Container& container = bitmap_->containers_[container_];
+      if (++rank_ < container.cardinality()) {
+        container.Advance(&cursor_);
+        return;
+      }
+      ++container_;
+      rank_ = 0;
+      if (container_ < bitmap_->containers_.size()) {
+        cursor_ = bitmap_->containers_[container_].Seek(0);
+      }
+    }
+
+    bool equal(const Iterator& other) const {
+      return container_ == other.container_ && rank_ == other.rank_;
+    }
+
+    uint32_t dereference() const {
+      return (uint32_t{bitmap_->keys_[container_]} << 16) |
+             bitmap_->containers_[container_].At(cursor_);
+    }
+
+  public:
+    Iterator() = default;
+  };
+
+  using iterator = Iterator;
+  using const_iterator = Iterator;
+  using local_iterator = Iterator;
+  using value_type = uint32_t;
+
+  RoaringBitmap() = default;
+
+  /// The bitmap of a sorted vector of values, which may repeat
+  static RoaringBitmap FromSorted(const std::vector<uint32_t>& values);
+
+  /// The bitmap of the set bits of bitset
+  static RoaringBitmap FromBitset(const DynamicBitset& bitset);
+
+  /// Read a bitmap written by Serialize
+  static Result<RoaringBitmap> Deserialize(const uint8_t* data, size_t size);
+
+  /// The bitmap of the true values of a boolean node property; nulls are
+  /// treated as false
+  static Result<RoaringBitmap> FromNodeProperty(
+      const arrow::ChunkedArray& property);
+
+  static RoaringBitmap And(const RoaringBitmap& a, const RoaringBitmap& b);
+  static RoaringBitmap Or(const RoaringBitmap& a, const RoaringBitmap& b);
+  static RoaringBitmap AndNot(const RoaringBitmap& a, const RoaringBitmap& b);
+  static RoaringBitmap Xor(const RoaringBitmap& a, const RoaringBitmap& b);
+
+  /// Add value; returns true if it was not already present
+  bool Add(uint32_t value);
+
+  /// Add the values [begin, end)
+  void AddRange(uint64_t begin, uint64_t end);
+
+  bool Contains(uint32_t value) const;
+
+  uint64_t Cardinality() const;
+
+  /// The largest value; the bitmap must not be empty
+  uint32_t Maximum() const;
+
+  bool Empty() const { return containers_.empty(); }
+
+  /// Convert every container to its smallest form. Containers are kept
+  /// small as they are built, but runs are only found by AddRange and
+  /// here.
+  void RunOptimize();
+
+  /// Memory used by the containers, not counting allocator overhead
+  size_t SizeInBytes() const;
+
+  /// The values in increasing order
+  std::vector<uint32_t> ToVector() const;
+
+  /// Set the bits of the values of this bitmap in bitset, which must be
+  /// large enough to hold them
+  void ToBitset(DynamicBitset* bitset) const;
+
+  /// A portable (little endian) encoding of the bitmap
+  std::vector<uint8_t> Serialize() const;
+
+  /// A table with one boolean column, name, that is true for the nodes in
+  /// the bitmap; for use with PropertyFileGraph::AddNodeProperties. All
+  /// values must be less than num_nodes.
+  Result<std::shared_ptr<arrow::Table>> ToNodeProperty(
+      const std::string& name, uint64_t num_nodes) const;
+
+  /// Call fn(value) on every value in increasing order
+  template <typename F>
+  void ForEach(const F& fn) const {
+    for (size_t i = 0; i < containers_.size(); ++i) {
+      uint32_t high = uint32_t{keys_[i]} << 16;
+      containers_[i].ForEach([&](uint16_t low) { fn(high | low); });
+    }
+  }
+
+  /// The iterator at the value with the given rank
+  Iterator IteratorAt(uint64_t rank) const;
+
+  Iterator begin() const { return Iterator(this, 0, 0); }
+  Iterator end() const { return Iterator(this, containers_.size(), 0); }
+
+  /// The share of the values of the current thread
+  Iterator local_begin() const;
+  Iterator local_end() const;
+
+  bool operator==(const RoaringBitmap& other) const;
+  bool operator!=(const RoaringBitmap& other) const {
+    return !(*this == other);
+  }
+};
+
+}  // namespace galois
+
+#endif
@@ -0,0 +1,78 @@
+#ifndef GALOIS_LIBGALOIS_GALOIS_SETINTERSECTION_H_
+#define GALOIS_LIBGALOIS_GALOIS_SETINTERSECTION_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "galois/config.h"
+
+/// Intersection of sorted sets of node ids.
+///
+/// Neighbor-overlap algorithms (triangle counting, k-truss, Jaccard
+/// similarity, ...) spend most of their time intersecting the sorted
+/// adjacency lists of pairs of nodes. The functions here intersect two
+/// strictly increasing ranges of uint32_t values, which is what
+/// out_dests of a GraphTopology holds for a node after
+/// \ref galois::graphs::SortAllEdgesByDest.
+///
+/// Depending on the sizes of the inputs and on the instructions supported by
+/// the processor, the implementation chooses between a scalar merge,
+/// galloping search (when one range is much smaller than the other) and
+/// blocked SIMD comparison using AVX2 or AVX-512. The choice of SIMD kernel
+/// is made once at runtime, so binaries built for a generic architecture
+/// still use the widest instructions available.
+///
+/// Results are only defined when neither range contains duplicates.
+///
+/// \file SetIntersection.h
+
+namespace galois {
+
+enum class IntersectionKernel {
+  /// Pick a kernel based on the sizes of the inputs and the processor
+  kAutomatic,
+  /// Linear merge
+  kScalar,
+  /// Exponential search of the larger range for each element of the smaller
+  kGalloping,
+  /// 8x8 blocked comparison with AVX2
+  kAVX2,
+  /// 16x16 blocked comparison with AVX-512F
+  kAVX512,
+};
+
+/// \returns true if kernel can run on this processor
+GALOIS_EXPORT bool IsIntersectionKernelSupported(IntersectionKernel kernel);
+
+/// \returns the SIMD kernel (or kScalar) that kAutomatic uses on this
+/// processor for ranges of similar sizes
+GALOIS_EXPORT IntersectionKernel BestIntersectionKernel();
+
+/// IntersectionCount returns the number of values common to the sorted ranges
+/// [a, a + a_size) and [b, b + b_size).
+///
+/// The kernel must be supported by the processor (see
+/// IsIntersectionKernelSupported); kAutomatic always is.
+GALOIS_EXPORT size_t IntersectionCount(
+    const uint32_t* a, size_t a_size, const uint32_t* b, size_t b_size,
+    IntersectionKernel kernel = IntersectionKernel::kAutomatic);
+
+/// IntersectionCount returns the number of values common to the sorted ranges,
+/// but at most limit, and stops comparing once it has found limit of them.
+/// Use it when only whether the count reaches a threshold matters, e.g., the
+/// support of an edge in k-truss.
+GALOIS_EXPORT size_t IntersectionCount(
+    const uint32_t* a, size_t a_size, const uint32_t* b, size_t b_size,
+    size_t limit, IntersectionKernel kernel = IntersectionKernel::kAutomatic);
+
+/// Intersection writes the values common to the sorted ranges [a, a + a_size)
+/// and [b, b + b_size) to out in increasing order and returns the number of
+/// values written. out must have room for min(a_size, b_size) values and may
+/// not overlap the inputs.
+GALOIS_EXPORT size_t Intersection(
+    const uint32_t* a, size_t a_size, const uint32_t* b, size_t b_size,
+    uint32_t* out, IntersectionKernel kernel = IntersectionKernel::kAutomatic);
+
+}  // namespace galois
+
+#endif
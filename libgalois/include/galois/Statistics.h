@@ -313,6 +313,11 @@ protected:
   /// ReadParam and ReadFP and print their own results here.
   virtual void PrintStats(std::ostream& out);
 
+  /// PrintStatsJson prints statistics, including per-thread values, as a JSON
+  /// object with a "stats" array. Print uses it instead of PrintStats when
+  /// the stat file name ends in ".json".
+  void PrintStatsJson(std::ostream& out);
+
   void MergeStats();
 
   bool IsPrintingThreadVals() const;
@@ -346,6 +351,8 @@ public:
 
   virtual ~StatManager();
 
+  /// Print statistics to outfile instead of standard out. Statistics are
+  /// printed as CSV unless outfile ends in ".json".
   void SetStatFile(const std::string& outfile);
 
   void AddInt(
@@ -437,6 +444,23 @@ GALOIS_EXPORT void reportRUsage(const std::string& id);
 //! Reports Galois system memory stats for all threads
 GALOIS_EXPORT void reportPageAlloc(const char* category);
 
+//! Reports current and peak bytes of each memory category (see
+//! galois/MemoryAccounting.h), in total and per socket, as stats of region.
+//! Stats are maxima, so when region is reported several times (e.g., a loop
+//! that runs repeatedly), "...Bytes" is the largest usage seen at the end of
+//! any run, not at the end of the last one.
+//! @param region region to report stats under, e.g., a loop name
+GALOIS_EXPORT void reportMemoryUsage(const std::string& region);
+
+//! Calls reportMemoryUsage(loopname) if GALOIS_SAMPLE_MEMORY is set; named
+//! do_all and for_each loops call it when they finish
+GALOIS_EXPORT void sampleMemoryUsage(const char* loopname);
+
+//! Reports how often and how quickly thread pool threads were woken for
+//! parallel sections since the last report
+//! @param id Identifier to prefix stat with in statistics output
+GALOIS_EXPORT void reportWakeupStats(const std::string& id);
+
 /// Prints statistics out to standard out or to the file indicated by
 /// SetStatFile
 GALOIS_EXPORT void PrintStats();
@@ -0,0 +1,86 @@
+#ifndef GALOIS_LIBGALOIS_GALOIS_TASKGROUP_H_
+#define GALOIS_LIBGALOIS_GALOIS_TASKGROUP_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+#include <boost/noncopyable.hpp>
+
+#include "galois/config.h"
+#include "galois/substrate/ThreadPool.h"
+
+namespace galois {
+
+/// TaskGroup runs work spawned from inside a parallel loop operator in
+/// parallel. Spawned tasks are queued on the spawning thread. A thread that
+/// finishes its share of the enclosing loop steals queued tasks until none
+/// are left before it goes idle, and any thread waiting for a task group
+/// steals them too. This way a few very expensive items, such as hub nodes,
+/// can split their work instead of leaving one thread running long after
+/// the rest are done. Threads that went idle before a task was queued are
+/// not woken for it, so spawn early in an expensive item rather than late.
+///
+/// Tasks run outside of the enclosing loop's iteration context, so they
+/// must not rely on conflict detection or push work to the loop, and they
+/// cannot start parallel loops themselves. Outside of a parallel loop,
+/// tasks run serially in wait().
+///
+/// \code
+/// galois::TaskGroup tg;
+/// tg.run([&] { Left(); });
+/// Right();
+/// tg.wait();
+/// \endcode
+class TaskGroup : private boost::noncopyable {
+public:
+  TaskGroup() = default;
+  ~TaskGroup() { wait(); }
+
+  /// Spawn fn as a task. Anything fn refers to must live until wait()
+  /// returns.
+  template <typename F>
+  void run(F&& fn) {
+    pending_.fetch_add(1, std::memory_order_relaxed);
+    substrate::GetThreadPool().spawnTask(
+        substrate::ThreadPool::Task{std::forward<F>(fn), &pending_});
+  }
+
+  /// Wait for all tasks spawned by this group, running queued tasks while
+  /// waiting
+  void wait() { substrate::GetThreadPool().waitTasks(pending_); }
+
+private:
+  std::atomic<size_t> pending_{0};
+};
+
+/// Reduce op(fn(i)...) over i in [begin, end) by recursively splitting the
+/// range into tasks of at least grain indices. op must be associative and
+/// identity its identity.
+template <typename T, typename Fn, typename Op>
+T
+TaskReduce(
+    size_t begin, size_t end, size_t grain, const T& identity, const Fn& fn,
+    const Op& op) {
+  grain = std::max<size_t>(grain, 1);
+  if (end - begin <= grain) {
+    T acc = identity;
+    for (size_t i = begin; i < end; ++i) {
+      acc = op(acc, fn(i));
+    }
+    return acc;
+  }
+
+  size_t mid = begin + (end - begin) / 2;
+  T left = identity;
+  TaskGroup tg;
+  tg.run([&] { left = TaskReduce(begin, mid, grain, identity, fn, op); });
+  T right = TaskReduce(mid, end, grain, identity, fn, op);
+  tg.wait();
+  return op(left, right);
+}
+
+}  // namespace galois
+
+#endif
@@ -81,6 +81,13 @@ public:
   //! Acquire a per-iteration allocator
   PerIterAllocTy& getPerIterAlloc() { return PerIterationAllocator; }
 
+#ifdef GALOIS_HAS_MEMORY_RESOURCE
+  //! Acquire the per-iteration allocator as a std::pmr::memory_resource
+  std::pmr::memory_resource* getPerIterResource() {
+    return IterationAllocatorBase.resource();
+  }
+#endif
+
   //! Push new work
   template <typename... Args>
   void push(Args&&... args) {
@@ -5,6 +5,8 @@
 
 #include "galois/analytics/Plan.h"
 #include "galois/analytics/Utils.h"
+#include "galois/graphs/CompressedTopology.h"
+#include "galois/graphs/ProjectedTopology.h"
 
 namespace galois::analytics {
 
@@ -73,6 +75,27 @@ GALOIS_EXPORT Result<void> Bfs(
     const std::string& output_property_name,
     BfsPlan algo = BfsPlan::Automatic());
 
+/// Compute BFS level of the nodes of the subgraph of pfg selected by
+/// projection, starting from start_node (a node id of pfg). Nodes that are not
+/// part of the projection are left at the infinite distance. The property
+/// named output_property_name is created on pfg, as in the unprojected
+/// version. Projected edge ranges cannot be tiled, so tiled plans run their
+/// untiled counterparts.
+GALOIS_EXPORT Result<void> Bfs(
+    graphs::PropertyFileGraph* pfg, const graphs::ProjectedTopology& projection,
+    size_t start_node, const std::string& output_property_name,
+    BfsPlan algo = BfsPlan::Automatic());
+
+/// Compute BFS level of nodes in the graph pfg starting from start_node,
+/// traversing the edges of topology, a compressed copy of the topology of
+/// pfg. The output property is created on pfg as in the uncompressed version.
+/// Compressed edge ranges cannot be tiled, so tiled plans run their untiled
+/// counterparts.
+GALOIS_EXPORT Result<void> Bfs(
+    graphs::PropertyFileGraph* pfg, const graphs::CompressedTopology& topology,
+    size_t start_node, const std::string& output_property_name,
+    BfsPlan algo = BfsPlan::Automatic());
+
 GALOIS_EXPORT Result<bool> BfsValidate(
     graphs::PropertyFileGraph* pfg, const std::string& property_name);
 
@@ -3,6 +3,8 @@
 
 #include "bfs.h"
 #include "galois/analytics/BfsSsspImplementationBase.h"
+#include "galois/graphs/CompressedPropertyGraph.h"
+#include "galois/graphs/ProjectedPropertyGraph.h"
 
 namespace galois::analytics {
 
@@ -16,6 +18,30 @@ struct BfsImplementation
             unsigned int, false>{edge_tile_size} {}
 };
 
+struct ProjectedBfsImplementation
+    : BfsSsspImplementationBase<
+          graphs::ProjectedPropertyGraph<
+              std::tuple<BfsNodeDistance>, std::tuple<>>,
+          unsigned int, false> {
+  ProjectedBfsImplementation(ptrdiff_t edge_tile_size)
+      : BfsSsspImplementationBase<
+            graphs::ProjectedPropertyGraph<
+                std::tuple<BfsNodeDistance>, std::tuple<>>,
+            unsigned int, false>{edge_tile_size} {}
+};
+
+struct CompressedBfsImplementation
+    : BfsSsspImplementationBase<
+          graphs::CompressedPropertyGraph<
+              std::tuple<BfsNodeDistance>, std::tuple<>>,
+          unsigned int, false> {
+  CompressedBfsImplementation(ptrdiff_t edge_tile_size)
+      : BfsSsspImplementationBase<
+            graphs::CompressedPropertyGraph<
+                std::tuple<BfsNodeDistance>, std::tuple<>>,
+            unsigned int, false>{edge_tile_size} {}
+};
+
 }  // namespace galois::analytics
 
 #endif
@@ -20,12 +20,14 @@ public:
     kDeltaTile,
     kDeltaStep,
     kDeltaStepBarrier,
+    kDeltaStepAdaptive,
     kSerialDeltaTile,  // TODO: Do we want to expose these at all?
     kSerialDelta,
     kDijkstraTile,
     kDijkstra,
     kTopo,
     kTopoTile,
+    kMultiQueue,
     kAutomatic,
   };
 
@@ -69,6 +71,13 @@ public:
     return {kCPU, kDeltaStepBarrier, delta, 0};
   }
 
+  /// Delta stepping where the bucket width starts at 2^delta and is tuned
+  /// while the algorithm runs. Starting wide bounds the number of buckets
+  /// made before the first tuning decision.
+  static SsspPlan DeltaStepAdaptive(unsigned delta = 13) {
+    return {kCPU, kDeltaStepAdaptive, delta, 0};
+  }
+
   static SsspPlan SerialDeltaTile(
       unsigned delta = 13, ptrdiff_t edge_tile_size = 512) {
     return {kCPU, kSerialDeltaTile, delta, edge_tile_size};
@@ -91,27 +100,17 @@ public:
     return {kCPU, kTopoTile, 0, edge_tile_size};
   }
 
+  /// Asynchronous SSSP scheduled by exact distance with a relaxed priority
+  /// queue; unlike the delta stepping algorithms, it has no delta to tune.
+  static SsspPlan MultiQueue() { return {kCPU, kMultiQueue, 0, 0}; }
+
   static SsspPlan Automatic() { return {}; }
 
-  static SsspPlan Automatic(const galois::graphs::PropertyFileGraph* pfg) {
-    // TODO: What to do about const cast? We know we don't modify pfg, but there
-    //  is no way to construct a const PropertyGraph.
-    auto graph =
-        galois::graphs::PropertyGraph<std::tuple<>, std::tuple<>>::Make(
-            const_cast<galois::graphs::PropertyFileGraph*>(pfg), {}, {});
-    if (!graph)
-      GALOIS_LOG_FATAL(
-          "PropertyGraph should always be constructable here: {}",
-          graph.error());
-    galois::StatTimer autoAlgoTimer("SSSP_Automatic_Algorithm_Selection");
-    autoAlgoTimer.start();
-    bool isPowerLaw = isApproximateDegreeDistributionPowerLaw(graph.value());
-    autoAlgoTimer.stop();
-    if (isPowerLaw) {
-      return DeltaStep();
-    } else {
-      return DeltaStepBarrier();
-    }
+  /// Automatic picks delta stepping with adaptive bucket widths, which does
+  /// not depend on guessing a delta for the weights of pfg.
+  static SsspPlan Automatic(
+      [[maybe_unused]] const galois::graphs::PropertyFileGraph* pfg) {
+    return DeltaStepAdaptive();
   }
 };
 
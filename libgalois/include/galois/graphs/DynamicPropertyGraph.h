@@ -0,0 +1,211 @@
+#ifndef GALOIS_LIBGALOIS_GALOIS_GRAPHS_DYNAMICPROPERTYGRAPH_H_
+#define GALOIS_LIBGALOIS_GALOIS_GRAPHS_DYNAMICPROPERTYGRAPH_H_
+
+#include <cassert>
+#include <tuple>
+
+#include <boost/iterator/counting_iterator.hpp>
+
+#include "galois/NoDerefIterator.h"
+#include "galois/Properties.h"
+#include "galois/Range.h"
+#include "galois/Result.h"
+#include "galois/Traits.h"
+#include "galois/graphs/DynamicTopology.h"
+#include "galois/graphs/PropertyFileGraph.h"
+#include "galois/graphs/PropertyViews.h"
+
+namespace galois::graphs {
+
+/// A DynamicPropertyGraph is a typed view, like \ref PropertyGraph, of a
+/// \ref PropertyFileGraph whose edges are given by a \ref DynamicTopology.
+///
+/// Code written against the PropertyGraph interface (begin/end, edges,
+/// GetEdgeDest, GetData, GetEdgeData) works unchanged, so analytics can run
+/// between batches of updates without compacting first. Node properties are
+/// read from the PropertyFileGraph. Edge properties exist only for edges of
+/// the base topology; calling GetEdgeData on an inserted edge is an error.
+///
+/// Unlike PropertyGraph, edges(n) returns a forward range.
+///
+/// \tparam NodeProps A tuple of property types (\ref Properties.h) for nodes
+/// \tparam EdgeProps A tuple of property types for edges
+template <typename NodeProps, typename EdgeProps>
+class DynamicPropertyGraph {
+  using NodeView = PropertyViewTuple<NodeProps>;
+  using EdgeView = PropertyViewTuple<EdgeProps>;
+
+public:
+  using node_properties = NodeProps;
+  using edge_properties = EdgeProps;
+  using node_iterator = boost::counting_iterator<uint32_t>;
+  using edge_iterator = DynamicTopology::EdgeIterator;
+  using edges_iterator = StandardRange<NoDerefIterator<edge_iterator>>;
+  using iterator = node_iterator;
+  using Node = uint32_t;
+
+private:
+  PropertyFileGraph* pfg_;
+  const DynamicTopology* topology_;
+
+  NodeView node_view_;
+  EdgeView edge_view_;
+
+  DynamicPropertyGraph(
+      PropertyFileGraph* pfg, const DynamicTopology* topology,
+      NodeView node_view, EdgeView edge_view)
+      : pfg_(pfg),
+        topology_(topology),
+        node_view_(std::move(node_view)),
+        edge_view_(std::move(edge_view)) {}
+
+public:
+  // Standard container concepts
+
+  node_iterator begin() const { return node_iterator(0); }
+
+  node_iterator end() const { return node_iterator(num_nodes()); }
+
+  size_t size() const { return num_nodes(); }
+
+  bool empty() const { return num_nodes() == 0; }
+
+  // Graph accessors
+
+  /**
+   * Gets the node data.
+   *
+   * @param node node to get the data of
+   * @returns reference to the node data
+   */
+  template <typename NodeIndex>
+  PropertyReferenceType<NodeIndex> GetData(const Node& node) {
+    constexpr size_t prop_index = find_trait<NodeIndex, NodeProps>();
+    return std::get<prop_index>(node_view_).GetValue(node);
+  }
+  template <typename NodeIndex>
+  PropertyReferenceType<NodeIndex> GetData(const node_iterator& node) {
+    return GetData<NodeIndex>(*node);
+  }
+
+  template <typename NodeIndex>
+  PropertyConstReferenceType<NodeIndex> GetData(const Node& node) const {
+    constexpr size_t prop_index = find_trait<NodeIndex, NodeProps>();
+    return std::get<prop_index>(node_view_).GetValue(node);
+  }
+  template <typename NodeIndex>
+  PropertyConstReferenceType<NodeIndex> GetData(
+      const node_iterator& node) const {
+    return GetData<NodeIndex>(*node);
+  }
+
+  /**
+   * Gets the edge data. The edge must be an edge of the base topology.
+   *
+   * @param edge edge iterator to get the data of
+   * @returns reference to the edge data
+   */
+  template <typename EdgeIndex>
+  PropertyReferenceType<EdgeIndex> GetEdgeData(const edge_iterator& edge) {
+    assert(!DynamicTopology::IsDeltaEdge(*edge));
+    constexpr size_t prop_index = find_trait<EdgeIndex, EdgeProps>();
+    return std::get<prop_index>(edge_view_).GetValue(*edge);
+  }
+
+  template <typename EdgeIndex>
+  PropertyConstReferenceType<EdgeIndex> GetEdgeData(
+      const edge_iterator& edge) const {
+    assert(!DynamicTopology::IsDeltaEdge(*edge));
+    constexpr size_t prop_index = find_trait<EdgeIndex, EdgeProps>();
+    return std::get<prop_index>(edge_view_).GetValue(*edge);
+  }
+
+  /**
+   * Gets the destination for an edge.
+   *
+   * @param edge edge iterator to get the destination of
+   * @returns node iterator to the edge destination
+   */
+  node_iterator GetEdgeDest(const edge_iterator& edge) const {
+    return node_iterator(topology_->edge_dest(*edge));
+  }
+
+  uint64_t num_nodes() const { return topology_->num_nodes(); }
+  uint64_t num_edges() const { return topology_->num_edges(); }
+
+  /**
+   * Gets the edges of some node.
+   *
+   * @param node node to get the edge range of
+   * @returns iterable edge range for node.
+   */
+  edges_iterator edges(const node_iterator& node) const {
+    return MakeStandardRange(
+        make_no_deref_iterator(topology_->edge_begin(*node)),
+        make_no_deref_iterator(topology_->edge_end(*node)));
+  }
+
+  /**
+   * Accessor for first edge of a node.
+   */
+  edge_iterator edge_begin(Node node) const {
+    return topology_->edge_begin(node);
+  }
+
+  /**
+   * Accessor for end of edges of a node.
+   */
+  edge_iterator edge_end(Node node) const { return topology_->edge_end(node); }
+
+  const PropertyFileGraph& GetPropertyFileGraph() const { return *pfg_; }
+
+  const DynamicTopology& GetDynamicTopology() const { return *topology_; }
+
+  // Graph constructors
+  static Result<DynamicPropertyGraph<NodeProps, EdgeProps>> Make(
+      PropertyFileGraph* pfg, const DynamicTopology* topology,
+      const std::vector<std::string>& node_properties,
+      const std::vector<std::string>& edge_properties);
+  static Result<DynamicPropertyGraph<NodeProps, EdgeProps>> Make(
+      PropertyFileGraph* pfg, const DynamicTopology* topology);
+};
+
+template <typename NodeProps, typename EdgeProps>
+Result<DynamicPropertyGraph<NodeProps, EdgeProps>>
+DynamicPropertyGraph<NodeProps, EdgeProps>::Make(
+    PropertyFileGraph* pfg, const DynamicTopology* topology,
+    const std::vector<std::string>& node_properties,
+    const std::vector<std::string>& edge_properties) {
+  if (topology->num_nodes() != pfg->topology().num_nodes()) {
+    return ErrorCode::InvalidArgument;
+  }
+
+  auto node_view_result =
+      internal::MakeNodePropertyViews<NodeProps>(pfg, node_properties);
+  if (!node_view_result) {
+    return node_view_result.error();
+  }
+
+  auto edge_view_result =
+      internal::MakeEdgePropertyViews<EdgeProps>(pfg, edge_properties);
+  if (!edge_view_result) {
+    return edge_view_result.error();
+  }
+
+  return DynamicPropertyGraph(
+      pfg, topology, std::move(node_view_result.value()),
+      std::move(edge_view_result.value()));
+}
+
+template <typename NodeProps, typename EdgeProps>
+Result<DynamicPropertyGraph<NodeProps, EdgeProps>>
+DynamicPropertyGraph<NodeProps, EdgeProps>::Make(
+    PropertyFileGraph* pfg, const DynamicTopology* topology) {
+  return DynamicPropertyGraph<NodeProps, EdgeProps>::Make(
+      pfg, topology, pfg->node_schema()->field_names(),
+      pfg->edge_schema()->field_names());
+}
+
+}  // namespace galois::graphs
+
+#endif
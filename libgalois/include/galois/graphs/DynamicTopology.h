@@ -0,0 +1,184 @@
+#ifndef GALOIS_LIBGALOIS_GALOIS_GRAPHS_DYNAMICTOPOLOGY_H_
+#define GALOIS_LIBGALOIS_GALOIS_GRAPHS_DYNAMICTOPOLOGY_H_
+
+#include <cassert>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <boost/iterator/iterator_facade.hpp>
+
+#include "galois/DynamicBitset.h"
+#include "galois/Result.h"
+#include "galois/config.h"
+#include "galois/graphs/PropertyFileGraph.h"
+
+namespace galois::graphs {
+
+/// A DynamicTopology is a mutable topology layered over an immutable
+/// GraphTopology (delta-CSR).
+///
+/// Edges of the base CSR are never moved. Deleting one of them sets a bit in
+/// a deletion mask, and inserted edges are appended to a per-node buffer.
+/// Iterating over the edges of a node visits its undeleted base edges
+/// followed by its inserted edges. Insertions and deletions are applied in
+/// batches, in parallel, with each source node handled by a single thread so
+/// that no locking is needed; a batch must not run concurrently with readers.
+///
+/// As deltas accumulate, iteration gets slower. \ref Compact folds them back
+/// into a new base CSR in parallel.
+///
+/// Edges are identified by handles. The handle of a base edge is its id in
+/// the base CSR, so properties of base edges can be looked up directly. The
+/// handle of an inserted edge has \ref kDeltaEdgeBit set and is only stable
+/// until the next batch or compaction. Inserted edges have no properties.
+class GALOIS_EXPORT DynamicTopology {
+public:
+  using Edge = std::pair<uint32_t, uint32_t>;
+
+  static constexpr uint64_t kDeltaEdgeBit = uint64_t{1} << 63;
+
+private:
+  static constexpr int kDeltaIndexBits = 31;
+
+  GraphTopology base_;
+  /// Deleted edges of base_; empty if no base edge has been deleted
+  DynamicBitset deleted_;
+  /// Destinations of inserted edges, per source node
+  std::vector<std::vector<uint32_t>> delta_;
+
+  uint64_t num_deleted_{};
+  uint64_t num_inserted_{};
+
+  DynamicTopology(const GraphTopology& base);
+
+  bool IsBaseEdgeDeleted(uint64_t edge) const {
+    return deleted_.size() != 0 && deleted_.test(edge);
+  }
+
+public:
+  /// Forward iterator over the handles of the edges of one node
+  class EdgeIterator
+      : public boost::iterator_facade<
+            EdgeIterator, uint64_t, std::forward_iterator_tag, uint64_t> {
+    friend class boost::iterator_core_access;
+    friend class DynamicTopology;
+
+    const DynamicTopology* topology_{};
+    uint32_t node_{};
+    /// Position in [base begin, base end) followed by delta indices
+    uint64_t pos_{};
+    uint64_t base_end_{};
+
+    EdgeIterator(
+        const DynamicTopology* topology, uint32_t node, uint64_t pos,
+        uint64_t base_end)
+        : topology_(topology), node_(node), pos_(pos), base_end_(base_end) {
+      SkipDeleted();
+    }
+
+    void SkipDeleted() {
+      while (pos_ < base_end_ && topology_->IsBaseEdgeDeleted(pos_)) {
+        ++pos_;
+      }
+    }
+
+    void increment() {
+      ++pos_;
+      SkipDeleted();
+    }
+
+    bool equal(const EdgeIterator& other) const { return pos_ == other.pos_; }
+
+    uint64_t dereference() const {
+      if (pos_ < base_end_) {
+        return pos_;
+      }
+      return kDeltaEdgeBit | (uint64_t{node_} << kDeltaIndexBits) |
+             (pos_ - base_end_);
+    }
+
+  public:
+    EdgeIterator() = default;
+  };
+
+  /// Make a dynamic topology whose initial state is base. base itself is not
+  /// modified; this only shares references to its arrow arrays.
+  static std::unique_ptr<DynamicTopology> Make(const GraphTopology& base);
+
+  /// Insert a batch of (source, destination) edges. Duplicate edges are
+  /// allowed.
+  ///
+  /// \returns invalid_argument if an endpoint is not a node of this topology;
+  /// in that case, no edge is inserted
+  Result<void> InsertEdges(std::vector<Edge> batch);
+
+  /// Delete every edge from source to destination for each (source,
+  /// destination) pair of batch. Pairs that are not edges are ignored.
+  ///
+  /// \returns invalid_argument if an endpoint is not a node of this topology;
+  /// in that case, no edge is deleted
+  Result<void> DeleteEdges(std::vector<Edge> batch);
+
+  /// Compact folds the deltas into a new base CSR. Afterwards, the handle of
+  /// every edge is its position in the new base CSR; edges of a node keep
+  /// their iteration order. Edge properties indexed by the old base edge ids
+  /// no longer line up with the handles.
+  Result<void> Compact();
+
+  /// CompactInto compacts this topology and makes the result the topology of
+  /// pfg. Since inserted edges have no properties, pfg must not have edge
+  /// properties.
+  ///
+  /// \returns invalid_argument if pfg has edge properties or a different
+  /// number of nodes
+  Result<void> CompactInto(PropertyFileGraph* pfg);
+
+  /// \returns true if there are no deltas, i.e., base_topology() describes
+  /// this topology exactly
+  bool is_compacted() const { return num_deleted_ == 0 && num_inserted_ == 0; }
+
+  const GraphTopology& base_topology() const { return base_; }
+
+  uint64_t num_nodes() const { return base_.num_nodes(); }
+  uint64_t num_edges() const {
+    return base_.num_edges() - num_deleted_ + num_inserted_;
+  }
+
+  /// Number of deleted base edges and inserted edges since the last
+  /// compaction
+  uint64_t num_deltas() const { return num_deleted_ + num_inserted_; }
+
+  EdgeIterator edge_begin(uint32_t node) const {
+    auto [begin, end] = base_.edge_range(node);
+    return EdgeIterator(this, node, begin, end);
+  }
+
+  EdgeIterator edge_end(uint32_t node) const {
+    auto [begin, end] = base_.edge_range(node);
+    return EdgeIterator(this, node, end + delta_[node].size(), end);
+  }
+
+  uint64_t degree(uint32_t node) const {
+    return std::distance(edge_begin(node), edge_end(node));
+  }
+
+  static bool IsDeltaEdge(uint64_t edge) {
+    return (edge & kDeltaEdgeBit) != 0;
+  }
+
+  uint32_t edge_dest(uint64_t edge) const {
+    if (!IsDeltaEdge(edge)) {
+      assert(!IsBaseEdgeDeleted(edge));
+      return base_.out_dests->Value(edge);
+    }
+    uint32_t node = (edge & ~kDeltaEdgeBit) >> kDeltaIndexBits;
+    uint64_t index = edge & ((uint64_t{1} << kDeltaIndexBits) - 1);
+    return delta_[node][index];
+  }
+};
+
+}  // namespace galois::graphs
+
+#endif
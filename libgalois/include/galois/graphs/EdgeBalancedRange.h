@@ -0,0 +1,138 @@
+#ifndef GALOIS_LIBGALOIS_GALOIS_GRAPHS_EDGEBALANCEDRANGE_H_
+#define GALOIS_LIBGALOIS_GALOIS_GRAPHS_EDGEBALANCEDRANGE_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include <boost/iterator/counting_iterator.hpp>
+#include <boost/iterator/iterator_facade.hpp>
+
+#include "galois/Range.h"
+#include "galois/Threads.h"
+#include "galois/config.h"
+#include "galois/graphs/PropertyFileGraph.h"
+#include "galois/substrate/ThreadPool.h"
+
+/// Ranges that statically balance loops over a graph by edges rather than by
+/// nodes. They are meant to be used with do_all without steal(): each thread
+/// iterates over a precomputed block, so the loop needs neither stealing nor
+/// per-round tiling to be balanced on skewed degree distributions. Block
+/// boundaries are cached on the GraphTopology (see \ref
+/// GraphTopology::EdgeBalancedNodeRanges), so building a range is cheap after
+/// the first loop.
+
+namespace galois::graphs {
+
+/// EdgeBalancedNodes returns a range over all the nodes of topology where the
+/// nodes of each thread have roughly the same number of edges. With a
+/// node_weight of w, a node counts as w edges in addition to its degree,
+/// which balances loops that do significant work per node as well as per
+/// edge.
+///
+/// The range is only valid for loops with the number of active threads at
+/// the time it is created.
+inline SpecificRange<boost::counting_iterator<uint32_t>>
+EdgeBalancedNodes(const GraphTopology& topology, uint32_t node_weight = 0) {
+  return MakeSpecificRange(
+      boost::counting_iterator<uint32_t>(0),
+      boost::counting_iterator<uint32_t>(topology.num_nodes()),
+      topology.EdgeBalancedNodeRanges(getActiveThreads(), node_weight));
+}
+
+/// The edges [begin, end) of node
+struct EdgeTile {
+  uint32_t node;
+  uint64_t begin;
+  uint64_t end;
+};
+
+/// An EdgeTileRange splits the edges of a topology into one window of equal
+/// size per thread. A thread visits every node with edges in its window and
+/// gets the part of the node's edges that fall in it, so the edges of a hub
+/// are split across threads and every edge is visited exactly once. Nodes
+/// without edges may be skipped.
+class EdgeTileRange {
+  const GraphTopology* topology_;
+  std::vector<std::pair<uint32_t, uint32_t>> tiles_;
+
+  uint64_t WindowBegin(uint32_t tile) const {
+    return topology_->num_edges() * tile / tiles_.size();
+  }
+
+public:
+  /// Random access iterator over the nodes of a tile, yielding their edges
+  /// clipped to the edge window of the tile
+  class iterator
+      : public boost::iterator_facade<
+            iterator, EdgeTile, std::random_access_iterator_tag, EdgeTile,
+            std::ptrdiff_t> {
+    friend class boost::iterator_core_access;
+
+    const GraphTopology* topology_{};
+    uint32_t node_{};
+    uint64_t window_begin_{};
+    uint64_t window_end_{};
+
+    EdgeTile dereference() const {
+      auto [begin, end] = topology_->edge_range(node_);
+      return EdgeTile{
+          .node = node_,
+          .begin = std::max(begin, window_begin_),
+          .end = std::min(end, window_end_),
+      };
+    }
+
+    bool equal(const iterator& other) const { return node_ == other.node_; }
+    void increment() { ++node_; }
+    void decrement() { --node_; }
+    void advance(std::ptrdiff_t n) { node_ += n; }
+    std::ptrdiff_t distance_to(const iterator& other) const {
+      return std::ptrdiff_t(other.node_) - std::ptrdiff_t(node_);
+    }
+
+  public:
+    iterator() = default;
+    iterator(
+        const GraphTopology* topology, uint32_t node, uint64_t window_begin,
+        uint64_t window_end)
+        : topology_(topology),
+          node_(node),
+          window_begin_(window_begin),
+          window_end_(window_end) {}
+  };
+
+  using local_iterator = iterator;
+  using value_type = EdgeTile;
+
+  /// The range is only valid for loops with the number of active threads at
+  /// the time it is created.
+  explicit EdgeTileRange(const GraphTopology& topology)
+      : topology_(&topology),
+        tiles_(topology.EdgeTileNodeRanges(getActiveThreads())) {}
+
+  iterator begin() const {
+    return iterator(topology_, 0, 0, topology_->num_edges());
+  }
+  iterator end() const {
+    return iterator(
+        topology_, topology_->num_nodes(), 0, topology_->num_edges());
+  }
+
+  local_iterator local_begin() const {
+    unsigned tid = substrate::ThreadPool::getTID();
+    return iterator(
+        topology_, tiles_[tid].first, WindowBegin(tid), WindowBegin(tid + 1));
+  }
+  local_iterator local_end() const {
+    unsigned tid = substrate::ThreadPool::getTID();
+    return iterator(
+        topology_, tiles_[tid].second, WindowBegin(tid), WindowBegin(tid + 1));
+  }
+};
+
+}  // namespace galois::graphs
+
+#endif
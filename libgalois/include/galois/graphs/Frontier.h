@@ -0,0 +1,278 @@
+#ifndef GALOIS_LIBGALOIS_GALOIS_GRAPHS_FRONTIER_H_
+#define GALOIS_LIBGALOIS_GALOIS_GRAPHS_FRONTIER_H_
+
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#include "galois/Bag.h"
+#include "galois/DynamicBitset.h"
+#include "galois/Galois.h"
+#include "galois/MethodFlags.h"
+#include "galois/Reduction.h"
+#include "galois/config.h"
+
+namespace galois::graphs {
+
+/// A subset of the nodes of a graph, typically the frontier of a traversal.
+///
+/// Small subsets are kept sparse, as a bag of nodes, and large ones dense,
+/// as a bitset over all nodes. Sparse subsets are cheap to iterate; dense
+/// ones are cheap to test for membership. EdgeMap produces whichever
+/// representation its traversal direction makes cheapest, and the subset
+/// converts between them on demand.
+template <typename Node = uint32_t>
+class VertexSubset {
+  size_t num_nodes_;
+  bool dense_{false};
+  InsertBag<Node> sparse_;
+  DynamicBitset bits_;
+
+public:
+  /// An empty subset of a graph with num_nodes nodes
+  explicit VertexSubset(size_t num_nodes) : num_nodes_(num_nodes) {}
+
+  /// The subset containing only node
+  VertexSubset(size_t num_nodes, Node node) : num_nodes_(num_nodes) {
+    sparse_.push(node);
+  }
+
+  VertexSubset(VertexSubset&&) = default;
+  VertexSubset& operator=(VertexSubset&&) = default;
+
+  size_t num_nodes() const { return num_nodes_; }
+
+  bool IsDense() const { return dense_; }
+
+  /// Add node to the subset. Safe to call concurrently. A sparse subset does
+  /// not check for duplicates, so each node must be added at most once.
+  void Add(Node node) {
+    if (dense_) {
+      bits_.set(node);
+    } else {
+      sparse_.push(node);
+    }
+  }
+
+  /// Test membership; the subset must be dense
+  bool Contains(Node node) const {
+    assert(dense_);
+    return bits_.test(node);
+  }
+
+  bool Empty() const {
+    if (!dense_) {
+      return sparse_.empty();
+    }
+    return bits_.none();
+  }
+
+  size_t Size() const {
+    if (dense_) {
+      return bits_.count();
+    }
+    GAccumulator<size_t> size;
+    do_all(
+        iterate(sparse_), [&](Node) { size += 1; }, no_stats());
+    return size.reduce();
+  }
+
+  /// Switch to the dense representation
+  void ToDense() {
+    if (dense_) {
+      return;
+    }
+    bits_.resize(num_nodes_);
+    bits_.reset();
+    do_all(
+        iterate(sparse_), [&](Node node) { bits_.set(node); }, steal(),
+        no_stats());
+    sparse_.clear();
+    dense_ = true;
+  }
+
+  /// Switch to the sparse representation
+  void ToSparse() {
+    if (!dense_) {
+      return;
+    }
+    bits_.parallel_for_each_set([&](size_t node) { sparse_.push(node); });
+    bits_.resize(0);
+    dense_ = false;
+  }
+
+  /// Call fn(node) for every node in the subset in parallel
+  template <typename F>
+  void Map(const F& fn) {
+    if (dense_) {
+      bits_.parallel_for_each_set([&](size_t node) { fn(Node(node)); });
+    } else {
+      do_all(iterate(sparse_), fn, steal(), no_stats());
+    }
+  }
+
+  /// The nodes of a sparse subset
+  InsertBag<Node>& sparse() {
+    assert(!dense_);
+    return sparse_;
+  }
+
+  /// The membership bits of a dense subset
+  const DynamicBitset& dense() const {
+    assert(dense_);
+    return bits_;
+  }
+};
+
+enum class EdgeMapDirection {
+  /// Choose per call from the size of the frontier
+  kAuto,
+  /// Go over the out edges of the frontier
+  kPush,
+  /// Go over the in edges of every node that may still be updated
+  kPull,
+};
+
+struct EdgeMapOptions {
+  EdgeMapDirection direction{EdgeMapDirection::kAuto};
+  /// Pull when the frontier and its out edges make up more than
+  /// 1/threshold of the edges of the graph
+  uint64_t threshold{20};
+  /// The graph is symmetric, so out edges can be used as in edges when
+  /// pulling over a graph that does not store in edges
+  bool symmetric{false};
+};
+
+namespace internal {
+
+template <typename Graph, typename = void>
+struct HasInEdges : std::false_type {};
+
+template <typename Graph>
+struct HasInEdges<
+    Graph, std::void_t<decltype(std::declval<Graph&>().in_edges(
+               std::declval<typename Graph::GraphNode>()))>>
+    : std::true_type {};
+
+template <typename Graph, typename Node, typename F>
+VertexSubset<Node>
+EdgeMapPush(Graph& graph, VertexSubset<Node>& frontier, F& fn) {
+  constexpr MethodFlag flag = MethodFlag::UNPROTECTED;
+  VertexSubset<Node> next(frontier.num_nodes());
+
+  frontier.Map([&](Node src) {
+    for (auto e : graph.edges(src, flag)) {
+      Node dst = graph.getEdgeDst(e);
+      if (fn.Cond(dst) && fn.UpdateAtomic(src, dst)) {
+        next.Add(dst);
+      }
+    }
+  });
+
+  return next;
+}
+
+template <typename Graph, typename Node, typename F>
+VertexSubset<Node>
+EdgeMapPull(
+    Graph& graph, VertexSubset<Node>& frontier, F& fn,
+    const EdgeMapOptions& options) {
+  constexpr MethodFlag flag = MethodFlag::UNPROTECTED;
+  frontier.ToDense();
+  VertexSubset<Node> next(frontier.num_nodes());
+  next.ToDense();
+
+  auto pull = [&](Node dst, auto in_edges, auto in_dst) {
+    if (!fn.Cond(dst)) {
+      return;
+    }
+    for (auto e : in_edges) {
+      Node src = in_dst(e);
+      if (frontier.Contains(src) && fn.Update(src, dst)) {
+        next.Add(dst);
+      }
+      if (!fn.Cond(dst)) {
+        break;
+      }
+    }
+  };
+
+  if constexpr (HasInEdges<Graph>::value) {
+    if (!options.symmetric) {
+      do_all(
+          iterate(size_t{0}, graph.size()),
+          [&](size_t dst) {
+            pull(dst, graph.in_edges(dst, flag), [&](auto e) {
+              return graph.getInEdgeDst(e);
+            });
+          },
+          steal(), no_stats());
+      return next;
+    }
+  }
+
+  do_all(
+      iterate(size_t{0}, graph.size()),
+      [&](size_t dst) {
+        pull(dst, graph.edges(dst, flag), [&](auto e) {
+          return graph.getEdgeDst(e);
+        });
+      },
+      steal(), no_stats());
+  return next;
+}
+
+}  // namespace internal
+
+/// Apply fn to the edges leaving frontier and return the nodes it updated,
+/// in the style of Ligra's edgeMap.
+///
+/// fn must provide:
+/// - bool Cond(Node dst): whether dst may still be updated
+/// - bool UpdateAtomic(Node src, Node dst): update dst from src when called
+///   concurrently with other updates of dst; return true if dst should be
+///   in the next frontier, which must happen at most once per dst per call
+/// - bool Update(Node src, Node dst): the same, but never called
+///   concurrently for the same dst
+///
+/// The direction is chosen as in direction-optimizing BFS: when the
+/// frontier plus its out-degree is a large fraction of the edges, it is
+/// cheaper to pull over the in edges of all nodes that may still be updated
+/// (skipping the rest of a node's in edges once Cond turns false) than to
+/// push along the out edges of the frontier. Pushing needs no in edges;
+/// pulling needs in edges (e.g., LC_CSR_CSC_Graph) or a symmetric graph.
+/// Graphs without either are always pushed.
+template <typename Graph, typename Node, typename F>
+VertexSubset<Node>
+EdgeMap(
+    Graph& graph, VertexSubset<Node>& frontier, F& fn,
+    const EdgeMapOptions& options = EdgeMapOptions()) {
+  constexpr bool can_pull_in_edges = internal::HasInEdges<Graph>::value;
+  bool can_pull = can_pull_in_edges || options.symmetric;
+
+  EdgeMapDirection direction = options.direction;
+  if (!can_pull) {
+    direction = EdgeMapDirection::kPush;
+  }
+
+  if (direction == EdgeMapDirection::kAuto) {
+    GAccumulator<uint64_t> work;
+    frontier.Map([&](Node src) {
+      work += 1 + std::distance(
+                      graph.edge_begin(src, MethodFlag::UNPROTECTED),
+                      graph.edge_end(src, MethodFlag::UNPROTECTED));
+    });
+    direction = work.reduce() > graph.sizeEdges() / options.threshold
+                    ? EdgeMapDirection::kPull
+                    : EdgeMapDirection::kPush;
+  }
+
+  if (direction == EdgeMapDirection::kPull) {
+    return internal::EdgeMapPull(graph, frontier, fn, options);
+  }
+  return internal::EdgeMapPush(graph, frontier, fn);
+}
+
+}  // namespace galois::graphs
+
+#endif
@@ -24,6 +24,7 @@
 #include <type_traits>
 
 #include "galois/Galois.h"
+#include "galois/MemoryAccounting.h"
 #include "galois/PODResizeableArray.h"
 #include "galois/config.h"
 #include "galois/graphs/Details.h"
@@ -186,6 +187,32 @@ protected:
     return edge_sort_iterator(*raw_end(N), &edgeDst, &edgeData);
   }
 
+  /// Allocate the arrays for numNodes nodes and numEdges edges. Memory
+  /// accounting charges node and edge data to properties and the rest to
+  /// topology.
+  void allocateArrays() {
+    auto allocate = [](auto& array, size_t n) {
+      if (UseNumaAlloc) {
+        array.allocateBlocked(n);
+      } else {
+        array.allocateInterleaved(n);
+      }
+    };
+    {
+      MemoryCategoryScope topology(MemoryCategory::kTopology);
+      allocate(edgeIndData, numNodes);
+      allocate(edgeDst, numEdges);
+      if (UseNumaAlloc) {
+        this->outOfLineAllocateBlocked(numNodes);
+      } else {
+        this->outOfLineAllocateInterleaved(numNodes);
+      }
+    }
+    MemoryCategoryScope properties(MemoryCategory::kProperties);
+    allocate(nodeData, numNodes);
+    allocate(edgeData, numEdges);
+  }
+
   template <bool _A1 = HasNoLockable, bool _A2 = HasOutOfLineLockable>
   void acquireNode(
       GraphNode N, MethodFlag mflag,
@@ -422,38 +449,14 @@ public:
   void allocateFrom(const FileGraph& graph) {
     numNodes = graph.size();
     numEdges = graph.sizeEdges();
-    if (UseNumaAlloc) {
-      nodeData.allocateBlocked(numNodes);
-      edgeIndData.allocateBlocked(numNodes);
-      edgeDst.allocateBlocked(numEdges);
-      edgeData.allocateBlocked(numEdges);
-      this->outOfLineAllocateBlocked(numNodes);
-    } else {
-      nodeData.allocateInterleaved(numNodes);
-      edgeIndData.allocateInterleaved(numNodes);
-      edgeDst.allocateInterleaved(numEdges);
-      edgeData.allocateInterleaved(numEdges);
-      this->outOfLineAllocateInterleaved(numNodes);
-    }
+    allocateArrays();
   }
 
   void allocateFrom(uint32_t nNodes, uint64_t nEdges) {
     numNodes = nNodes;
     numEdges = nEdges;
 
-    if (UseNumaAlloc) {
-      nodeData.allocateBlocked(numNodes);
-      edgeIndData.allocateBlocked(numNodes);
-      edgeDst.allocateBlocked(numEdges);
-      edgeData.allocateBlocked(numEdges);
-      this->outOfLineAllocateBlocked(numNodes);
-    } else {
-      nodeData.allocateInterleaved(numNodes);
-      edgeIndData.allocateInterleaved(numNodes);
-      edgeDst.allocateInterleaved(numEdges);
-      edgeData.allocateInterleaved(numEdges);
-      this->outOfLineAllocateInterleaved(numNodes);
-    }
+    allocateArrays();
   }
 
   void destroyAndAllocateFrom(uint32_t nNodes, uint64_t nEdges) {
@@ -461,19 +464,7 @@ public:
     numEdges = nEdges;
 
     deallocate();
-    if (UseNumaAlloc) {
-      nodeData.allocateBlocked(numNodes);
-      edgeIndData.allocateBlocked(numNodes);
-      edgeDst.allocateBlocked(numEdges);
-      edgeData.allocateBlocked(numEdges);
-      this->outOfLineAllocateBlocked(numNodes);
-    } else {
-      nodeData.allocateInterleaved(numNodes);
-      edgeIndData.allocateInterleaved(numNodes);
-      edgeDst.allocateInterleaved(numEdges);
-      edgeData.allocateInterleaved(numEdges);
-      this->outOfLineAllocateInterleaved(numNodes);
-    }
+    allocateArrays();
   }
 
   void constructNodes() {
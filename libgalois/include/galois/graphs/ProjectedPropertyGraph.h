@@ -0,0 +1,232 @@
+#ifndef GALOIS_LIBGALOIS_GALOIS_GRAPHS_PROJECTEDPROPERTYGRAPH_H_
+#define GALOIS_LIBGALOIS_GALOIS_GRAPHS_PROJECTEDPROPERTYGRAPH_H_
+
+#include <tuple>
+
+#include <boost/iterator/counting_iterator.hpp>
+#include <boost/iterator/filter_iterator.hpp>
+
+#include "galois/NoDerefIterator.h"
+#include "galois/Properties.h"
+#include "galois/Range.h"
+#include "galois/Result.h"
+#include "galois/Traits.h"
+#include "galois/graphs/ProjectedTopology.h"
+#include "galois/graphs/PropertyFileGraph.h"
+#include "galois/graphs/PropertyViews.h"
+
+namespace galois::graphs {
+
+/// A ProjectedPropertyGraph is a typed view, like \ref PropertyGraph, of the
+/// subgraph of a \ref PropertyFileGraph selected by a \ref ProjectedTopology.
+///
+/// Nodes are identified by their projected (dense) ids, so code written
+/// against the PropertyGraph interface (begin/end, edges, GetEdgeDest, GetData,
+/// GetEdgeData) works unchanged. Property accesses are translated to original
+/// ids and read the arrays of the underlying PropertyFileGraph directly; no
+/// property data is copied.
+///
+/// Unlike PropertyGraph, edges(n) returns a forward range because edges that
+/// are masked out of an uncompacted projection are skipped during iteration.
+///
+/// \tparam NodeProps A tuple of property types (\ref Properties.h) for nodes
+/// \tparam EdgeProps A tuple of property types for edges
+template <typename NodeProps, typename EdgeProps>
+class ProjectedPropertyGraph {
+  using NodeView = PropertyViewTuple<NodeProps>;
+  using EdgeView = PropertyViewTuple<EdgeProps>;
+
+public:
+  using node_properties = NodeProps;
+  using edge_properties = EdgeProps;
+  using node_iterator = boost::counting_iterator<uint32_t>;
+  using edge_iterator = boost::counting_iterator<uint64_t>;
+  using iterator = node_iterator;
+  using Node = uint32_t;
+
+private:
+  struct EdgeSelected {
+    const ProjectedTopology* projection;
+
+    bool operator()(const edge_iterator& edge) const {
+      return projection->IsEdgeSelected(*edge);
+    }
+  };
+
+  using filtered_edge_iterator =
+      boost::filter_iterator<EdgeSelected, NoDerefIterator<edge_iterator>>;
+
+public:
+  using edges_iterator = StandardRange<filtered_edge_iterator>;
+
+private:
+  PropertyFileGraph* pfg_;
+  const ProjectedTopology* projection_;
+
+  NodeView node_view_;
+  EdgeView edge_view_;
+
+  ProjectedPropertyGraph(
+      PropertyFileGraph* pfg, const ProjectedTopology* projection,
+      NodeView node_view, EdgeView edge_view)
+      : pfg_(pfg),
+        projection_(projection),
+        node_view_(std::move(node_view)),
+        edge_view_(std::move(edge_view)) {}
+
+public:
+  // Standard container concepts
+
+  node_iterator begin() const { return node_iterator(0); }
+
+  node_iterator end() const { return node_iterator(num_nodes()); }
+
+  size_t size() const { return num_nodes(); }
+
+  bool empty() const { return num_nodes() == 0; }
+
+  // Graph accessors
+
+  /**
+   * Gets the node data.
+   *
+   * @param node projected node to get the data of
+   * @returns reference to the node data
+   */
+  template <typename NodeIndex>
+  PropertyReferenceType<NodeIndex> GetData(const Node& node) {
+    constexpr size_t prop_index = find_trait<NodeIndex, NodeProps>();
+    return std::get<prop_index>(node_view_)
+        .GetValue(projection_->OriginalNodeId(node));
+  }
+  template <typename NodeIndex>
+  PropertyReferenceType<NodeIndex> GetData(const node_iterator& node) {
+    return GetData<NodeIndex>(*node);
+  }
+
+  template <typename NodeIndex>
+  PropertyConstReferenceType<NodeIndex> GetData(const Node& node) const {
+    constexpr size_t prop_index = find_trait<NodeIndex, NodeProps>();
+    return std::get<prop_index>(node_view_)
+        .GetValue(projection_->OriginalNodeId(node));
+  }
+  template <typename NodeIndex>
+  PropertyConstReferenceType<NodeIndex> GetData(
+      const node_iterator& node) const {
+    return GetData<NodeIndex>(*node);
+  }
+
+  /**
+   * Gets the edge data.
+   *
+   * @param edge edge iterator to get the data of
+   * @returns reference to the edge data
+   */
+  template <typename EdgeIndex>
+  PropertyReferenceType<EdgeIndex> GetEdgeData(const edge_iterator& edge) {
+    constexpr size_t prop_index = find_trait<EdgeIndex, EdgeProps>();
+    return std::get<prop_index>(edge_view_)
+        .GetValue(projection_->OriginalEdgeId(*edge));
+  }
+
+  template <typename EdgeIndex>
+  PropertyConstReferenceType<EdgeIndex> GetEdgeData(
+      const edge_iterator& edge) const {
+    constexpr size_t prop_index = find_trait<EdgeIndex, EdgeProps>();
+    return std::get<prop_index>(edge_view_)
+        .GetValue(projection_->OriginalEdgeId(*edge));
+  }
+
+  /**
+   * Gets the destination for an edge.
+   *
+   * @param edge edge iterator to get the destination of
+   * @returns node iterator to the projected edge destination
+   */
+  node_iterator GetEdgeDest(const edge_iterator& edge) const {
+    return node_iterator(projection_->edge_dest(*edge));
+  }
+
+  uint64_t num_nodes() const { return projection_->num_nodes(); }
+  uint64_t num_edges() const { return projection_->num_edges(); }
+
+  /**
+   * Gets the edges of some node that are part of the projection.
+   *
+   * @param node projected node to get the edge range of
+   * @returns iterator to edges of node
+   */
+  edges_iterator edges(const node_iterator& node) const {
+    auto [begin_edge, end_edge] = projection_->edge_range(*node);
+    auto end = make_no_deref_iterator(edge_iterator(end_edge));
+    EdgeSelected pred{projection_};
+    return MakeStandardRange(
+        filtered_edge_iterator(
+            pred, make_no_deref_iterator(edge_iterator(begin_edge)), end),
+        filtered_edge_iterator(pred, end, end));
+  }
+
+  /**
+   * Maps a projected node to its id in the underlying PropertyFileGraph.
+   */
+  Node OriginalNodeId(const Node& node) const {
+    return projection_->OriginalNodeId(node);
+  }
+
+  const PropertyFileGraph& GetPropertyFileGraph() const { return *pfg_; }
+
+  const ProjectedTopology& GetProjectedTopology() const {
+    return *projection_;
+  }
+
+  // Graph constructors
+  static Result<ProjectedPropertyGraph<NodeProps, EdgeProps>> Make(
+      PropertyFileGraph* pfg, const ProjectedTopology* projection,
+      const std::vector<std::string>& node_properties,
+      const std::vector<std::string>& edge_properties);
+  static Result<ProjectedPropertyGraph<NodeProps, EdgeProps>> Make(
+      PropertyFileGraph* pfg, const ProjectedTopology* projection);
+};
+
+template <typename NodeProps, typename EdgeProps>
+Result<ProjectedPropertyGraph<NodeProps, EdgeProps>>
+ProjectedPropertyGraph<NodeProps, EdgeProps>::Make(
+    PropertyFileGraph* pfg, const ProjectedTopology* projection,
+    const std::vector<std::string>& node_properties,
+    const std::vector<std::string>& edge_properties) {
+  if (projection->original_topology().num_nodes() !=
+          pfg->topology().num_nodes() ||
+      projection->original_topology().num_edges() !=
+          pfg->topology().num_edges()) {
+    return ErrorCode::InvalidArgument;
+  }
+
+  auto node_view_result =
+      internal::MakeNodePropertyViews<NodeProps>(pfg, node_properties);
+  if (!node_view_result) {
+    return node_view_result.error();
+  }
+
+  auto edge_view_result =
+      internal::MakeEdgePropertyViews<EdgeProps>(pfg, edge_properties);
+  if (!edge_view_result) {
+    return edge_view_result.error();
+  }
+
+  return ProjectedPropertyGraph(
+      pfg, projection, std::move(node_view_result.value()),
+      std::move(edge_view_result.value()));
+}
+
+template <typename NodeProps, typename EdgeProps>
+Result<ProjectedPropertyGraph<NodeProps, EdgeProps>>
+ProjectedPropertyGraph<NodeProps, EdgeProps>::Make(
+    PropertyFileGraph* pfg, const ProjectedTopology* projection) {
+  return ProjectedPropertyGraph<NodeProps, EdgeProps>::Make(
+      pfg, projection, pfg->node_schema()->field_names(),
+      pfg->edge_schema()->field_names());
+}
+
+}  // namespace galois::graphs
+
+#endif
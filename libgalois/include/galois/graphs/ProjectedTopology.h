@@ -0,0 +1,195 @@
+#ifndef GALOIS_LIBGALOIS_GALOIS_GRAPHS_PROJECTEDTOPOLOGY_H_
+#define GALOIS_LIBGALOIS_GALOIS_GRAPHS_PROJECTEDTOPOLOGY_H_
+
+#include <cassert>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <arrow/api.h>
+
+#include "galois/DynamicBitset.h"
+#include "galois/Loops.h"
+#include "galois/Result.h"
+#include "galois/config.h"
+#include "galois/graphs/PropertyFileGraph.h"
+
+namespace galois::graphs {
+
+/// A ProjectedTopology is a zero-copy view of a subgraph of a GraphTopology.
+///
+/// The subgraph is selected by a node mask and an edge mask over the original
+/// node and edge ids. An empty mask selects everything. An edge is part of the
+/// projection if it is selected by the edge mask and both of its endpoints are
+/// selected by the node mask.
+///
+/// Nodes of the projection are renumbered densely in [0, num_nodes()),
+/// preserving their original relative order, so that projected node ids work
+/// with the usual iteration idioms (e.g., galois::iterate). Edges keep their
+/// original ids and are skipped during iteration when they are masked out.
+///
+/// For heavily filtered graphs, skipping masked edges dominates traversal
+/// time. \ref Compact builds a CSR containing only the projected edges, after
+/// which edge ids refer to positions in that CSR. In both cases, \ref
+/// OriginalNodeId and \ref OriginalEdgeId map back to ids in the original
+/// topology, which is how properties are looked up without copying them.
+class GALOIS_EXPORT ProjectedTopology {
+  ProjectedTopology(
+      const GraphTopology& base, DynamicBitset&& node_mask,
+      DynamicBitset&& edge_mask);
+
+  Result<void> Init();
+
+  /// The original topology; this only shares references to the arrow arrays
+  GraphTopology base_;
+
+  DynamicBitset node_mask_;
+  DynamicBitset edge_mask_;
+
+  /// Inclusive prefix sum of selected nodes per word of node_mask_; used to
+  /// map original node ids to projected node ids
+  std::vector<uint64_t> node_rank_;
+  /// Original node id of each projected node
+  std::vector<uint32_t> original_nodes_;
+
+  uint64_t num_nodes_{};
+  uint64_t num_edges_{};
+
+  /// Compacted topology in projected node ids, if Compact has been called
+  GraphTopology compact_;
+  /// Original edge id of each edge of compact_
+  std::shared_ptr<arrow::UInt64Array> original_edges_;
+
+  bool has_node_mask() const { return node_mask_.size() != 0; }
+  bool has_edge_mask() const { return edge_mask_.size() != 0; }
+
+  bool IsOriginalNodeSelected(uint32_t original_node) const {
+    return !has_node_mask() || node_mask_.test(original_node);
+  }
+
+  bool IsOriginalEdgeSelected(uint64_t original_edge) const {
+    return (!has_edge_mask() || edge_mask_.test(original_edge)) &&
+           IsOriginalNodeSelected(base_.out_dests->Value(original_edge));
+  }
+
+  /// A mask of size bits in which bit i is set if pred(i) is true; pred is
+  /// called in parallel
+  template <typename Pred>
+  static DynamicBitset MaskOf(uint64_t size, const Pred& pred) {
+    DynamicBitset mask;
+    mask.resize(size);
+    galois::do_all(
+        galois::iterate(uint64_t{0}, size),
+        [&](uint64_t i) {
+          if (pred(i)) {
+            mask.set(i);
+          }
+        },
+        galois::no_stats());
+    return mask;
+  }
+
+public:
+  /// Make a projection of topology. Either mask may be empty (i.e., have size
+  /// zero) to select all nodes or edges respectively.
+  ///
+  /// \returns invalid_argument if a non-empty mask does not have one bit per
+  /// node or edge of topology
+  static Result<std::unique_ptr<ProjectedTopology>> Make(
+      const GraphTopology& topology, DynamicBitset node_mask,
+      DynamicBitset edge_mask);
+
+  /// Make a projection of topology that contains the nodes n for which
+  /// node_pred(n) is true and the edges e for which edge_pred(e) is true.
+  /// The predicates are called in parallel with original ids.
+  template <typename NodePred, typename EdgePred>
+  static Result<std::unique_ptr<ProjectedTopology>> MakeFiltered(
+      const GraphTopology& topology, const NodePred& node_pred,
+      const EdgePred& edge_pred) {
+    DynamicBitset node_mask = MaskOf(topology.num_nodes(), node_pred);
+    DynamicBitset edge_mask = MaskOf(topology.num_edges(), edge_pred);
+
+    return Make(topology, std::move(node_mask), std::move(edge_mask));
+  }
+
+  /// Make a projection of topology that contains all nodes and the edges e
+  /// for which edge_pred(e) is true.
+  template <typename EdgePred>
+  static Result<std::unique_ptr<ProjectedTopology>> MakeEdgeFiltered(
+      const GraphTopology& topology, const EdgePred& edge_pred) {
+    DynamicBitset edge_mask = MaskOf(topology.num_edges(), edge_pred);
+
+    return Make(topology, DynamicBitset{}, std::move(edge_mask));
+  }
+
+  /// Compact builds a CSR of only the projected edges. Afterwards, edge ids
+  /// of this projection refer to the compacted CSR. Compact is idempotent.
+  Result<void> Compact();
+
+  bool is_compacted() const { return original_edges_ != nullptr; }
+
+  /// The topology of the compacted projection in projected node ids. Only
+  /// valid if is_compacted().
+  const GraphTopology& compacted_topology() const { return compact_; }
+
+  const GraphTopology& original_topology() const { return base_; }
+
+  uint64_t num_nodes() const { return num_nodes_; }
+  uint64_t num_edges() const { return num_edges_; }
+
+  uint32_t OriginalNodeId(uint32_t node) const {
+    return has_node_mask() ? original_nodes_[node] : node;
+  }
+
+  /// Map an original node id to its projected node id. The original node
+  /// must be part of the projection.
+  uint32_t ProjectedNodeId(uint32_t original_node) const {
+    assert(IsOriginalNodeSelected(original_node));
+    if (!has_node_mask()) {
+      return original_node;
+    }
+    size_t word = original_node / DynamicBitset::bits_uint64;
+    uint64_t below =
+        (uint64_t{1} << (original_node % DynamicBitset::bits_uint64)) - 1;
+    uint64_t bits = node_mask_.get_vec()[word];
+    uint64_t rank = word > 0 ? node_rank_[word - 1] : 0;
+    return rank + __builtin_popcountll(bits & below);
+  }
+
+  /// \returns true if the node with the given original id is part of the
+  /// projection
+  bool ContainsOriginalNode(uint32_t original_node) const {
+    return original_node < base_.num_nodes() &&
+           IsOriginalNodeSelected(original_node);
+  }
+
+  uint64_t OriginalEdgeId(uint64_t edge) const {
+    return is_compacted() ? original_edges_->Value(edge) : edge;
+  }
+
+  /// Gets the range of edge ids of a projected node. Unless the projection is
+  /// compacted, the range may contain edges that are not part of the
+  /// projection; use \ref IsEdgeSelected to skip them.
+  std::pair<uint64_t, uint64_t> edge_range(uint32_t node) const {
+    if (is_compacted()) {
+      return compact_.edge_range(node);
+    }
+    return base_.edge_range(OriginalNodeId(node));
+  }
+
+  bool IsEdgeSelected(uint64_t edge) const {
+    return is_compacted() || IsOriginalEdgeSelected(edge);
+  }
+
+  /// \returns the projected node id of the destination of edge
+  uint32_t edge_dest(uint64_t edge) const {
+    if (is_compacted()) {
+      return compact_.out_dests->Value(edge);
+    }
+    return ProjectedNodeId(base_.out_dests->Value(edge));
+  }
+};
+
+}  // namespace galois::graphs
+
+#endif
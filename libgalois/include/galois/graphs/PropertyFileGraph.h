@@ -1,6 +1,9 @@
 #ifndef GALOIS_LIBGALOIS_GALOIS_GRAPHS_PROPERTYFILEGRAPH_H_
 #define GALOIS_LIBGALOIS_GALOIS_GRAPHS_PROPERTYFILEGRAPH_H_
 
+#include <map>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -16,11 +19,62 @@
 
 namespace galois::graphs {
 
+namespace internal {
+
+/// Memoized partitions of a GraphTopology, and the out_indices they were
+/// computed from. Holding a weak_ptr rather than a raw pointer means a new
+/// array allocated at the address of a freed one never matches.
+struct PartitionCache {
+  std::mutex mutex;
+  std::weak_ptr<arrow::UInt64Array> indices;
+  /// (num_blocks, node_weight) -> block boundaries
+  std::map<std::pair<uint32_t, uint32_t>, std::vector<uint32_t>> node_ranges;
+  /// num_tiles -> node bounds of each tile
+  std::map<uint32_t, std::vector<std::pair<uint32_t, uint32_t>>> tile_ranges;
+};
+
+/// A PartitionCache that is created on first use, so that topologies that
+/// are never partitioned (e.g., empty or temporary ones) do not allocate
+/// one. Copies share the cache if it exists when they are made.
+class PartitionCacheRef {
+public:
+  PartitionCacheRef() = default;
+  PartitionCacheRef(const PartitionCacheRef& other)
+      : cache_(std::atomic_load(&other.cache_)) {}
+  PartitionCacheRef& operator=(const PartitionCacheRef& other) {
+    std::atomic_store(&cache_, std::atomic_load(&other.cache_));
+    return *this;
+  }
+
+  /// The cache, created if there is none yet
+  std::shared_ptr<PartitionCache> Get() const {
+    auto cache = std::atomic_load(&cache_);
+    if (!cache) {
+      auto fresh = std::make_shared<PartitionCache>();
+      cache = std::atomic_compare_exchange_strong(&cache_, &cache, fresh)
+                  ? fresh
+                  : cache;
+    }
+    return cache;
+  }
+
+  /// The cache, or nullptr if there is none yet
+  std::shared_ptr<PartitionCache> Peek() const {
+    return std::atomic_load(&cache_);
+  }
+
+private:
+  mutable std::shared_ptr<PartitionCache> cache_;
+};
+
+}  // namespace internal
+
 /// A graph topology represents the adjacency information for a graph in CSR
 /// format.
-struct GraphTopology {
+struct GALOIS_EXPORT GraphTopology {
   std::shared_ptr<arrow::UInt64Array> out_indices;
   std::shared_ptr<arrow::UInt32Array> out_dests;
+  internal::PartitionCacheRef partition_cache;
 
   uint64_t num_nodes() const { return out_indices ? out_indices->length() : 0; }
 
@@ -36,6 +90,31 @@ struct GraphTopology {
     auto edge_end = out_indices->Value(node_id);
     return std::make_pair(edge_start, edge_end);
   }
+
+  /// EdgeBalancedNodeRanges splits the nodes into num_blocks contiguous
+  /// blocks of roughly equal weight, where the weight of a node is its degree
+  /// plus node_weight. Splits are found by binary search over out_indices and
+  /// cached, so loops that run repeatedly over the same topology only pay for
+  /// them once.
+  ///
+  /// \returns num_blocks + 1 boundaries; block i is the nodes in
+  /// [ranges[i], ranges[i + 1])
+  std::vector<uint32_t> EdgeBalancedNodeRanges(
+      uint32_t num_blocks, uint32_t node_weight = 0) const;
+
+  /// EdgeTileNodeRanges splits the edges into num_tiles contiguous windows
+  /// of equal size, [num_edges() * t / num_tiles, num_edges() * (t + 1) /
+  /// num_tiles) for tile t, and returns the nodes whose edges overlap each
+  /// window. A node with more edges than a window (a hub) spans several tiles.
+  /// Results are cached like \ref EdgeBalancedNodeRanges.
+  ///
+  /// \returns [begin, end) node bounds of each tile
+  std::vector<std::pair<uint32_t, uint32_t>> EdgeTileNodeRanges(
+      uint32_t num_tiles) const;
+
+  /// InvalidatePartitions drops cached partitions. Call it after modifying
+  /// out_indices in place.
+  void InvalidatePartitions() const;
 };
 
 /// A property graph is a graph that has properties associated with its nodes
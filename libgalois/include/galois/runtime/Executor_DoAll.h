@@ -20,12 +20,15 @@
 #ifndef GALOIS_LIBGALOIS_GALOIS_RUNTIME_EXECUTORDOALL_H_
 #define GALOIS_LIBGALOIS_GALOIS_RUNTIME_EXECUTORDOALL_H_
 
+#include "galois/PerfCounters.h"
 #include "galois/Statistics.h"
 #include "galois/Timer.h"
+#include "galois/Trace.h"
 #include "galois/config.h"
 #include "galois/gIO.h"
 #include "galois/runtime/Executor_OnEach.h"
 #include "galois/runtime/OperatorReferenceTypes.h"
+#include "galois/runtime/SchedulingStatistics.h"
 #include "galois/substrate/Barrier.h"
 #include "galois/substrate/CompilerSpecific.h"
 #include "galois/substrate/PaddedLock.h"
@@ -50,6 +53,8 @@ class DoAllStealingExec {
       NEED_STATS && has_trait<more_stats_tag, ArgsTuple>();
   constexpr static const bool USE_TERM = false;
 
+  using SchedStats = SchedulingStatistics<MORE_STATS>;
+
   struct ThreadContext {
     alignas(substrate::GALOIS_CACHE_LINE_SIZE) substrate::SimpleLock work_mutex;
     unsigned id;
@@ -58,6 +63,8 @@ class DoAllStealingExec {
     Iter shared_end;
     Diff_ty m_size;
     size_t num_iter;
+    size_t num_steal_attempts;
+    size_t num_steals;
 
     // Stats
 
@@ -67,7 +74,9 @@ class DoAllStealingExec {
           shared_beg(),
           shared_end(),
           m_size(0),
-          num_iter(0) {
+          num_iter(0),
+          num_steal_attempts(0),
+          num_steals(0) {
       // TODO: fix this initialization problem,
       // see initThread
     }
@@ -78,9 +87,13 @@ class DoAllStealingExec {
           shared_beg(beg),
           shared_end(end),
           m_size(std::distance(beg, end)),
-          num_iter(0) {}
+          num_iter(0),
+          num_steal_attempts(0),
+          num_steals(0) {}
 
-    bool doWork(F func, const unsigned chunk_size) {
+    bool doWork(
+        F func, const unsigned chunk_size, const char* trace_name,
+        SchedStats& sched) {
       Iter beg(shared_beg);
       Iter end(shared_end);
 
@@ -88,13 +101,16 @@ class DoAllStealingExec {
 
       while (getWork(beg, end, chunk_size)) {
         didwork = true;
+        TraceScope chunk_trace(trace_name, "chunk");
 
+        size_t chunk_iter = num_iter;
         for (; beg != end; ++beg) {
           if (NEED_STATS) {
             ++num_iter;
           }
           func(*beg);
         }
+        sched.addChunk(num_iter - chunk_iter);
       }
 
       return didwork;
@@ -248,11 +264,17 @@ private:
     bool succ =
         rich.stealWork(steal_beg, steal_end, steal_size, amount, chunk_size);
 
+    if (MORE_STATS) {
+      ++poor.num_steal_attempts;
+      poor.num_steals += succ;
+    }
+
     if (succ) {
       assert(steal_beg != steal_end);
       assert(std::distance(steal_beg, steal_end) == steal_size);
 
       poor.assignWork(steal_beg, steal_end, steal_size);
+      TraceInstant("Steal", "steal", steal_size);
     }
 
     return succ;
@@ -355,6 +377,8 @@ private:
   R range;
   F func;
   const char* loopname;
+  //! loopname, copied if tracing since loopname may not outlive the trace
+  const char* traceName;
   Diff_ty chunk_size;
   substrate::PerThreadStorage<ThreadContext> workers;
 
@@ -372,6 +396,7 @@ public:
       : range(_range),
         func(_func),
         loopname(galois::internal::getLoopName(argsTuple)),
+        traceName(TraceEnabled() ? TraceIntern(loopname) : loopname),
         chunk_size(get_trait_value<chunk_size_tag>(argsTuple).value),
         term(substrate::GetTerminationDetection(activeThreads)),
         totalTime(loopname, "Total"),
@@ -410,18 +435,23 @@ public:
 
   void operator()(void) {
     ThreadContext& ctx = *workers.getLocal();
+    TraceScope loop_trace(traceName, "loop");
+    PerfCounterScope<NEED_STATS> perf_counters(loopname);
+    SchedStats sched(loopname);
     totalTime.start();
 
     while (true) {
       bool workHappened = false;
 
+      sched.setBusy(true);
       execTime.start();
 
-      if (ctx.doWork(func, chunk_size)) {
+      if (ctx.doWork(func, chunk_size, traceName, sched)) {
         workHappened = true;
       }
 
       execTime.stop();
+      sched.setBusy(false);
 
       assert(!ctx.hasWork());
 
@@ -456,6 +486,8 @@ public:
     if (NEED_STATS) {
       galois::ReportStatSum(loopname, "Iterations", ctx.num_iter);
     }
+    sched.addSteals(ctx.num_steal_attempts, ctx.num_steals);
+    sched.finish();
   }
 };
 
@@ -479,18 +511,26 @@ template <>
 struct ChooseDoAllImpl<false> {
   template <typename R, typename F, typename ArgsT>
   static void call(const R& range, F func, const ArgsT& argsTuple) {
+    static constexpr bool NEED_STATS =
+        galois::internal::NeedStats<ArgsT>::value;
+    static constexpr bool MORE_STATS =
+        NEED_STATS && has_trait<more_stats_tag, ArgsT>();
+
+    const char* const loopname = galois::internal::getLoopName(argsTuple);
+
+    // Per-thread timers report when destroyed, which must happen outside of
+    // the loop
+    PerThreadTimer<MORE_STATS> totalTime(loopname, "Total");
+    PerThreadTimer<MORE_STATS> initTime(loopname, "Init");
+    PerThreadTimer<MORE_STATS> execTime(loopname, "Work");
+
     runtime::on_each_gen(
         [&](const unsigned int, const unsigned int) {
-          static constexpr bool NEED_STATS =
-              galois::internal::NeedStats<ArgsT>::value;
-          static constexpr bool MORE_STATS =
-              NEED_STATS && has_trait<more_stats_tag, ArgsT>();
+          TraceScope loop_trace(
+              TraceEnabled() ? TraceIntern(loopname) : loopname, "loop");
 
-          const char* const loopname = galois::internal::getLoopName(argsTuple);
-
-          PerThreadTimer<MORE_STATS> totalTime(loopname, "Total");
-          PerThreadTimer<MORE_STATS> initTime(loopname, "Init");
-          PerThreadTimer<MORE_STATS> execTime(loopname, "Work");
+          PerfCounterScope<NEED_STATS> perf_counters(loopname);
+          SchedulingStatistics<MORE_STATS> sched(loopname);
 
           totalTime.start();
           initTime.start();
@@ -501,6 +541,7 @@ struct ChooseDoAllImpl<false> {
           initTime.stop();
 
           execTime.start();
+          sched.setBusy(true);
 
           size_t iter = 0;
 
@@ -511,6 +552,8 @@ struct ChooseDoAllImpl<false> {
             }
           }
           execTime.stop();
+          sched.addItems(iter);
+          sched.finish();
 
           totalTime.stop();
 
@@ -549,6 +592,9 @@ do_all_gen(const R& range, F&& func, const ArgsTuple& argsTuple) {
   internal::ChooseDoAllImpl<STEAL>::call(range, func_ref, argsT);
 
   timer.stop();
+  if constexpr (TIME_IT) {
+    sampleMemoryUsage(galois::internal::getLoopName(argsT));
+  }
 }
 
 }  // namespace galois::runtime
@@ -26,16 +26,20 @@
 #include <utility>
 
 #include "galois/Mem.h"
+#include "galois/PerfCounters.h"
 #include "galois/Range.h"
+#include "galois/Statistics.h"
 #include "galois/ThreadTimer.h"
 #include "galois/Threads.h"
 #include "galois/Timer.h"
+#include "galois/Trace.h"
 #include "galois/Traits.h"
 #include "galois/config.h"
 #include "galois/gIO.h"
 #include "galois/runtime/Context.h"
 #include "galois/runtime/LoopStatistics.h"
 #include "galois/runtime/OperatorReferenceTypes.h"
+#include "galois/runtime/SchedulingStatistics.h"
 #include "galois/runtime/UserContextAccess.h"
 #include "galois/substrate/Barrier.h"
 #include "galois/substrate/TerminationDetection.h"
@@ -192,6 +196,8 @@ protected:
   WorkListTy wl;
   FunctionTy origFunction;
   const char* loopname;
+  //! loopname, copied if tracing since loopname may not outlive the trace
+  const char* traceName;
   bool broke;
 
   PerThreadTimer<MORE_STATS> initTime;
@@ -302,6 +308,9 @@ protected:
 
   template <bool couldAbort, bool isLeader>
   void go() {
+    TraceScope loop_trace(traceName, "loop");
+    PerfCounterScope<needStats> perf_counters(loopname);
+    SchedulingStatistics<MORE_STATS> sched(loopname);
     execTime.start();
 
     // Thread-local data goes on the local stack to be NUMA friendly
@@ -318,7 +327,10 @@ protected:
       do {
         bool didWork = false;
 
-        // Run some iterations
+        // Run some iterations; only chunks that did work are traced, so that
+        // threads waiting for termination do not fill their trace buffers
+        TraceScope chunk_trace(traceName, "chunk");
+        sched.setBusy(true);
         if (couldAbort || needsBreak) {
           constexpr int __NUM = (needsBreak || isLeader) ? 64 : 0;
           bool b = runQueue<__NUM>(tld, wl);
@@ -332,6 +344,10 @@ protected:
           bool b = runQueueSimple(tld);
           didWork = b || didWork;
         }
+        sched.setBusy(false);
+        if (!didWork) {
+          chunk_trace.Discard();
+        }
 
         // Update node color and prop token
         term.SignalWorked(didWork);
@@ -352,6 +368,9 @@ protected:
       barrier.Wait();
     }
 
+    sched.addItems(tld.iterations());
+    sched.finish();
+
     if (couldAbort)
       setThreadContext(0);
   }
@@ -366,6 +385,7 @@ protected:
         wl(std::forward<WArgsTy>(wargs)...),
         origFunction(f),
         loopname(galois::internal::getLoopName(args)),
+        traceName(TraceEnabled() ? TraceIntern(loopname) : loopname),
         broke(false),
         initTime(loopname, "Init"),
         execTime(loopname, "Execute") {}
@@ -489,6 +509,9 @@ for_each_gen(const RangeTy& r, FunctionTy&& fn, const TupleTy& tpl) {
   runtime::for_each_impl(r, std::forward<FunctionTy>(fn), xtpl);
 
   timer.stop();
+  if constexpr (TIME_IT) {
+    sampleMemoryUsage(galois::internal::getLoopName(xtpl));
+  }
 }
 
 }  // end namespace runtime
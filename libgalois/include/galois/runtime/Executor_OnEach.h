@@ -23,6 +23,7 @@
 #include "galois/ThreadTimer.h"
 #include "galois/Threads.h"
 #include "galois/Timer.h"
+#include "galois/Trace.h"
 #include "galois/Traits.h"
 #include "galois/config.h"
 #include "galois/gIO.h"
@@ -45,6 +46,8 @@ on_each_impl(FunctionTy&& fn, const ArgsTy& argsTuple) {
       NEEDS_STATS && has_trait<more_stats_tag, ArgsTy>();
 
   const char* const loopname = galois::internal::getLoopName(argsTuple);
+  const char* const trace_name =
+      TraceEnabled() ? TraceIntern(loopname) : loopname;
 
   CondStatTimer<NEEDS_STATS> timer(loopname);
 
@@ -55,6 +58,7 @@ on_each_impl(FunctionTy&& fn, const ArgsTy& argsTuple) {
   OperatorReferenceType<decltype(std::forward<FunctionTy>(fn))> fn_ref = fn;
 
   auto runFun = [&] {
+    TraceScope loop_trace(trace_name, "loop");
     execTime.start();
 
     fn_ref(substrate::ThreadPool::getTID(), numT);
@@ -0,0 +1,96 @@
+#ifndef GALOIS_LIBGALOIS_GALOIS_RUNTIME_SCHEDULINGSTATISTICS_H_
+#define GALOIS_LIBGALOIS_GALOIS_RUNTIME_SCHEDULINGSTATISTICS_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "galois/config.h"
+
+namespace galois::runtime {
+
+/// How one thread spent its time in one loop
+struct GALOIS_EXPORT ThreadSchedulingStats {
+  /// Chunk sizes are counted in power-of-two buckets: bucket i counts chunks
+  /// of 2^i to 2^(i+1) - 1 items. The last bucket also counts larger chunks.
+  static constexpr size_t kChunkBuckets = 16;
+
+  /// Time spent running the operator
+  uint64_t busy_ns{0};
+  /// Time spent looking for work, stealing or waiting for termination
+  uint64_t idle_ns{0};
+  uint64_t items{0};
+  uint64_t chunks{0};
+  uint64_t steal_attempts{0};
+  uint64_t steals{0};
+  std::array<uint64_t, kChunkBuckets> chunk_sizes{};
+
+  uint64_t phase_begin_ns{0};
+  bool busy{false};
+  bool started{false};
+
+  static uint64_t Now();
+
+  /// Start accounting time as busy or idle
+  void SetBusy(bool is_busy) {
+    uint64_t now = Now();
+    if (started) {
+      (busy ? busy_ns : idle_ns) += now - phase_begin_ns;
+    }
+    started = true;
+    busy = is_busy;
+    phase_begin_ns = now;
+  }
+
+  void AddChunk(uint64_t size);
+
+  /// Stop accounting time and report the statistics of the calling thread
+  void Finish(const char* loopname);
+};
+
+/// Per-thread busy and idle time, work items, chunk sizes and steals of a
+/// loop, collected when the loop is run with galois::more_stats(). Each
+/// thread reports its own values (BusyTimeUs, IdleTimeUs, WorkItems, Chunks,
+/// ChunkSize<n>, StealAttempts, Steals). StatManager derives how unevenly
+/// work was spread from the per-thread values (WorkItemsImbalance,
+/// BusyTimeImbalance, IdleFraction).
+///
+/// Usually instantiated per thread.
+template <bool Enabled>
+class SchedulingStatistics {
+  ThreadSchedulingStats stats_;
+  const char* loopname_;
+
+public:
+  explicit SchedulingStatistics(const char* loopname) : loopname_(loopname) {}
+
+  void setBusy(bool is_busy) { stats_.SetBusy(is_busy); }
+
+  void addChunk(uint64_t size) { stats_.AddChunk(size); }
+
+  void addItems(uint64_t n) { stats_.items += n; }
+
+  void addSteals(uint64_t attempts, uint64_t succeeded) {
+    stats_.steal_attempts += attempts;
+    stats_.steals += succeeded;
+  }
+
+  /// Called by the owning thread when it leaves the loop
+  void finish() { stats_.Finish(loopname_); }
+};
+
+template <>
+class SchedulingStatistics<false> {
+public:
+  explicit SchedulingStatistics(const char*) {}
+
+  void setBusy(bool) const {}
+  void addChunk(uint64_t) const {}
+  void addItems(uint64_t) const {}
+  void addSteals(uint64_t, uint64_t) const {}
+  void finish() const {}
+};
+
+}  // namespace galois::runtime
+
+#endif
@@ -24,7 +24,9 @@
 #include <memory>
 #include <vector>
 
+#include "galois/MemoryAccounting.h"
 #include "galois/config.h"
+#include "galois/substrate/PageAlloc.h"
 
 namespace galois {
 namespace substrate {
@@ -32,25 +34,46 @@ namespace substrate {
 namespace internal {
 struct GALOIS_EXPORT largeFreer {
   size_t bytes;
+  /// Memory accounting: the mapping is charged to category, with
+  /// socket_bytes[s] bytes on socket s and the rest on no socket; the charge
+  /// is returned when it is freed
+  MemoryCategory category{MemoryCategory::kUser};
+  std::vector<int64_t> socket_bytes;
+
   void operator()(void* ptr) const;
 };
 }  // namespace internal
 
 typedef std::unique_ptr<void, internal::largeFreer> LAptr;
 
-GALOIS_EXPORT LAptr largeMallocLocal(size_t bytes);  // fault in locally
-GALOIS_EXPORT LAptr
-largeMallocFloating(size_t bytes);  // leave numa mapping undefined
+// The largeMalloc functions map whole huge pages (allocSize()) backed by
+// pages of the given kind. Pre-faulting touches every base page so that
+// placement holds whether or not huge pages were obtained; it places memory
+// in units of allocSize(), or of 1G pages when those back the mapping.
+// Requests for 1G pages smaller than one such page use 2M pages instead.
+//
+// Mappings are charged to memory accounting (see galois/MemoryAccounting.h)
+// under the current category of the calling thread, kUser by default, on
+// the sockets of the threads that fault them in; floating mappings are
+// charged to no socket.
+
+GALOIS_EXPORT LAptr largeMallocLocal(
+    size_t bytes, PageKind pages = defaultPageKind());  // fault in locally
+GALOIS_EXPORT LAptr largeMallocFloating(
+    size_t bytes,
+    PageKind pages = defaultPageKind());  // leave numa mapping undefined
 // fault in interleaved mapping
-GALOIS_EXPORT LAptr largeMallocInterleaved(size_t bytes, unsigned numThreads);
+GALOIS_EXPORT LAptr largeMallocInterleaved(
+    size_t bytes, unsigned numThreads, PageKind pages = defaultPageKind());
 // fault in block interleaved mapping
-GALOIS_EXPORT LAptr largeMallocBlocked(size_t bytes, unsigned numThreads);
+GALOIS_EXPORT LAptr largeMallocBlocked(
+    size_t bytes, unsigned numThreads, PageKind pages = defaultPageKind());
 
 // fault in specified regions for each thread (threadRanges)
 template <typename RangeArrayTy>
 LAptr largeMallocSpecified(
     size_t bytes, uint32_t numThreads, RangeArrayTy& threadRanges,
-    size_t elementSize);
+    size_t elementSize, PageKind pages = defaultPageKind());
 
 }  // namespace substrate
 }  // namespace galois
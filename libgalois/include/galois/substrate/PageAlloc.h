@@ -26,12 +26,43 @@
 
 namespace galois::substrate {
 
+/// The pages that back a mapping from allocPages. Explicit huge pages come
+/// from the hugetlbfs pool, which must be reserved by the administrator
+/// (vm.nr_hugepages); when it is empty, allocation falls back to the next
+/// smaller kind.
+enum class PageKind {
+  /// Base pages (4K on x86), with transparent huge pages disabled
+  kBase,
+  /// Base pages that the kernel may back with transparent huge pages
+  /// (madvise(MADV_HUGEPAGE))
+  kTransparent,
+  /// Explicit 2M pages, falling back to kTransparent
+  kHuge2M,
+  /// Explicit 1G pages, falling back to kHuge2M
+  kHuge1G,
+};
+
 // size of pages
 GALOIS_EXPORT size_t allocSize();
 
+// size of one page of kind
+GALOIS_EXPORT size_t pageSize(PageKind kind);
+
+/// The kind of pages large allocations use unless told otherwise: kHuge2M,
+/// or the value of the environment variable GALOIS_HUGE_PAGES (base,
+/// transparent, 2M or 1G)
+GALOIS_EXPORT PageKind defaultPageKind();
+
 // allocate contiguous pages, optionally faulting them in
 GALOIS_EXPORT void* allocPages(unsigned num, bool preFault);
 
+/// Allocate num contiguous pages of allocSize() bytes backed by pages of
+/// kind, optionally faulting them in. If obtained is not null, it is set to
+/// the kind the mapping ended up with after any fallback. kHuge1G is only
+/// tried when the mapping is a whole number of 1G pages.
+GALOIS_EXPORT void* allocPages(
+    unsigned num, bool preFault, PageKind kind, PageKind* obtained = nullptr);
+
 // free page range
 GALOIS_EXPORT void freePages(void* ptr, unsigned num);
 
@@ -27,6 +27,7 @@
 #include <unordered_map>
 #include <vector>
 
+#include "galois/MemoryAccounting.h"
 #include "galois/config.h"
 #include "galois/substrate/CacheLineStorage.h"
 #include "galois/substrate/PageAlloc.h"
@@ -70,6 +71,10 @@ class PageAllocState {
     assert(ptr);
     auto tid = galois::substrate::ThreadPool::getTID();
     counts[tid] += 1;
+    // Pages are kept by the pool until exit, so they are never uncharged
+    galois::AccountMemory(
+        galois::MemoryCategory::kWorklists, galois::substrate::allocSize(),
+        galois::substrate::ThreadPool::getSocket());
     std::lock_guard<galois::substrate::SimpleLock> lg(mapLock);
     ownerMap[ptr] = tid;
     return ptr;
@@ -22,6 +22,9 @@
 
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <typeinfo>
 #include <utility>
 #include <vector>
 
@@ -85,6 +88,59 @@ GALOIS_EXPORT PerBackend& getPPSBackend();
 
 GALOIS_EXPORT void initPTS(unsigned maxT);
 
+/// A range of memory, given by its start and its size in bytes
+using MemoryRange = std::pair<const void*, size_t>;
+
+/// Append the memory that the per-thread object obj writes to, for the
+/// sharing audit of PerThreadStorage: the object itself, and the elements
+/// of vectors. Overload this function in the namespace of a type that owns
+/// other memory to include that memory in the audit.
+template <typename T>
+void
+AppendSlotRanges(const T& obj, std::vector<MemoryRange>* ranges) {
+  ranges->emplace_back(&obj, sizeof(T));
+}
+
+template <typename T, typename Alloc>
+void
+AppendSlotRanges(
+    const std::vector<T, Alloc>& obj, std::vector<MemoryRange>* ranges) {
+  ranges->emplace_back(&obj, sizeof(obj));
+  if constexpr (!std::is_same_v<T, bool>) {
+    if (!obj.empty()) {
+      ranges->emplace_back(obj.data(), obj.size() * sizeof(T));
+    }
+  }
+}
+
+/// Whether the sharing audit is on, which it is when the
+/// GALOIS_AUDIT_SHARING environment variable is set. The audit is a
+/// debugging aid: when a PerThreadStorage is destroyed, it warns about the
+/// cache lines that the objects of more than one thread write to (see
+/// PerThreadStorage::sharedCacheLines), which threads contend for even
+/// though each only touches its own object.
+GALOIS_EXPORT bool SharingAuditEnabled();
+
+/// The addresses of the cache lines that the ranges of more than one thread
+/// overlap, in increasing order; ranges[t] are the ranges of thread t
+GALOIS_EXPORT std::vector<uintptr_t> FindSharedCacheLines(
+    const std::vector<std::vector<MemoryRange>>& ranges);
+
+/// Warn about the cache lines shared by the objects of a PerThreadStorage
+/// whose element type is named type_name, if there are any
+GALOIS_EXPORT void ReportSharedCacheLines(
+    const char* type_name, const std::vector<uintptr_t>& lines);
+
+/// Storage for one T per thread. Each thread's objects are in a page that
+/// the thread allocated and first touched, so they are on its socket, and
+/// objects are cache-line aligned, so the objects of different threads never
+/// share a cache line. Memory that objects allocate themselves is placed
+/// wherever the allocating thread puts it, though: the objects are
+/// constructed by the calling thread, and, e.g., vectors resized there
+/// share a socket and may share cache lines. Large per-thread buffers
+/// should be allocated by their owning threads, e.g., with
+/// PerThreadLargeArray; the sharing audit (see SharingAuditEnabled) finds
+/// the cache lines that are shared.
 template <typename T>
 class PerThreadStorage {
   PerBackend* b;
@@ -95,6 +151,10 @@ class PerThreadStorage {
       return;
     }
 
+    if (SharingAuditEnabled()) {
+      ReportSharedCacheLines(typeid(T).name(), sharedCacheLines());
+    }
+
     for (unsigned n = 0; n < GetThreadPool().getMaxThreads(); ++n) {
       reinterpret_cast<T*>(b->getRemote(n, offset))->~T();
     }
@@ -196,6 +256,17 @@ public:
 
   unsigned size() const { return GetThreadPool().getMaxThreads(); }
 
+  /// The addresses of the cache lines that the objects of more than one
+  /// thread write to, as given by AppendSlotRanges. Call it outside of
+  /// parallel regions.
+  std::vector<uintptr_t> sharedCacheLines() const {
+    std::vector<std::vector<MemoryRange>> ranges(size());
+    for (unsigned n = 0; n < size(); ++n) {
+      AppendSlotRanges(*getRemote(n), &ranges[n]);
+    }
+    return FindSharedCacheLines(ranges);
+  }
+
   iterator begin() { return iterator(*this, 0); }
 
   iterator end() { return iterator(*this, size()); }
@@ -205,18 +276,29 @@ public:
   local_iterator local_end() { return local_begin() + 1; }
 };
 
+/// Storage for one T per socket, shared by the threads of the socket, e.g.,
+/// for caches or queues that threads on a socket share. Each object is in a
+/// page that the socket leader allocated and first touched. getLocal and
+/// getRemote take thread ids, which map to the object of the socket of the
+/// thread, and size is the number of threads; getRemoteByPkg takes a socket
+/// id.
 template <typename T>
 class PerSocketStorage {
   unsigned offset;
   PerBackend* b;
 
   void destruct() {
+    if (offset == ~0U) {
+      return;
+    }
+
     auto& tp = GetThreadPool();
     for (unsigned n = 0; n < tp.getMaxSockets(); ++n) {
       reinterpret_cast<T*>(b->getRemote(tp.getLeaderForSocket(n), offset))
           ->~T();
     }
     b->deallocOffset(offset, sizeof(T));
+    offset = ~0U;
   }
 
 public:
@@ -235,7 +317,9 @@ public:
   }
 
   PerSocketStorage(PerSocketStorage&& rhs) noexcept
-      : offset(std::move(rhs.offset)), b(&getPPSBackend()) {}
+      : offset(rhs.offset), b(rhs.b) {
+    rhs.offset = ~0U;
+  }
 
   PerSocketStorage& operator=(PerSocketStorage&& rhs) {
     auto tmp = std::move(rhs);
@@ -291,6 +375,9 @@ public:
   }
 
   unsigned size() const { return GetThreadPool().getMaxThreads(); }
+
+  /// The number of sockets, i.e., of distinct objects
+  unsigned numSockets() const { return GetThreadPool().getMaxSockets(); }
 };
 
 }  // end namespace galois::substrate
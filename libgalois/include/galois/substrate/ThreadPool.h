@@ -23,8 +23,11 @@
 #include <atomic>
 #include <cassert>
 #include <condition_variable>
+#include <cstdint>
 #include <cstdlib>
+#include <deque>
 #include <functional>
+#include <mutex>
 #include <thread>
 #include <vector>
 
@@ -53,6 +56,25 @@ namespace galois::substrate {
 class GALOIS_EXPORT ThreadPool {
   friend class SharedMem;
 
+public:
+  //! Wakeup statistics summed over threads
+  struct WakeupStats {
+    //! Times a thread was woken to run work
+    uint64_t wakeups{};
+    //! Wakeups of threads that had stopped spinning and parked
+    uint64_t parks{};
+    //! Time from the start of a parallel section until a thread runs work
+    uint64_t latency_sum_ns{};
+    uint64_t latency_max_ns{};
+  };
+
+  //! A unit of fork/join work; see galois::TaskGroup
+  struct Task {
+    std::function<void()> fn;
+    //! Decremented once fn returns
+    std::atomic<size_t>* pending;
+  };
+
 protected:
   struct shutdown_ty {};  //! type for shutting down thread
   struct fastmode_ty {
@@ -63,38 +85,59 @@ protected:
   };  //! type to switch to dedicated mode
 
   //! Per-thread mailboxes for notification
+  //!
+  //! Outside of fastmode, a waiting thread spins for a while and then parks
+  //! (on a futex on Linux). How long it spins is learned from how long it
+  //! has waited for work before: spinning through short gaps between
+  //! parallel sections avoids the cost of parking, and long gaps make the
+  //! thread park sooner so that it does not burn a core.
   struct per_signal {
+    //! Values of state
+    enum : uint32_t { kIdle, kReleased, kParked };
+
     std::condition_variable cv;
     std::mutex m;
+    //! Range of positions in the wake order this thread wakes up
     unsigned wbegin, wend;
     std::atomic<int> done;
     std::atomic<int> fastRelease;
+    std::atomic<uint32_t> state{kIdle};
+    //! Learned time to spin before parking
+    uint64_t spinNs{0};
+    WakeupStats stats;
     ThreadTopoInfo topo;
+    //! Tasks spawned by this thread; the owner runs the newest, thieves
+    //! take the oldest
+    std::mutex taskLock;
+    std::deque<Task> tasks;
+    std::atomic<size_t> numTasks{0};
 
     void wakeup(bool fastmode) {
       if (fastmode) {
         done = 0;
         fastRelease = 1;
       } else {
-        std::lock_guard<std::mutex> lg(m);
         done = 0;
-        cv.notify_one();
-        // start.release();
+        if (state.exchange(kReleased) == kParked) {
+          unpark();
+        }
       }
     }
 
-    void wait(bool fastmode) {
+    void wait(bool fastmode, uint64_t maxSpinNs) {
       if (fastmode) {
         while (!fastRelease.load(std::memory_order_relaxed)) {
           asmPause();
         }
         fastRelease = 0;
       } else {
-        std::unique_lock<std::mutex> lg(m);
-        cv.wait(lg, [=] { return !done; });
-        // start.acquire();
+        waitAdaptive(maxSpinNs);
       }
     }
+
+    void waitAdaptive(uint64_t maxSpinNs);
+    void park();
+    void unpark();
   };
 
   thread_local static per_signal my_box;
@@ -106,6 +149,64 @@ protected:
   unsigned masterFastmode;
   bool running;
   std::function<void(void)> work;
+  //! Upper bound on the time a waiting thread spins before parking
+  uint64_t maxSpinNs;
+  //! When the current parallel section was started
+  std::atomic<uint64_t> launchNs{0};
+  //! Threads in the order they are woken: the master, then threads grouped
+  //! by socket starting with the socket of the master
+  std::vector<unsigned> wakeOrder;
+  unsigned wakeOrderNum{0};
+  //! Tasks spawned but not yet started, over all threads
+  std::atomic<size_t> queuedTasks{0};
+
+  //! Take the newest or oldest task of s
+  bool popTask(per_signal& s, bool newest, Task* task);
+
+  //! Run one task of this thread or stolen from another; false if there
+  //! were none
+  bool runOneTask();
+
+  //! Run tasks of any thread until none are queued
+  void helpTasks();
+
+  //! Call fn(pos, begin, end) for each thread at position pos of the wake
+  //! order that is woken by a thread responsible for [wbegin, wend); the
+  //! child is then responsible for [begin, end). Ranges spanning sockets
+  //! are split by socket so that each socket is woken by one cross-socket
+  //! signal; ranges within a socket are split in half.
+  template <typename F>
+  void forEachChild(unsigned wbegin, unsigned wend, F fn) {
+    if (wbegin == wend) {
+      return;
+    }
+    unsigned socket = signals[wakeOrder[wbegin]]->topo.socket;
+    unsigned split = wbegin + 1;
+    while (split < wend && signals[wakeOrder[split]]->topo.socket == socket) {
+      ++split;
+    }
+    if (split < wend) {
+      for (unsigned gbegin = wbegin; gbegin < wend;) {
+        unsigned gsocket = signals[wakeOrder[gbegin]]->topo.socket;
+        unsigned gend = gbegin + 1;
+        while (gend < wend &&
+               signals[wakeOrder[gend]]->topo.socket == gsocket) {
+          ++gend;
+        }
+        fn(gbegin, gbegin + 1, gend);
+        gbegin = gend;
+      }
+      return;
+    }
+    unsigned midpoint = wbegin + (1 + wend - wbegin) / 2;
+    fn(wbegin, wbegin + 1, midpoint);
+    if (midpoint < wend) {
+      fn(midpoint, midpoint + 1, wend);
+    }
+  }
+
+  //! compute wakeOrder for num threads
+  void computeWakeOrder(unsigned num);
 
   //! destroy all threads
   void destroyCommon();
@@ -169,6 +270,18 @@ public:
   // experimental: leave busy wait
   void beKind();
 
+  //! Queue a task on the calling thread where idle threads may steal it.
+  //! Outside of a parallel section the task runs when it is waited for.
+  void spawnTask(Task task);
+
+  //! Run tasks, this thread's first, until pending is zero
+  void waitTasks(const std::atomic<size_t>& pending);
+
+  //! Wakeup statistics since the last reset; only meaningful outside of
+  //! parallel sections
+  WakeupStats getWakeupStats() const;
+  void resetWakeupStats();
+
   bool isRunning() const { return running; }
 
   //! return the number of non-reserved threads in the pool
@@ -0,0 +1,210 @@
+#ifndef GALOIS_LIBGALOIS_GALOIS_WORKLISTS_ADAPTIVEOBIM_H_
+#define GALOIS_LIBGALOIS_GALOIS_WORKLISTS_ADAPTIVEOBIM_H_
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <type_traits>
+
+#include <boost/noncopyable.hpp>
+
+#include "galois/config.h"
+#include "galois/optional.h"
+#include "galois/substrate/PerThreadStorage.h"
+#include "galois/worklists/Chunk.h"
+#include "galois/worklists/Obim.h"
+#include "galois/worklists/WLCompileCheck.h"
+#include "galois/worklists/WorkListHelpers.h"
+
+namespace galois {
+namespace worklists {
+
+/**
+ * Approximate priority scheduling like \ref OrderedByIntegerMetric, but the
+ * width of the priority buckets is tuned while the loop runs instead of being
+ * fixed by the indexer.
+ *
+ * Indexer gives the exact priority of an item. An item goes into the bucket
+ * with key (priority >> shift) << shift, i.e., the lowest priority of its
+ * bucket, so buckets made with different shifts stay ordered with respect to
+ * each other. Each thread tracks how many items it pops from a bucket before
+ * it moves to another one. If that is small, buckets do not hold
+ * enough work to keep threads busy and the shift is increased (buckets are
+ * merged). If a thread keeps popping from the same bucket for a long time,
+ * work is likely being done out of priority order and the shift is
+ * decreased (buckets are split). A shift change only affects items pushed
+ * after it.
+ *
+ * Index must be an integral type and priorities must not be negative.
+ *
+ * @tparam Indexer        Indexer class giving the exact priority
+ * @tparam Container      Scheduler for each bucket
+ * @tparam BlockPeriod    Check for higher priority work every 2^BlockPeriod
+ *                        iterations
+ * @tparam BSP            Use back-scan prevention
+ */
+template <
+    class Indexer = DummyIndexer<int>,
+    typename Container = PerSocketChunkFIFO<>, unsigned BlockPeriod = 0,
+    bool BSP = true, typename T = int, typename Index = int,
+    bool Concurrent = true>
+class AdaptiveOrderedByIntegerMetric : private boost::noncopyable {
+public:
+  template <typename _T>
+  using retype = AdaptiveOrderedByIntegerMetric<
+      Indexer, typename Container::template retype<_T>, BlockPeriod, BSP, _T,
+      typename std::result_of<Indexer(_T)>::type, Concurrent>;
+
+  template <bool _b>
+  using rethread = AdaptiveOrderedByIntegerMetric<
+      Indexer, Container, BlockPeriod, BSP, T, Index, _b>;
+
+  template <unsigned _period>
+  struct with_block_period {
+    typedef AdaptiveOrderedByIntegerMetric<
+        Indexer, Container, _period, BSP, T, Index, Concurrent>
+        type;
+  };
+
+  template <typename _container>
+  struct with_container {
+    typedef AdaptiveOrderedByIntegerMetric<
+        Indexer, _container, BlockPeriod, BSP, T, Index, Concurrent>
+        type;
+  };
+
+  template <typename _indexer>
+  struct with_indexer {
+    typedef AdaptiveOrderedByIntegerMetric<
+        _indexer, Container, BlockPeriod, BSP, T, Index, Concurrent>
+        type;
+  };
+
+  template <bool _bsp>
+  struct with_back_scan_prevention {
+    typedef AdaptiveOrderedByIntegerMetric<
+        Indexer, Container, BlockPeriod, _bsp, T, Index, Concurrent>
+        type;
+  };
+
+  typedef T value_type;
+  typedef Index index_type;
+
+  /// Pops per thread between tuning decisions
+  static constexpr unsigned kTuningPeriod = 4096;
+  /// Merge buckets if a thread pops fewer items than this from a bucket on
+  /// average
+  static constexpr unsigned kMinItemsPerBucket = 128;
+  /// Split buckets if a thread does not change buckets for this many tuning
+  /// periods
+  static constexpr unsigned kSplitPeriods = 2;
+
+private:
+  static_assert(
+      std::is_integral<Index>::value, "only integral index types supported");
+
+  static constexpr unsigned kMaxShift =
+      std::numeric_limits<std::make_unsigned_t<Index>>::digits - 1;
+
+  /// Maps an item to the key of its bucket with the current shift
+  struct KeyIndexer {
+    Indexer indexer;
+    const std::atomic<unsigned>* shift;
+
+    Index operator()(const T& val) {
+      unsigned s = shift->load(std::memory_order_relaxed);
+      return (indexer(val) >> s) << s;
+    }
+  };
+
+  using Inner = OrderedByIntegerMetric<
+      KeyIndexer, Container, BlockPeriod, BSP, T, Index, false, false, false,
+      Concurrent>;
+
+  struct ThreadStats {
+    unsigned pops{};
+    unsigned switches{};
+    unsigned quiet_periods{};
+    unsigned period_shift{};
+    Index last_key{};
+  };
+
+  std::atomic<unsigned> shift_;
+  substrate::PerThreadStorage<ThreadStats> stats_;
+  Inner inner_;
+
+  void Tune(ThreadStats& s) {
+    unsigned shift = s.period_shift;
+    unsigned new_shift = shift;
+    if (s.pops < kMinItemsPerBucket * s.switches) {
+      s.quiet_periods = 0;
+      new_shift = std::min(shift + 1, kMaxShift);
+    } else if (s.switches == 0 && ++s.quiet_periods >= kSplitPeriods) {
+      s.quiet_periods = 0;
+      new_shift = shift > 0 ? shift - 1 : 0;
+    } else if (s.switches != 0) {
+      s.quiet_periods = 0;
+    }
+
+    // Only act on measurements made with the current shift, so that
+    // threads tuning at the same time do not overshoot
+    if (new_shift != shift) {
+      shift_.compare_exchange_strong(shift, new_shift);
+    }
+
+    s.pops = 0;
+    s.switches = 0;
+    s.period_shift = shift_.load(std::memory_order_relaxed);
+  }
+
+public:
+  AdaptiveOrderedByIntegerMetric(
+      const Indexer& x = Indexer(), unsigned initial_shift = 0)
+      : shift_(std::min(initial_shift, kMaxShift)),
+        inner_(KeyIndexer{x, &shift_}) {
+    for (unsigned i = 0; i < stats_.size(); ++i) {
+      stats_.getRemote(i)->period_shift = shift_.load();
+    }
+  }
+
+  /// The current bucket width as a shift
+  unsigned shift() const { return shift_.load(std::memory_order_relaxed); }
+
+  void push(const value_type& val) { inner_.push(val); }
+
+  template <typename Iter>
+  void push(Iter b, Iter e) {
+    while (b != e) {
+      push(*b++);
+    }
+  }
+
+  template <typename RangeTy>
+  void push_initial(const RangeTy& range) {
+    push(range.local_begin(), range.local_end());
+  }
+
+  galois::optional<value_type> pop() {
+    galois::optional<value_type> item = inner_.pop();
+    if (!item) {
+      return item;
+    }
+
+    ThreadStats& s = *stats_.getLocal();
+    Index key = inner_.currentIndex();
+    if (key != s.last_key) {
+      s.last_key = key;
+      ++s.switches;
+    }
+    if (++s.pops == kTuningPeriod) {
+      Tune(s);
+    }
+    return item;
+  }
+};
+GALOIS_WLCOMPILECHECK(AdaptiveOrderedByIntegerMetric)
+
+}  // end namespace worklists
+}  // end namespace galois
+
+#endif
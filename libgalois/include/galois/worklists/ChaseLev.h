@@ -0,0 +1,313 @@
+#ifndef GALOIS_LIBGALOIS_GALOIS_WORKLISTS_CHASELEV_H_
+#define GALOIS_LIBGALOIS_GALOIS_WORKLISTS_CHASELEV_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+#include "galois/Trace.h"
+#include "galois/config.h"
+#include "galois/optional.h"
+#include "galois/substrate/CompilerSpecific.h"
+#include "galois/substrate/PerThreadStorage.h"
+#include "galois/substrate/ThreadPool.h"
+#include "galois/worklists/WLCompileCheck.h"
+
+namespace galois {
+
+namespace runtime {
+extern unsigned activeThreads;
+}  // namespace runtime
+
+namespace worklists {
+
+namespace internal {
+
+/**
+ * Lock-free work-stealing deque (Chase and Lev, SPAA 2005; memory orders
+ * from Le et al., PPoPP 2013). The owning thread pushes and pops at the
+ * bottom; other threads steal from the top.
+ *
+ * Thieves take up to half of the deque, at most MaxSteal items, with a
+ * single CAS on top. A thief may act on a stale bottom, so the owner only
+ * pops from the bottom without synchronization when at least MaxSteal items
+ * separate it from top; closer to top it takes items from the top with a
+ * CAS like a thief.
+ *
+ * Buffers replaced when the deque grows are kept until the deque is
+ * destroyed because thieves may still be reading them.
+ */
+template <typename T, unsigned MaxSteal>
+class ChaseLevDeque : private boost::noncopyable {
+  static_assert(MaxSteal > 0, "need to steal at least one item");
+
+  static constexpr int64_t kInitialCapacity = 256;
+
+  struct Buffer {
+    int64_t mask;
+    std::unique_ptr<T[]> items;
+
+    explicit Buffer(int64_t capacity)
+        : mask(capacity - 1), items(new T[capacity]) {}
+
+    T& at(int64_t i) { return items[i & mask]; }
+  };
+
+  alignas(substrate::GALOIS_CACHE_LINE_SIZE) std::atomic<int64_t> top_{0};
+  alignas(substrate::GALOIS_CACHE_LINE_SIZE) std::atomic<int64_t> bottom_{0};
+  std::atomic<Buffer*> buffer_;
+  std::vector<std::unique_ptr<Buffer>> buffers_;
+
+  GALOIS_ATTRIBUTE_NOINLINE
+  Buffer* Grow(Buffer* old, int64_t top, int64_t bottom) {
+    auto next = std::make_unique<Buffer>(2 * (old->mask + 1));
+    for (int64_t i = top; i < bottom; ++i) {
+      next->at(i) = old->at(i);
+    }
+    Buffer* ret = next.get();
+    buffers_.emplace_back(std::move(next));
+    buffer_.store(ret, std::memory_order_release);
+    return ret;
+  }
+
+public:
+  ChaseLevDeque() {
+    buffers_.emplace_back(std::make_unique<Buffer>(kInitialCapacity));
+    buffer_.store(buffers_.back().get(), std::memory_order_relaxed);
+  }
+
+  //! Owner only
+  void push(const T& val) {
+    int64_t b = bottom_.load(std::memory_order_relaxed);
+    int64_t t = top_.load(std::memory_order_acquire);
+    Buffer* buf = buffer_.load(std::memory_order_relaxed);
+    if (b - t > buf->mask) {
+      buf = Grow(buf, t, b);
+    }
+    buf->at(b) = val;
+    bottom_.store(b + 1, std::memory_order_release);
+  }
+
+  //! Owner only
+  galois::optional<T> pop() {
+    int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+    Buffer* buf = buffer_.load(std::memory_order_relaxed);
+    bottom_.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t t = top_.load(std::memory_order_relaxed);
+
+    if (b - t >= static_cast<int64_t>(MaxSteal)) {
+      // No thief can reach index b
+      return galois::optional<T>(buf->at(b));
+    }
+
+    bottom_.store(b + 1, std::memory_order_relaxed);
+    galois::optional<T> ret;
+    while (!ret && !empty()) {
+      ret = stealOne();
+    }
+    return ret;
+  }
+
+  bool empty() const {
+    int64_t t = top_.load(std::memory_order_acquire);
+    int64_t b = bottom_.load(std::memory_order_acquire);
+    return t >= b;
+  }
+
+  size_t size() const {
+    int64_t t = top_.load(std::memory_order_acquire);
+    int64_t b = bottom_.load(std::memory_order_acquire);
+    return b > t ? b - t : 0;
+  }
+
+  /**
+   * Take up to half the items, at most MaxSteal, from the top and append
+   * them to out. Returns false if there was nothing to take or another
+   * thread got there first.
+   */
+  bool stealHalf(std::vector<T>* out) {
+    int64_t t = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t b = bottom_.load(std::memory_order_acquire);
+    if (t >= b) {
+      return false;
+    }
+
+    int64_t n =
+        std::min<int64_t>((b - t + 1) / 2, static_cast<int64_t>(MaxSteal));
+    Buffer* buf = buffer_.load(std::memory_order_acquire);
+    size_t start = out->size();
+    for (int64_t i = t; i < t + n; ++i) {
+      out->emplace_back(buf->at(i));
+    }
+
+    if (!top_.compare_exchange_strong(
+            t, t + n, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+      out->resize(start);
+      return false;
+    }
+    return true;
+  }
+
+  galois::optional<T> stealOne() {
+    galois::optional<T> ret;
+    int64_t t = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t b = bottom_.load(std::memory_order_acquire);
+    if (t >= b) {
+      return ret;
+    }
+
+    T val = buffer_.load(std::memory_order_acquire)->at(t);
+    if (top_.compare_exchange_strong(
+            t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+      ret = val;
+    }
+    return ret;
+  }
+};
+
+}  // namespace internal
+
+/**
+ * Per-thread lock-free deques with work stealing, for irregular loops where
+ * chunked FIFOs add too much scheduling overhead. Threads push and pop work
+ * LIFO from their own deque. An idle thread steals half of a victim's deque
+ * (at most MaxSteal items) at a time, trying victims in order of locality:
+ * first the hardware threads sharing its core, then threads on its socket
+ * starting from the nearest thread ids, then the remaining threads.
+ *
+ * @tparam MaxSteal  Maximum number of items taken by one steal
+ */
+template <unsigned MaxSteal = 64, typename T = int, bool Concurrent = true>
+class ChaseLevStealing : private boost::noncopyable {
+public:
+  template <typename _T>
+  using retype = ChaseLevStealing<MaxSteal, _T, Concurrent>;
+
+  template <bool _concurrent>
+  using rethread = ChaseLevStealing<MaxSteal, T, _concurrent>;
+
+  template <unsigned _max_steal>
+  struct with_max_steal {
+    typedef ChaseLevStealing<_max_steal, T, Concurrent> type;
+  };
+
+  typedef T value_type;
+
+private:
+  struct PerThread {
+    internal::ChaseLevDeque<T, MaxSteal> deque;
+    //! Threads to steal from in order of preference
+    std::vector<unsigned> victims;
+    //! Items taken by the last steal
+    std::vector<T> stolen;
+  };
+
+  substrate::PerThreadStorage<PerThread> local_;
+
+  //! Victims of tid ordered by locality
+  static std::vector<unsigned> VictimOrder(unsigned tid, unsigned num) {
+    auto& tp = substrate::GetThreadPool();
+    // Threads are numbered one per core first, then their SMT siblings, so
+    // threads sharing a core have the same id modulo the number of cores
+    unsigned cores = std::max(tp.getMaxCores(), 1U);
+    unsigned socket = tp.getSocket(tid);
+
+    std::vector<unsigned> others;
+    for (unsigned i = 1; i < num; ++i) {
+      others.emplace_back((tid + i) % num);
+    }
+
+    auto distance = [&](unsigned other) {
+      return std::min((other + num - tid) % num, (tid + num - other) % num);
+    };
+    auto rank = [&](unsigned other) {
+      if (other % cores == tid % cores) {
+        return 0;
+      }
+      if (tp.getSocket(other) == socket) {
+        return 1;
+      }
+      return 2;
+    };
+    std::stable_sort(
+        others.begin(), others.end(), [&](unsigned a, unsigned b) {
+          int ra = rank(a);
+          int rb = rank(b);
+          if (ra != rb) {
+            return ra < rb;
+          }
+          return distance(a) < distance(b);
+        });
+    return others;
+  }
+
+  GALOIS_ATTRIBUTE_NOINLINE
+  galois::optional<value_type> steal(PerThread& me) {
+    galois::optional<value_type> ret;
+    if (!Concurrent) {
+      return ret;
+    }
+
+    unsigned num = runtime::activeThreads;
+    if (me.victims.size() + 1 != num) {
+      me.victims = VictimOrder(substrate::ThreadPool::getTID(), num);
+    }
+
+    for (unsigned victim : me.victims) {
+      internal::ChaseLevDeque<T, MaxSteal>& d = local_.getRemote(victim)->deque;
+      if (d.empty()) {
+        continue;
+      }
+      me.stolen.clear();
+      if (!d.stealHalf(&me.stolen)) {
+        continue;
+      }
+      // Keep the oldest item, which is the one the victim would have run
+      // last, and queue the rest locally
+      TraceInstant("Steal", "steal", me.stolen.size());
+      ret = me.stolen.front();
+      for (auto ii = me.stolen.begin() + 1; ii != me.stolen.end(); ++ii) {
+        me.deque.push(*ii);
+      }
+      return ret;
+    }
+    return ret;
+  }
+
+public:
+  void push(const value_type& val) { local_.getLocal()->deque.push(val); }
+
+  template <typename Iter>
+  void push(Iter b, Iter e) {
+    PerThread& me = *local_.getLocal();
+    while (b != e) {
+      me.deque.push(*b++);
+    }
+  }
+
+  template <typename RangeTy>
+  void push_initial(const RangeTy& range) {
+    push(range.local_begin(), range.local_end());
+  }
+
+  galois::optional<value_type> pop() {
+    PerThread& me = *local_.getLocal();
+    if (galois::optional<value_type> ret = me.deque.pop()) {
+      return ret;
+    }
+    return steal(me);
+  }
+};
+GALOIS_WLCOMPILECHECK(ChaseLevStealing)
+
+}  // end namespace worklists
+}  // end namespace galois
+
+#endif
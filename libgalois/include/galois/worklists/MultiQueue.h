@@ -0,0 +1,247 @@
+#ifndef GALOIS_LIBGALOIS_GALOIS_WORKLISTS_MULTIQUEUE_H_
+#define GALOIS_LIBGALOIS_GALOIS_WORKLISTS_MULTIQUEUE_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+#include "galois/config.h"
+#include "galois/optional.h"
+#include "galois/substrate/CompilerSpecific.h"
+#include "galois/substrate/PerThreadStorage.h"
+#include "galois/substrate/SimpleLock.h"
+#include "galois/substrate/ThreadPool.h"
+#include "galois/worklists/WLCompileCheck.h"
+#include "galois/worklists/WorkListHelpers.h"
+
+namespace galois {
+
+namespace runtime {
+extern unsigned activeThreads;
+}  // namespace runtime
+
+namespace worklists {
+
+/**
+ * Relaxed priority scheduling with a MultiQueue (Rihani et al., SPAA 2015).
+ * Items are kept in QueuesPerThread * P binary heaps, each protected by its
+ * own lock. A push goes to a random heap. A pop looks at the tops of two
+ * random heaps and takes the smaller one, which returns items close to the
+ * global minimum with high probability while keeping contention low.
+ *
+ * Unlike \ref OrderedByIntegerMetric, items are ordered by their exact
+ * priority rather than by buckets, so the indexer does not need to be tuned
+ * to the input (e.g., for SSSP, index by distance rather than by distance /
+ * delta). Index must be a type with a total order and
+ * std::numeric_limits.
+ *
+ * An example:
+ * \code
+ * struct Item { int dist; };
+ *
+ * struct Indexer {
+ *   int operator()(Item i) const { return i.dist; }
+ * };
+ *
+ * typedef galois::worklists::MultiQueue<Indexer> WL;
+ * galois::for_each(galois::iterate(items), Fn, galois::wl<WL>());
+ * \endcode
+ *
+ * @tparam Indexer          Indexer class
+ * @tparam QueuesPerThread  Number of heaps per thread
+ */
+template <
+    class Indexer = DummyIndexer<int>, unsigned QueuesPerThread = 2,
+    typename T = int, typename Index = int, bool Concurrent = true>
+class MultiQueue : private boost::noncopyable {
+public:
+  template <typename _T>
+  using retype = MultiQueue<
+      Indexer, QueuesPerThread, _T, typename std::result_of<Indexer(_T)>::type,
+      Concurrent>;
+
+  template <bool _b>
+  using rethread = MultiQueue<Indexer, QueuesPerThread, T, Index, _b>;
+
+  template <unsigned _queues>
+  struct with_queues_per_thread {
+    typedef MultiQueue<Indexer, _queues, T, Index, Concurrent> type;
+  };
+
+  template <typename _indexer>
+  struct with_indexer {
+    typedef MultiQueue<_indexer, QueuesPerThread, T, Index, Concurrent> type;
+  };
+
+  typedef T value_type;
+  typedef Index index_type;
+
+private:
+  static_assert(QueuesPerThread > 0, "need at least one queue per thread");
+
+  /// Number of two-choice attempts before a pop falls back to scanning all
+  /// heaps
+  static constexpr unsigned kPopAttempts = 8;
+
+  using Entry = std::pair<Index, T>;
+
+  struct Greater {
+    bool operator()(const Entry& a, const Entry& b) const {
+      return a.first > b.first;
+    }
+  };
+
+  struct alignas(substrate::GALOIS_CACHE_LINE_SIZE) Queue {
+    substrate::SimpleLock lock;
+    /// Index of the top of heap, readable without the lock; only meaningful
+    /// when size > 0
+    std::atomic<Index> top{std::numeric_limits<Index>::max()};
+    std::atomic<size_t> size{0};
+    std::vector<Entry> heap;
+
+    void Push(Entry&& entry) {
+      heap.emplace_back(std::move(entry));
+      std::push_heap(heap.begin(), heap.end(), Greater());
+      Publish();
+    }
+
+    T Pop() {
+      std::pop_heap(heap.begin(), heap.end(), Greater());
+      T item = std::move(heap.back().second);
+      heap.pop_back();
+      Publish();
+      return item;
+    }
+
+    void Publish() {
+      if (!heap.empty()) {
+        top.store(heap.front().first, std::memory_order_relaxed);
+      }
+      size.store(heap.size(), std::memory_order_relaxed);
+    }
+  };
+
+  Indexer indexer_;
+  size_t num_queues_;
+  std::unique_ptr<Queue[]> queues_;
+  /// xorshift state per thread
+  substrate::PerThreadStorage<uint64_t> rng_;
+
+  size_t RandomQueue() {
+    uint64_t& x = *rng_.getLocal();
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    return x % num_queues_;
+  }
+
+  /// Better of two heaps by their published tops, or nullptr if both are
+  /// empty
+  Queue* Choose(Queue* a, Queue* b) {
+    bool a_empty = a->size.load(std::memory_order_relaxed) == 0;
+    bool b_empty = b->size.load(std::memory_order_relaxed) == 0;
+    if (a_empty) {
+      return b_empty ? nullptr : b;
+    }
+    if (b_empty) {
+      return a;
+    }
+    return b->top.load(std::memory_order_relaxed) <
+                   a->top.load(std::memory_order_relaxed)
+               ? b
+               : a;
+  }
+
+  galois::optional<value_type> TryPop(Queue* q) {
+    galois::optional<value_type> item;
+    if (q->heap.empty()) {
+      return item;
+    }
+    item = q->Pop();
+    return item;
+  }
+
+public:
+  MultiQueue(const Indexer& x = Indexer())
+      : indexer_(x),
+        num_queues_(
+            Concurrent ? QueuesPerThread * std::max(runtime::activeThreads, 1U)
+                       : 1),
+        queues_(new Queue[num_queues_]) {
+    for (unsigned i = 0; i < rng_.size(); ++i) {
+      // xorshift state must be nonzero
+      *rng_.getRemote(i) = 0x9E3779B97F4A7C15ULL * (i + 1);
+    }
+  }
+
+  void push(const value_type& val) {
+    Entry entry(indexer_(val), val);
+    for (;;) {
+      Queue& q = queues_[RandomQueue()];
+      if (q.lock.try_lock()) {
+        q.Push(std::move(entry));
+        q.lock.unlock();
+        return;
+      }
+    }
+  }
+
+  template <typename Iter>
+  void push(Iter b, Iter e) {
+    while (b != e) {
+      push(*b++);
+    }
+  }
+
+  template <typename RangeTy>
+  void push_initial(const RangeTy& range) {
+    push(range.local_begin(), range.local_end());
+  }
+
+  galois::optional<value_type> pop() {
+    galois::optional<value_type> item;
+
+    for (unsigned attempt = 0; attempt < kPopAttempts; ++attempt) {
+      Queue* q = Choose(&queues_[RandomQueue()], &queues_[RandomQueue()]);
+      if (!q || !q->lock.try_lock()) {
+        continue;
+      }
+      item = TryPop(q);
+      q->lock.unlock();
+      if (item) {
+        return item;
+      }
+    }
+
+    // Random choices can miss the few nonempty heaps near the end of a loop;
+    // only report empty after checking every heap.
+    size_t start = RandomQueue();
+    for (size_t i = 0; i < num_queues_; ++i) {
+      Queue& q = queues_[(start + i) % num_queues_];
+      if (q.size.load(std::memory_order_relaxed) == 0) {
+        continue;
+      }
+      q.lock.lock();
+      item = TryPop(&q);
+      q.lock.unlock();
+      if (item) {
+        return item;
+      }
+    }
+
+    return item;
+  }
+};
+GALOIS_WLCOMPILECHECK(MultiQueue)
+
+}  // end namespace worklists
+}  // end namespace galois
+
+#endif
@@ -392,6 +392,10 @@ public:
     push(range.local_begin(), range.local_end());
   }
 
+  //! Index of the bucket the calling thread last popped from or was moved
+  //! to by a push
+  Index currentIndex() { return data.getLocal()->curIndex; }
+
   galois::optional<value_type> pop() {
     // Find a successful pop
     ThreadData& p = *data.getLocal();
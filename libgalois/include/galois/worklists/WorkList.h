@@ -22,9 +22,12 @@
 
 #include "galois/config.h"
 #include "galois/optional.h"
+#include "galois/worklists/AdaptiveObim.h"
 #include "galois/worklists/BulkSynchronous.h"
+#include "galois/worklists/ChaseLev.h"
 #include "galois/worklists/Chunk.h"
 #include "galois/worklists/LocalQueue.h"
+#include "galois/worklists/MultiQueue.h"
 #include "galois/worklists/Obim.h"
 #include "galois/worklists/OrderedList.h"
 #include "galois/worklists/OwnerComputes.h"
@@ -37,8 +40,11 @@ namespace galois {
  * Scheduling policies for Galois iterators. Unless you have very specific
  * scheduling requirement, \ref PerSocketChunkLIFO or \ref PerSocketChunkFIFO is
  * a reasonable scheduling policy. If you need approximate priority scheduling,
- * use \ref OrderedByIntegerMetric. For debugging, you may be interested in
- * \ref FIFO or \ref LIFO, which try to follow serial order exactly.
+ * use \ref OrderedByIntegerMetric, or \ref MultiQueue if there is no good
+ * bucketing of priorities. For irregular loops with little work per item,
+ * \ref ChaseLevStealing has lower scheduling overhead. For debugging, you may
+ * be interested in \ref FIFO or \ref LIFO, which try to follow serial order
+ * exactly.
  *
  * The way to use a worklist is to pass it as a template parameter to
  * \ref for_each(). For example,
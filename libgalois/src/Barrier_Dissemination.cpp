@@ -19,6 +19,7 @@
 
 #include <atomic>
 
+#include "galois/Trace.h"
 #include "galois/substrate/Barrier.h"
 #include "galois/substrate/CompilerSpecific.h"
 #include "galois/substrate/ThreadPool.h"
@@ -77,6 +78,7 @@ public:
   void Reinit(unsigned val) override { _reinit(val); }
 
   void Wait() override {
+    galois::TraceScope trace("BarrierWait", "barrier");
     auto& ld = nodes_.at(galois::substrate::ThreadPool::getTID()).get();
     auto& sense = ld.sense;
     auto& parity = ld.parity;
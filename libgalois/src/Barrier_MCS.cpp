@@ -19,6 +19,7 @@
 
 #include <atomic>
 
+#include "galois/Trace.h"
 #include "galois/substrate/Barrier.h"
 #include "galois/substrate/CompilerSpecific.h"
 #include "galois/substrate/ThreadPool.h"
@@ -75,6 +76,7 @@ public:
   void Reinit(unsigned val) override { _reinit(val); }
 
   void Wait() override {
+    galois::TraceScope trace("BarrierWait", "barrier");
     TreeNode& n = nodes_.at(galois::substrate::ThreadPool::getTID()).get();
     while (n.child_not_ready[0] || n.child_not_ready[1] ||
            n.child_not_ready[2] || n.child_not_ready[3]) {
@@ -20,6 +20,7 @@
 #include <condition_variable>
 #include <mutex>
 
+#include "galois/Trace.h"
 #include "galois/substrate/Barrier.h"
 #include "galois/substrate/ThreadPool.h"
 
@@ -64,6 +65,7 @@ public:
   }
 
   void Wait() override {
+    galois::TraceScope trace("BarrierWait", "barrier");
     barrier1.Wait();
     if (galois::substrate::ThreadPool::getTID() == 0) {
       barrier1.Reinit(total);
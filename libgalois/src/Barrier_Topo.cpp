@@ -19,6 +19,7 @@
 
 #include <atomic>
 
+#include "galois/Trace.h"
 #include "galois/substrate/Barrier.h"
 #include "galois/substrate/CompilerSpecific.h"
 #include "galois/substrate/PerThreadStorage.h"
@@ -80,6 +81,7 @@ public:
   void Reinit(unsigned val) override { _reinit(val); }
 
   void Wait() override {
+    galois::TraceScope trace("BarrierWait", "barrier");
     unsigned id = galois::substrate::ThreadPool::getTID();
     TreeNode& n = *nodes_.getLocal();
     unsigned& s = *sense_.getLocal();
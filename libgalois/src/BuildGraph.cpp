@@ -28,6 +28,7 @@
 #include "galois/ErrorCode.h"
 #include "galois/Galois.h"
 #include "galois/Logging.h"
+#include "galois/NumaMemoryPool.h"
 #include "galois/ParallelSTL.h"
 #include "galois/SharedMemSys.h"
 #include "galois/Threads.h"
@@ -97,7 +98,7 @@ AddNullArrays(
     std::unordered_map<int, std::shared_ptr<arrow::Array>>* null_map,
     std::unordered_map<int, std::shared_ptr<arrow::Array>>* lists_null_map,
     size_t elts) {
-  auto* pool = arrow::default_memory_pool();
+  auto* pool = galois::GetPropertyMemoryPool();
 
   // the builder types are still added for the list types since the list type is
   // extraneous info
@@ -123,7 +124,7 @@ AddNullArrays(
     std::unordered_map<int, std::shared_ptr<arrow::Array>>* null_map,
     std::unordered_map<int, std::shared_ptr<arrow::Array>>* lists_null_map,
     size_t elts, std::shared_ptr<arrow::DataType> type) {
-  auto* pool = arrow::default_memory_pool();
+  auto* pool = galois::GetPropertyMemoryPool();
 
   // the builder types are still added for the list types since the list type is
   // extraneous info
@@ -930,7 +931,7 @@ ArrowArrays
 RearrangeListArray(
     const std::shared_ptr<arrow::ChunkedArray>& list_chunked_array,
     const std::vector<size_t>& mapping, WriterProperties* properties) {
-  auto* pool = arrow::default_memory_pool();
+  auto* pool = galois::GetPropertyMemoryPool();
   ArrowArrays chunks;
   auto list_type =
       std::static_pointer_cast<arrow::BaseListType>(list_chunked_array->type())
@@ -1064,7 +1065,7 @@ RearrangeTable(
         }
         case arrow::Type::TIMESTAMP: {
           auto tb = std::make_shared<arrow::TimestampBuilder>(
-              array->type(), arrow::default_memory_pool());
+              array->type(), galois::GetPropertyMemoryPool());
           ca = RearrangeArray<arrow::TimestampBuilder, arrow::TimestampArray>(
               tb, array, mapping, properties);
           break;
@@ -1393,43 +1394,43 @@ galois::PropertyGraphBuilder::AddBuilder(const PropertyKey& key) {
   PropertiesState* properties =
       key.for_node ? &node_properties_ : &edge_properties_;
 
-  auto* pool = arrow::default_memory_pool();
+  auto* pool = galois::GetPropertyMemoryPool();
   if (!key.is_list) {
     switch (key.type) {
     case ImportDataType::kString: {
       properties->schema.emplace_back(arrow::field(key.name, arrow::utf8()));
       properties->builders.emplace_back(
-          std::make_shared<arrow::StringBuilder>());
+          std::make_shared<arrow::StringBuilder>(pool));
       break;
     }
     case ImportDataType::kInt64: {
       properties->schema.emplace_back(arrow::field(key.name, arrow::int64()));
       properties->builders.emplace_back(
-          std::make_shared<arrow::Int64Builder>());
+          std::make_shared<arrow::Int64Builder>(pool));
       break;
     }
     case ImportDataType::kInt32: {
       properties->schema.emplace_back(arrow::field(key.name, arrow::int32()));
       properties->builders.emplace_back(
-          std::make_shared<arrow::Int32Builder>());
+          std::make_shared<arrow::Int32Builder>(pool));
       break;
     }
     case ImportDataType::kDouble: {
       properties->schema.emplace_back(arrow::field(key.name, arrow::float64()));
       properties->builders.emplace_back(
-          std::make_shared<arrow::DoubleBuilder>());
+          std::make_shared<arrow::DoubleBuilder>(pool));
       break;
     }
     case ImportDataType::kFloat: {
       properties->schema.emplace_back(arrow::field(key.name, arrow::float32()));
       properties->builders.emplace_back(
-          std::make_shared<arrow::FloatBuilder>());
+          std::make_shared<arrow::FloatBuilder>(pool));
       break;
     }
     case ImportDataType::kBoolean: {
       properties->schema.emplace_back(arrow::field(key.name, arrow::boolean()));
       properties->builders.emplace_back(
-          std::make_shared<arrow::BooleanBuilder>());
+          std::make_shared<arrow::BooleanBuilder>(pool));
       break;
     }
     case ImportDataType::kTimestampMilli: {
@@ -1443,7 +1444,7 @@ galois::PropertyGraphBuilder::AddBuilder(const PropertyKey& key) {
     case ImportDataType::kStruct: {
       properties->schema.emplace_back(arrow::field(key.name, arrow::uint8()));
       properties->builders.emplace_back(
-          std::make_shared<arrow::UInt8Builder>());
+          std::make_shared<arrow::UInt8Builder>(pool));
       break;
     }
     default:
@@ -1451,7 +1452,7 @@ galois::PropertyGraphBuilder::AddBuilder(const PropertyKey& key) {
       GALOIS_LOG_WARN("treating unknown type {} as string", key.type);
       properties->schema.emplace_back(arrow::field(key.name, arrow::utf8()));
       properties->builders.emplace_back(
-          std::make_shared<arrow::StringBuilder>());
+          std::make_shared<arrow::StringBuilder>(pool));
       break;
     }
   } else {
@@ -1460,42 +1461,42 @@ galois::PropertyGraphBuilder::AddBuilder(const PropertyKey& key) {
       properties->schema.emplace_back(
           arrow::field(key.name, arrow::list(arrow::utf8())));
       properties->builders.emplace_back(std::make_shared<arrow::ListBuilder>(
-          pool, std::make_shared<arrow::StringBuilder>()));
+          pool, std::make_shared<arrow::StringBuilder>(pool)));
       break;
     }
     case ImportDataType::kInt64: {
       properties->schema.emplace_back(
           arrow::field(key.name, arrow::list(arrow::int64())));
       properties->builders.emplace_back(std::make_shared<arrow::ListBuilder>(
-          pool, std::make_shared<arrow::Int64Builder>()));
+          pool, std::make_shared<arrow::Int64Builder>(pool)));
       break;
     }
     case ImportDataType::kInt32: {
       properties->schema.emplace_back(
           arrow::field(key.name, arrow::list(arrow::int32())));
       properties->builders.emplace_back(std::make_shared<arrow::ListBuilder>(
-          pool, std::make_shared<arrow::Int32Builder>()));
+          pool, std::make_shared<arrow::Int32Builder>(pool)));
       break;
     }
     case ImportDataType::kDouble: {
       properties->schema.emplace_back(
           arrow::field(key.name, arrow::list(arrow::float64())));
       properties->builders.emplace_back(std::make_shared<arrow::ListBuilder>(
-          pool, std::make_shared<arrow::DoubleBuilder>()));
+          pool, std::make_shared<arrow::DoubleBuilder>(pool)));
       break;
     }
     case ImportDataType::kFloat: {
       properties->schema.emplace_back(
           arrow::field(key.name, arrow::list(arrow::float32())));
       properties->builders.emplace_back(std::make_shared<arrow::ListBuilder>(
-          pool, std::make_shared<arrow::FloatBuilder>()));
+          pool, std::make_shared<arrow::FloatBuilder>(pool)));
       break;
     }
     case ImportDataType::kBoolean: {
       properties->schema.emplace_back(
           arrow::field(key.name, arrow::list(arrow::boolean())));
       properties->builders.emplace_back(std::make_shared<arrow::ListBuilder>(
-          pool, std::make_shared<arrow::BooleanBuilder>()));
+          pool, std::make_shared<arrow::BooleanBuilder>(pool)));
       break;
     }
     case ImportDataType::kTimestampMilli: {
@@ -1516,7 +1517,7 @@ galois::PropertyGraphBuilder::AddBuilder(const PropertyKey& key) {
       properties->schema.emplace_back(
           arrow::field(key.name, arrow::list(arrow::utf8())));
       properties->builders.emplace_back(std::make_shared<arrow::ListBuilder>(
-          pool, std::make_shared<arrow::StringBuilder>()));
+          pool, std::make_shared<arrow::StringBuilder>(pool)));
       break;
     }
   }
@@ -0,0 +1,116 @@
+#include "galois/graphs/CompressedTopology.h"
+
+#include <vector>
+
+#include "galois/ArrowInterchange.h"
+#include "galois/Loops.h"
+#include "galois/MemoryAccounting.h"
+#include "galois/ParallelSTL.h"
+
+namespace {
+
+uint64_t
+VarintSize(uint64_t value) {
+  uint64_t size = 1;
+  while (value >= 0x80U) {
+    value >>= 7;
+    ++size;
+  }
+  return size;
+}
+
+uint8_t*
+EncodeVarint(uint64_t value, uint8_t* out) {
+  while (value >= 0x80U) {
+    *out++ = static_cast<uint8_t>(value | 0x80U);
+    value >>= 7;
+  }
+  *out++ = static_cast<uint8_t>(value);
+  return out;
+}
+
+/// Delta of dest from prev as a zigzag encoded value
+uint64_t
+EncodedDelta(uint32_t prev, uint32_t dest) {
+  return galois::graphs::CompressedTopology::ZigZagEncode(
+      int64_t{dest} - int64_t{prev});
+}
+
+}  // namespace
+
+std::unique_ptr<galois::graphs::CompressedTopology>
+galois::graphs::CompressedTopology::Make(const GraphTopology& topology) {
+  MemoryCategoryScope scope(MemoryCategory::kTopology);
+  std::unique_ptr<CompressedTopology> compressed(new CompressedTopology());
+  compressed->out_indices_ = topology.out_indices;
+
+  uint64_t num_nodes = topology.num_nodes();
+  if (num_nodes == 0) {
+    return compressed;
+  }
+
+  galois::LargeArray<uint64_t> sizes;
+  sizes.allocateBlocked(num_nodes);
+  galois::do_all(
+      galois::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t n) {
+        auto [begin, end] = topology.edge_range(n);
+        uint32_t prev = n;
+        uint64_t size = 0;
+        for (auto e = begin; e != end; ++e) {
+          uint32_t dest = topology.out_dests->Value(e);
+          size += VarintSize(EncodedDelta(prev, dest));
+          prev = dest;
+        }
+        sizes[n] = size;
+      },
+      galois::steal(), galois::no_stats());
+
+  compressed->byte_offsets_.allocateBlocked(num_nodes);
+  galois::ParallelSTL::partial_sum(
+      sizes.begin(), sizes.end(), compressed->byte_offsets_.begin());
+
+  uint64_t num_bytes = compressed->byte_offsets_[num_nodes - 1];
+  if (num_bytes == 0) {
+    return compressed;
+  }
+
+  compressed->data_.allocateInterleaved(num_bytes);
+  galois::do_all(
+      galois::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t n) {
+        auto [begin, end] = topology.edge_range(n);
+        uint64_t offset = n > 0 ? compressed->byte_offsets_[n - 1] : 0;
+        uint8_t* out = compressed->data_.data() + offset;
+        uint32_t prev = n;
+        for (auto e = begin; e != end; ++e) {
+          uint32_t dest = topology.out_dests->Value(e);
+          out = EncodeVarint(EncodedDelta(prev, dest), out);
+          prev = dest;
+        }
+        assert(
+            out == compressed->data_.data() + compressed->byte_offsets_[n]);
+      },
+      galois::steal(), galois::no_stats());
+
+  return compressed;
+}
+
+galois::graphs::GraphTopology
+galois::graphs::CompressedTopology::Decompress() const {
+  std::vector<uint32_t> out_dests(num_edges());
+  galois::do_all(
+      galois::iterate(uint64_t{0}, num_nodes()),
+      [&](uint64_t n) {
+        for (auto it = edge_begin(n), end = edge_end(n); it != end; ++it) {
+          out_dests[*it] = it.dest();
+        }
+      },
+      galois::steal(), galois::no_stats());
+
+  return GraphTopology{
+      .out_indices = out_indices_,
+      .out_dests = std::static_pointer_cast<arrow::UInt32Array>(
+          galois::BuildArray(out_dests)),
+  };
+}
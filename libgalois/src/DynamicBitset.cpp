@@ -27,77 +27,152 @@
 
 GALOIS_EXPORT galois::DynamicBitset galois::EmptyBitset;
 
+namespace {
+
+using Word = uint64_t;
+
+static_assert(
+    sizeof(galois::CopyableAtomic<Word>) == sizeof(Word) &&
+        alignof(galois::CopyableAtomic<Word>) == alignof(Word),
+    "bitset words must be laid out as plain words");
+
+/// Words per block of a bulk operation. Blocks are large enough that the
+/// inner loops vectorize well and small enough to balance across threads.
+constexpr size_t kBlockWords = 1024;
+
+// The bulk operations below assume the bitsets are not updated in parallel,
+// so they work on the words as plain integers rather than atomics; this lets
+// the compiler vectorize the inner loops.
+Word*
+Words(galois::PODResizeableArray<galois::CopyableAtomic<Word>>& vec) {
+  return reinterpret_cast<Word*>(vec.data());
+}
+
+const Word*
+Words(const galois::PODResizeableArray<galois::CopyableAtomic<Word>>& vec) {
+  return reinterpret_cast<const Word*>(vec.data());
+}
+
+/// Call fn(begin, end) on blocks of [0, num_words) in parallel
+template <typename F>
 void
-galois::DynamicBitset::bitwise_or(const DynamicBitset& other) {
-  assert(size() == other.size());
-  const auto& other_bitvec = other.get_vec();
+ForEachBlock(size_t num_words, const F& fn) {
+  size_t num_blocks = (num_words + kBlockWords - 1) / kBlockWords;
   galois::do_all(
-      galois::iterate(size_t{0}, bitvec.size()),
-      [&](size_t i) { bitvec[i] |= other_bitvec[i]; }, galois::no_stats());
+      galois::iterate(size_t{0}, num_blocks),
+      [&](size_t block) {
+        size_t begin = block * kBlockWords;
+        fn(begin, std::min(begin + kBlockWords, num_words));
+      },
+      galois::no_stats());
+}
+
+/// dst[i] = op(dst[i], src[i])
+template <typename Op>
+void
+Apply(galois::DynamicBitset* dst, const galois::DynamicBitset& src, Op op) {
+  assert(dst->size() == src.size());
+  Word* __restrict out = Words(dst->get_vec());
+  const Word* __restrict in = Words(src.get_vec());
+  ForEachBlock(dst->get_vec().size(), [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      out[i] = op(out[i], in[i]);
+    }
+  });
+}
+
+/// dst[i] = op(src1[i], src2[i])
+template <typename Op>
+void
+Apply(
+    galois::DynamicBitset* dst, const galois::DynamicBitset& src1,
+    const galois::DynamicBitset& src2, Op op) {
+  assert(dst->size() == src1.size());
+  assert(dst->size() == src2.size());
+  Word* out = Words(dst->get_vec());
+  const Word* in1 = Words(src1.get_vec());
+  const Word* in2 = Words(src2.get_vec());
+  // dst may alias either source, so out cannot be restrict
+  ForEachBlock(dst->get_vec().size(), [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      out[i] = op(in1[i], in2[i]);
+    }
+  });
+}
+
+uint64_t
+PopCount(Word n) {
+#ifdef __GNUC__
+  return __builtin_popcountll(n);
+#else
+  n = n - ((n >> 1) & 0x5555555555555555UL);
+  n = (n & 0x3333333333333333UL) + ((n >> 2) & 0x3333333333333333UL);
+  return (((n + (n >> 4)) & 0xF0F0F0F0F0F0F0FUL) * 0x101010101010101UL) >> 56;
+#endif
+}
+
+}  // namespace
+
+void
+galois::DynamicBitset::bitwise_or(const DynamicBitset& other) {
+  Apply(this, other, [](Word a, Word b) { return a | b; });
+}
+
+void
+galois::DynamicBitset::bitwise_or(
+    const DynamicBitset& other1, const DynamicBitset& other2) {
+  Apply(this, other1, other2, [](Word a, Word b) { return a | b; });
 }
 
 void
 galois::DynamicBitset::bitwise_and(const DynamicBitset& other) {
-  assert(size() == other.size());
-  const auto& other_bitvec = other.get_vec();
-  galois::do_all(
-      galois::iterate(size_t{0}, bitvec.size()),
-      [&](size_t i) { bitvec[i] &= other_bitvec[i]; }, galois::no_stats());
+  Apply(this, other, [](Word a, Word b) { return a & b; });
 }
 
 void
 galois::DynamicBitset::bitwise_and(
     const DynamicBitset& other1, const DynamicBitset& other2) {
-  assert(size() == other1.size());
-  assert(size() == other2.size());
-  const auto& other_bitvec1 = other1.get_vec();
-  const auto& other_bitvec2 = other2.get_vec();
-
-  galois::do_all(
-      galois::iterate(size_t{0}, bitvec.size()),
-      [&](size_t i) { bitvec[i] = other_bitvec1[i] & other_bitvec2[i]; },
-      galois::no_stats());
+  Apply(this, other1, other2, [](Word a, Word b) { return a & b; });
 }
 
 void
 galois::DynamicBitset::bitwise_xor(const DynamicBitset& other) {
-  assert(size() == other.size());
-  const auto& other_bitvec = other.get_vec();
-  galois::do_all(
-      galois::iterate(size_t{0}, bitvec.size()),
-      [&](size_t i) { bitvec[i] ^= other_bitvec[i]; }, galois::no_stats());
+  Apply(this, other, [](Word a, Word b) { return a ^ b; });
 }
 
 void
 galois::DynamicBitset::bitwise_xor(
     const DynamicBitset& other1, const DynamicBitset& other2) {
-  assert(size() == other1.size());
-  assert(size() == other2.size());
-  const auto& other_bitvec1 = other1.get_vec();
-  const auto& other_bitvec2 = other2.get_vec();
+  Apply(this, other1, other2, [](Word a, Word b) { return a ^ b; });
+}
 
-  galois::do_all(
-      galois::iterate(size_t{0}, bitvec.size()),
-      [&](size_t i) { bitvec[i] = other_bitvec1[i] ^ other_bitvec2[i]; },
-      galois::no_stats());
+void
+galois::DynamicBitset::bitwise_andnot(const DynamicBitset& other) {
+  Apply(this, other, [](Word a, Word b) { return a & ~b; });
+}
+
+void
+galois::DynamicBitset::bitwise_andnot(
+    const DynamicBitset& other1, const DynamicBitset& other2) {
+  Apply(this, other1, other2, [](Word a, Word b) { return a & ~b; });
+}
+
+uint64_t
+galois::DynamicBitset::count_words(size_t begin, size_t end) const {
+  const Word* words = Words(bitvec);
+  uint64_t count = 0;
+  for (size_t i = begin; i < end; ++i) {
+    count += PopCount(words[i]);
+  }
+  return count;
 }
 
 uint64_t
 galois::DynamicBitset::count() const {
   galois::GAccumulator<uint64_t> ret;
-  galois::do_all(
-      galois::iterate(bitvec.begin(), bitvec.end()),
-      [&](uint64_t n) {
-#ifdef __GNUC__
-        ret += __builtin_popcountll(n);
-#else
-        n = n - ((n >> 1) & 0x5555555555555555UL);
-        n = (n & 0x3333333333333333UL) + ((n >> 2) & 0x3333333333333333UL);
-        ret += (((n + (n >> 4)) & 0xF0F0F0F0F0F0F0FUL) * 0x101010101010101UL) >>
-               56;
-#endif
-      },
-      galois::no_stats());
+  ForEachBlock(bitvec.size(), [&](size_t begin, size_t end) {
+    ret += count_words(begin, end);
+  });
   return ret.reduce();
 }
 
@@ -105,57 +180,40 @@ namespace {
 template <typename Integer>
 std::vector<Integer>
 GetOffsets(const galois::DynamicBitset& bitset) {
-  // TODO uint32_t is somewhat dangerous; change in the future
-  uint32_t activeThreads = galois::getActiveThreads();
-  std::vector<Integer> tPrefixBitCounts(activeThreads);
-
-  // count how many bits are set on each thread
-  galois::on_each([&](unsigned tid, unsigned nthreads) {
-    auto [start, end] =
-        galois::block_range(size_t{0}, bitset.size(), tid, nthreads);
-
-    Integer count = 0;
-    for (Integer i = start; i < end; ++i) {
-      if (bitset.test(i)) {
-        ++count;
-      }
-    }
+  const auto& bitvec = bitset.get_vec();
+  size_t num_blocks = (bitvec.size() + kBlockWords - 1) / kBlockWords;
 
-    tPrefixBitCounts[tid] = count;
-  });
-
-  // calculate prefix sum of bits per thread
-  for (uint32_t i = 1; i < activeThreads; ++i) {
-    tPrefixBitCounts[i] += tPrefixBitCounts[i - 1];
+  // count how many bits are set in each block, then scan to find where each
+  // block writes its offsets
+  std::vector<uint64_t> block_offsets(num_blocks + 1);
+  galois::do_all(
+      galois::iterate(size_t{0}, num_blocks),
+      [&](size_t block) {
+        size_t begin = block * kBlockWords;
+        block_offsets[block + 1] = bitset.count_words(
+            begin, std::min(begin + kBlockWords, bitvec.size()));
+      },
+      galois::no_stats());
+  for (size_t i = 1; i <= num_blocks; ++i) {
+    block_offsets[i] += block_offsets[i - 1];
   }
 
-  // total num of set bits
-  Integer bitsetCount = tPrefixBitCounts[activeThreads - 1];
-  std::vector<Integer> offsets;
-
-  // calculate the indices of the set bits and save them to the offset
-  // vector
-  if (bitsetCount > 0) {
-    offsets.resize(bitsetCount);
-    galois::on_each([&](unsigned tid, unsigned nthreads) {
-      auto [start, end] =
-          galois::block_range(size_t{0}, bitset.size(), tid, nthreads);
-      Integer count = 0;
-      Integer tPrefixBitCount;
-      if (tid == 0) {
-        tPrefixBitCount = 0;
-      } else {
-        tPrefixBitCount = tPrefixBitCounts[tid - 1];
-      }
-
-      for (Integer i = start; i < end; ++i) {
-        if (bitset.test(i)) {
-          offsets[tPrefixBitCount + count] = i;
-          ++count;
+  std::vector<Integer> offsets(block_offsets[num_blocks]);
+  const Word* words = Words(bitvec);
+  galois::do_all(
+      galois::iterate(size_t{0}, num_blocks),
+      [&](size_t block) {
+        size_t begin = block * kBlockWords;
+        size_t end = std::min(begin + kBlockWords, bitvec.size());
+        Integer* out = offsets.data() + block_offsets[block];
+        for (size_t word = begin; word < end; ++word) {
+          for (Word bits = words[word]; bits != 0; bits &= bits - 1) {
+            *out++ = word * galois::DynamicBitset::bits_uint64 +
+                     galois::internal::CountTrailingZeros(bits);
+          }
         }
-      }
-    });
-  }
+      },
+      galois::no_stats());
 
   return offsets;
 }
@@ -0,0 +1,215 @@
+#include "galois/graphs/DynamicTopology.h"
+
+#include <algorithm>
+
+#include "galois/ArrowInterchange.h"
+#include "galois/Bag.h"
+#include "galois/LargeArray.h"
+#include "galois/Logging.h"
+#include "galois/Loops.h"
+#include "galois/ParallelSTL.h"
+#include "galois/Reduction.h"
+
+namespace {
+
+using Edge = galois::graphs::DynamicTopology::Edge;
+
+galois::Result<void>
+CheckEndpoints(const std::vector<Edge>& batch, uint64_t num_nodes) {
+  galois::GReduceLogicalOr out_of_range;
+  galois::do_all(
+      galois::iterate(batch.begin(), batch.end()),
+      [&](const Edge& edge) {
+        if (edge.first >= num_nodes || edge.second >= num_nodes) {
+          out_of_range.update(true);
+        }
+      },
+      galois::no_stats());
+  if (out_of_range.reduce()) {
+    GALOIS_LOG_DEBUG("batch has an edge endpoint >= {}", num_nodes);
+    return galois::ErrorCode::InvalidArgument;
+  }
+  return galois::ResultSuccess();
+}
+
+/// GroupBySource sorts batch and returns the position of the first edge of
+/// each run of edges with the same source. Within a run, destinations are
+/// sorted.
+void
+GroupBySource(std::vector<Edge>* batch, galois::InsertBag<size_t>* runs) {
+  galois::ParallelSTL::sort(batch->begin(), batch->end());
+  galois::do_all(
+      galois::iterate(size_t{0}, batch->size()),
+      [&](size_t i) {
+        if (i == 0 || (*batch)[i - 1].first != (*batch)[i].first) {
+          runs->push(i);
+        }
+      },
+      galois::no_stats());
+}
+
+/// RunEnd returns one past the last position of the run starting at begin
+size_t
+RunEnd(const std::vector<Edge>& batch, size_t begin) {
+  size_t end = begin + 1;
+  while (end < batch.size() && batch[end].first == batch[begin].first) {
+    ++end;
+  }
+  return end;
+}
+
+}  // namespace
+
+galois::graphs::DynamicTopology::DynamicTopology(const GraphTopology& base)
+    : base_(base), delta_(base.num_nodes()) {}
+
+std::unique_ptr<galois::graphs::DynamicTopology>
+galois::graphs::DynamicTopology::Make(const GraphTopology& base) {
+  return std::unique_ptr<DynamicTopology>(new DynamicTopology(base));
+}
+
+galois::Result<void>
+galois::graphs::DynamicTopology::InsertEdges(std::vector<Edge> batch) {
+  if (auto r = CheckEndpoints(batch, num_nodes()); !r) {
+    return r.error();
+  }
+
+  galois::InsertBag<size_t> runs;
+  GroupBySource(&batch, &runs);
+
+  galois::do_all(
+      galois::iterate(runs),
+      [&](size_t begin) {
+        size_t end = RunEnd(batch, begin);
+        std::vector<uint32_t>& dests = delta_[batch[begin].first];
+        dests.reserve(dests.size() + end - begin);
+        for (size_t i = begin; i < end; ++i) {
+          dests.push_back(batch[i].second);
+        }
+        assert(dests.size() < (uint64_t{1} << kDeltaIndexBits));
+      },
+      galois::steal(), galois::no_stats());
+
+  num_inserted_ += batch.size();
+
+  return ResultSuccess();
+}
+
+galois::Result<void>
+galois::graphs::DynamicTopology::DeleteEdges(std::vector<Edge> batch) {
+  if (auto r = CheckEndpoints(batch, num_nodes()); !r) {
+    return r.error();
+  }
+
+  galois::InsertBag<size_t> runs;
+  GroupBySource(&batch, &runs);
+
+  if (deleted_.size() == 0) {
+    deleted_.resize(base_.num_edges());
+  }
+
+  galois::GAccumulator<uint64_t> num_deleted;
+  galois::GAccumulator<uint64_t> num_uninserted;
+
+  galois::do_all(
+      galois::iterate(runs),
+      [&](size_t begin) {
+        size_t end = RunEnd(batch, begin);
+        uint32_t src = batch[begin].first;
+        auto is_deleted = [&](uint32_t dest) {
+          return std::binary_search(
+              batch.begin() + begin, batch.begin() + end, Edge{src, dest});
+        };
+
+        auto [base_begin, base_end] = base_.edge_range(src);
+        for (auto e = base_begin; e != base_end; ++e) {
+          if (!deleted_.test(e) && is_deleted(base_.out_dests->Value(e))) {
+            deleted_.set(e);
+            num_deleted += 1;
+          }
+        }
+
+        std::vector<uint32_t>& dests = delta_[src];
+        auto it = std::remove_if(dests.begin(), dests.end(), is_deleted);
+        num_uninserted += dests.end() - it;
+        dests.erase(it, dests.end());
+      },
+      galois::steal(), galois::no_stats());
+
+  num_deleted_ += num_deleted.reduce();
+  num_inserted_ -= num_uninserted.reduce();
+
+  return ResultSuccess();
+}
+
+galois::Result<void>
+galois::graphs::DynamicTopology::Compact() {
+  if (is_compacted()) {
+    return ResultSuccess();
+  }
+
+  uint64_t num_nodes = this->num_nodes();
+
+  galois::LargeArray<uint64_t> degrees;
+  degrees.allocateBlocked(num_nodes);
+  galois::do_all(
+      galois::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t n) { degrees[n] = degree(n); }, galois::steal(),
+      galois::no_stats());
+
+  std::vector<uint64_t> out_indices(num_nodes);
+  galois::ParallelSTL::partial_sum(
+      degrees.begin(), degrees.end(), out_indices.begin());
+  assert(num_nodes == 0 || out_indices.back() == num_edges());
+
+  std::vector<uint32_t> out_dests(num_edges());
+  galois::do_all(
+      galois::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t n) {
+        uint64_t out = n > 0 ? out_indices[n - 1] : 0;
+        for (auto it = edge_begin(n), end = edge_end(n); it != end; ++it) {
+          out_dests[out++] = edge_dest(*it);
+        }
+        assert(out == out_indices[n]);
+      },
+      galois::steal(), galois::no_stats());
+
+  base_ = GraphTopology{
+      .out_indices = std::static_pointer_cast<arrow::UInt64Array>(
+          galois::BuildArray(out_indices)),
+      .out_dests = std::static_pointer_cast<arrow::UInt32Array>(
+          galois::BuildArray(out_dests)),
+  };
+
+  deleted_ = DynamicBitset{};
+  galois::do_all(
+      galois::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t n) { std::vector<uint32_t>().swap(delta_[n]); },
+      galois::no_stats());
+  num_deleted_ = 0;
+  num_inserted_ = 0;
+
+  return ResultSuccess();
+}
+
+galois::Result<void>
+galois::graphs::DynamicTopology::CompactInto(PropertyFileGraph* pfg) {
+  if (pfg->edge_schema()->num_fields() != 0) {
+    GALOIS_LOG_DEBUG(
+        "graph has {} edge properties but inserted edges have none",
+        pfg->edge_schema()->num_fields());
+    return ErrorCode::InvalidArgument;
+  }
+  if (pfg->topology().num_nodes() != num_nodes()) {
+    GALOIS_LOG_DEBUG(
+        "graph has {} nodes but topology has {}", pfg->topology().num_nodes(),
+        num_nodes());
+    return ErrorCode::InvalidArgument;
+  }
+
+  if (auto r = Compact(); !r) {
+    return r.error();
+  }
+
+  return pfg->SetTopology(base_);
+}
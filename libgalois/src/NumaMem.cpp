@@ -19,7 +19,9 @@
 
 #include "galois/substrate/NumaMem.h"
 
+#include <algorithm>
 #include <cassert>
+#include <vector>
 
 #include "galois/gIO.h"
 #include "galois/substrate/PageAlloc.h"
@@ -27,35 +29,46 @@
 
 using namespace galois::substrate;
 
+/* Write to every base page of [begin, end) so that the calling thread is the
+ * first to touch them. Touching one byte per huge page would leave the rest
+ * of the region to whoever touches it first when the mapping fell back to
+ * base pages. */
+static void
+touch(char* ptr, size_t begin, size_t end) {
+  const size_t stride = pageSize(PageKind::kBase);
+  for (size_t x = begin - begin % stride; x < end; x += stride)
+    ptr[x] = 0;
+}
+
 /* Access pages on each thread so each thread has some pages already loaded
- * (preferably ones it will use) */
+ * (preferably ones it will use). Memory is handed out in units of unit
+ * bytes; len is a multiple of unit. */
 static void
 pageIn(
-    void* _ptr, size_t len, size_t pageSize, unsigned numThreads,
+    void* _ptr, size_t len, size_t unit, unsigned numThreads,
     bool finegrained) {
   char* ptr = static_cast<char*>(_ptr);
 
   if (numThreads == 1) {
-    for (size_t x = 0; x < len; x += pageSize / 2)
-      ptr[x] = 0;
+    touch(ptr, 0, len);
   } else {
     GetThreadPool().run(
-        numThreads, [ptr, len, pageSize, numThreads, finegrained]() {
+        numThreads, [ptr, len, unit, numThreads, finegrained]() {
           auto myID = ThreadPool::getTID();
 
           if (finegrained) {
-            // round robin page distribution among threads (e.g. thread 0 gets
-            // a page, then thread 1, then thread n, then back to thread 0 and
+            // round robin unit distribution among threads (e.g. thread 0 gets
+            // a unit, then thread 1, then thread n, then back to thread 0 and
             // so on until the end of the region)
-            for (size_t x = pageSize * myID; x < len;
-                 x += pageSize * numThreads)
-              ptr[x] = 0;
+            for (size_t x = unit * myID; x < len; x += unit * numThreads)
+              touch(ptr, x, std::min(x + unit, len));
           } else {
-            // sectioned page distribution (e.g. thread 0 gets first chunk, thread
-            // 1 gets next chunk, ... last thread gets last chunk)
-            for (size_t x = myID * len / numThreads;
-                 x < len && x < (myID + 1) * len / numThreads; x += pageSize)
-              ptr[x] = 0;
+            // sectioned unit distribution (e.g. thread 0 gets first chunk,
+            // thread 1 gets next chunk, ... last thread gets last chunk)
+            size_t units = len / unit;
+            touch(
+                ptr, myID * units / numThreads * unit,
+                (myID + 1) * units / numThreads * unit);
           }
         });
   }
@@ -69,7 +82,6 @@ pageIn(
  * or uint64_t*
  * @param _ptr Pointer to the memory to page in
  * @param len Length of the memory passed in
- * @param pageSize Size of a page
  * @param numThreads Number of threads to split work amongst
  * @param threadRanges Array that specifies distribution of elements among
  * threads
@@ -79,59 +91,29 @@ pageIn(
 template <typename RangeArrayTy>
 static void
 pageInSpecified(
-    void* _ptr, size_t len, size_t pageSize, unsigned numThreads,
-    RangeArrayTy threadRanges, size_t elementSize) {
+    void* _ptr, size_t len, unsigned numThreads, RangeArrayTy threadRanges,
+    size_t elementSize) {
   assert(numThreads > 0);
   assert(elementSize > 0);
 
   char* ptr = static_cast<char*>(_ptr);
 
   if (numThreads > 1) {
-    GetThreadPool().run(
-        numThreads, [ptr, pageSize, threadRanges, elementSize]() {
-          auto myID = ThreadPool::getTID();
-
-          uint64_t beginLocation = threadRanges[myID];
-          uint64_t endLocation = threadRanges[myID + 1];
-
-          assert(beginLocation <= endLocation);
+    GetThreadPool().run(numThreads, [ptr, threadRanges, elementSize]() {
+      auto myID = ThreadPool::getTID();
 
-          // printf("[%u] begin location %u and end location
-          // %u\n", myID,
-          //       beginLocation, endLocation);
+      uint64_t beginLocation = threadRanges[myID];
+      uint64_t endLocation = threadRanges[myID + 1];
 
-          // if equal, then no memory needed to allocate in
-          // first place
-          if (beginLocation != endLocation) {
-            size_t beginByte = beginLocation * elementSize;
-            // -1 since endLocation * elementSize will result in the first
-            // byte of the next element.
-            size_t endByte = endLocation ? (endLocation * elementSize) - 1 : 0;
+      assert(beginLocation <= endLocation);
 
-            assert(beginByte <= endByte);
-
-            // memset(ptr + beginByte, 0, (endByte - beginByte +
-            // 1));
-
-            uint32_t beginPage = beginByte / pageSize;
-            uint32_t endPage = endByte / pageSize;
-
-            assert(beginPage <= endPage);
-
-            // printf("thread %u gets begin page %u and end page
-            // %u\n", myID,
-            //        beginPage, endPage);
-
-            // write a byte to every page this thread occupies
-            for (uint32_t i = beginPage; i <= endPage; i++) {
-              ptr[i * pageSize] = 0;
-            }
-          }
-        });
+      // write a byte to every page this thread occupies; if equal, then no
+      // memory needed to allocate in first place
+      touch(ptr, beginLocation * elementSize, endLocation * elementSize);
+    });
   } else {
     // 1 thread case
-    for (size_t x = 0; x < len; x += pageSize / 2)
-      ptr[x] = 0;
+    touch(ptr, 0, len);
   }
 }
 
@@ -140,8 +122,21 @@ largeFree(void* ptr, size_t bytes) {
   freePages(ptr, bytes / allocSize());
 }
 
+/* Charge sign * f.bytes to memory accounting as described by f */
+static void
+account(const internal::largeFreer& f, int64_t sign) {
+  int64_t on_sockets = 0;
+  for (size_t socket = 0; socket < f.socket_bytes.size(); ++socket) {
+    galois::AccountMemory(f.category, sign * f.socket_bytes[socket], socket);
+    on_sockets += f.socket_bytes[socket];
+  }
+  galois::AccountMemory(
+      f.category, sign * (static_cast<int64_t>(f.bytes) - on_sockets));
+}
+
 void
 galois::substrate::internal::largeFreer::operator()(void* ptr) const {
+  account(*this, -1);
   largeFree(ptr, bytes);
 }
 
@@ -155,11 +150,56 @@ roundup(size_t data, size_t mult) {
   return data + (mult - rem);
 }
 
-LAptr
-galois::substrate::largeMallocInterleaved(size_t bytes, unsigned numThreads) {
-  // round up to hugePageSize
-  bytes = roundup(bytes, allocSize());
+/* Map bytes backed by pages of kind pages, rounding bytes up to whole pages.
+ * Sets unit to the granularity at which the mapping can be placed: a huge
+ * page, or a 1G page if those were obtained. */
+static void*
+mapPages(size_t& bytes, bool preFault, PageKind pages, size_t& unit) {
+  const size_t gigaPage = pageSize(PageKind::kHuge1G);
+  if (pages == PageKind::kHuge1G && bytes < gigaPage)
+    pages = PageKind::kHuge2M;
+  bytes = roundup(bytes, pages == PageKind::kHuge1G ? gigaPage : allocSize());
+
+  PageKind obtained = pages;
+  void* data = allocPages(bytes / allocSize(), preFault, pages, &obtained);
+  unit = std::max(allocSize(), pageSize(obtained));
+  return data;
+}
+
+/* Wrap a new mapping of bytes that the threads [0, numThreads) faulted in,
+ * charging it to the current category of the calling thread. Bytes are
+ * charged to sockets in proportion to the number of those threads on them,
+ * which is what both interleaved and blocked paging amount to up to a unit
+ * per thread. A mapping that was not faulted in (numThreads == 0) is charged
+ * to no socket. */
+static LAptr
+makeLAptr(void* data, size_t bytes, unsigned numThreads) {
+  internal::largeFreer f{
+      bytes, galois::CurrentMemoryCategory(galois::MemoryCategory::kUser), {}};
+  if (!data)
+    return LAptr{data, f};
 
+  if (numThreads == 1) {
+    f.socket_bytes.resize(ThreadPool::getSocket() + 1);
+    f.socket_bytes.back() = bytes;
+  } else if (numThreads > 1) {
+    const ThreadPool& pool = GetThreadPool();
+    f.socket_bytes.resize(pool.getMaxSockets());
+    for (unsigned tid = 0; tid < numThreads; ++tid) {
+      unsigned socket =
+          std::min<size_t>(pool.getSocket(tid), f.socket_bytes.size() - 1);
+      f.socket_bytes[socket] += 1;
+    }
+    for (int64_t& b : f.socket_bytes)
+      b = bytes * b / numThreads;
+  }
+  account(f, 1);
+  return LAptr{data, std::move(f)};
+}
+
+LAptr
+galois::substrate::largeMallocInterleaved(
+    size_t bytes, unsigned numThreads, PageKind pages) {
 #ifdef GALOIS_USE_NUMA
   // We don't use numa_alloc_interleaved_subset because we really want huge
   // pages
@@ -167,44 +207,43 @@ galois::substrate::largeMallocInterleaved(size_t bytes, unsigned numThreads) {
   // the alloc would go
 #endif
   // Get a non-prefaulted allocation
-  void* data = allocPages(bytes / allocSize(), false);
+  size_t unit;
+  void* data = mapPages(bytes, false, pages, unit);
 
   // Then page in based on thread number
   if (data)
     // true = round robin paging
-    pageIn(data, bytes, allocSize(), numThreads, true);
+    pageIn(data, bytes, unit, numThreads, true);
 
-  return LAptr{data, internal::largeFreer{bytes}};
+  return makeLAptr(data, bytes, numThreads);
 }
 
 LAptr
-galois::substrate::largeMallocLocal(size_t bytes) {
-  // round up to hugePageSize
-  bytes = roundup(bytes, allocSize());
+galois::substrate::largeMallocLocal(size_t bytes, PageKind pages) {
   // Get a prefaulted allocation
-  return LAptr{
-      allocPages(bytes / allocSize(), true), internal::largeFreer{bytes}};
+  size_t unit;
+  void* data = mapPages(bytes, true, pages, unit);
+  return makeLAptr(data, bytes, 1);
 }
 
 LAptr
-galois::substrate::largeMallocFloating(size_t bytes) {
-  // round up to hugePageSize
-  bytes = roundup(bytes, allocSize());
+galois::substrate::largeMallocFloating(size_t bytes, PageKind pages) {
   // Get a non-prefaulted allocation
-  return LAptr{
-      allocPages(bytes / allocSize(), false), internal::largeFreer{bytes}};
+  size_t unit;
+  void* data = mapPages(bytes, false, pages, unit);
+  return makeLAptr(data, bytes, 0);
 }
 
 LAptr
-galois::substrate::largeMallocBlocked(size_t bytes, unsigned numThreads) {
-  // round up to hugePageSize
-  bytes = roundup(bytes, allocSize());
+galois::substrate::largeMallocBlocked(
+    size_t bytes, unsigned numThreads, PageKind pages) {
   // Get a non-prefaulted allocation
-  void* data = allocPages(bytes / allocSize(), false);
+  size_t unit;
+  void* data = mapPages(bytes, false, pages, unit);
   if (data)
     // false = blocked paging
-    pageIn(data, bytes, allocSize(), numThreads, false);
-  return LAptr{data, internal::largeFreer{bytes}};
+    pageIn(data, bytes, unit, numThreads, false);
+  return makeLAptr(data, bytes, numThreads);
 }
 
 /**
@@ -218,32 +257,31 @@ galois::substrate::largeMallocBlocked(size_t bytes, unsigned numThreads) {
  * @param threadRanges Array specifying distribution of elements among threads
  * @param elementSize Size of a data element that will be stored in the
  * allocated memory
+ * @param pages Kind of pages to back the allocation with
  * @returns The allocated memory along with a freer object
  */
 template <typename RangeArrayTy>
 LAptr
 galois::substrate::largeMallocSpecified(
     size_t bytes, uint32_t numThreads, RangeArrayTy& threadRanges,
-    size_t elementSize) {
-  // ceiling to nearest page
-  bytes = roundup(bytes, allocSize());
-
-  void* data = allocPages(bytes / allocSize(), false);
+    size_t elementSize, PageKind pages) {
+  size_t unit;
+  void* data = mapPages(bytes, false, pages, unit);
 
   // NUMA aware page in based on element distribution specified in threadRanges
   if (data)
-    pageInSpecified(
-        data, bytes, allocSize(), numThreads, threadRanges, elementSize);
+    pageInSpecified(data, bytes, numThreads, threadRanges, elementSize);
 
-  return LAptr{data, internal::largeFreer{bytes}};
+  // Charged as if blocked, since the ranges are usually balanced
+  return makeLAptr(data, bytes, numThreads);
 }
 // Explicit template declarations since the template is defined in the .h
 // file
 template LAptr GALOIS_EXPORT
 galois::substrate::largeMallocSpecified<std::vector<uint32_t>>(
     size_t bytes, uint32_t numThreads, std::vector<uint32_t>& threadRanges,
-    size_t elementSize);
+    size_t elementSize, PageKind pages);
 template LAptr GALOIS_EXPORT
 galois::substrate::largeMallocSpecified<std::vector<uint64_t>>(
     size_t bytes, uint32_t numThreads, std::vector<uint64_t>& threadRanges,
-    size_t elementSize);
+    size_t elementSize, PageKind pages);
@@ -0,0 +1,378 @@
+#include "galois/NumaMemoryPool.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+#include "galois/Env.h"
+#include "galois/Logging.h"
+#include "galois/MemoryAccounting.h"
+#include "galois/Statistics.h"
+#include "galois/Threads.h"
+#include "galois/substrate/HWTopo.h"
+#include "galois/substrate/NumaMem.h"
+#include "galois/substrate/PageAlloc.h"
+#include "galois/substrate/ThreadPool.h"
+
+namespace {
+
+/// Arrow requires buffers aligned to 64 bytes
+constexpr int64_t kAlignment = 64;
+
+/// Returned for zero-size allocations, as arrow's own pools do
+alignas(kAlignment) uint8_t zero_size_area[1];
+
+/// Small buffers are preceded by a header of kAlignment bytes that records
+/// the socket and memory category they were counted on
+struct SmallHeader {
+  unsigned socket;
+  galois::MemoryCategory category;
+};
+
+/// Forwards to arrow::default_memory_pool(), charging each buffer to the
+/// current memory category of the allocating thread, kProperties by default,
+/// on the socket of that thread. Buffers are preceded by a SmallHeader, so
+/// the totals of the pool include kAlignment bytes per buffer.
+class AccountedDefaultPool : public arrow::MemoryPool {
+public:
+  arrow::Status Allocate(int64_t size, uint8_t** out) override {
+    if (size < 0) {
+      return arrow::Status::Invalid("negative malloc size");
+    }
+    if (size == 0) {
+      *out = zero_size_area;
+      return arrow::Status::OK();
+    }
+    uint8_t* base = nullptr;
+    ARROW_RETURN_NOT_OK(pool()->Allocate(size + kAlignment, &base));
+    auto* header = reinterpret_cast<SmallHeader*>(base);
+    header->socket = galois::substrate::ThreadPool::getSocket();
+    header->category =
+        galois::CurrentMemoryCategory(galois::MemoryCategory::kProperties);
+    galois::AccountMemory(header->category, size, header->socket);
+    *out = base + kAlignment;
+    return arrow::Status::OK();
+  }
+
+  arrow::Status Reallocate(
+      int64_t old_size, int64_t new_size, uint8_t** ptr) override {
+    if (*ptr == zero_size_area || new_size == 0) {
+      uint8_t* fresh = nullptr;
+      ARROW_RETURN_NOT_OK(Allocate(new_size, &fresh));
+      Free(*ptr, old_size);
+      *ptr = fresh;
+      return arrow::Status::OK();
+    }
+    uint8_t* base = *ptr - kAlignment;
+    ARROW_RETURN_NOT_OK(pool()->Reallocate(
+        old_size + kAlignment, new_size + kAlignment, &base));
+    const auto* header = reinterpret_cast<const SmallHeader*>(base);
+    galois::AccountMemory(
+        header->category, new_size - old_size, header->socket);
+    *ptr = base + kAlignment;
+    return arrow::Status::OK();
+  }
+
+  void Free(uint8_t* buffer, int64_t size) override {
+    if (buffer == zero_size_area) {
+      return;
+    }
+    uint8_t* base = buffer - kAlignment;
+    const auto* header = reinterpret_cast<const SmallHeader*>(base);
+    galois::AccountMemory(header->category, -size, header->socket);
+    pool()->Free(base, size + kAlignment);
+  }
+
+  int64_t bytes_allocated() const override { return pool()->bytes_allocated(); }
+  int64_t max_memory() const override { return pool()->max_memory(); }
+  std::string backend_name() const override { return pool()->backend_name(); }
+
+private:
+  static arrow::MemoryPool* pool() { return arrow::default_memory_pool(); }
+};
+
+int64_t
+PageSize() {
+  return galois::substrate::allocSize();
+}
+
+int64_t
+RoundToPages(int64_t size) {
+  return (size + PageSize() - 1) / PageSize() * PageSize();
+}
+
+std::atomic<arrow::MemoryPool*> property_pool{nullptr};
+
+arrow::MemoryPool*
+AccountedDefaultPoolInstance() {
+  // Never destroyed, since arrow buffers may be freed during static
+  // destruction
+  static arrow::MemoryPool* pool = new AccountedDefaultPool();
+  return pool;
+}
+
+arrow::MemoryPool*
+DefaultPropertyPool() {
+  static arrow::MemoryPool* pool = [] {
+    std::string placement;
+    if (!galois::GetEnv("GALOIS_PROPERTY_PLACEMENT", &placement)) {
+      return AccountedDefaultPoolInstance();
+    }
+    if (placement == "local") {
+      return static_cast<arrow::MemoryPool*>(
+          galois::GetNumaMemoryPool(galois::NumaPlacement::kLocal));
+    }
+    if (placement == "interleaved") {
+      return static_cast<arrow::MemoryPool*>(
+          galois::GetNumaMemoryPool(galois::NumaPlacement::kInterleaved));
+    }
+    if (placement == "blocked") {
+      return static_cast<arrow::MemoryPool*>(
+          galois::GetNumaMemoryPool(galois::NumaPlacement::kBlocked));
+    }
+    GALOIS_LOG_WARN(
+        "unknown GALOIS_PROPERTY_PLACEMENT {}; using the default pool",
+        placement);
+    return AccountedDefaultPoolInstance();
+  }();
+  return pool;
+}
+
+}  // namespace
+
+galois::NumaMemoryPool::NumaMemoryPool(NumaPlacement placement)
+    : placement_(placement),
+      socket_bytes_(std::max(
+          substrate::getHWTopo().machineTopoInfo.maxSockets, 1u)) {}
+
+galois::NumaMemoryPool::~NumaMemoryPool() = default;
+
+galois::NumaMemoryPool::SocketSplit
+galois::NumaMemoryPool::Split(int64_t size, NumaPlacement placement) const {
+  SocketSplit split(socket_bytes_.size());
+  auto add = [&](unsigned socket, int64_t bytes) {
+    split[std::min<size_t>(socket, split.size() - 1)] += bytes;
+  };
+
+  unsigned threads = getActiveThreads();
+  if (placement == NumaPlacement::kLocal || threads == 1) {
+    add(substrate::ThreadPool::getSocket(), size);
+    return split;
+  }
+
+  // Mirror how substrate::largeMalloc* fault pages in: page p is touched by
+  // thread p % threads when interleaving, and thread t touches pages
+  // [t * pages / threads, (t + 1) * pages / threads) when blocking
+  const substrate::ThreadPool& pool = substrate::GetThreadPool();
+  int64_t page_size = PageSize();
+  int64_t num_pages = RoundToPages(size) / page_size;
+  auto bytes_of = [&](int64_t page) {
+    return std::min(page_size, size - page * page_size);
+  };
+  if (placement == NumaPlacement::kInterleaved) {
+    for (int64_t page = 0; page < num_pages; ++page) {
+      add(pool.getSocket(page % threads), bytes_of(page));
+    }
+    return split;
+  }
+  for (unsigned tid = 0; tid < threads; ++tid) {
+    for (int64_t page = tid * num_pages / threads,
+                 end = (tid + 1) * num_pages / threads;
+         page < end; ++page) {
+      add(pool.getSocket(tid), bytes_of(page));
+    }
+  }
+  return split;
+}
+
+void
+galois::NumaMemoryPool::Account(int64_t bytes) {
+  int64_t now =
+      bytes_allocated_.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+  int64_t max = max_memory_.load(std::memory_order_relaxed);
+  while (now > max && !max_memory_.compare_exchange_weak(
+                          max, now, std::memory_order_relaxed)) {
+  }
+}
+
+void
+galois::NumaMemoryPool::AccountSplit(const SocketSplit& split, int64_t sign) {
+  for (size_t socket = 0; socket < split.size(); ++socket) {
+    if (split[socket]) {
+      socket_bytes_[socket].fetch_add(
+          sign * split[socket], std::memory_order_relaxed);
+    }
+  }
+}
+
+arrow::Status
+galois::NumaMemoryPool::Allocate(int64_t size, uint8_t** out) {
+  if (size < 0) {
+    return arrow::Status::Invalid("negative malloc size");
+  }
+  if (size == 0) {
+    *out = zero_size_area;
+    return arrow::Status::OK();
+  }
+
+  if (size < PageSize()) {
+    void* base = nullptr;
+    if (posix_memalign(&base, kAlignment, size + kAlignment) != 0) {
+      return arrow::Status::OutOfMemory("malloc of size ", size, " failed");
+    }
+    unsigned socket = std::min<size_t>(
+        substrate::ThreadPool::getSocket(), socket_bytes_.size() - 1);
+    auto* header = static_cast<SmallHeader*>(base);
+    header->socket = socket;
+    header->category = CurrentMemoryCategory(MemoryCategory::kProperties);
+    socket_bytes_[socket].fetch_add(size, std::memory_order_relaxed);
+    AccountMemory(header->category, size, socket);
+    Account(size);
+    *out = static_cast<uint8_t*>(base) + kAlignment;
+    return arrow::Status::OK();
+  }
+
+  // Threads cannot be recruited to fault pages in from inside a parallel
+  // loop, so fall back to the socket of the allocating thread
+  NumaPlacement placement = substrate::GetThreadPool().isRunning()
+                                ? NumaPlacement::kLocal
+                                : placement_;
+  // Split places pages in units of substrate::allocSize(), so buffers are
+  // never backed by 1G pages
+  substrate::PageKind pages = substrate::defaultPageKind();
+  if (pages == substrate::PageKind::kHuge1G) {
+    pages = substrate::PageKind::kHuge2M;
+  }
+  // The mapping is charged to memory accounting by substrate::largeMalloc*
+  MemoryCategoryScope scope(
+      CurrentMemoryCategory(MemoryCategory::kProperties));
+  substrate::LAptr ptr;
+  switch (placement) {
+  case NumaPlacement::kLocal:
+    ptr = substrate::largeMallocLocal(size, pages);
+    break;
+  case NumaPlacement::kInterleaved:
+    ptr = substrate::largeMallocInterleaved(size, getActiveThreads(), pages);
+    break;
+  case NumaPlacement::kBlocked:
+    ptr = substrate::largeMallocBlocked(size, getActiveThreads(), pages);
+    break;
+  }
+  if (!ptr) {
+    return arrow::Status::OutOfMemory("malloc of size ", size, " failed");
+  }
+
+  SocketSplit split = Split(size, placement);
+  AccountSplit(split, 1);
+  Account(size);
+  substrate::internal::largeFreer freer = ptr.get_deleter();
+  *out = static_cast<uint8_t*>(ptr.release());
+  std::lock_guard<std::mutex> lock(mutex_);
+  placed_.emplace(*out, Placed{std::move(split), std::move(freer)});
+  return arrow::Status::OK();
+}
+
+arrow::Status
+galois::NumaMemoryPool::Reallocate(
+    int64_t old_size, int64_t new_size, uint8_t** ptr) {
+  uint8_t* fresh = nullptr;
+  ARROW_RETURN_NOT_OK(Allocate(new_size, &fresh));
+  std::memcpy(fresh, *ptr, std::min(old_size, new_size));
+  Free(*ptr, old_size);
+  *ptr = fresh;
+  return arrow::Status::OK();
+}
+
+void
+galois::NumaMemoryPool::Free(uint8_t* buffer, int64_t size) {
+  if (buffer == zero_size_area) {
+    return;
+  }
+
+  if (size < PageSize()) {
+    uint8_t* base = buffer - kAlignment;
+    const auto* header = reinterpret_cast<SmallHeader*>(base);
+    socket_bytes_[header->socket].fetch_sub(size, std::memory_order_relaxed);
+    AccountMemory(header->category, -size, header->socket);
+    Account(-size);
+    free(base);
+    return;
+  }
+
+  Placed placed;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = placed_.find(buffer);
+    GALOIS_LOG_VASSERT(it != placed_.end(), "freeing unknown buffer");
+    placed = std::move(it->second);
+    placed_.erase(it);
+  }
+  AccountSplit(placed.split, -1);
+  Account(-size);
+  placed.freer(buffer);
+}
+
+int64_t
+galois::NumaMemoryPool::bytes_allocated() const {
+  return bytes_allocated_.load(std::memory_order_relaxed);
+}
+
+int64_t
+galois::NumaMemoryPool::max_memory() const {
+  return max_memory_.load(std::memory_order_relaxed);
+}
+
+std::string
+galois::NumaMemoryPool::backend_name() const {
+  switch (placement_) {
+  case NumaPlacement::kLocal:
+    return "galois-numa-local";
+  case NumaPlacement::kInterleaved:
+    return "galois-numa-interleaved";
+  case NumaPlacement::kBlocked:
+    return "galois-numa-blocked";
+  }
+  return "galois-numa";
+}
+
+std::vector<int64_t>
+galois::NumaMemoryPool::socket_bytes() const {
+  std::vector<int64_t> bytes(socket_bytes_.size());
+  for (size_t i = 0; i < bytes.size(); ++i) {
+    bytes[i] = socket_bytes_[i].load(std::memory_order_relaxed);
+  }
+  return bytes;
+}
+
+void
+galois::NumaMemoryPool::ReportStats(const std::string& region) const {
+  ReportStatSingle(region, "BytesAllocated", bytes_allocated());
+  ReportStatSingle(region, "MaxBytes", max_memory());
+  std::vector<int64_t> bytes = socket_bytes();
+  for (size_t i = 0; i < bytes.size(); ++i) {
+    ReportStatSingle(region, "Socket" + std::to_string(i) + "Bytes", bytes[i]);
+  }
+}
+
+galois::NumaMemoryPool*
+galois::GetNumaMemoryPool(NumaPlacement placement) {
+  // Never destroyed, since arrow buffers may be freed during static
+  // destruction
+  static NumaMemoryPool* pools[] = {
+      new NumaMemoryPool(NumaPlacement::kLocal),
+      new NumaMemoryPool(NumaPlacement::kInterleaved),
+      new NumaMemoryPool(NumaPlacement::kBlocked),
+  };
+  return pools[static_cast<int>(placement)];
+}
+
+arrow::MemoryPool*
+galois::GetPropertyMemoryPool() {
+  arrow::MemoryPool* pool = property_pool.load(std::memory_order_acquire);
+  return pool ? pool : DefaultPropertyPool();
+}
+
+void
+galois::SetPropertyMemoryPool(arrow::MemoryPool* pool) {
+  property_pool.store(pool, std::memory_order_release);
+}
@@ -19,8 +19,13 @@
 
 #include "galois/substrate/PageAlloc.h"
 
+#include <unistd.h>
+
+#include <cstdint>
 #include <mutex>
+#include <string>
 
+#include "galois/Env.h"
 #include "galois/Logging.h"
 #include "galois/substrate/SimpleLock.h"
 
@@ -31,6 +36,7 @@
 
 // figure this out dynamically
 const size_t hugePageSize = 2 * 1024 * 1024;
+const size_t gigaPageSize = 1024 * 1024 * 1024;
 // protect mmap, munmap since linux has issues
 static galois::substrate::SimpleLock allocLock;
 
@@ -45,6 +51,14 @@ trymmap(size_t size, int flag) {
   return ptr;
 }
 
+static void
+trymunmap(void* ptr, size_t size) {
+  std::lock_guard<galois::substrate::SimpleLock> lg(allocLock);
+  if (munmap(ptr, size) != 0) {
+    GALOIS_LOG_FATAL("munmap failed: {}", errno);
+  }
+}
+
 // mmap flags
 #if defined(MAP_ANONYMOUS)
 static const int _MAP_ANON = MAP_ANONYMOUS;
@@ -57,55 +71,173 @@ static_assert(false, "No Anonymous mapping");
 static const int _MAP = _MAP_ANON | MAP_PRIVATE;
 #ifdef MAP_POPULATE
 static const int _MAP_POP = MAP_POPULATE | _MAP;
-static const bool doHandMap = false;
 #else
 static const int _MAP_POP = _MAP;
-static const bool doHandMap = true;
 #endif
 #ifdef MAP_HUGETLB
+static const bool haveHugeTLB = true;
 static const int _MAP_HUGE_POP = MAP_HUGETLB | _MAP_POP;
 static const int _MAP_HUGE = MAP_HUGETLB | _MAP;
 #else
+static const bool haveHugeTLB = false;
 static const int _MAP_HUGE_POP = _MAP_POP;
 static const int _MAP_HUGE = _MAP;
 #endif
+// select the hugetlbfs page size rather than the system default
+#ifdef MAP_HUGE_2MB
+static const int _MAP_HUGE_2MB = MAP_HUGE_2MB;
+#else
+static const int _MAP_HUGE_2MB = 0;
+#endif
+#ifdef MAP_HUGE_1GB
+static const bool haveGigaPages = haveHugeTLB;
+static const int _MAP_HUGE_1GB = MAP_HUGE_1GB;
+#else
+static const bool haveGigaPages = false;
+static const int _MAP_HUGE_1GB = 0;
+#endif
+
+// Map size bytes of base pages, aligned to a huge page so that transparent
+// huge pages can back all of it
+static void*
+mapBase(size_t size, bool preFault, bool transparent) {
+  char* raw = static_cast<char*>(trymmap(size + hugePageSize, _MAP));
+  if (!raw) {
+    return nullptr;
+  }
+  uintptr_t addr = reinterpret_cast<uintptr_t>(raw);
+  char* ptr = raw + (hugePageSize - addr % hugePageSize) % hugePageSize;
+  if (ptr != raw) {
+    trymunmap(raw, ptr - raw);
+  }
+  if (ptr + size != raw + size + hugePageSize) {
+    trymunmap(ptr + size, raw + size + hugePageSize - (ptr + size));
+  }
+
+#if defined(MADV_HUGEPAGE) && defined(MADV_NOHUGEPAGE)
+  // Advice is best effort; without THP support the mapping simply keeps
+  // base pages
+  madvise(ptr, size, transparent ? MADV_HUGEPAGE : MADV_NOHUGEPAGE);
+#else
+  (void)transparent;
+#endif
+
+  if (preFault) {
+#ifdef MADV_POPULATE_WRITE
+    if (madvise(ptr, size, MADV_POPULATE_WRITE) == 0) {
+      return ptr;
+    }
+#endif
+    // Fault in after the advice so that the pages respect it
+    size_t stride = galois::substrate::pageSize(
+        galois::substrate::PageKind::kBase);
+    for (size_t x = 0; x < size; x += stride) {
+      ptr[x] = 0;
+    }
+  }
+  return ptr;
+}
 
 size_t
 galois::substrate::allocSize() {
   return hugePageSize;
 }
 
+size_t
+galois::substrate::pageSize(PageKind kind) {
+  static const size_t basePageSize = sysconf(_SC_PAGESIZE);
+  switch (kind) {
+  case PageKind::kBase:
+    return basePageSize;
+  case PageKind::kTransparent:
+  case PageKind::kHuge2M:
+    return hugePageSize;
+  case PageKind::kHuge1G:
+    return gigaPageSize;
+  }
+  return basePageSize;
+}
+
+galois::substrate::PageKind
+galois::substrate::defaultPageKind() {
+  static const PageKind kind = [] {
+    std::string name;
+    if (!GetEnv("GALOIS_HUGE_PAGES", &name)) {
+      return PageKind::kHuge2M;
+    }
+    if (name == "base") {
+      return PageKind::kBase;
+    }
+    if (name == "transparent") {
+      return PageKind::kTransparent;
+    }
+    if (name == "2M") {
+      return PageKind::kHuge2M;
+    }
+    if (name == "1G") {
+      return PageKind::kHuge1G;
+    }
+    GALOIS_LOG_WARN("unknown GALOIS_HUGE_PAGES {}; using 2M pages", name);
+    return PageKind::kHuge2M;
+  }();
+  return kind;
+}
+
 void*
 galois::substrate::allocPages(unsigned num, bool preFault) {
+  return allocPages(num, preFault, PageKind::kHuge2M);
+}
+
+void*
+galois::substrate::allocPages(
+    unsigned num, bool preFault, PageKind kind, PageKind* obtained) {
   if (num == 0) {
     return nullptr;
   }
 
-  void* ptr = trymmap(num * hugePageSize, preFault ? _MAP_HUGE_POP : _MAP_HUGE);
-  if (!ptr) {
+  const size_t size = num * hugePageSize;
+  void* ptr = nullptr;
+
+  if (kind == PageKind::kHuge1G) {
+    if (haveGigaPages && size % gigaPageSize == 0) {
+      ptr = trymmap(
+          size, (preFault ? _MAP_HUGE_POP : _MAP_HUGE) | _MAP_HUGE_1GB);
+    }
+    if (!ptr) {
+      GALOIS_WARN_ONCE("1G page alloc failed, falling back to 2M pages");
+      kind = PageKind::kHuge2M;
+    }
+  }
+
+  if (kind == PageKind::kHuge2M) {
+    if (haveHugeTLB) {
+      ptr = trymmap(
+          size, (preFault ? _MAP_HUGE_POP : _MAP_HUGE) | _MAP_HUGE_2MB);
+    }
+    if (!ptr) {
 #ifndef NDEBUG
-    GALOIS_WARN_ONCE("huge page alloc failed, falling back to regular pages");
+      GALOIS_WARN_ONCE(
+          "huge page alloc failed, falling back to transparent huge pages");
 #endif
-    ptr = trymmap(num * hugePageSize, preFault ? _MAP_POP : _MAP);
+      kind = PageKind::kTransparent;
+    }
   }
 
   if (!ptr) {
-    GALOIS_LOG_FATAL("failed to allocate: {}", errno);
+    ptr = mapBase(size, preFault, kind == PageKind::kTransparent);
   }
 
-  if (preFault && doHandMap) {
-    for (size_t x = 0; x < num * hugePageSize; x += 4096) {
-      static_cast<char*>(ptr)[x] = 0;
-    }
+  if (!ptr) {
+    GALOIS_LOG_FATAL("failed to allocate: {}", errno);
   }
 
+  if (obtained) {
+    *obtained = kind;
+  }
   return ptr;
 }
 
 void
 galois::substrate::freePages(void* ptr, unsigned num) {
-  std::lock_guard<SimpleLock> lg(allocLock);
-  if (munmap(ptr, num * hugePageSize) != 0) {
-    GALOIS_LOG_FATAL("munmap failed: {}", errno);
-  }
+  trymunmap(ptr, num * hugePageSize);
 }
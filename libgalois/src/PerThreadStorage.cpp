@@ -19,9 +19,12 @@
 
 #include "galois/substrate/PerThreadStorage.h"
 
+#include <algorithm>
 #include <atomic>
 #include <mutex>
 
+#include "galois/Env.h"
+#include "galois/Logging.h"
 #include "galois/gIO.h"
 #include "galois/substrate/PageAlloc.h"
 
@@ -204,3 +207,52 @@ galois::substrate::initPTS(unsigned maxT) {
     pssBase = getPPSBackend().initPerSocket(maxT);
   }
 }
+
+bool
+galois::substrate::SharingAuditEnabled() {
+  static const bool enabled = GetEnv("GALOIS_AUDIT_SHARING");
+  return enabled;
+}
+
+std::vector<uintptr_t>
+galois::substrate::FindSharedCacheLines(
+    const std::vector<std::vector<MemoryRange>>& ranges) {
+  // (line, thread) for every cache line that every range touches
+  std::vector<std::pair<uintptr_t, unsigned>> touched;
+  for (unsigned t = 0; t < ranges.size(); ++t) {
+    for (const auto& [ptr, size] : ranges[t]) {
+      if (size == 0) {
+        continue;
+      }
+      uintptr_t begin = reinterpret_cast<uintptr_t>(ptr);
+      uintptr_t first = begin / GALOIS_CACHE_LINE_SIZE;
+      uintptr_t last = (begin + size - 1) / GALOIS_CACHE_LINE_SIZE;
+      for (uintptr_t line = first; line <= last; ++line) {
+        touched.emplace_back(line, t);
+      }
+    }
+  }
+  std::sort(touched.begin(), touched.end());
+
+  std::vector<uintptr_t> shared;
+  for (size_t i = 1; i < touched.size(); ++i) {
+    auto [line, t] = touched[i];
+    if (line == touched[i - 1].first && t != touched[i - 1].second &&
+        (shared.empty() || shared.back() != line * GALOIS_CACHE_LINE_SIZE)) {
+      shared.emplace_back(line * GALOIS_CACHE_LINE_SIZE);
+    }
+  }
+  return shared;
+}
+
+void
+galois::substrate::ReportSharedCacheLines(
+    const char* type_name, const std::vector<uintptr_t>& lines) {
+  if (lines.empty()) {
+    return;
+  }
+  GALOIS_LOG_WARN(
+      "PerThreadStorage<{}>: objects of different threads share {} cache "
+      "lines, the first at {:#x}",
+      type_name, lines.size(), lines.front());
+}
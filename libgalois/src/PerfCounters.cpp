@@ -0,0 +1,180 @@
+#include "galois/PerfCounters.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+
+#include "galois/Env.h"
+#include "galois/Logging.h"
+#include "galois/Statistics.h"
+
+namespace {
+
+constexpr size_t kNumEvents = galois::PerfCounts::kNumEvents;
+
+constexpr const char* kEventNames[kNumEvents] = {
+    "HwCycles", "HwInstructions", "HwLLCMisses", "HwDTLBMisses",
+    "HwBranchMisses"};
+
+/// Set to false the first time the kernel refuses to count
+std::atomic<bool> available{true};
+
+#ifdef __linux__
+
+constexpr uint64_t
+CacheEvent(uint64_t cache) {
+  return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+         (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+}
+
+constexpr struct {
+  uint32_t type;
+  uint64_t config;
+} kEvents[kNumEvents] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HW_CACHE, CacheEvent(PERF_COUNT_HW_CACHE_LL)},
+    {PERF_TYPE_HW_CACHE, CacheEvent(PERF_COUNT_HW_CACHE_DTLB)},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+};
+
+/// Counters of one thread. All events are opened as one group so that the
+/// kernel schedules them together and one read returns all of them.
+class ThreadCounters {
+  int leader_{-1};
+  std::array<int, kNumEvents> fds_;
+  /// Position of each event in the group or -1 if it is not counted
+  std::array<int, kNumEvents> slots_;
+  bool opened_{false};
+
+  void Open() {
+    opened_ = true;
+    fds_.fill(-1);
+    slots_.fill(-1);
+
+    int num_slots = 0;
+    int first_errno = 0;
+    for (size_t i = 0; i < kNumEvents; ++i) {
+      perf_event_attr attr;
+      std::memset(&attr, 0, sizeof(attr));
+      attr.size = sizeof(attr);
+      attr.type = kEvents[i].type;
+      attr.config = kEvents[i].config;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED |
+                         PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+      int fd = syscall(SYS_perf_event_open, &attr, 0, -1, leader_, 0);
+      if (fd < 0) {
+        // Unsupported events (ENOENT, EOPNOTSUPP) are skipped
+        if (!first_errno) {
+          first_errno = errno;
+        }
+        continue;
+      }
+      if (leader_ < 0) {
+        leader_ = fd;
+      }
+      fds_[i] = fd;
+      slots_[i] = num_slots++;
+    }
+
+    if (leader_ < 0) {
+      available = false;
+      GALOIS_WARN_ONCE(
+          "hardware counters unavailable, not counting: {}",
+          std::strerror(first_errno));
+    }
+  }
+
+public:
+  ThreadCounters() = default;
+  ThreadCounters(const ThreadCounters&) = delete;
+  ThreadCounters& operator=(const ThreadCounters&) = delete;
+
+  ~ThreadCounters() {
+    for (int fd : fds_) {
+      if (opened_ && fd >= 0) {
+        close(fd);
+      }
+    }
+  }
+
+  bool Read(galois::PerfCounts* counts) {
+    if (!opened_) {
+      Open();
+    }
+    if (leader_ < 0) {
+      return false;
+    }
+
+    // Layout of a group read: nr, time_enabled, time_running, values[nr]
+    uint64_t buf[3 + kNumEvents];
+    if (read(leader_, buf, sizeof(buf)) < 0) {
+      return false;
+    }
+    counts->time_enabled = buf[1];
+    counts->time_running = buf[2];
+    for (size_t i = 0; i < kNumEvents; ++i) {
+      counts->valid[i] = slots_[i] >= 0;
+      counts->values[i] = counts->valid[i] ? buf[3 + slots_[i]] : 0;
+    }
+    return true;
+  }
+};
+
+#endif
+
+}  // namespace
+
+const char*
+galois::PerfCounts::EventName(size_t i) {
+  return kEventNames[i];
+}
+
+bool
+galois::PerfCounts::Read([[maybe_unused]] PerfCounts* counts) {
+#ifdef __linux__
+  thread_local ThreadCounters counters;
+  return counters.Read(counts);
+#else
+  return false;
+#endif
+}
+
+bool
+galois::PerfCounts::Enabled() {
+  static const bool requested = GetEnv("GALOIS_PERF_COUNTERS");
+  return requested && available.load(std::memory_order_relaxed);
+}
+
+void
+galois::PerfCounts::ReportSince(const char* region, const PerfCounts& begin) {
+  PerfCounts end;
+  if (!Read(&end)) {
+    return;
+  }
+
+  uint64_t enabled = end.time_enabled - begin.time_enabled;
+  uint64_t running = end.time_running - begin.time_running;
+  for (size_t i = 0; i < kNumEvents; ++i) {
+    if (!end.valid[i]) {
+      continue;
+    }
+    uint64_t value = end.values[i] - begin.values[i];
+    if (running && running < enabled) {
+      // Extrapolate multiplexed counts to the whole interval
+      value = static_cast<uint64_t>(
+          static_cast<double>(value) * enabled / running);
+    }
+    ReportStatSum(region, kEventNames[i], value);
+  }
+}
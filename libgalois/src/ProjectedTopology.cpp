@@ -0,0 +1,136 @@
+#include "galois/graphs/ProjectedTopology.h"
+
+#include "galois/ArrowInterchange.h"
+#include "galois/LargeArray.h"
+#include "galois/Logging.h"
+#include "galois/Loops.h"
+#include "galois/ParallelSTL.h"
+#include "galois/Reduction.h"
+
+galois::graphs::ProjectedTopology::ProjectedTopology(
+    const GraphTopology& base, DynamicBitset&& node_mask,
+    DynamicBitset&& edge_mask)
+    : base_(base),
+      node_mask_(std::move(node_mask)),
+      edge_mask_(std::move(edge_mask)) {}
+
+galois::Result<std::unique_ptr<galois::graphs::ProjectedTopology>>
+galois::graphs::ProjectedTopology::Make(
+    const GraphTopology& topology, DynamicBitset node_mask,
+    DynamicBitset edge_mask) {
+  if (node_mask.size() != 0 && node_mask.size() != topology.num_nodes()) {
+    GALOIS_LOG_DEBUG(
+        "node mask size {} does not match number of nodes {}",
+        node_mask.size(), topology.num_nodes());
+    return ErrorCode::InvalidArgument;
+  }
+  if (edge_mask.size() != 0 && edge_mask.size() != topology.num_edges()) {
+    GALOIS_LOG_DEBUG(
+        "edge mask size {} does not match number of edges {}",
+        edge_mask.size(), topology.num_edges());
+    return ErrorCode::InvalidArgument;
+  }
+
+  std::unique_ptr<ProjectedTopology> projection(new ProjectedTopology(
+      topology, std::move(node_mask), std::move(edge_mask)));
+  if (auto r = projection->Init(); !r) {
+    return r.error();
+  }
+
+  return std::unique_ptr<ProjectedTopology>(std::move(projection));
+}
+
+galois::Result<void>
+galois::graphs::ProjectedTopology::Init() {
+  if (!has_node_mask()) {
+    num_nodes_ = base_.num_nodes();
+  } else {
+    const auto& words = node_mask_.get_vec();
+    node_rank_.resize(words.size());
+    galois::do_all(
+        galois::iterate(size_t{0}, words.size()),
+        [&](size_t w) {
+          uint64_t bits = words[w];
+          node_rank_[w] = __builtin_popcountll(bits);
+        },
+        galois::no_stats());
+    galois::ParallelSTL::partial_sum(
+        node_rank_.begin(), node_rank_.end(), node_rank_.begin());
+
+    original_nodes_ = node_mask_.getOffsets<uint32_t>();
+    num_nodes_ = original_nodes_.size();
+  }
+
+  galois::GAccumulator<uint64_t> num_edges;
+  galois::do_all(
+      galois::iterate(uint64_t{0}, num_nodes_),
+      [&](uint64_t n) {
+        auto [begin, end] = base_.edge_range(OriginalNodeId(n));
+        for (auto e = begin; e != end; ++e) {
+          if (IsOriginalEdgeSelected(e)) {
+            num_edges += 1;
+          }
+        }
+      },
+      galois::steal(), galois::no_stats());
+  num_edges_ = num_edges.reduce();
+
+  return ResultSuccess();
+}
+
+galois::Result<void>
+galois::graphs::ProjectedTopology::Compact() {
+  if (is_compacted()) {
+    return ResultSuccess();
+  }
+
+  galois::LargeArray<uint64_t> degrees;
+  degrees.allocateBlocked(num_nodes_);
+  galois::do_all(
+      galois::iterate(uint64_t{0}, num_nodes_),
+      [&](uint64_t n) {
+        auto [begin, end] = base_.edge_range(OriginalNodeId(n));
+        uint64_t degree = 0;
+        for (auto e = begin; e != end; ++e) {
+          if (IsOriginalEdgeSelected(e)) {
+            ++degree;
+          }
+        }
+        degrees[n] = degree;
+      },
+      galois::steal(), galois::no_stats());
+
+  std::vector<uint64_t> out_indices(num_nodes_);
+  galois::ParallelSTL::partial_sum(
+      degrees.begin(), degrees.end(), out_indices.begin());
+  assert(num_nodes_ == 0 || out_indices.back() == num_edges_);
+
+  std::vector<uint32_t> out_dests(num_edges_);
+  std::vector<uint64_t> original_edges(num_edges_);
+  galois::do_all(
+      galois::iterate(uint64_t{0}, num_nodes_),
+      [&](uint64_t n) {
+        uint64_t out = n > 0 ? out_indices[n - 1] : 0;
+        auto [begin, end] = base_.edge_range(OriginalNodeId(n));
+        for (auto e = begin; e != end; ++e) {
+          if (IsOriginalEdgeSelected(e)) {
+            out_dests[out] = ProjectedNodeId(base_.out_dests->Value(e));
+            original_edges[out] = e;
+            ++out;
+          }
+        }
+        assert(out == out_indices[n]);
+      },
+      galois::steal(), galois::no_stats());
+
+  compact_ = GraphTopology{
+      .out_indices = std::static_pointer_cast<arrow::UInt64Array>(
+          galois::BuildArray(out_indices)),
+      .out_dests = std::static_pointer_cast<arrow::UInt32Array>(
+          galois::BuildArray(out_dests)),
+  };
+  original_edges_ = std::static_pointer_cast<arrow::UInt64Array>(
+      galois::BuildArray(original_edges));
+
+  return ResultSuccess();
+}
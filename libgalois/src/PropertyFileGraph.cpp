@@ -2,6 +2,11 @@
 
 #include <sys/mman.h>
 
+#include <algorithm>
+#include <mutex>
+
+#include <boost/iterator/counting_iterator.hpp>
+
 #include "galois/Logging.h"
 #include "galois/Loops.h"
 #include "galois/Platform.h"
@@ -159,8 +164,107 @@ MakePropertyFileGraph(std::unique_ptr<tsuba::RDGFile> rdg_file) {
       std::move(rdg_file), std::move(rdg_result.value()));
 }
 
+/// FirstNode returns the first node n in [0, num_nodes) for which pred(n)
+/// is true, or num_nodes if there is none; pred must be monotonic.
+template <typename Pred>
+uint32_t
+FirstNode(uint32_t num_nodes, Pred pred) {
+  return *std::partition_point(
+      boost::counting_iterator<uint32_t>(0),
+      boost::counting_iterator<uint32_t>(num_nodes),
+      [&](uint32_t n) { return !pred(n); });
+}
+
+/// LockPartitionCache locks the partition cache of topology and drops its
+/// contents if they were computed for different out_indices.
+std::pair<
+    std::shared_ptr<galois::graphs::internal::PartitionCache>,
+    std::unique_lock<std::mutex>>
+LockPartitionCache(const galois::graphs::GraphTopology& topology) {
+  auto cache = topology.partition_cache.Get();
+  std::unique_lock<std::mutex> lock(cache->mutex);
+  if (cache->indices.lock() != topology.out_indices) {
+    cache->node_ranges.clear();
+    cache->tile_ranges.clear();
+    cache->indices = topology.out_indices;
+  }
+  return std::make_pair(std::move(cache), std::move(lock));
+}
+
 }  // namespace
 
+std::vector<uint32_t>
+galois::graphs::GraphTopology::EdgeBalancedNodeRanges(
+    uint32_t num_blocks, uint32_t node_weight) const {
+  assert(num_blocks > 0);
+  auto [cache, lock] = LockPartitionCache(*this);
+  auto key = std::make_pair(num_blocks, node_weight);
+  auto it = cache->node_ranges.find(key);
+  if (it != cache->node_ranges.end()) {
+    return it->second;
+  }
+
+  uint32_t num_nodes = this->num_nodes();
+  // Weight of the nodes up to and including n
+  auto weight = [&](uint32_t n) {
+    return out_indices->Value(n) + uint64_t{node_weight} * (n + 1);
+  };
+  uint64_t total = num_nodes > 0 ? weight(num_nodes - 1) : 0;
+
+  std::vector<uint32_t> ranges(num_blocks + 1);
+  ranges[num_blocks] = num_nodes;
+  for (uint32_t b = 1; b < num_blocks; ++b) {
+    uint64_t target = total * b / num_blocks;
+    ranges[b] =
+        FirstNode(num_nodes, [&](uint32_t n) { return weight(n) > target; });
+  }
+
+  cache->node_ranges.emplace(key, ranges);
+  return ranges;
+}
+
+std::vector<std::pair<uint32_t, uint32_t>>
+galois::graphs::GraphTopology::EdgeTileNodeRanges(uint32_t num_tiles) const {
+  assert(num_tiles > 0);
+  auto [cache, lock] = LockPartitionCache(*this);
+  auto it = cache->tile_ranges.find(num_tiles);
+  if (it != cache->tile_ranges.end()) {
+    return it->second;
+  }
+
+  uint32_t num_nodes = this->num_nodes();
+  uint64_t num_edges = num_nodes > 0 ? out_indices->Value(num_nodes - 1) : 0;
+  // The node whose edges include edge e
+  auto node_of = [&](uint64_t e) {
+    return FirstNode(
+        num_nodes, [&](uint32_t n) { return out_indices->Value(n) > e; });
+  };
+
+  std::vector<std::pair<uint32_t, uint32_t>> ranges(num_tiles);
+  for (uint32_t t = 0; t < num_tiles; ++t) {
+    uint64_t lo = num_edges * t / num_tiles;
+    uint64_t hi = num_edges * (t + 1) / num_tiles;
+    uint32_t begin = node_of(lo);
+    uint32_t end = lo < hi ? node_of(hi - 1) + 1 : begin;
+    ranges[t] = std::make_pair(begin, end);
+  }
+
+  cache->tile_ranges.emplace(num_tiles, ranges);
+  return ranges;
+}
+
+void
+galois::graphs::GraphTopology::InvalidatePartitions() const {
+  auto cache = partition_cache.Peek();
+  if (!cache) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(cache->mutex);
+  cache->node_ranges.clear();
+  cache->tile_ranges.clear();
+  cache->indices.reset();
+}
+
 galois::graphs::PropertyFileGraph::PropertyFileGraph() = default;
 
 galois::graphs::PropertyFileGraph::PropertyFileGraph(
@@ -389,7 +493,7 @@ galois::graphs::SortNodesByDegree(galois::graphs::PropertyFileGraph* pfg) {
   });
 
   // sort by degree (first item)
-  galois::ParallelSTL::sort(
+  galois::ParallelSTL::sample_sort(
       dn_pairs.begin(), dn_pairs.end(), std::greater<DegreeNodePair>());
 
   // create mapping, get degrees out to another vector to get prefix sum
@@ -462,5 +566,7 @@ galois::graphs::SortNodesByDegree(galois::graphs::PropertyFileGraph* pfg) {
         out_dests_view[edge_id] = new_out_dest[edge_id];
       });
 
+  pfg->topology().InvalidatePartitions();
+
   return galois::ResultSuccess();
 }
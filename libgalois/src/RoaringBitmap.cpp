@@ -0,0 +1,923 @@
+#include "galois/RoaringBitmap.h"
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+
+#include <arrow/api.h>
+
+#include "galois/ErrorCode.h"
+#include "galois/Galois.h"
+#include "galois/Logging.h"
+#include "galois/NumaMemoryPool.h"
+
+namespace {
+
+using Container = galois::internal::RoaringContainer;
+using Type = Container::Type;
+
+/// Written at the start of a serialized bitmap: "GRB" and a format version
+constexpr uint32_t kSerialCookie = 0x01425247;
+
+void
+SetRange(std::vector<uint64_t>* words, uint32_t begin, uint32_t end) {
+  if (begin >= end) {
+    return;
+  }
+  uint32_t first = begin / 64;
+  uint32_t last = (end - 1) / 64;
+  uint64_t first_mask = ~uint64_t{0} << (begin % 64);
+  uint64_t last_mask = ~uint64_t{0} >> (63 - (end - 1) % 64);
+  if (first == last) {
+    (*words)[first] |= first_mask & last_mask;
+    return;
+  }
+  (*words)[first] |= first_mask;
+  std::fill(
+      words->begin() + first + 1, words->begin() + last, ~uint64_t{0});
+  (*words)[last] |= last_mask;
+}
+
+uint32_t
+CountRuns(const std::vector<uint64_t>& words) {
+  uint32_t runs = 0;
+  uint64_t carry = 0;
+  for (uint64_t word : words) {
+    // A run starts at every set bit whose predecessor is not set
+    runs += __builtin_popcountll(word & ~((word << 1) | carry));
+    carry = word >> 63;
+  }
+  return runs;
+}
+
+/// Helpers for the portable encoding
+class Writer {
+  std::vector<uint8_t>* out_;
+
+public:
+  explicit Writer(std::vector<uint8_t>* out) : out_(out) {}
+
+  void Put(uint64_t value, int bytes) {
+    for (int i = 0; i < bytes; ++i) {
+      out_->push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+  }
+};
+
+class Reader {
+  const uint8_t* next_;
+  const uint8_t* end_;
+
+public:
+  Reader(const uint8_t* data, size_t size) : next_(data), end_(data + size) {}
+
+  bool Get(int bytes, uint64_t* value) {
+    if (end_ - next_ < bytes) {
+      return false;
+    }
+    *value = 0;
+    for (int i = 0; i < bytes; ++i) {
+      *value |= uint64_t{*next_++} << (8 * i);
+    }
+    return true;
+  }
+
+  bool AtEnd() const { return next_ == end_; }
+};
+
+}  // namespace
+
+Container
+Container::FromSorted(const uint16_t* begin, const uint16_t* end) {
+  Container container;
+  if (static_cast<size_t>(end - begin) <= kMaxArray) {
+    container.values_.assign(begin, end);
+    container.values_.erase(
+        std::unique(container.values_.begin(), container.values_.end()),
+        container.values_.end());
+    container.cardinality_ = container.values_.size();
+  } else {
+    container.type_ = Type::kBitmap;
+    container.words_.resize(kBitmapWords);
+    for (const uint16_t* it = begin; it != end; ++it) {
+      container.words_[*it / 64] |= uint64_t{1} << (*it % 64);
+    }
+    for (uint64_t word : container.words_) {
+      container.cardinality_ += __builtin_popcountll(word);
+    }
+  }
+  container.Optimize();
+  return container;
+}
+
+Container
+Container::FromWords(std::vector<uint64_t> words) {
+  assert(words.size() == kBitmapWords);
+  Container container;
+  container.type_ = Type::kBitmap;
+  for (uint64_t word : words) {
+    container.cardinality_ += __builtin_popcountll(word);
+  }
+  container.words_ = std::move(words);
+  container.Optimize();
+  return container;
+}
+
+bool
+Container::Contains(uint16_t value) const {
+  switch (type_) {
+  case Type::kArray:
+    return std::binary_search(values_.begin(), values_.end(), value);
+  case Type::kBitmap:
+    return (words_[value / 64] >> (value % 64)) & 1;
+  case Type::kRun: {
+    // Find the last run starting at or before value
+    size_t lo = 0;
+    size_t hi = values_.size() / 2;
+    while (lo < hi) {
+      size_t mid = (lo + hi) / 2;
+      if (values_[2 * mid] <= value) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    return lo > 0 &&
+           value <= uint32_t{values_[2 * (lo - 1)]} + values_[2 * lo - 1];
+  }
+  }
+  return false;
+}
+
+bool
+Container::Add(uint16_t value) {
+  switch (type_) {
+  case Type::kArray: {
+    auto it = std::lower_bound(values_.begin(), values_.end(), value);
+    if (it != values_.end() && *it == value) {
+      return false;
+    }
+    if (values_.size() < kMaxArray) {
+      values_.insert(it, value);
+      ++cardinality_;
+      return true;
+    }
+    break;
+  }
+  case Type::kBitmap:
+    break;
+  case Type::kRun: {
+    // Find the first run starting after value
+    size_t lo = 0;
+    size_t hi = values_.size() / 2;
+    while (lo < hi) {
+      size_t mid = (lo + hi) / 2;
+      if (values_[2 * mid] <= value) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    uint32_t prev_last =
+        lo > 0 ? uint32_t{values_[2 * lo - 2]} + values_[2 * lo - 1] : 0;
+    if (lo > 0 && value <= prev_last) {
+      return false;
+    }
+    bool extends_prev = lo > 0 && prev_last + 1 == value;
+    bool extends_next =
+        2 * lo < values_.size() && uint32_t{value} + 1 == values_[2 * lo];
+    if (extends_prev && extends_next) {
+      // value closes the gap between the two runs
+      values_[2 * lo - 1] += values_[2 * lo + 1] + 2;
+      values_.erase(values_.begin() + 2 * lo, values_.begin() + 2 * lo + 2);
+    } else if (extends_prev) {
+      ++values_[2 * lo - 1];
+    } else if (extends_next) {
+      values_[2 * lo] = value;
+      ++values_[2 * lo + 1];
+    } else {
+      uint16_t run[2] = {value, 0};
+      values_.insert(values_.begin() + 2 * lo, run, run + 2);
+    }
+    ++cardinality_;
+    if (!extends_prev && !extends_next) {
+      // One more run may make another form smaller
+      Optimize();
+    }
+    return true;
+  }
+  }
+
+  if (type_ == Type::kArray) {
+    words_ = ToWords();
+    values_.clear();
+    values_.shrink_to_fit();
+    type_ = Type::kBitmap;
+  }
+  uint64_t& word = words_[value / 64];
+  uint64_t bit = uint64_t{1} << (value % 64);
+  if (word & bit) {
+    return false;
+  }
+  word |= bit;
+  ++cardinality_;
+  return true;
+}
+
+void
+Container::AddRange(uint32_t begin, uint32_t end) {
+  assert(end <= kRange);
+  if (begin >= end) {
+    return;
+  }
+  std::vector<uint64_t> words = ToWords();
+  SetRange(&words, begin, end);
+  *this = FromWords(std::move(words));
+}
+
+void
+Container::Optimize() {
+  uint32_t runs = 0;
+  switch (type_) {
+  case Type::kArray:
+    for (size_t i = 0; i < values_.size(); ++i) {
+      if (i == 0 || values_[i] != values_[i - 1] + 1) {
+        ++runs;
+      }
+    }
+    break;
+  case Type::kBitmap:
+    runs = CountRuns(words_);
+    break;
+  case Type::kRun:
+    runs = values_.size() / 2;
+    break;
+  }
+
+  size_t run_bytes = 4 * size_t{runs};
+  size_t array_bytes = 2 * size_t{cardinality_};
+  size_t bitmap_bytes = 8 * size_t{kBitmapWords};
+  Type best = cardinality_ <= kMaxArray ? Type::kArray : Type::kBitmap;
+  if (run_bytes < std::min(
+                      best == Type::kArray ? array_bytes : bitmap_bytes,
+                      bitmap_bytes)) {
+    best = Type::kRun;
+  }
+  if (best == type_) {
+    return;
+  }
+
+  std::vector<uint16_t> values;
+  std::vector<uint64_t> words;
+  switch (best) {
+  case Type::kArray:
+    values.reserve(cardinality_);
+    ForEach([&](uint16_t value) { values.push_back(value); });
+    break;
+  case Type::kBitmap:
+    words = ToWords();
+    break;
+  case Type::kRun:
+    values.reserve(2 * runs);
+    ForEach([&](uint16_t value) {
+      if (!values.empty() &&
+          uint32_t{values[values.size() - 2]} + values.back() + 1 == value) {
+        ++values.back();
+      } else {
+        values.push_back(value);
+        values.push_back(0);
+      }
+    });
+    break;
+  }
+  type_ = best;
+  values_ = std::move(values);
+  words_ = std::move(words);
+}
+
+uint16_t
+Container::Maximum() const {
+  assert(!empty());
+  switch (type_) {
+  case Type::kArray:
+    return values_.back();
+  case Type::kBitmap: {
+    uint32_t word = kBitmapWords - 1;
+    while (words_[word] == 0) {
+      --word;
+    }
+    return word * 64 + 63 - __builtin_clzll(words_[word]);
+  }
+  case Type::kRun:
+    return values_[values_.size() - 2] + values_.back();
+  }
+  return 0;
+}
+
+size_t
+Container::SizeInBytes() const {
+  return sizeof(Container) + values_.size() * sizeof(uint16_t) +
+         words_.size() * sizeof(uint64_t);
+}
+
+std::vector<uint64_t>
+Container::ToWords() const {
+  if (type_ == Type::kBitmap) {
+    return words_;
+  }
+  std::vector<uint64_t> words(kBitmapWords);
+  if (type_ == Type::kRun) {
+    for (size_t run = 0; run < values_.size(); run += 2) {
+      SetRange(
+          &words, values_[run], uint32_t{values_[run]} + values_[run + 1] + 1);
+    }
+  } else {
+    for (uint16_t value : values_) {
+      words[value / 64] |= uint64_t{1} << (value % 64);
+    }
+  }
+  return words;
+}
+
+Container::Cursor
+Container::Seek(uint32_t rank) const {
+  assert(rank < cardinality_);
+  Cursor cursor;
+  switch (type_) {
+  case Type::kArray:
+    cursor.index = rank;
+    break;
+  case Type::kBitmap: {
+    uint32_t word = 0;
+    for (uint32_t count; (count = __builtin_popcountll(words_[word])) <= rank;
+         ++word) {
+      rank -= count;
+    }
+    uint64_t bits = words_[word];
+    for (; rank > 0; --rank) {
+      bits &= bits - 1;
+    }
+    cursor.index = word * 64 + __builtin_ctzll(bits);
+    break;
+  }
+  case Type::kRun:
+    while (rank > values_[2 * cursor.index + 1]) {
+      rank -= values_[2 * cursor.index + 1] + 1;
+      ++cursor.index;
+    }
+    cursor.offset = rank;
+    break;
+  }
+  return cursor;
+}
+
+Container
+Container::And(const Container& a, const Container& b) {
+  if (a.type_ == Type::kArray || b.type_ == Type::kArray) {
+    const Container& small = a.type_ == Type::kArray ? a : b;
+    const Container& other = a.type_ == Type::kArray ? b : a;
+    std::vector<uint16_t> values;
+    for (uint16_t value : small.values_) {
+      if (other.Contains(value)) {
+        values.push_back(value);
+      }
+    }
+    return FromSorted(values.data(), values.data() + values.size());
+  }
+  std::vector<uint64_t> words = a.ToWords();
+  std::vector<uint64_t> other = b.ToWords();
+  for (uint32_t i = 0; i < kBitmapWords; ++i) {
+    words[i] &= other[i];
+  }
+  return FromWords(std::move(words));
+}
+
+Container
+Container::Or(const Container& a, const Container& b) {
+  if (a.type_ == Type::kArray && b.type_ == Type::kArray) {
+    std::vector<uint16_t> values;
+    values.reserve(a.values_.size() + b.values_.size());
+    std::set_union(
+        a.values_.begin(), a.values_.end(), b.values_.begin(),
+        b.values_.end(), std::back_inserter(values));
+    return FromSorted(values.data(), values.data() + values.size());
+  }
+  std::vector<uint64_t> words = a.ToWords();
+  std::vector<uint64_t> other = b.ToWords();
+  for (uint32_t i = 0; i < kBitmapWords; ++i) {
+    words[i] |= other[i];
+  }
+  return FromWords(std::move(words));
+}
+
+Container
+Container::AndNot(const Container& a, const Container& b) {
+  if (a.type_ == Type::kArray) {
+    std::vector<uint16_t> values;
+    for (uint16_t value : a.values_) {
+      if (!b.Contains(value)) {
+        values.push_back(value);
+      }
+    }
+    return FromSorted(values.data(), values.data() + values.size());
+  }
+  std::vector<uint64_t> words = a.ToWords();
+  if (b.type_ == Type::kArray) {
+    for (uint16_t value : b.values_) {
+      words[value / 64] &= ~(uint64_t{1} << (value % 64));
+    }
+  } else {
+    std::vector<uint64_t> other = b.ToWords();
+    for (uint32_t i = 0; i < kBitmapWords; ++i) {
+      words[i] &= ~other[i];
+    }
+  }
+  return FromWords(std::move(words));
+}
+
+Container
+Container::Xor(const Container& a, const Container& b) {
+  if (a.type_ == Type::kArray && b.type_ == Type::kArray) {
+    std::vector<uint16_t> values;
+    std::set_symmetric_difference(
+        a.values_.begin(), a.values_.end(), b.values_.begin(),
+        b.values_.end(), std::back_inserter(values));
+    return FromSorted(values.data(), values.data() + values.size());
+  }
+  std::vector<uint64_t> words = a.ToWords();
+  std::vector<uint64_t> other = b.ToWords();
+  for (uint32_t i = 0; i < kBitmapWords; ++i) {
+    words[i] ^= other[i];
+  }
+  return FromWords(std::move(words));
+}
+
+template <typename Op>
+galois::RoaringBitmap
+galois::RoaringBitmap::Combine(
+    const RoaringBitmap& a, const RoaringBitmap& b, bool keep_a, bool keep_b,
+    const Op& op) {
+  // Pair up containers by key; a missing container is represented by the
+  // end index of its bitmap
+  struct Pair {
+    uint16_t key;
+    size_t a;
+    size_t b;
+  };
+  std::vector<Pair> pairs;
+  size_t i = 0;
+  size_t j = 0;
+  size_t a_end = a.keys_.size();
+  size_t b_end = b.keys_.size();
+  while (i < a_end || j < b_end) {
+    if (j == b_end || (i < a_end && a.keys_[i] < b.keys_[j])) {
+      if (keep_a) {
+        pairs.push_back(Pair{a.keys_[i], i, b_end});
+      }
+      ++i;
+    } else if (i == a_end || b.keys_[j] < a.keys_[i]) {
+      if (keep_b) {
+        pairs.push_back(Pair{b.keys_[j], a_end, j});
+      }
+      ++j;
+    } else {
+      pairs.push_back(Pair{a.keys_[i], i, j});
+      ++i;
+      ++j;
+    }
+  }
+
+  std::vector<Container> containers(pairs.size());
+  galois::do_all(
+      galois::iterate(size_t{0}, pairs.size()),
+      [&](size_t p) {
+        const Pair& pair = pairs[p];
+        if (pair.b == b_end) {
+          containers[p] = a.containers_[pair.a];
+        } else if (pair.a == a_end) {
+          containers[p] = b.containers_[pair.b];
+        } else {
+          containers[p] = op(a.containers_[pair.a], b.containers_[pair.b]);
+        }
+      },
+      galois::steal(), galois::no_stats());
+
+  RoaringBitmap result;
+  for (size_t p = 0; p < pairs.size(); ++p) {
+    if (!containers[p].empty()) {
+      result.keys_.push_back(pairs[p].key);
+      result.containers_.push_back(std::move(containers[p]));
+    }
+  }
+  return result;
+}
+
+galois::RoaringBitmap
+galois::RoaringBitmap::And(const RoaringBitmap& a, const RoaringBitmap& b) {
+  return Combine(a, b, false, false, &Container::And);
+}
+
+galois::RoaringBitmap
+galois::RoaringBitmap::Or(const RoaringBitmap& a, const RoaringBitmap& b) {
+  return Combine(a, b, true, true, &Container::Or);
+}
+
+galois::RoaringBitmap
+galois::RoaringBitmap::AndNot(const RoaringBitmap& a, const RoaringBitmap& b) {
+  return Combine(a, b, true, false, &Container::AndNot);
+}
+
+galois::RoaringBitmap
+galois::RoaringBitmap::Xor(const RoaringBitmap& a, const RoaringBitmap& b) {
+  return Combine(a, b, true, true, &Container::Xor);
+}
+
+galois::RoaringBitmap
+galois::RoaringBitmap::FromSorted(const std::vector<uint32_t>& values) {
+  assert(std::is_sorted(values.begin(), values.end()));
+
+  // Find where each container's values start; there are at most 2^16
+  // containers, so a binary search per container is cheap
+  std::vector<size_t> starts;
+  for (size_t start = 0; start < values.size();) {
+    starts.push_back(start);
+    uint32_t last = values[start] | 0xFFFF;
+    start = std::upper_bound(values.begin() + start, values.end(), last) -
+            values.begin();
+  }
+  starts.push_back(values.size());
+
+  RoaringBitmap bitmap;
+  size_t num_containers = starts.size() - 1;
+  bitmap.keys_.resize(num_containers);
+  bitmap.containers_.resize(num_containers);
+  galois::do_all(
+      galois::iterate(size_t{0}, num_containers),
+      [&](size_t c) {
+        std::vector<uint16_t> low(
+            values.begin() + starts[c], values.begin() + starts[c + 1]);
+        bitmap.keys_[c] = values[starts[c]] >> 16;
+        bitmap.containers_[c] =
+            Container::FromSorted(low.data(), low.data() + low.size());
+      },
+      galois::steal(), galois::no_stats());
+  return bitmap;
+}
+
+galois::RoaringBitmap
+galois::RoaringBitmap::FromBitset(const DynamicBitset& bitset) {
+  const auto& vec = bitset.get_vec();
+  size_t num_chunks =
+      (vec.size() + Container::kBitmapWords - 1) / Container::kBitmapWords;
+  // Values are 32 bits
+  assert(num_chunks <= Container::kRange);
+
+  std::vector<Container> containers(num_chunks);
+  galois::do_all(
+      galois::iterate(size_t{0}, num_chunks),
+      [&](size_t chunk) {
+        size_t begin = chunk * Container::kBitmapWords;
+        size_t end = std::min(begin + Container::kBitmapWords, vec.size());
+        std::vector<uint64_t> words(Container::kBitmapWords);
+        bool any = false;
+        for (size_t i = begin; i < end; ++i) {
+          words[i - begin] = vec[i].load(std::memory_order_relaxed);
+          any |= words[i - begin] != 0;
+        }
+        if (any) {
+          containers[chunk] = Container::FromWords(std::move(words));
+        }
+      },
+      galois::steal(), galois::no_stats());
+
+  RoaringBitmap bitmap;
+  for (size_t chunk = 0; chunk < num_chunks; ++chunk) {
+    if (!containers[chunk].empty()) {
+      bitmap.keys_.push_back(chunk);
+      bitmap.containers_.push_back(std::move(containers[chunk]));
+    }
+  }
+  return bitmap;
+}
+
+bool
+galois::RoaringBitmap::Add(uint32_t value) {
+  uint16_t key = value >> 16;
+  auto it = std::lower_bound(keys_.begin(), keys_.end(), key);
+  size_t index = it - keys_.begin();
+  if (it == keys_.end() || *it != key) {
+    keys_.insert(it, key);
+    containers_.insert(containers_.begin() + index, Container());
+  }
+  return containers_[index].Add(value & 0xFFFF);
+}
+
+void
+galois::RoaringBitmap::AddRange(uint64_t begin, uint64_t end) {
+  assert(end <= (uint64_t{1} << 32));
+  while (begin < end) {
+    uint16_t key = begin >> 16;
+    uint64_t container_end = std::min(end, (uint64_t{key} + 1) << 16);
+    auto it = std::lower_bound(keys_.begin(), keys_.end(), key);
+    size_t index = it - keys_.begin();
+    if (it == keys_.end() || *it != key) {
+      keys_.insert(it, key);
+      containers_.insert(containers_.begin() + index, Container());
+    }
+    containers_[index].AddRange(
+        begin & 0xFFFF, container_end - (uint64_t{key} << 16));
+    begin = container_end;
+  }
+}
+
+bool
+galois::RoaringBitmap::Contains(uint32_t value) const {
+  uint16_t key = value >> 16;
+  auto it = std::lower_bound(keys_.begin(), keys_.end(), key);
+  if (it == keys_.end() || *it != key) {
+    return false;
+  }
+  return containers_[it - keys_.begin()].Contains(value & 0xFFFF);
+}
+
+uint32_t
+galois::RoaringBitmap::Maximum() const {
+  assert(!Empty());
+  return uint32_t{keys_.back()} << 16 | containers_.back().Maximum();
+}
+
+uint64_t
+galois::RoaringBitmap::Cardinality() const {
+  uint64_t cardinality = 0;
+  for (const Container& container : containers_) {
+    cardinality += container.cardinality();
+  }
+  return cardinality;
+}
+
+void
+galois::RoaringBitmap::RunOptimize() {
+  galois::do_all(
+      galois::iterate(containers_.begin(), containers_.end()),
+      [&](Container& container) { container.Optimize(); }, galois::steal(),
+      galois::no_stats());
+}
+
+size_t
+galois::RoaringBitmap::SizeInBytes() const {
+  size_t size = keys_.size() * sizeof(uint16_t);
+  for (const Container& container : containers_) {
+    size += container.SizeInBytes();
+  }
+  return size;
+}
+
+std::vector<uint32_t>
+galois::RoaringBitmap::ToVector() const {
+  std::vector<uint64_t> offsets(containers_.size() + 1);
+  for (size_t c = 0; c < containers_.size(); ++c) {
+    offsets[c + 1] = offsets[c] + containers_[c].cardinality();
+  }
+
+  std::vector<uint32_t> values(offsets.back());
+  galois::do_all(
+      galois::iterate(size_t{0}, containers_.size()),
+      [&](size_t c) {
+        uint32_t high = uint32_t{keys_[c]} << 16;
+        uint32_t* out = values.data() + offsets[c];
+        containers_[c].ForEach([&](uint16_t low) { *out++ = high | low; });
+      },
+      galois::steal(), galois::no_stats());
+  return values;
+}
+
+void
+galois::RoaringBitmap::ToBitset(DynamicBitset* bitset) const {
+  auto& vec = bitset->get_vec();
+  assert(Empty() || Maximum() < bitset->size());
+  // Each container owns a disjoint block of words of the bitset
+  galois::do_all(
+      galois::iterate(size_t{0}, containers_.size()),
+      [&](size_t c) {
+        std::vector<uint64_t> words = containers_[c].ToWords();
+        size_t begin = size_t{keys_[c]} * Container::kBitmapWords;
+        for (size_t i = 0; i < words.size() && begin + i < vec.size(); ++i) {
+          if (words[i]) {
+            vec[begin + i] |= words[i];
+          }
+        }
+      },
+      galois::steal(), galois::no_stats());
+}
+
+std::vector<uint8_t>
+galois::RoaringBitmap::Serialize() const {
+  std::vector<uint8_t> out;
+  Writer writer(&out);
+  writer.Put(kSerialCookie, 4);
+  writer.Put(containers_.size(), 4);
+  for (size_t c = 0; c < containers_.size(); ++c) {
+    const Container& container = containers_[c];
+    writer.Put(keys_[c], 2);
+    writer.Put(static_cast<uint8_t>(container.type_), 1);
+    writer.Put(container.cardinality_, 4);
+    if (container.type_ == Type::kBitmap) {
+      for (uint64_t word : container.words_) {
+        writer.Put(word, 8);
+      }
+    } else {
+      writer.Put(container.values_.size(), 4);
+      for (uint16_t value : container.values_) {
+        writer.Put(value, 2);
+      }
+    }
+  }
+  return out;
+}
+
+galois::Result<galois::RoaringBitmap>
+galois::RoaringBitmap::Deserialize(const uint8_t* data, size_t size) {
+  Reader reader(data, size);
+  uint64_t cookie = 0;
+  uint64_t num_containers = 0;
+  if (!reader.Get(4, &cookie) || cookie != kSerialCookie ||
+      !reader.Get(4, &num_containers) || num_containers > Container::kRange) {
+    GALOIS_LOG_DEBUG("not a serialized RoaringBitmap");
+    return ErrorCode::InvalidArgument;
+  }
+
+  RoaringBitmap bitmap;
+  for (uint64_t c = 0; c < num_containers; ++c) {
+    uint64_t key = 0;
+    uint64_t type = 0;
+    uint64_t cardinality = 0;
+    if (!reader.Get(2, &key) || !reader.Get(1, &type) ||
+        !reader.Get(4, &cardinality) || type > uint64_t(Type::kRun) ||
+        cardinality == 0 || cardinality > Container::kRange ||
+        (!bitmap.keys_.empty() && key <= bitmap.keys_.back())) {
+      GALOIS_LOG_DEBUG("invalid header of container {}", c);
+      return ErrorCode::InvalidArgument;
+    }
+
+    Container container;
+    container.type_ = static_cast<Type>(type);
+    uint64_t count = 0;
+    bool ok = true;
+    if (container.type_ == Type::kBitmap) {
+      container.words_.resize(Container::kBitmapWords);
+      for (uint64_t& word : container.words_) {
+        ok = ok && reader.Get(8, &word);
+        count += __builtin_popcountll(word);
+      }
+    } else {
+      uint64_t num_values = 0;
+      ok = reader.Get(4, &num_values) && num_values <= 2 * Container::kRange;
+      container.values_.resize(ok ? num_values : 0);
+      for (uint16_t& value : container.values_) {
+        uint64_t v = 0;
+        ok = ok && reader.Get(2, &v);
+        value = v;
+      }
+      if (container.type_ == Type::kArray) {
+        count = num_values;
+        ok = ok && std::adjacent_find(
+                       container.values_.begin(), container.values_.end(),
+                       std::greater_equal<uint16_t>()) ==
+                       container.values_.end();
+      } else {
+        ok = ok && num_values % 2 == 0;
+        for (size_t run = 0; ok && run < num_values; run += 2) {
+          uint32_t start = container.values_[run];
+          uint32_t last = start + container.values_[run + 1];
+          ok = last < Container::kRange &&
+               (run == 0 || start > uint32_t{container.values_[run - 2]} +
+                                        container.values_[run - 1] + 1);
+          count += last - start + 1;
+        }
+      }
+    }
+    if (!ok || count != cardinality) {
+      GALOIS_LOG_DEBUG("invalid values of container {}", c);
+      return ErrorCode::InvalidArgument;
+    }
+    container.cardinality_ = cardinality;
+    bitmap.keys_.push_back(key);
+    bitmap.containers_.push_back(std::move(container));
+  }
+  if (!reader.AtEnd()) {
+    GALOIS_LOG_DEBUG("trailing bytes after RoaringBitmap");
+    return ErrorCode::InvalidArgument;
+  }
+  return RoaringBitmap(std::move(bitmap));
+}
+
+galois::Result<std::shared_ptr<arrow::Table>>
+galois::RoaringBitmap::ToNodeProperty(
+    const std::string& name, uint64_t num_nodes) const {
+  if (!Empty() && Maximum() >= num_nodes) {
+    GALOIS_LOG_DEBUG("bitmap has values past {} nodes", num_nodes);
+    return ErrorCode::InvalidArgument;
+  }
+
+  // A boolean array is a bitset in the same layout as DynamicBitset
+  uint64_t num_words = (num_nodes + 63) / 64;
+  auto buffer_result = arrow::AllocateBuffer(
+      num_words * sizeof(uint64_t), GetPropertyMemoryPool());
+  if (!buffer_result.ok()) {
+    GALOIS_LOG_DEBUG("arrow error: {}", buffer_result.status());
+    return ErrorCode::ArrowError;
+  }
+  std::shared_ptr<arrow::Buffer> buffer =
+      std::move(buffer_result.ValueOrDie());
+  auto* words = reinterpret_cast<uint64_t*>(buffer->mutable_data());
+  galois::do_all(
+      galois::iterate(uint64_t{0}, num_words),
+      [&](uint64_t i) { words[i] = 0; }, galois::no_stats());
+  galois::do_all(
+      galois::iterate(size_t{0}, containers_.size()),
+      [&](size_t c) {
+        std::vector<uint64_t> container_words = containers_[c].ToWords();
+        uint64_t begin = uint64_t{keys_[c]} * Container::kBitmapWords;
+        for (size_t i = 0;
+             i < container_words.size() && begin + i < num_words; ++i) {
+          words[begin + i] = container_words[i];
+        }
+      },
+      galois::steal(), galois::no_stats());
+
+  auto array = std::make_shared<arrow::BooleanArray>(num_nodes, buffer);
+  return arrow::Table::Make(
+      arrow::schema({arrow::field(name, arrow::boolean())}), {array});
+}
+
+galois::Result<galois::RoaringBitmap>
+galois::RoaringBitmap::FromNodeProperty(const arrow::ChunkedArray& property) {
+  if (property.type()->id() != arrow::Type::BOOL) {
+    GALOIS_LOG_DEBUG(
+        "expected a boolean property, not {}", property.type()->ToString());
+    return ErrorCode::TypeError;
+  }
+
+  DynamicBitset bitset;
+  bitset.resize(property.length());
+  uint64_t offset = 0;
+  for (const auto& chunk : property.chunks()) {
+    auto array = std::static_pointer_cast<arrow::BooleanArray>(chunk);
+    galois::do_all(
+        galois::iterate(int64_t{0}, array->length()),
+        [&](int64_t i) {
+          if (array->IsValid(i) && array->Value(i)) {
+            bitset.set(offset + i);
+          }
+        },
+        galois::no_stats());
+    offset += array->length();
+  }
+  return FromBitset(bitset);
+}
+
+galois::RoaringBitmap::Iterator
+galois::RoaringBitmap::IteratorAt(uint64_t rank) const {
+  for (size_t c = 0; c < containers_.size(); ++c) {
+    if (rank < containers_[c].cardinality()) {
+      return Iterator(this, c, rank);
+    }
+    rank -= containers_[c].cardinality();
+  }
+  return end();
+}
+
+galois::RoaringBitmap::Iterator
+galois::RoaringBitmap::local_begin() const {
+  auto [begin, end] = galois::block_range(
+      uint64_t{0}, Cardinality(), substrate::ThreadPool::getTID(),
+      getActiveThreads());
+  return IteratorAt(begin);
+}
+
+galois::RoaringBitmap::Iterator
+galois::RoaringBitmap::local_end() const {
+  auto [begin, end] = galois::block_range(
+      uint64_t{0}, Cardinality(), substrate::ThreadPool::getTID(),
+      getActiveThreads());
+  return IteratorAt(end);
+}
+
+bool
+galois::RoaringBitmap::operator==(const RoaringBitmap& other) const {
+  if (keys_ != other.keys_) {
+    return false;
+  }
+  for (size_t c = 0; c < containers_.size(); ++c) {
+    const Container& a = containers_[c];
+    const Container& b = other.containers_[c];
+    if (a.cardinality() != b.cardinality()) {
+      return false;
+    }
+    if (a.type() == b.type() ? a.values_ != b.values_ || a.words_ != b.words_
+                             : a.ToWords() != b.ToWords()) {
+      return false;
+    }
+  }
+  return true;
+}
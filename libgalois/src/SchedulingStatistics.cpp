@@ -0,0 +1,48 @@
+#include "galois/runtime/SchedulingStatistics.h"
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+
+#include "galois/Statistics.h"
+
+uint64_t
+galois::runtime::ThreadSchedulingStats::Now() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void
+galois::runtime::ThreadSchedulingStats::AddChunk(uint64_t size) {
+  if (!size) {
+    return;
+  }
+  size_t bucket = 63 - __builtin_clzll(size);
+  ++chunk_sizes[std::min(bucket, kChunkBuckets - 1)];
+  ++chunks;
+  items += size;
+}
+
+void
+galois::runtime::ThreadSchedulingStats::Finish(const char* loopname) {
+  SetBusy(false);
+
+  ReportStatSum(loopname, "BusyTimeUs", busy_ns / 1000);
+  ReportStatSum(loopname, "IdleTimeUs", idle_ns / 1000);
+  ReportStatSum(loopname, "WorkItems", items);
+  if (chunks) {
+    ReportStatSum(loopname, "Chunks", chunks);
+    for (size_t i = 0; i < kChunkBuckets; ++i) {
+      if (chunk_sizes[i]) {
+        ReportStatSum(
+            loopname, "ChunkSize" + std::to_string(uint64_t{1} << i),
+            chunk_sizes[i]);
+      }
+    }
+  }
+  if (steal_attempts) {
+    ReportStatSum(loopname, "StealAttempts", steal_attempts);
+    ReportStatSum(loopname, "Steals", steals);
+  }
+}
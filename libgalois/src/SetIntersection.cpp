@@ -0,0 +1,383 @@
+#include "galois/SetIntersection.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "galois/Logging.h"
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define GALOIS_INTERSECTION_X86
+#include <immintrin.h>
+#endif
+
+namespace {
+
+/// Ratio of sizes above which galloping beats merging
+constexpr size_t kGallopRatio = 32;
+
+// The counting kernels stop once they have found limit common values. They
+// may overshoot limit by up to a block; IntersectionCount clamps the result.
+
+size_t
+CountScalar(
+    const uint32_t* a, size_t a_size, const uint32_t* b, size_t b_size,
+    size_t limit) {
+  size_t i = 0;
+  size_t j = 0;
+  size_t count = 0;
+  while (i < a_size && j < b_size && count < limit) {
+    if (a[i] < b[j]) {
+      ++i;
+    } else if (b[j] < a[i]) {
+      ++j;
+    } else {
+      ++count;
+      ++i;
+      ++j;
+    }
+  }
+  return count;
+}
+
+size_t
+IntersectScalar(
+    const uint32_t* a, size_t a_size, const uint32_t* b, size_t b_size,
+    uint32_t* out) {
+  size_t i = 0;
+  size_t j = 0;
+  size_t count = 0;
+  while (i < a_size && j < b_size) {
+    if (a[i] < b[j]) {
+      ++i;
+    } else if (b[j] < a[i]) {
+      ++j;
+    } else {
+      out[count++] = a[i];
+      ++i;
+      ++j;
+    }
+  }
+  return count;
+}
+
+/// GallopLowerBound returns the first index in [begin, size) whose value is
+/// not less than x by probing begin + 1, begin + 2, begin + 4, ... and then
+/// binary searching the last interval.
+size_t
+GallopLowerBound(const uint32_t* data, size_t begin, size_t size, uint32_t x) {
+  if (begin >= size || data[begin] >= x) {
+    return begin;
+  }
+  size_t lo = begin;
+  size_t step = 1;
+  while (lo + step < size && data[lo + step] < x) {
+    lo += step;
+    step <<= 1;
+  }
+  // data[lo] < x <= data[lo + step] (or lo + step is past the end)
+  size_t hi = std::min(lo + step, size);
+  return std::lower_bound(data + lo + 1, data + hi, x) - data;
+}
+
+/// The galloping kernels expect the smaller range first.
+size_t
+CountGalloping(
+    const uint32_t* small, size_t small_size, const uint32_t* large,
+    size_t large_size, size_t limit) {
+  size_t count = 0;
+  size_t pos = 0;
+  for (size_t i = 0; i < small_size && count < limit; ++i) {
+    pos = GallopLowerBound(large, pos, large_size, small[i]);
+    if (pos == large_size) {
+      break;
+    }
+    if (large[pos] == small[i]) {
+      ++count;
+      ++pos;
+    }
+  }
+  return count;
+}
+
+size_t
+IntersectGalloping(
+    const uint32_t* small, size_t small_size, const uint32_t* large,
+    size_t large_size, uint32_t* out) {
+  size_t count = 0;
+  size_t pos = 0;
+  for (size_t i = 0; i < small_size; ++i) {
+    pos = GallopLowerBound(large, pos, large_size, small[i]);
+    if (pos == large_size) {
+      break;
+    }
+    if (large[pos] == small[i]) {
+      out[count++] = small[i];
+      ++pos;
+    }
+  }
+  return count;
+}
+
+#ifdef GALOIS_INTERSECTION_X86
+
+// The blocked SIMD kernels compare a block of a with every rotation of a block
+// of b, which finds all common values of the two blocks, and then advance
+// whichever block has the smaller maximum (or both if they are equal). For
+// sets, each common value is found exactly once, when the blocks containing
+// it in a and b are compared. What remains after the last full block is
+// finished with the scalar kernel.
+
+__attribute__((target("avx2"))) inline uint32_t
+MatchAVX2(const uint32_t* a, const uint32_t* b) {
+  const __m256i rotate = _mm256_set_epi32(0, 7, 6, 5, 4, 3, 2, 1);
+  __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a));
+  __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b));
+  __m256i eq = _mm256_cmpeq_epi32(va, vb);
+  for (int r = 1; r < 8; ++r) {
+    vb = _mm256_permutevar8x32_epi32(vb, rotate);
+    eq = _mm256_or_si256(eq, _mm256_cmpeq_epi32(va, vb));
+  }
+  return _mm256_movemask_ps(_mm256_castsi256_ps(eq));
+}
+
+__attribute__((target("avx2,popcnt"))) size_t
+CountAVX2(
+    const uint32_t* a, size_t a_size, const uint32_t* b, size_t b_size,
+    size_t limit) {
+  constexpr size_t kWidth = 8;
+  size_t i = 0;
+  size_t j = 0;
+  size_t count = 0;
+  while (i + kWidth <= a_size && j + kWidth <= b_size && count < limit) {
+    count += __builtin_popcount(MatchAVX2(a + i, b + j));
+    uint32_t a_max = a[i + kWidth - 1];
+    uint32_t b_max = b[j + kWidth - 1];
+    i += a_max <= b_max ? kWidth : 0;
+    j += b_max <= a_max ? kWidth : 0;
+  }
+  if (count >= limit) {
+    return count;
+  }
+  return count +
+         CountScalar(a + i, a_size - i, b + j, b_size - j, limit - count);
+}
+
+__attribute__((target("avx2,bmi"))) size_t
+IntersectAVX2(
+    const uint32_t* a, size_t a_size, const uint32_t* b, size_t b_size,
+    uint32_t* out) {
+  constexpr size_t kWidth = 8;
+  size_t i = 0;
+  size_t j = 0;
+  size_t count = 0;
+  while (i + kWidth <= a_size && j + kWidth <= b_size) {
+    uint32_t mask = MatchAVX2(a + i, b + j);
+    while (mask != 0) {
+      out[count++] = a[i + __builtin_ctz(mask)];
+      mask &= mask - 1;
+    }
+    uint32_t a_max = a[i + kWidth - 1];
+    uint32_t b_max = b[j + kWidth - 1];
+    i += a_max <= b_max ? kWidth : 0;
+    j += b_max <= a_max ? kWidth : 0;
+  }
+  return count +
+         IntersectScalar(a + i, a_size - i, b + j, b_size - j, out + count);
+}
+
+__attribute__((target("avx512f"))) inline __mmask16
+MatchAVX512(const uint32_t* a, const uint32_t* b) {
+  __m512i va = _mm512_loadu_si512(a);
+  __m512i vb = _mm512_loadu_si512(b);
+  __mmask16 eq = _mm512_cmpeq_epi32_mask(va, vb);
+  for (int r = 1; r < 16; ++r) {
+    vb = _mm512_mask_alignr_epi32(vb, 0xFFFF, vb, vb, 1);
+    eq |= _mm512_cmpeq_epi32_mask(va, vb);
+  }
+  return eq;
+}
+
+__attribute__((target("avx512f,popcnt"))) size_t
+CountAVX512(
+    const uint32_t* a, size_t a_size, const uint32_t* b, size_t b_size,
+    size_t limit) {
+  constexpr size_t kWidth = 16;
+  size_t i = 0;
+  size_t j = 0;
+  size_t count = 0;
+  while (i + kWidth <= a_size && j + kWidth <= b_size && count < limit) {
+    count += __builtin_popcount(MatchAVX512(a + i, b + j));
+    uint32_t a_max = a[i + kWidth - 1];
+    uint32_t b_max = b[j + kWidth - 1];
+    i += a_max <= b_max ? kWidth : 0;
+    j += b_max <= a_max ? kWidth : 0;
+  }
+  if (count >= limit) {
+    return count;
+  }
+  return count +
+         CountScalar(a + i, a_size - i, b + j, b_size - j, limit - count);
+}
+
+__attribute__((target("avx512f,popcnt"))) size_t
+IntersectAVX512(
+    const uint32_t* a, size_t a_size, const uint32_t* b, size_t b_size,
+    uint32_t* out) {
+  constexpr size_t kWidth = 16;
+  size_t i = 0;
+  size_t j = 0;
+  size_t count = 0;
+  while (i + kWidth <= a_size && j + kWidth <= b_size) {
+    __mmask16 mask = MatchAVX512(a + i, b + j);
+    _mm512_mask_compressstoreu_epi32(
+        out + count, mask, _mm512_loadu_si512(a + i));
+    count += __builtin_popcount(mask);
+    uint32_t a_max = a[i + kWidth - 1];
+    uint32_t b_max = b[j + kWidth - 1];
+    i += a_max <= b_max ? kWidth : 0;
+    j += b_max <= a_max ? kWidth : 0;
+  }
+  return count +
+         IntersectScalar(a + i, a_size - i, b + j, b_size - j, out + count);
+}
+
+#endif
+
+bool
+CpuSupports(galois::IntersectionKernel kernel) {
+#ifdef GALOIS_INTERSECTION_X86
+  __builtin_cpu_init();
+  switch (kernel) {
+  case galois::IntersectionKernel::kAVX2:
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("bmi") &&
+           __builtin_cpu_supports("popcnt");
+  case galois::IntersectionKernel::kAVX512:
+    return __builtin_cpu_supports("avx512f") &&
+           __builtin_cpu_supports("popcnt");
+  default:
+    return false;
+  }
+#else
+  (void)kernel;
+  return false;
+#endif
+}
+
+galois::IntersectionKernel
+DetectBestKernel() {
+  // The 16x16 AVX-512 block does twice the comparisons of the 8x8 AVX2 block
+  // per element advanced and measures slower on current parts (see
+  // intersection-bench), so AVX2 is preferred when both are available.
+  if (CpuSupports(galois::IntersectionKernel::kAVX2)) {
+    return galois::IntersectionKernel::kAVX2;
+  }
+  if (CpuSupports(galois::IntersectionKernel::kAVX512)) {
+    return galois::IntersectionKernel::kAVX512;
+  }
+  return galois::IntersectionKernel::kScalar;
+}
+
+/// ChooseKernel resolves kAutomatic for inputs of the given sizes
+galois::IntersectionKernel
+ChooseKernel(size_t a_size, size_t b_size) {
+  size_t small = std::min(a_size, b_size);
+  size_t large = std::max(a_size, b_size);
+  if (small * kGallopRatio < large) {
+    return galois::IntersectionKernel::kGalloping;
+  }
+  return galois::BestIntersectionKernel();
+}
+
+}  // namespace
+
+bool
+galois::IsIntersectionKernelSupported(IntersectionKernel kernel) {
+  switch (kernel) {
+  case IntersectionKernel::kAutomatic:
+  case IntersectionKernel::kScalar:
+  case IntersectionKernel::kGalloping:
+    return true;
+  case IntersectionKernel::kAVX2: {
+    static const bool supported = CpuSupports(IntersectionKernel::kAVX2);
+    return supported;
+  }
+  case IntersectionKernel::kAVX512: {
+    static const bool supported = CpuSupports(IntersectionKernel::kAVX512);
+    return supported;
+  }
+  default:
+    return false;
+  }
+}
+
+galois::IntersectionKernel
+galois::BestIntersectionKernel() {
+  static const IntersectionKernel best = DetectBestKernel();
+  return best;
+}
+
+size_t
+galois::IntersectionCount(
+    const uint32_t* a, size_t a_size, const uint32_t* b, size_t b_size,
+    IntersectionKernel kernel) {
+  return IntersectionCount(
+      a, a_size, b, b_size, std::numeric_limits<size_t>::max(), kernel);
+}
+
+size_t
+galois::IntersectionCount(
+    const uint32_t* a, size_t a_size, const uint32_t* b, size_t b_size,
+    size_t limit, IntersectionKernel kernel) {
+  if (kernel == IntersectionKernel::kAutomatic) {
+    kernel = ChooseKernel(a_size, b_size);
+  }
+
+  size_t count = 0;
+  switch (kernel) {
+  case IntersectionKernel::kScalar:
+    count = CountScalar(a, a_size, b, b_size, limit);
+    break;
+  case IntersectionKernel::kGalloping:
+    count = a_size <= b_size ? CountGalloping(a, a_size, b, b_size, limit)
+                             : CountGalloping(b, b_size, a, a_size, limit);
+    break;
+#ifdef GALOIS_INTERSECTION_X86
+  case IntersectionKernel::kAVX2:
+    count = CountAVX2(a, a_size, b, b_size, limit);
+    break;
+  case IntersectionKernel::kAVX512:
+    count = CountAVX512(a, a_size, b, b_size, limit);
+    break;
+#endif
+  default:
+    GALOIS_LOG_FATAL("unsupported intersection kernel");
+  }
+  return std::min(count, limit);
+}
+
+size_t
+galois::Intersection(
+    const uint32_t* a, size_t a_size, const uint32_t* b, size_t b_size,
+    uint32_t* out, IntersectionKernel kernel) {
+  if (kernel == IntersectionKernel::kAutomatic) {
+    kernel = ChooseKernel(a_size, b_size);
+  }
+
+  switch (kernel) {
+  case IntersectionKernel::kScalar:
+    return IntersectScalar(a, a_size, b, b_size, out);
+  case IntersectionKernel::kGalloping:
+    if (a_size <= b_size) {
+      return IntersectGalloping(a, a_size, b, b_size, out);
+    }
+    return IntersectGalloping(b, b_size, a, a_size, out);
+#ifdef GALOIS_INTERSECTION_X86
+  case IntersectionKernel::kAVX2:
+    return IntersectAVX2(a, a_size, b, b_size, out);
+  case IntersectionKernel::kAVX512:
+    return IntersectAVX512(a, a_size, b, b_size, out);
+#endif
+  default:
+    GALOIS_LOG_FATAL("unsupported intersection kernel");
+  }
+}
@@ -22,6 +22,7 @@
 #include "galois/CommBackend.h"
 #include "galois/Logging.h"
 #include "galois/Statistics.h"
+#include "galois/Trace.h"
 #include "galois/substrate/SharedMem.h"
 #include "tsuba/FileStorage.h"
 #include "tsuba/tsuba.h"
@@ -43,9 +44,16 @@ galois::SharedMemSys::SharedMemSys() : impl_(std::make_unique<Impl>()) {
   }
 
   galois::internal::setSysStatManager(&impl_->stat_manager);
+
+  galois::TraceInitFromEnv();
 }
 
 galois::SharedMemSys::~SharedMemSys() {
+  if (auto trace_good = galois::TraceFiniFromEnv(); !trace_good) {
+    GALOIS_LOG_ERROR("writing trace: {}", trace_good.error());
+  }
+
+  galois::reportMemoryUsage("MemoryUsage");
   galois::PrintStats();
   galois::internal::setSysStatManager(nullptr);
 
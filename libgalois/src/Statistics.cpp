@@ -22,13 +22,19 @@
 #include <sys/resource.h>
 #include <sys/time.h>
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 
+#include <nlohmann/json.hpp>
+
 #include "galois/Env.h"
 #include "galois/Logging.h"
+#include "galois/MemoryAccounting.h"
+#include "galois/Strings.h"
 #include "galois/runtime/Executor_OnEach.h"
 #include "galois/substrate/PerThreadStorage.h"
+#include "galois/substrate/ThreadPool.h"
 
 namespace {
 
@@ -123,8 +129,49 @@ struct StatImpl {
       }
     }
   }
+
+  void PrintJson(nlohmann::json* stats) const {
+    for (auto i = result_.cbegin(), end_i = result_.cend(); i != end_i; ++i) {
+      const auto& s = result_.stat(i);
+      nlohmann::json values = nlohmann::json::array();
+      for (const auto& v : s.values()) {
+        values.push_back(ToJson(v));
+      }
+      stats->push_back({
+          {"kind", StatKind()},
+          {"region", ToJson(result_.region(i))},
+          {"category", ToJson(result_.category(i))},
+          {"total_type", galois::StatTotal::str(s.totalTy())},
+          {"total", ToJson(s.total())},
+          {"thread_values", std::move(values)},
+      });
+    }
+  }
+
+private:
+  template <typename U>
+  static U ToJson(const U& v) {
+    return v;
+  }
+
+  static std::string ToJson(const galois::gstl::Str& v) {
+    return std::string(v.begin(), v.end());
+  }
 };
 
+/// max / mean of the per-thread values of a statistic: 1 is perfectly
+/// balanced and the number of threads is as bad as it gets
+double
+Imbalance(const galois::gstl::Vector<int64_t>& values) {
+  int64_t sum = 0;
+  int64_t max = 0;
+  for (int64_t v : values) {
+    sum += v;
+    max = std::max(max, v);
+  }
+  return sum ? static_cast<double>(max) * values.size() / sum : 1.0;
+}
+
 }  // end unnamed namespace
 
 class galois::StatManager::Impl {
@@ -133,6 +180,45 @@ public:
   StatImpl<double> fp_stats_;
   StatImpl<Str> str_stats_;
   std::string outfile_;
+  bool derived_{};
+
+  /// Add statistics computed from the per-thread values of the scheduling
+  /// statistics of loops (see runtime/SchedulingStatistics.h)
+  void AddDerivedStats() {
+    if (derived_) {
+      return;
+    }
+    derived_ = true;
+
+    auto& ints = int_stats_.result_;
+    for (auto i = ints.cbegin(), end_i = ints.cend(); i != end_i; ++i) {
+      const Str& region = ints.region(i);
+      const Str& category = ints.category(i);
+      const auto& values = ints.stat(i).values();
+
+      if (category == "WorkItems") {
+        fp_stats_.result_.addToStat(
+            region, Str("WorkItemsImbalance"), Imbalance(values),
+            StatTotal::SINGLE);
+      } else if (category == "BusyTimeUs") {
+        fp_stats_.result_.addToStat(
+            region, Str("BusyTimeImbalance"), Imbalance(values),
+            StatTotal::SINGLE);
+
+        auto idle = ints.findStat(region, Str("IdleTimeUs"));
+        if (idle != ints.cend()) {
+          int64_t busy_us = ints.stat(i).total();
+          int64_t idle_us = ints.stat(idle).total();
+          double fraction =
+              busy_us + idle_us
+                  ? static_cast<double>(idle_us) / (busy_us + idle_us)
+                  : 0.0;
+          fp_stats_.result_.addToStat(
+              region, Str("IdleFraction"), fraction, StatTotal::SINGLE);
+        }
+      }
+    }
+  }
 };
 
 galois::StatManager::StatManager() { impl_ = std::make_unique<Impl>(); }
@@ -164,6 +250,18 @@ galois::StatManager::PrintStats(std::ostream& out) {
   impl_->str_stats_.Print(out, kSep, kThreadSep, kThreadNameSep);
 }
 
+void
+galois::StatManager::PrintStatsJson(std::ostream& out) {
+  MergeStats();
+
+  nlohmann::json stats = nlohmann::json::array();
+  impl_->int_stats_.PrintJson(&stats);
+  impl_->fp_stats_.PrintJson(&stats);
+  impl_->str_stats_.PrintJson(&stats);
+
+  out << nlohmann::json{{"stats", std::move(stats)}}.dump(2) << "\n";
+}
+
 auto
 galois::StatManager::int_cbegin() const -> int_const_iterator {
   return impl_->int_stats_.result_.cbegin();
@@ -199,6 +297,7 @@ galois::StatManager::MergeStats() {
   impl_->int_stats_.Merge();
   impl_->fp_stats_.Merge();
   impl_->str_stats_.Merge();
+  impl_->AddDerivedStats();
 }
 
 void
@@ -257,6 +356,9 @@ galois::StatManager::Print() {
     return PrintStats(std::cerr);
   }
 
+  if (HasSuffix(impl_->outfile_, ".json")) {
+    return PrintStatsJson(out);
+  }
   PrintStats(out);
 }
 
@@ -295,6 +397,60 @@ galois::reportPageAlloc(const char* category) {
       std::make_tuple());
 }
 
+void
+galois::reportMemoryUsage(const std::string& region) {
+  int sockets = std::min<int>(
+      substrate::GetThreadPool().getMaxSockets(), kMaxAccountedSockets);
+
+  for (size_t i = 0; i < kNumMemoryCategories; ++i) {
+    auto category = static_cast<MemoryCategory>(i);
+    MemoryUsage usage = GetMemoryUsage(category);
+    // Skip categories that were never used
+    if (usage.peak_bytes == 0) {
+      continue;
+    }
+    std::string name = MemoryCategoryName(category);
+    ReportStatMax(region, name + "Bytes", usage.bytes);
+    ReportStatMax(region, name + "PeakBytes", usage.peak_bytes);
+    for (int s = 0; s < sockets; ++s) {
+      MemoryUsage on_socket = GetMemoryUsage(category, s);
+      if (on_socket.peak_bytes == 0) {
+        continue;
+      }
+      std::string prefix = name + "Socket" + std::to_string(s);
+      ReportStatMax(region, prefix + "Bytes", on_socket.bytes);
+      ReportStatMax(region, prefix + "PeakBytes", on_socket.peak_bytes);
+    }
+  }
+
+  MemoryUsage total = GetTotalMemoryUsage();
+  ReportStatMax(region, "TotalBytes", total.bytes);
+  ReportStatMax(region, "TotalPeakBytes", total.peak_bytes);
+}
+
+void
+galois::sampleMemoryUsage(const char* loopname) {
+  static const bool sample_memory = GetEnv("GALOIS_SAMPLE_MEMORY");
+  if (sample_memory) {
+    reportMemoryUsage(loopname);
+  }
+}
+
+void
+galois::reportWakeupStats(const std::string& id) {
+  auto& tp = substrate::GetThreadPool();
+  substrate::ThreadPool::WakeupStats stats = tp.getWakeupStats();
+  tp.resetWakeupStats();
+
+  ReportStatSingle("ThreadPool", "Wakeups_" + id, stats.wakeups);
+  ReportStatSingle("ThreadPool", "Parks_" + id, stats.parks);
+  ReportStatSingle(
+      "ThreadPool", "WakeupLatencyAvgNs_" + id,
+      stats.wakeups ? stats.latency_sum_ns / stats.wakeups : 0);
+  ReportStatSingle(
+      "ThreadPool", "WakeupLatencyMaxNs_" + id, stats.latency_max_ns);
+}
+
 void
 galois::reportRUsage(const std::string& id) {
   // get rusage at this point in time
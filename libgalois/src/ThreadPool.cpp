@@ -19,11 +19,21 @@
 
 #include "galois/substrate/ThreadPool.h"
 
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 #include <algorithm>
+#include <chrono>
 #include <iostream>
 
+#include <fmt/format.h>
+
 #include "galois/Env.h"
 #include "galois/Logging.h"
+#include "galois/Trace.h"
 #include "galois/substrate/HWTopo.h"
 
 // Forward declare this to avoid including PerThreadStorage.
@@ -38,11 +48,98 @@ using galois::substrate::ThreadPool;
 
 thread_local ThreadPool::per_signal ThreadPool::my_box;
 
+namespace {
+
+/// Default bound on spinning before parking. Parking and waking a thread
+/// costs tens of microseconds, so spinning longer than that is not worth
+/// it.
+constexpr int kDefaultMaxSpinUs = 50;
+
+uint64_t
+NowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+}  // namespace
+
+void
+ThreadPool::per_signal::waitAdaptive(uint64_t maxSpinNs) {
+  uint64_t start = NowNs();
+  uint64_t deadline = start + spinNs;
+  bool parked = false;
+
+  for (unsigned i = 1; state.load(std::memory_order_acquire) != kReleased;
+       ++i) {
+    // Reading the clock is slower than a pause, so only check it now and
+    // then
+    if (i % 64 == 0 && NowNs() >= deadline) {
+      uint32_t expected = kIdle;
+      if (state.compare_exchange_strong(expected, kParked)) {
+        parked = true;
+        park();
+      }
+      break;
+    }
+    asmPause();
+  }
+  state.store(kIdle, std::memory_order_relaxed);
+
+  // Spin for about twice the recent gaps between parallel sections if they
+  // are short enough to spin through; otherwise back off
+  uint64_t gap = NowNs() - start;
+  if (gap <= maxSpinNs) {
+    spinNs = (spinNs + std::min(2 * gap, maxSpinNs)) / 2;
+  } else {
+    spinNs /= 2;
+  }
+  stats.parks += parked;
+}
+
+#ifdef __linux__
+
+void
+ThreadPool::per_signal::park() {
+  while (state.load(std::memory_order_acquire) == kParked) {
+    syscall(
+        SYS_futex, reinterpret_cast<uint32_t*>(&state), FUTEX_WAIT_PRIVATE,
+        kParked, nullptr, nullptr, 0);
+  }
+}
+
+void
+ThreadPool::per_signal::unpark() {
+  syscall(
+      SYS_futex, reinterpret_cast<uint32_t*>(&state), FUTEX_WAKE_PRIVATE, 1,
+      nullptr, nullptr, 0);
+}
+
+#else
+
+void
+ThreadPool::per_signal::park() {
+  std::unique_lock<std::mutex> lg(m);
+  cv.wait(lg, [this] { return state.load() != kParked; });
+}
+
+void
+ThreadPool::per_signal::unpark() {
+  std::lock_guard<std::mutex> lg(m);
+  cv.notify_one();
+}
+
+#endif
+
 ThreadPool::ThreadPool()
     : mi(getHWTopo().machineTopoInfo),
       reserved(0),
       masterFastmode(false),
       running(false) {
+  int max_spin_us = kDefaultMaxSpinUs;
+  GetEnv("GALOIS_MAX_SPIN_US", &max_spin_us);
+  maxSpinNs = static_cast<uint64_t>(std::max(max_spin_us, 0)) * 1000;
+
   signals.resize(mi.maxThreads);
   initThread(0);
 
@@ -130,6 +227,7 @@ void
 ThreadPool::initThread(unsigned tid) {
   signals[tid] = &my_box;
   my_box.topo = getHWTopo().threadTopoInfo[tid];
+  galois::TraceSetThreadName(fmt::format("galois-{}", tid));
   // Initialize
   substrate::initPTS(mi.maxThreads);
 
@@ -158,7 +256,11 @@ ThreadPool::threadLoop(unsigned tid) {
   bool fastmode = false;
   auto& me = my_box;
   do {
-    me.wait(fastmode);
+    me.wait(fastmode, maxSpinNs);
+    uint64_t latency = NowNs() - launchNs.load(std::memory_order_relaxed);
+    me.stats.wakeups += 1;
+    me.stats.latency_sum_ns += latency;
+    me.stats.latency_max_ns = std::max(me.stats.latency_max_ns, latency);
     cascade(fastmode);
     try {
       work();
@@ -181,23 +283,83 @@ ThreadPool::threadLoop(unsigned tid) {
   } while (true);
 }
 
+bool
+ThreadPool::popTask(per_signal& s, bool newest, Task* task) {
+  if (s.numTasks.load(std::memory_order_relaxed) == 0) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lg(s.taskLock);
+  if (s.tasks.empty()) {
+    return false;
+  }
+  if (newest) {
+    *task = std::move(s.tasks.back());
+    s.tasks.pop_back();
+  } else {
+    *task = std::move(s.tasks.front());
+    s.tasks.pop_front();
+  }
+  s.numTasks.fetch_sub(1, std::memory_order_relaxed);
+  queuedTasks.fetch_sub(1, std::memory_order_relaxed);
+  return true;
+}
+
+bool
+ThreadPool::runOneTask() {
+  auto& me = my_box;
+  Task task;
+  bool found = popTask(me, true, &task);
+  for (unsigned i = 1; !found && i < signals.size(); ++i) {
+    found = popTask(*signals[(me.topo.tid + i) % signals.size()], false, &task);
+  }
+  if (!found) {
+    return false;
+  }
+  task.fn();
+  task.pending->fetch_sub(1, std::memory_order_release);
+  return true;
+}
+
 void
-ThreadPool::decascade() {
+ThreadPool::spawnTask(Task task) {
   auto& me = my_box;
-  // nothing to wake up
-  if (me.wbegin != me.wend) {
-    auto midpoint = me.wbegin + (1 + me.wend - me.wbegin) / 2;
-    auto& c1done = signals[me.wbegin]->done;
-    while (!c1done) {
+  // Count before queueing so that counts never go below zero
+  queuedTasks.fetch_add(1, std::memory_order_relaxed);
+  me.numTasks.fetch_add(1, std::memory_order_relaxed);
+  std::lock_guard<std::mutex> lg(me.taskLock);
+  me.tasks.emplace_back(std::move(task));
+}
+
+void
+ThreadPool::waitTasks(const std::atomic<size_t>& pending) {
+  while (pending.load(std::memory_order_acquire) != 0) {
+    if (!runOneTask()) {
       asmPause();
     }
-    if (midpoint < me.wend) {
-      auto& c2done = signals[midpoint]->done;
-      while (!c2done) {
-        asmPause();
-      }
+  }
+}
+
+void
+ThreadPool::helpTasks() {
+  // Only help while there is queued work; threads that are still busy wait
+  // for their own tasks, so finishing early does not keep this core spinning
+  while (queuedTasks.load(std::memory_order_acquire) != 0) {
+    if (!runOneTask()) {
+      asmPause();
     }
   }
+}
+
+void
+ThreadPool::decascade() {
+  auto& me = my_box;
+  helpTasks();
+  forEachChild(me.wbegin, me.wend, [this](unsigned pos, unsigned, unsigned) {
+    auto& child_done = signals[wakeOrder[pos]]->done;
+    while (!child_done) {
+      asmPause();
+    }
+  });
   me.done = 1;
 }
 
@@ -206,23 +368,49 @@ ThreadPool::cascade(bool fastmode) {
   auto& me = my_box;
   assert(me.wbegin <= me.wend);
 
-  // nothing to wake up
-  if (me.wbegin == me.wend) {
-    return;
-  }
+  forEachChild(
+      me.wbegin, me.wend,
+      [this, fastmode](unsigned pos, unsigned begin, unsigned end) {
+        auto* child = signals[wakeOrder[pos]];
+        child->wbegin = begin;
+        child->wend = end;
+        child->wakeup(fastmode);
+      });
+}
 
-  auto midpoint = me.wbegin + (1 + me.wend - me.wbegin) / 2;
+void
+ThreadPool::computeWakeOrder(unsigned num) {
+  unsigned master_socket = signals[0]->topo.socket;
+  wakeOrder.resize(num);
+  for (unsigned i = 0; i < num; ++i) {
+    wakeOrder[i] = i;
+  }
+  std::stable_sort(
+      wakeOrder.begin() + 1, wakeOrder.end(), [&](unsigned a, unsigned b) {
+        unsigned sa = signals[a]->topo.socket;
+        unsigned sb = signals[b]->topo.socket;
+        return std::make_pair(sa != master_socket, sa) <
+               std::make_pair(sb != master_socket, sb);
+      });
+  wakeOrderNum = num;
+}
 
-  auto* child1 = signals[me.wbegin];
-  child1->wbegin = me.wbegin + 1;
-  child1->wend = midpoint;
-  child1->wakeup(fastmode);
+ThreadPool::WakeupStats
+ThreadPool::getWakeupStats() const {
+  WakeupStats ret;
+  for (per_signal* s : signals) {
+    ret.wakeups += s->stats.wakeups;
+    ret.parks += s->stats.parks;
+    ret.latency_sum_ns += s->stats.latency_sum_ns;
+    ret.latency_max_ns = std::max(ret.latency_max_ns, s->stats.latency_max_ns);
+  }
+  return ret;
+}
 
-  if (midpoint < me.wend) {
-    auto* child2 = signals[midpoint];
-    child2->wbegin = midpoint + 1;
-    child2->wend = me.wend;
-    child2->wakeup(fastmode);
+void
+ThreadPool::resetWakeupStats() {
+  for (per_signal* s : signals) {
+    s->stats = WakeupStats();
   }
 }
 
@@ -233,6 +421,9 @@ ThreadPool::runInternal(unsigned num) {
   GALOIS_LOG_VASSERT(!running, "Recursive thread pool execution not supported");
   running = true;
   num = std::min(std::max(1U, num), getMaxUsableThreads());
+  if (wakeOrderNum != num) {
+    computeWakeOrder(num);
+  }
   // my_box is tid 0
   auto& me = my_box;
   me.wbegin = 1;
@@ -240,6 +431,7 @@ ThreadPool::runInternal(unsigned num) {
 
   assert(!masterFastmode || masterFastmode == num);
   // launch threads
+  launchNs.store(NowNs(), std::memory_order_relaxed);
   cascade(masterFastmode);
   // Do master thread work
   try {
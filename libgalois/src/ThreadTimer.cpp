@@ -33,8 +33,8 @@ galois::ThreadTimers::reportTimes(const char* category, const char* region) {
   runtime::on_each_gen(
       [&](auto, auto) {
         auto ns = timers_.getLocal()->get_nsec();
+        assert(ns >= minTime && "negative time lag from min is impossible");
         auto lag = ns - minTime;
-        assert(lag > 0 && "negative time lag from min is impossible");
 
         ReportStatMax(region, timeCat.c_str(), ns / 1000000);
         ReportStatMax(region, lagCat.c_str(), lag / 1000000);
@@ -25,6 +25,8 @@
 using namespace galois::analytics;
 
 using Graph = BfsImplementation::Graph;
+using ProjectedGraph = ProjectedBfsImplementation::Graph;
+using CompressedGraph = CompressedBfsImplementation::Graph;
 
 constexpr static unsigned kChunkSize = 256U;
 
@@ -94,10 +96,11 @@ struct OneTilePushWrap {
   }
 };
 
-template <bool CONCURRENT, typename T, typename P, typename R>
+template <bool CONCURRENT, typename T, typename GraphTy, typename P, typename R>
 void
 AsyncAlgo(
-    Graph* graph, Graph::Node source, const P& pushWrap, const R& edgeRange) {
+    GraphTy* graph, typename GraphTy::Node source, const P& pushWrap,
+    const R& edgeRange) {
   namespace gwl = galois::worklists;
   // typedef PerSocketChunkFIFO<kChunkSize> dFIFO;
   using FIFO = gwl::PerSocketChunkFIFO<kChunkSize>;
@@ -116,7 +119,7 @@ AsyncAlgo(
   galois::GAccumulator<size_t> BadWork;
   galois::GAccumulator<size_t> WLEmptyWork;
 
-  graph->GetData<BfsNodeDistance>(source) = 0;
+  graph->template GetData<BfsNodeDistance>(source) = 0;
   galois::InsertBag<T> init_bag;
 
   if (CONCURRENT) {
@@ -128,7 +131,8 @@ AsyncAlgo(
   loop(
       galois::iterate(init_bag),
       [&](const T& item, auto& ctx) {
-        const auto& sdist = graph->GetData<BfsNodeDistance>(item.src);
+        const auto& sdist =
+            graph->template GetData<BfsNodeDistance>(item.src);
 
         if (kTrackWork) {
           if (item.dist != sdist) {
@@ -141,7 +145,7 @@ AsyncAlgo(
 
         for (auto ii : edgeRange(item)) {
           auto dest = graph->GetEdgeDest(ii);
-          auto& ddata = graph->GetData<BfsNodeDistance>(dest);
+          auto& ddata = graph->template GetData<BfsNodeDistance>(dest);
 
           while (true) {
             Dist old_dist = ddata;
@@ -177,10 +181,11 @@ AsyncAlgo(
   }
 }
 
-template <bool CONCURRENT, typename T, typename P, typename R>
+template <bool CONCURRENT, typename T, typename GraphTy, typename P, typename R>
 void
 SyncAlgo(
-    Graph* graph, Graph::Node source, const P& pushWrap, const R& edgeRange) {
+    GraphTy* graph, typename GraphTy::Node source, const P& pushWrap,
+    const R& edgeRange) {
   using Cont = typename std::conditional<
       CONCURRENT, galois::InsertBag<T>, galois::SerStack<T>>::type;
   using Loop = typename std::conditional<
@@ -192,7 +197,7 @@ SyncAlgo(
   auto next = std::make_unique<Cont>();
 
   Dist next_level = 0U;
-  graph->GetData<BfsNodeDistance>(source) = 0U;
+  graph->template GetData<BfsNodeDistance>(source) = 0U;
 
   if (CONCURRENT) {
     pushWrap(*next, source, "parallel");
@@ -212,7 +217,8 @@ SyncAlgo(
         [&](const T& item) {
           for (auto e : edgeRange(item)) {
             auto dest = graph->GetEdgeDest(e);
-            auto& dest_data = graph->GetData<BfsNodeDistance>(dest);
+            auto& dest_data =
+                graph->template GetData<BfsNodeDistance>(dest);
 
             if (dest_data == BfsImplementation::kDistanceInfinity) {
               dest_data = next_level;
@@ -251,6 +257,31 @@ RunAlgo(BfsPlan algo, Graph* graph, const Graph::Node& source) {
   }
 }
 
+/// RunUntiledAlgo runs BFS over a graph whose edge ranges are forward ranges
+/// (projected or compressed graphs). Such ranges cannot be split into tiles,
+/// so tiled plans run their untiled counterparts instead.
+template <typename Impl>
+void
+RunUntiledAlgo(
+    BfsPlan algo, typename Impl::Graph* graph,
+    const typename Impl::Graph::Node& source) {
+  switch (algo.algorithm()) {
+  case BfsPlan::kAsyncTile:
+  case BfsPlan::kAsync:
+    AsyncAlgo<true, typename Impl::UpdateRequest>(
+        graph, source, typename Impl::ReqPushWrap(),
+        typename Impl::OutEdgeRangeFn{graph});
+    break;
+  case BfsPlan::kSyncTile:
+  case BfsPlan::kSync:
+    SyncAlgo<true, typename Impl::Graph::Node>(
+        graph, source, NodePushWrap(), typename Impl::OutEdgeRangeFn{graph});
+    break;
+  default:
+    std::cerr << "ERROR: unkown algo type\n";
+  }
+}
+
 static galois::Result<void>
 BfsImpl(
     galois::graphs::PropertyGraph<std::tuple<BfsNodeDistance>, std::tuple<>>&
@@ -299,6 +330,86 @@ galois::analytics::Bfs(
   return BfsImpl(pg_result.value(), start_node, algo);
 }
 
+galois::Result<void>
+galois::analytics::Bfs(
+    galois::graphs::PropertyFileGraph* pfg,
+    const galois::graphs::ProjectedTopology& projection, size_t start_node,
+    const std::string& output_property_name, BfsPlan algo) {
+  if (!projection.ContainsOriginalNode(start_node)) {
+    return galois::ErrorCode::InvalidArgument;
+  }
+
+  if (auto result = ConstructNodeProperties<std::tuple<BfsNodeDistance>>(
+          pfg, {output_property_name});
+      !result) {
+    return result.error();
+  }
+
+  // Nodes outside of the projection are never visited, so initialize the
+  // whole output property rather than just the projected nodes.
+  auto pg_result = Graph::Make(pfg, {output_property_name}, {});
+  if (!pg_result) {
+    return pg_result.error();
+  }
+  Graph graph = pg_result.value();
+  galois::do_all(galois::iterate(graph.begin(), graph.end()), [&graph](auto n) {
+    graph.GetData<BfsNodeDistance>(n) = BfsImplementation::kDistanceInfinity;
+  });
+
+  auto projected_result =
+      ProjectedGraph::Make(pfg, &projection, {output_property_name}, {});
+  if (!projected_result) {
+    return projected_result.error();
+  }
+  ProjectedGraph projected = projected_result.value();
+
+  galois::StatTimer execTime("BFS");
+  execTime.start();
+
+  RunUntiledAlgo<ProjectedBfsImplementation>(
+      algo, &projected, projection.ProjectedNodeId(start_node));
+
+  execTime.stop();
+
+  return galois::ResultSuccess();
+}
+
+galois::Result<void>
+galois::analytics::Bfs(
+    galois::graphs::PropertyFileGraph* pfg,
+    const galois::graphs::CompressedTopology& topology, size_t start_node,
+    const std::string& output_property_name, BfsPlan algo) {
+  if (start_node >= topology.num_nodes()) {
+    return galois::ErrorCode::InvalidArgument;
+  }
+
+  if (auto result = ConstructNodeProperties<std::tuple<BfsNodeDistance>>(
+          pfg, {output_property_name});
+      !result) {
+    return result.error();
+  }
+
+  auto pg_result =
+      CompressedGraph::Make(pfg, &topology, {output_property_name}, {});
+  if (!pg_result) {
+    return pg_result.error();
+  }
+  CompressedGraph graph = pg_result.value();
+
+  galois::do_all(galois::iterate(graph.begin(), graph.end()), [&graph](auto n) {
+    graph.GetData<BfsNodeDistance>(n) = BfsImplementation::kDistanceInfinity;
+  });
+
+  galois::StatTimer execTime("BFS");
+  execTime.start();
+
+  RunUntiledAlgo<CompressedBfsImplementation>(algo, &graph, start_node);
+
+  execTime.stop();
+
+  return galois::ResultSuccess();
+}
+
 galois::Result<bool>
 galois::analytics::BfsValidate(
     graphs::PropertyFileGraph* pfg, const std::string& property_name) {
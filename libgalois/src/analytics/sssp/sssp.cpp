@@ -19,6 +19,8 @@
 
 #include "galois/analytics/sssp/sssp.h"
 
+#include "galois/graphs/EdgeBalancedRange.h"
+
 // Implementation
 
 namespace galois::analytics {
@@ -43,7 +45,6 @@ struct SsspImplementation : public galois::analytics::BfsSsspImplementationBase<
   using UpdateRequest = typename Base::UpdateRequest;
   using UpdateRequestIndexer = typename Base::UpdateRequestIndexer;
   using SrcEdgeTile = typename Base::SrcEdgeTile;
-  using SrcEdgeTileMaker = typename Base::SrcEdgeTileMaker;
   using SrcEdgeTilePushWrap = typename Base::SrcEdgeTilePushWrap;
   using ReqPushWrap = typename Base::ReqPushWrap;
   using OutEdgeRangeFn = typename Base::OutEdgeRangeFn;
@@ -58,6 +59,20 @@ struct SsspImplementation : public galois::analytics::BfsSsspImplementationBase<
       galois::worklists::OrderedByIntegerMetric<UpdateRequestIndexer, PSchunk>;
   using OBIMBarrier = typename galois::worklists::OrderedByIntegerMetric<
       UpdateRequestIndexer, PSchunk>::template with_barrier<true>::type;
+  using AdaptiveOBIM = galois::worklists::AdaptiveOrderedByIntegerMetric<
+      UpdateRequestIndexer, PSchunk>;
+  using MultiQueue = galois::worklists::MultiQueue<UpdateRequestIndexer>;
+
+  /// Worklist for DeltaStepAlgo. Adaptive worklists index by exact distance
+  /// and start with buckets of width 2^stepShift.
+  template <typename OBIMTy>
+  static auto MakeWorklist(unsigned stepShift) {
+    if constexpr (std::is_same_v<OBIMTy, AdaptiveOBIM>) {
+      return galois::wl<OBIMTy>(UpdateRequestIndexer{0}, stepShift);
+    } else {
+      return galois::wl<OBIMTy>(UpdateRequestIndexer{stepShift});
+    }
+  }
 
   template <typename T, typename OBIMTy = OBIM, typename P, typename R>
   static void DeltaStepAlgo(
@@ -102,8 +117,8 @@ struct SsspImplementation : public galois::analytics::BfsSsspImplementationBase<
             }
           }
         },
-        galois::wl<OBIMTy>(UpdateRequestIndexer{stepShift}),
-        galois::disable_conflict_detection(), galois::loopname("SSSP"));
+        MakeWorklist<OBIMTy>(stepShift), galois::disable_conflict_detection(),
+        galois::loopname("SSSP"));
 
     if (kTrackWork) {
       //! [report self-defined stats]
@@ -243,18 +258,25 @@ struct SsspImplementation : public galois::analytics::BfsSsspImplementationBase<
     galois::ReportStatSingle("SSSP-Topo", "rounds", rounds);
   }
 
-  void TopoTileAlgo(Graph* graph, const typename Graph::Node& source) {
-    galois::InsertBag<SrcEdgeTile> tiles;
+  /// TopoTileAlgo is TopoAlgo with the edges of each round statically split
+  /// into equal parts per thread. Hubs are split across threads, and the
+  /// split is cached on the topology, so rounds need neither stealing nor
+  /// tiling.
+  static void TopoTileAlgo(Graph* graph, const typename Graph::Node& source) {
+    const graphs::GraphTopology& topology =
+        graph->GetPropertyFileGraph().topology();
 
-    graph->template GetData<NodeDistance>(source) = 0;
+    galois::LargeArray<Dist> old_dist;
+    old_dist.allocateInterleaved(graph->size());
+    galois::LargeArray<uint8_t> active;
+    active.allocateInterleaved(graph->size());
 
     galois::do_all(
-        galois::iterate(*graph),
-        [&](const typename Graph::Node& n) {
-          Base::PushEdgeTiles(
-              tiles, graph, n, SrcEdgeTileMaker{n, kDistanceInfinity});
-        },
-        galois::steal(), galois::loopname("MakeTiles"));
+        galois::iterate(size_t{0}, graph->size()),
+        [&](size_t i) { old_dist.constructAt(i, kDistanceInfinity); },
+        galois::no_stats(), galois::loopname("initDistArray"));
+
+    graph->template GetData<NodeDistance>(source) = 0;
 
     galois::GReduceLogicalOr changed;
     size_t rounds = 0;
@@ -264,24 +286,34 @@ struct SsspImplementation : public galois::analytics::BfsSsspImplementationBase<
       changed.reset();
 
       galois::do_all(
-          galois::iterate(tiles),
-          [&](SrcEdgeTile& t) {
-            const auto& sdata = graph->template GetData<NodeDistance>(t.src);
-
-            if (t.dist > sdata) {
-              t.dist = sdata;
+          graphs::EdgeBalancedNodes(topology, 1),
+          [&](uint32_t n) {
+            const auto& sdata = graph->template GetData<NodeDistance>(n);
+            active[n] = old_dist[n] > sdata;
+            if (active[n]) {
+              old_dist[n] = sdata;
               changed.update(true);
+            }
+          },
+          galois::loopname("Activate"));
 
-              for (auto e = t.beg; e != t.end; ++e) {
-                const Weight new_dist =
-                    sdata + graph->template GetEdgeData<EdgeWeight>(e);
-                auto dest = graph->GetEdgeDest(e);
-                auto& ddata = graph->template GetData<NodeDistance>(dest);
-                galois::atomicMin(ddata, new_dist);
-              }
+      galois::do_all(
+          graphs::EdgeTileRange(topology),
+          [&](const graphs::EdgeTile& t) {
+            if (!active[t.node]) {
+              return;
+            }
+            const Dist sdata = old_dist[t.node];
+            for (typename Graph::edge_iterator e(t.begin), end(t.end); e != end;
+                 ++e) {
+              const Weight new_dist =
+                  sdata + graph->template GetEdgeData<EdgeWeight>(e);
+              auto dest = graph->GetEdgeDest(e);
+              auto& ddata = graph->template GetData<NodeDistance>(dest);
+              galois::atomicMin(ddata, new_dist);
             }
           },
-          galois::steal(), galois::loopname("Update"));
+          galois::loopname("Update"));
 
     } while (changed.reduce());
 
@@ -352,6 +384,15 @@ public:
       DeltaStepAlgo<UpdateRequest, OBIMBarrier>(
           &graph, source, ReqPushWrap(), OutEdgeRangeFn{&graph}, plan.delta());
       break;
+    case SsspPlan::kDeltaStepAdaptive:
+      DeltaStepAlgo<UpdateRequest, AdaptiveOBIM>(
+          &graph, source, ReqPushWrap(), OutEdgeRangeFn{&graph}, plan.delta());
+      break;
+    case SsspPlan::kMultiQueue:
+      // Index by exact distance
+      DeltaStepAlgo<UpdateRequest, MultiQueue>(
+          &graph, source, ReqPushWrap(), OutEdgeRangeFn{&graph}, 0);
+      break;
     default:
       return galois::ErrorCode::InvalidArgument;
     }
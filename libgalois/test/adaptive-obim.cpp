@@ -0,0 +1,155 @@
+#include <atomic>
+#include <functional>
+#include <queue>
+#include <random>
+#include <vector>
+
+#include "galois/AtomicHelpers.h"
+#include "galois/Galois.h"
+#include "galois/Logging.h"
+#include "galois/worklists/AdaptiveObim.h"
+
+namespace {
+
+/// Sixteen items per priority level
+struct GroupIndexer {
+  uint32_t operator()(uint32_t x) const { return x / 16; }
+};
+
+using WL = galois::worklists::AdaptiveOrderedByIntegerMetric<
+    GroupIndexer, galois::worklists::PerSocketChunkFIFO<16>>::retype<uint32_t>;
+
+/// Drain wl, checking that everything pushed comes out once
+void
+Drain(WL* wl, size_t num_items) {
+  std::vector<uint8_t> seen(num_items);
+  size_t popped = 0;
+  while (auto item = wl->pop()) {
+    GALOIS_LOG_ASSERT(*item < num_items && !seen[*item]);
+    seen[*item] = 1;
+    ++popped;
+  }
+  GALOIS_LOG_VASSERT(popped == num_items, "{} != {}", popped, num_items);
+}
+
+/// Sixteen items per bucket is too little work, so buckets should be merged
+void
+TestMerge() {
+  constexpr size_t kNumItems = 1 << 14;
+  WL wl(GroupIndexer(), 0);
+  for (uint32_t i = 0; i < kNumItems; ++i) {
+    wl.push(i);
+  }
+  Drain(&wl, kNumItems);
+  GALOIS_LOG_VASSERT(wl.shift() > 0, "shift {} should have grown", wl.shift());
+}
+
+/// All items in one huge bucket should make the bucket split
+void
+TestSplit() {
+  constexpr size_t kNumItems = 1 << 16;
+  constexpr unsigned kInitialShift = 20;
+  WL wl(GroupIndexer(), kInitialShift);
+  for (uint32_t i = 0; i < kNumItems; ++i) {
+    wl.push(i);
+  }
+  Drain(&wl, kNumItems);
+  GALOIS_LOG_VASSERT(
+      wl.shift() < kInitialShift, "shift {} should have shrunk", wl.shift());
+}
+
+struct Edge {
+  uint32_t dest;
+  uint32_t weight;
+};
+
+using Graph = std::vector<std::vector<Edge>>;
+
+struct Request {
+  uint32_t node;
+  uint32_t dist;
+};
+
+struct RequestIndexer {
+  uint32_t operator()(const Request& r) const { return r.dist; }
+};
+
+/// Label correcting SSSP on a random graph with weights in [1, max_weight]
+/// should reach the same distances as Dijkstra
+void
+TestSssp(uint32_t num_nodes, uint32_t max_weight) {
+  std::mt19937 gen(max_weight);
+  std::uniform_int_distribution<uint32_t> node(0, num_nodes - 1);
+  std::uniform_int_distribution<uint32_t> weight(1, max_weight);
+  Graph g(num_nodes);
+  for (uint32_t n = 0; n < num_nodes; ++n) {
+    for (int i = 0; i < 4; ++i) {
+      g[n].push_back({node(gen), weight(gen)});
+    }
+  }
+
+  std::vector<std::atomic<uint32_t>> dist(num_nodes);
+  for (auto& d : dist) {
+    d = std::numeric_limits<uint32_t>::max();
+  }
+  dist[0] = 0;
+
+  std::vector<Request> init{{0, 0}};
+  galois::for_each(
+      galois::iterate(init),
+      [&](const Request& req, auto& ctx) {
+        if (dist[req.node] < req.dist) {
+          return;
+        }
+        for (const Edge& e : g[req.node]) {
+          uint32_t new_dist = req.dist + e.weight;
+          if (new_dist < galois::atomicMin(dist[e.dest], new_dist)) {
+            ctx.push(Request{e.dest, new_dist});
+          }
+        }
+      },
+      galois::wl<galois::worklists::AdaptiveOrderedByIntegerMetric<
+          RequestIndexer>>(),
+      galois::disable_conflict_detection(), galois::no_stats());
+
+  using Item = std::pair<uint32_t, uint32_t>;
+  std::vector<uint32_t> expected(
+      num_nodes, std::numeric_limits<uint32_t>::max());
+  std::priority_queue<Item, std::vector<Item>, std::greater<Item>> pq;
+  expected[0] = 0;
+  pq.emplace(0, 0);
+  while (!pq.empty()) {
+    auto [d, n] = pq.top();
+    pq.pop();
+    if (d > expected[n]) {
+      continue;
+    }
+    for (const Edge& e : g[n]) {
+      if (d + e.weight < expected[e.dest]) {
+        expected[e.dest] = d + e.weight;
+        pq.emplace(expected[e.dest], e.dest);
+      }
+    }
+  }
+
+  for (size_t n = 0; n < num_nodes; ++n) {
+    GALOIS_LOG_VASSERT(
+        dist[n] == expected[n], "node {}: {} != {}", n, dist[n], expected[n]);
+  }
+}
+
+}  // namespace
+
+int
+main() {
+  galois::SharedMemSys sys;
+
+  TestMerge();
+  TestSplit();
+
+  galois::setActiveThreads(4);
+  TestSssp(10000, 10);
+  TestSssp(10000, 1000000);
+
+  return 0;
+}
@@ -0,0 +1,110 @@
+#include <cstdint>
+#include <map>
+#include <vector>
+
+#include "galois/Galois.h"
+#include "galois/Logging.h"
+#include "galois/Mem.h"
+#include "galois/substrate/PagePool.h"
+
+namespace {
+
+void
+TestArena() {
+  galois::Arena arena;
+
+  for (size_t alignment : {1, 8, 16, 64, 4096}) {
+    void* ptr = arena.allocate(3, alignment);
+    GALOIS_LOG_ASSERT(reinterpret_cast<uintptr_t>(ptr) % alignment == 0);
+  }
+
+  struct alignas(32) Wide {
+    int value;
+  };
+  Wide* wide = arena.create<Wide>(Wide{7});
+  GALOIS_LOG_ASSERT(reinterpret_cast<uintptr_t>(wide) % 32 == 0);
+  GALOIS_LOG_ASSERT(wide->value == 7);
+
+  // Bigger than a page
+  char* big = static_cast<char*>(arena.allocate(3 * (1 << 21)));
+  big[3 * (1 << 21) - 1] = 1;
+
+  using Alloc = galois::ArenaAllocator<std::pair<const int, int>>;
+  std::map<int, int, std::less<int>, Alloc> map{Alloc(&arena)};
+  for (int i = 0; i < 10000; ++i) {
+    map[i] = i;
+  }
+  GALOIS_LOG_ASSERT(map.size() == 10000 && map[1234] == 1234);
+  map.clear();
+
+  // Once warm, clearing and refilling takes no new pages
+  arena.clear();
+  int pages = galois::substrate::numPagePoolAllocTotal();
+  for (int round = 0; round < 10; ++round) {
+    std::vector<int, galois::ArenaAllocator<int>> values{
+        galois::ArenaAllocator<int>(&arena)};
+    for (int i = 0; i < 100000; ++i) {
+      values.push_back(i);
+    }
+    arena.clear();
+  }
+  GALOIS_LOG_ASSERT(galois::substrate::numPagePoolAllocTotal() == pages);
+
+#ifdef GALOIS_HAS_MEMORY_RESOURCE
+  std::pmr::vector<int> values(arena.resource());
+  for (int i = 0; i < 1000; ++i) {
+    values.push_back(i);
+  }
+  GALOIS_LOG_ASSERT(values[999] == 999);
+#endif
+}
+
+void
+TestLoops() {
+  galois::PerThreadArena arenas;
+  galois::GAccumulator<size_t> sum;
+  galois::do_all(galois::iterate(0, 1000), [&](int n) {
+    galois::Arena& arena = arenas.getLocal();
+    arena.clear();
+    galois::ArenaAllocator<int> alloc(&arena);
+    std::vector<int, galois::ArenaAllocator<int>> values(alloc);
+    for (int i = 0; i <= n; ++i) {
+      values.push_back(i);
+    }
+    sum += values.back();
+  });
+  arenas.clear();
+  GALOIS_LOG_ASSERT(sum.reduce() == 999 * 1000 / 2);
+
+  sum.reset();
+  galois::for_each(
+      galois::iterate(0, 1000),
+      [&](int n, auto& ctx) {
+        using Alloc = galois::PerIterAllocTy::rebind<int>::other;
+        std::vector<int, Alloc> values(ctx.getPerIterAlloc());
+        for (int i = 0; i <= n; ++i) {
+          values.push_back(i);
+        }
+        sum += values.back();
+#ifdef GALOIS_HAS_MEMORY_RESOURCE
+        std::pmr::vector<int> more(ctx.getPerIterResource());
+        more.assign(values.begin(), values.end());
+        GALOIS_LOG_ASSERT(more.back() == n);
+#endif
+      },
+      galois::per_iter_alloc(), galois::no_pushes());
+  GALOIS_LOG_ASSERT(sum.reduce() == 999 * 1000 / 2);
+}
+
+}  // namespace
+
+int
+main() {
+  galois::SharedMemSys sys;
+  galois::setActiveThreads(galois::substrate::GetThreadPool().getMaxThreads());
+
+  TestArena();
+  TestLoops();
+
+  return 0;
+}
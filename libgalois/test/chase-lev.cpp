@@ -0,0 +1,96 @@
+#include <atomic>
+#include <vector>
+
+#include "galois/Galois.h"
+#include "galois/Logging.h"
+#include "galois/worklists/ChaseLev.h"
+
+namespace {
+
+using Deque = galois::worklists::internal::ChaseLevDeque<uint32_t, 8>;
+
+/// Owner pops and thieves steal concurrently; every item should be taken
+/// exactly once
+void
+TestDeque(uint32_t num_items) {
+  Deque deque;
+  std::vector<std::atomic<uint32_t>> taken(num_items);
+  std::atomic<bool> done{false};
+
+  galois::on_each([&](unsigned tid, unsigned) {
+    auto take = [&](uint32_t item) {
+      GALOIS_LOG_ASSERT(item < num_items);
+      taken[item].fetch_add(1);
+    };
+
+    if (tid == 0) {
+      // Interleave pushes and pops so the deque crosses the point where the
+      // owner must synchronize with thieves many times
+      for (uint32_t i = 0; i < num_items; ++i) {
+        deque.push(i);
+        if (i % 3 == 0) {
+          if (auto item = deque.pop()) {
+            take(*item);
+          }
+        }
+      }
+      while (auto item = deque.pop()) {
+        take(*item);
+      }
+      done = true;
+      return;
+    }
+
+    std::vector<uint32_t> stolen;
+    while (!done || !deque.empty()) {
+      stolen.clear();
+      if (deque.stealHalf(&stolen)) {
+        GALOIS_LOG_ASSERT(!stolen.empty() && stolen.size() <= 8);
+        for (uint32_t item : stolen) {
+          take(item);
+        }
+      }
+    }
+  });
+
+  for (uint32_t i = 0; i < num_items; ++i) {
+    GALOIS_LOG_VASSERT(taken[i] == 1, "item {} taken {} times", i, taken[i]);
+  }
+}
+
+/// A binary tree of tasks grown from one root should visit every node once
+void
+TestTree(uint32_t depth) {
+  uint32_t num_nodes = (1U << depth) - 1;
+  std::vector<std::atomic<uint32_t>> visits(num_nodes);
+  std::vector<uint32_t> root{0};
+
+  galois::for_each(
+      galois::iterate(root),
+      [&](uint32_t node, auto& ctx) {
+        visits[node].fetch_add(1);
+        if (2 * node + 2 < num_nodes) {
+          ctx.push(2 * node + 1);
+          ctx.push(2 * node + 2);
+        }
+      },
+      galois::wl<galois::worklists::ChaseLevStealing<>>(),
+      galois::disable_conflict_detection(), galois::no_stats());
+
+  for (uint32_t i = 0; i < num_nodes; ++i) {
+    GALOIS_LOG_VASSERT(visits[i] == 1, "node {} visited {} times", i, visits[i]);
+  }
+}
+
+}  // namespace
+
+int
+main() {
+  galois::SharedMemSys sys;
+  galois::setActiveThreads(4);
+
+  TestDeque(1000000);
+  TestTree(18);
+
+  return 0;
+}
@@ -0,0 +1,140 @@
+#include <arrow/api.h>
+#include <arrow/type.h>
+#include <arrow/type_traits.h>
+
+#include "TestPropertyGraph.h"
+#include "galois/Logging.h"
+#include "galois/Properties.h"
+#include "galois/SharedMemSys.h"
+#include "galois/analytics/bfs/bfs.h"
+#include "galois/graphs/CompressedPropertyGraph.h"
+#include "galois/graphs/CompressedTopology.h"
+
+namespace gg = galois::graphs;
+
+using DataType = int64_t;
+
+struct Field0 {
+  using ViewType = galois::PODPropertyView<int64_t>;
+  using ArrowType = arrow::CTypeTraits<int64_t>::ArrowType;
+};
+
+using NodeType = std::tuple<Field0>;
+using EdgeType = std::tuple<Field0>;
+using Graph = gg::CompressedPropertyGraph<NodeType, EdgeType>;
+
+/// Decode every edge and compare with the uncompressed topology
+void
+TestRoundTrip(size_t num_nodes, Policy* policy) {
+  std::unique_ptr<gg::PropertyFileGraph> g =
+      MakeFileGraph<DataType>(num_nodes, 1, policy);
+  const gg::GraphTopology& topology = g->topology();
+
+  std::unique_ptr<gg::CompressedTopology> compressed =
+      gg::CompressedTopology::Make(topology);
+  GALOIS_LOG_VASSERT(
+      compressed->num_edges() == topology.num_edges(), "{} != {}",
+      compressed->num_edges(), topology.num_edges());
+
+  for (uint32_t n = 0; n < num_nodes; ++n) {
+    auto [begin, end] = topology.edge_range(n);
+    auto it = compressed->edge_begin(n);
+    for (auto e = begin; e != end; ++e, ++it) {
+      GALOIS_LOG_VASSERT(*it == e, "{} != {}", *it, e);
+      GALOIS_LOG_VASSERT(
+          it.dest() == topology.out_dests->Value(e), "edge {}: {} != {}", e,
+          it.dest(), topology.out_dests->Value(e));
+    }
+    GALOIS_LOG_ASSERT(it == compressed->edge_end(n));
+  }
+
+  GALOIS_LOG_ASSERT(compressed->Decompress().Equals(topology));
+}
+
+/// Line graphs have small deltas, so they should take one byte per edge
+void
+TestSize(size_t num_nodes) {
+  LinePolicy policy{4};
+
+  std::unique_ptr<gg::PropertyFileGraph> g =
+      MakeFileGraph<DataType>(num_nodes, 1, &policy);
+
+  std::unique_ptr<gg::CompressedTopology> compressed =
+      gg::CompressedTopology::Make(g->topology());
+
+  // Only the wrap-around edges of the last nodes need more than one byte
+  size_t max_bytes = g->topology().num_edges() + 4 * 5;
+  GALOIS_LOG_VASSERT(
+      compressed->num_bytes() <= max_bytes, "{} > {}",
+      compressed->num_bytes(), max_bytes);
+}
+
+void
+TestPropertyGraph(size_t num_nodes) {
+  RandomPolicy policy{5};
+
+  std::unique_ptr<gg::PropertyFileGraph> g =
+      MakeFileGraph<DataType>(num_nodes, 1, &policy);
+
+  std::unique_ptr<gg::CompressedTopology> compressed =
+      gg::CompressedTopology::Make(g->topology());
+
+  auto r = Graph::Make(g.get(), compressed.get());
+  GALOIS_LOG_ASSERT(r);
+  Graph graph = r.value();
+
+  // Properties from MakeFileGraph are all ones
+  size_t num_edges = 0;
+  DataType sum = 0;
+  for (auto node : graph) {
+    for (auto edge : graph.edges(node)) {
+      GALOIS_LOG_ASSERT(*graph.GetEdgeDest(edge) < graph.num_nodes());
+      sum += graph.GetEdgeData<Field0>(edge);
+      ++num_edges;
+    }
+  }
+  GALOIS_LOG_VASSERT(
+      num_edges == graph.num_edges(), "{} != {}", num_edges,
+      graph.num_edges());
+  GALOIS_LOG_VASSERT(
+      sum == DataType(num_edges), "{} != {}", sum, num_edges);
+}
+
+void
+TestBfs(size_t num_nodes) {
+  RandomPolicy policy{3};
+
+  std::unique_ptr<gg::PropertyFileGraph> g =
+      MakeFileGraph<DataType>(num_nodes, 1, &policy);
+
+  std::unique_ptr<gg::CompressedTopology> compressed =
+      gg::CompressedTopology::Make(g->topology());
+
+  GALOIS_LOG_ASSERT(galois::analytics::Bfs(g.get(), 0, "expected"));
+  GALOIS_LOG_ASSERT(galois::analytics::Bfs(
+      g.get(), *compressed, 0, "level", galois::analytics::BfsPlan::Sync()));
+
+  auto expected = g->NodePropertyTyped<uint32_t>("expected").value();
+  auto levels = g->NodePropertyTyped<uint32_t>("level").value();
+  for (size_t i = 0; i < num_nodes; ++i) {
+    GALOIS_LOG_VASSERT(
+        levels->Value(i) == expected->Value(i), "{}: {} != {}", i,
+        levels->Value(i), expected->Value(i));
+  }
+}
+
+int
+main() {
+  galois::SharedMemSys sys;
+
+  LinePolicy line{3};
+  RandomPolicy random{4};
+  TestRoundTrip(1, &line);
+  TestRoundTrip(1000, &line);
+  TestRoundTrip(1000, &random);
+  TestSize(1000);
+  TestPropertyGraph(1000);
+  TestBfs(1000);
+
+  return 0;
+}
@@ -0,0 +1,84 @@
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "galois/ConcurrentHashMap.h"
+#include "galois/Galois.h"
+
+namespace {
+
+void
+InitGalois() {
+  static galois::SharedMemSys sys;
+  [[maybe_unused]] static unsigned threads = galois::setActiveThreads(
+      galois::substrate::GetThreadPool().getMaxThreads());
+}
+
+constexpr size_t kUpdates = 1 << 22;
+
+/// Keys of kUpdates updates, drawn from num_keys keys spread over the range
+/// of uint64_t
+std::vector<uint64_t>
+MakeKeys(size_t num_keys) {
+  std::mt19937_64 gen(num_keys);
+  std::vector<uint64_t> keys(num_keys);
+  for (auto& k : keys) {
+    k = gen() >> 1;
+  }
+  std::uniform_int_distribution<size_t> pick(0, num_keys - 1);
+  std::vector<uint64_t> updates(kUpdates);
+  for (auto& u : updates) {
+    u = keys[pick(gen)];
+  }
+  return updates;
+}
+
+/// Count the occurrences of each key. Arguments are (number of keys,
+/// variant): variant 0 counts in per-thread std::unordered_maps that are
+/// merged serially, variant 1 upserts into one ConcurrentHashMap.
+void
+CountKeys(benchmark::State& state) {
+  InitGalois();
+  state.SetLabel(state.range(1) ? "ConcurrentHashMap" : "per-thread merge");
+  const size_t num_keys = state.range(0);
+  std::vector<uint64_t> updates = MakeKeys(num_keys);
+
+  for (auto _ : state) {
+    if (state.range(1)) {
+      galois::ConcurrentHashMap<uint64_t, uint64_t> counts(num_keys);
+      galois::do_all(galois::iterate(updates), [&](uint64_t key) {
+        counts.Upsert(key, 1, std::plus<uint64_t>());
+      });
+      benchmark::DoNotOptimize(counts.Size());
+    } else {
+      using LocalCounts = std::unordered_map<uint64_t, uint64_t>;
+      galois::substrate::PerThreadStorage<LocalCounts> local;
+      galois::do_all(galois::iterate(updates), [&](uint64_t key) {
+        ++(*local.getLocal())[key];
+      });
+      LocalCounts counts;
+      for (unsigned i = 0; i < local.size(); ++i) {
+        for (const auto& kv : *local.getRemote(i)) {
+          counts[kv.first] += kv.second;
+        }
+      }
+      benchmark::DoNotOptimize(counts.size());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * updates.size());
+}
+
+BENCHMARK(CountKeys)
+    ->Apply([](benchmark::internal::Benchmark* b) {
+      for (long num_keys : {1 << 10, 1 << 16, 1 << 20}) {
+        b->Args({num_keys, 0});
+        b->Args({num_keys, 1});
+      }
+    })
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace
+
+BENCHMARK_MAIN();
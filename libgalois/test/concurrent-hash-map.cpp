@@ -0,0 +1,144 @@
+#include "galois/ConcurrentHashMap.h"
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+#include "galois/Galois.h"
+#include "galois/Logging.h"
+
+namespace {
+
+using Map = galois::ConcurrentHashMap<uint64_t, uint64_t>;
+
+/// Keys spread over a large range, including keys that share their low bits
+uint64_t
+KeyOf(uint64_t i) {
+  return (i % 1000) << 32;
+}
+
+void
+TestInsert() {
+  constexpr uint64_t kNum = 100000;
+  Map map(kNum);
+
+  galois::GAccumulator<uint64_t> inserted;
+  galois::do_all(galois::iterate(uint64_t{0}, kNum), [&](uint64_t i) {
+    if (map.Insert(i / 2, i / 2 + 1)) {
+      inserted += 1;
+    }
+  });
+  GALOIS_LOG_ASSERT(inserted.reduce() == kNum / 2);
+  GALOIS_LOG_ASSERT(map.Size() == kNum / 2);
+
+  galois::do_all(galois::iterate(uint64_t{0}, kNum / 2), [&](uint64_t k) {
+    GALOIS_LOG_ASSERT(map.Find(k).value() == k + 1);
+    GALOIS_LOG_ASSERT(!map.Contains(k + kNum));
+  });
+  GALOIS_LOG_ASSERT(!map.Insert(7, 0));
+  GALOIS_LOG_ASSERT(map.Find(7).value() == 8);
+}
+
+void
+TestUpsert() {
+  constexpr uint64_t kNum = 200000;
+  Map counts(1000);
+
+  galois::do_all(galois::iterate(uint64_t{0}, kNum), [&](uint64_t i) {
+    counts.Upsert(KeyOf(i), 1, std::plus<uint64_t>());
+  });
+  GALOIS_LOG_ASSERT(counts.Size() == 1000);
+  for (uint64_t i = 0; i < 1000; ++i) {
+    GALOIS_LOG_ASSERT(counts.Find(KeyOf(i)).value() == kNum / 1000);
+  }
+
+  // Initial values other than zero, e.g., for a minimum
+  Map first(1000, Map::kEmptyKey);
+  galois::do_all(galois::iterate(uint64_t{0}, kNum), [&](uint64_t i) {
+    first.Upsert(KeyOf(i), i, galois::gmin<uint64_t>());
+  });
+  for (uint64_t i = 0; i < 1000; ++i) {
+    GALOIS_LOG_ASSERT(first.Find(KeyOf(i)).value() == i);
+  }
+}
+
+void
+TestIterate() {
+  constexpr uint64_t kNum = 5000;
+  Map map(kNum);
+  galois::do_all(galois::iterate(uint64_t{0}, kNum), [&](uint64_t i) {
+    map.Insert(KeyOf(i) + i, i);
+  });
+
+  galois::GAccumulator<uint64_t> count;
+  galois::GAccumulator<uint64_t> sum;
+  map.ForEach([&](uint64_t key, uint64_t value) {
+    GALOIS_LOG_ASSERT(key == KeyOf(value) + value);
+    count += 1;
+    sum += value;
+  });
+  GALOIS_LOG_ASSERT(count.reduce() == kNum);
+  GALOIS_LOG_ASSERT(sum.reduce() == kNum * (kNum - 1) / 2);
+
+  auto pairs = map.ToVector();
+  GALOIS_LOG_ASSERT(pairs.size() == kNum);
+  std::sort(pairs.begin(), pairs.end(), [](const auto& a, const auto& b) {
+    return a.second < b.second;
+  });
+  for (uint64_t i = 0; i < kNum; ++i) {
+    GALOIS_LOG_ASSERT(pairs[i].first == KeyOf(i) + i);
+    GALOIS_LOG_ASSERT(pairs[i].second == i);
+  }
+}
+
+void
+TestRebuild() {
+  Map map;
+  GALOIS_LOG_ASSERT(map.Empty());
+  size_t capacity = map.Capacity();
+
+  // Grow between loops as the number of keys increases
+  uint64_t num = 0;
+  for (uint64_t round = 1; round <= 5; ++round) {
+    uint64_t next = round * 10000;
+    map.Reserve(next);
+    galois::do_all(galois::iterate(num, next), [&](uint64_t i) {
+      map.Upsert(i, i, std::plus<uint64_t>());
+    });
+    num = next;
+  }
+  GALOIS_LOG_ASSERT(map.Capacity() > capacity);
+  GALOIS_LOG_ASSERT(map.Size() == num);
+  galois::do_all(galois::iterate(uint64_t{0}, num), [&](uint64_t i) {
+    GALOIS_LOG_ASSERT(map.Find(i).value() == i);
+  });
+
+  capacity = map.Capacity();
+  map.Rebuild(4 * num);
+  GALOIS_LOG_ASSERT(map.Capacity() > capacity);
+  GALOIS_LOG_ASSERT(map.Size() == num);
+  GALOIS_LOG_ASSERT(map.Find(num - 1).value() == num - 1);
+
+  map.Clear();
+  GALOIS_LOG_ASSERT(map.Empty());
+  GALOIS_LOG_ASSERT(!map.Contains(0));
+  GALOIS_LOG_ASSERT(map.ToVector().empty());
+}
+
+}  // namespace
+
+int
+main() {
+  galois::SharedMemSys sys;
+  unsigned max_threads = galois::substrate::GetThreadPool().getMaxThreads();
+
+  for (unsigned threads : {1u, std::max(max_threads, 4u)}) {
+    galois::setActiveThreads(threads);
+    TestInsert();
+    TestUpsert();
+    TestIterate();
+    TestRebuild();
+  }
+
+  return 0;
+}
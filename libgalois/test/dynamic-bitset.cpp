@@ -0,0 +1,154 @@
+#include "galois/DynamicBitset.h"
+
+#include <algorithm>
+#include <mutex>
+#include <random>
+#include <vector>
+
+#include "galois/Galois.h"
+#include "galois/Logging.h"
+
+namespace {
+
+std::vector<bool>
+MakeBits(size_t size, double density, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::bernoulli_distribution dist(density);
+  std::vector<bool> bits(size);
+  for (size_t i = 0; i < size; ++i) {
+    bits[i] = dist(gen);
+  }
+  return bits;
+}
+
+std::vector<uint64_t>
+Offsets(const std::vector<bool>& bits) {
+  std::vector<uint64_t> offsets;
+  for (size_t i = 0; i < bits.size(); ++i) {
+    if (bits[i]) {
+      offsets.push_back(i);
+    }
+  }
+  return offsets;
+}
+
+void
+AssertEqual(
+    const galois::DynamicBitset& bitset, const std::vector<bool>& bits) {
+  GALOIS_LOG_ASSERT(bitset.size() == bits.size());
+  for (size_t i = 0; i < bits.size(); ++i) {
+    GALOIS_LOG_ASSERT(bitset.test(i) == bits[i]);
+  }
+}
+
+template <typename Op>
+void
+TestBinary(
+    const std::vector<bool>& a, const std::vector<bool>& b,
+    void (galois::DynamicBitset::*in_place)(const galois::DynamicBitset&),
+    void (galois::DynamicBitset::*two)(
+        const galois::DynamicBitset&, const galois::DynamicBitset&),
+    Op op) {
+  std::vector<bool> expected(a.size());
+  for (size_t i = 0; i < a.size(); ++i) {
+    expected[i] = op(a[i], b[i]);
+  }
+
+  galois::DynamicBitset bits_a;
+  bits_a.setOffsets(a.size(), Offsets(a));
+  galois::DynamicBitset bits_b;
+  bits_b.setOffsets(b.size(), Offsets(b));
+
+  galois::DynamicBitset result;
+  result.resize(a.size());
+  (result.*two)(bits_a, bits_b);
+  AssertEqual(result, expected);
+
+  (bits_a.*in_place)(bits_b);
+  AssertEqual(bits_a, expected);
+}
+
+void
+Test(size_t size, double density) {
+  std::vector<bool> a = MakeBits(size, density, size);
+  std::vector<bool> b = MakeBits(size, 0.5, size + 1);
+  std::vector<uint64_t> offsets = Offsets(a);
+
+  galois::DynamicBitset bitset;
+  bitset.setOffsets(size, offsets);
+  AssertEqual(bitset, a);
+  GALOIS_LOG_ASSERT(bitset.count() == offsets.size());
+  GALOIS_LOG_ASSERT(bitset.any() == !offsets.empty());
+  GALOIS_LOG_ASSERT(bitset.none() == offsets.empty());
+  GALOIS_LOG_ASSERT(bitset.getOffsets<uint64_t>() == offsets);
+  std::vector<uint32_t> offsets32(offsets.begin(), offsets.end());
+  GALOIS_LOG_ASSERT(bitset.getOffsets<uint32_t>() == offsets32);
+
+  // Iterating set bits, serially and in parallel
+  std::vector<uint64_t> found;
+  bitset.for_each_set([&](size_t i) { found.push_back(i); });
+  GALOIS_LOG_ASSERT(found == offsets);
+
+  found.clear();
+  std::mutex mutex;
+  bitset.parallel_for_each_set([&](size_t i) {
+    std::lock_guard<std::mutex> lock(mutex);
+    found.push_back(i);
+  });
+  std::sort(found.begin(), found.end());
+  GALOIS_LOG_ASSERT(found == offsets);
+
+  found.clear();
+  for (size_t i = bitset.find_first(); i < bitset.size();
+       i = bitset.find_next(i + 1)) {
+    found.push_back(i);
+  }
+  GALOIS_LOG_ASSERT(found == offsets);
+  GALOIS_LOG_ASSERT(bitset.find_next(size) == size);
+
+  TestBinary(
+      a, b, &galois::DynamicBitset::bitwise_or,
+      &galois::DynamicBitset::bitwise_or,
+      [](bool x, bool y) { return x || y; });
+  TestBinary(
+      a, b, &galois::DynamicBitset::bitwise_and,
+      &galois::DynamicBitset::bitwise_and,
+      [](bool x, bool y) { return x && y; });
+  TestBinary(
+      a, b, &galois::DynamicBitset::bitwise_xor,
+      &galois::DynamicBitset::bitwise_xor,
+      [](bool x, bool y) { return x != y; });
+  TestBinary(
+      a, b, &galois::DynamicBitset::bitwise_andnot,
+      &galois::DynamicBitset::bitwise_andnot,
+      [](bool x, bool y) { return x && !y; });
+
+  // Setting sorted ids adds to the bits already set
+  galois::DynamicBitset merged;
+  merged.resize(size);
+  std::vector<uint64_t> other = Offsets(b);
+  merged.set_sorted(other.begin(), other.end());
+  merged.set_sorted(offsets.begin(), offsets.end());
+  for (size_t i = 0; i < size; ++i) {
+    GALOIS_LOG_ASSERT(merged.test(i) == (a[i] || b[i]));
+  }
+}
+
+}  // namespace
+
+int
+main() {
+  galois::SharedMemSys sys;
+  unsigned max_threads = galois::substrate::GetThreadPool().getMaxThreads();
+
+  for (unsigned threads : {1u, std::max(max_threads, 4u)}) {
+    galois::setActiveThreads(threads);
+    for (size_t size : {0, 1, 63, 64, 65, 1000, 100000, 1 << 20}) {
+      for (double density : {0.0, 0.001, 0.5, 1.0}) {
+        Test(size, density);
+      }
+    }
+  }
+
+  return 0;
+}
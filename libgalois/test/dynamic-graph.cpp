@@ -0,0 +1,216 @@
+#include <algorithm>
+#include <vector>
+
+#include <arrow/api.h>
+#include <arrow/type.h>
+#include <arrow/type_traits.h>
+
+#include "TestPropertyGraph.h"
+#include "galois/Logging.h"
+#include "galois/Properties.h"
+#include "galois/SharedMemSys.h"
+#include "galois/graphs/DynamicPropertyGraph.h"
+#include "galois/graphs/DynamicTopology.h"
+
+namespace gg = galois::graphs;
+
+using DataType = int64_t;
+
+struct Field0 {
+  using ViewType = galois::PODPropertyView<int64_t>;
+  using ArrowType = arrow::CTypeTraits<int64_t>::ArrowType;
+};
+
+using NodeType = std::tuple<Field0>;
+using EdgeType = std::tuple<Field0>;
+using Graph = gg::DynamicPropertyGraph<NodeType, EdgeType>;
+
+using Edge = gg::DynamicTopology::Edge;
+using Reference = std::vector<std::vector<uint32_t>>;
+
+Reference
+MakeReference(const gg::GraphTopology& topology) {
+  Reference ref(topology.num_nodes());
+  for (uint32_t n = 0; n < topology.num_nodes(); ++n) {
+    auto [begin, end] = topology.edge_range(n);
+    for (auto e = begin; e != end; ++e) {
+      ref[n].push_back(topology.out_dests->Value(e));
+    }
+  }
+  return ref;
+}
+
+void
+CheckEqual(const gg::DynamicTopology& topology, Reference ref) {
+  size_t num_edges = 0;
+  for (uint32_t n = 0; n < topology.num_nodes(); ++n) {
+    std::vector<uint32_t> dests;
+    for (auto it = topology.edge_begin(n); it != topology.edge_end(n); ++it) {
+      dests.push_back(topology.edge_dest(*it));
+    }
+    std::sort(dests.begin(), dests.end());
+    std::sort(ref[n].begin(), ref[n].end());
+    GALOIS_LOG_VASSERT(dests == ref[n], "edges of node {} differ", n);
+    GALOIS_LOG_VASSERT(
+        topology.degree(n) == dests.size(), "{} != {}", topology.degree(n),
+        dests.size());
+    num_edges += dests.size();
+  }
+  GALOIS_LOG_VASSERT(
+      topology.num_edges() == num_edges, "{} != {}", topology.num_edges(),
+      num_edges);
+}
+
+/// Insert and delete batches on a line graph, checking against a simple
+/// adjacency list, and then compact.
+void
+TestUpdates(size_t num_nodes, size_t line_width) {
+  LinePolicy policy{line_width};
+
+  std::unique_ptr<gg::PropertyFileGraph> g =
+      MakeFileGraph<DataType>(num_nodes, 1, &policy);
+
+  std::unique_ptr<gg::DynamicTopology> topology =
+      gg::DynamicTopology::Make(g->topology());
+  Reference ref = MakeReference(g->topology());
+
+  std::vector<Edge> insertions;
+  for (uint32_t n = 0; n < num_nodes; n += 3) {
+    uint32_t dest = (n * 7 + 1) % num_nodes;
+    insertions.emplace_back(n, dest);
+    insertions.emplace_back(n, dest);
+    ref[n].push_back(dest);
+    ref[n].push_back(dest);
+  }
+  GALOIS_LOG_ASSERT(topology->InsertEdges(insertions));
+  CheckEqual(*topology, ref);
+
+  // Delete the first line edge of every other node and the inserted edges of
+  // every sixth node
+  std::vector<Edge> deletions;
+  for (uint32_t n = 0; n < num_nodes; n += 2) {
+    uint32_t dest = (n + 1) % num_nodes;
+    deletions.emplace_back(n, dest);
+    ref[n].erase(std::remove(ref[n].begin(), ref[n].end(), dest), ref[n].end());
+  }
+  for (uint32_t n = 0; n < num_nodes; n += 6) {
+    uint32_t dest = (n * 7 + 1) % num_nodes;
+    deletions.emplace_back(n, dest);
+    ref[n].erase(std::remove(ref[n].begin(), ref[n].end(), dest), ref[n].end());
+  }
+  GALOIS_LOG_ASSERT(topology->DeleteEdges(deletions));
+  CheckEqual(*topology, ref);
+  GALOIS_LOG_ASSERT(!topology->is_compacted());
+
+  GALOIS_LOG_ASSERT(topology->Compact());
+  GALOIS_LOG_ASSERT(topology->is_compacted());
+  GALOIS_LOG_VASSERT(
+      topology->base_topology().num_edges() == topology->num_edges(),
+      "{} != {}", topology->base_topology().num_edges(),
+      topology->num_edges());
+  CheckEqual(*topology, ref);
+
+  // Keep updating after compaction
+  GALOIS_LOG_ASSERT(topology->InsertEdges({{0, 1}}));
+  ref[0].push_back(1);
+  CheckEqual(*topology, ref);
+}
+
+/// Iterate through the PropertyGraph interface; only base edges have
+/// properties.
+void
+TestPropertyGraph(size_t num_nodes, size_t line_width) {
+  LinePolicy policy{line_width};
+
+  std::unique_ptr<gg::PropertyFileGraph> g =
+      MakeFileGraph<DataType>(num_nodes, 1, &policy);
+
+  std::unique_ptr<gg::DynamicTopology> topology =
+      gg::DynamicTopology::Make(g->topology());
+  GALOIS_LOG_ASSERT(topology->InsertEdges({{0, 2}, {1, 3}, {1, 4}}));
+
+  auto r = Graph::Make(g.get(), topology.get());
+  GALOIS_LOG_ASSERT(r);
+  Graph graph = r.value();
+
+  size_t num_base = 0;
+  size_t num_delta = 0;
+  DataType sum = 0;
+  for (auto node : graph) {
+    for (auto edge : graph.edges(node)) {
+      GALOIS_LOG_ASSERT(*graph.GetEdgeDest(edge) < graph.num_nodes());
+      if (gg::DynamicTopology::IsDeltaEdge(*edge)) {
+        ++num_delta;
+      } else {
+        ++num_base;
+        sum += graph.GetEdgeData<Field0>(edge);
+      }
+    }
+  }
+
+  // Properties from MakeFileGraph are all ones
+  size_t expected_base = num_nodes * line_width;
+  GALOIS_LOG_VASSERT(num_delta == 3, "{} != 3", num_delta);
+  GALOIS_LOG_VASSERT(
+      num_base == expected_base, "{} != {}", num_base, expected_base);
+  GALOIS_LOG_VASSERT(
+      sum == DataType(expected_base), "{} != {}", sum, expected_base);
+  GALOIS_LOG_VASSERT(
+      graph.num_edges() == num_base + num_delta, "{} != {}",
+      graph.num_edges(), num_base + num_delta);
+}
+
+void
+TestBadBatch(size_t num_nodes) {
+  LinePolicy policy{1};
+
+  std::unique_ptr<gg::PropertyFileGraph> g =
+      MakeFileGraph<DataType>(num_nodes, 1, &policy);
+
+  std::unique_ptr<gg::DynamicTopology> topology =
+      gg::DynamicTopology::Make(g->topology());
+
+  auto r = topology->InsertEdges({{0, 1}, {0, uint32_t(num_nodes)}});
+  GALOIS_LOG_VASSERT(
+      !r && r.error() == galois::ErrorCode::InvalidArgument,
+      "Should return InvalidArgument for out of range endpoint");
+  GALOIS_LOG_ASSERT(topology->is_compacted());
+}
+
+void
+TestCompactInto(size_t num_nodes) {
+  LinePolicy policy{2};
+
+  std::unique_ptr<gg::PropertyFileGraph> g =
+      MakeFileGraph<DataType>(num_nodes, 1, &policy);
+
+  std::unique_ptr<gg::DynamicTopology> topology =
+      gg::DynamicTopology::Make(g->topology());
+  GALOIS_LOG_ASSERT(topology->InsertEdges({{0, 3}}));
+
+  auto r = topology->CompactInto(g.get());
+  GALOIS_LOG_VASSERT(
+      !r && r.error() == galois::ErrorCode::InvalidArgument,
+      "Should not compact into a graph with edge properties");
+
+  GALOIS_LOG_ASSERT(g->RemoveEdgeProperty(0));
+  GALOIS_LOG_ASSERT(topology->CompactInto(g.get()));
+
+  size_t expected = num_nodes * 2 + 1;
+  GALOIS_LOG_VASSERT(
+      g->topology().num_edges() == expected, "{} != {}",
+      g->topology().num_edges(), expected);
+}
+
+int
+main() {
+  galois::SharedMemSys sys;
+
+  TestUpdates(10, 2);
+  TestUpdates(1000, 5);
+  TestPropertyGraph(100, 3);
+  TestBadBatch(10);
+  TestCompactInto(100);
+
+  return 0;
+}
@@ -0,0 +1,146 @@
+#include <atomic>
+#include <vector>
+
+#include "TestPropertyGraph.h"
+#include "galois/Galois.h"
+#include "galois/Logging.h"
+#include "galois/SharedMemSys.h"
+#include "galois/graphs/EdgeBalancedRange.h"
+
+namespace gg = galois::graphs;
+
+/// Every stride-th node is a hub connected to all nodes; the rest have no
+/// edges
+class HubPolicy : public Policy {
+  size_t stride_{};
+
+public:
+  HubPolicy(size_t stride) : stride_(stride) {}
+
+  std::vector<uint32_t> GenerateNeighbors(
+      size_t node_id, size_t num_nodes) override {
+    std::vector<uint32_t> r;
+    if (node_id % stride_ == 0) {
+      for (size_t i = 0; i < num_nodes; ++i) {
+        r.emplace_back(i);
+      }
+    }
+    return r;
+  }
+};
+
+/// Blocks should cover all nodes in order, and no block should be heavier
+/// than its share by more than one node
+void
+TestNodeRanges(const gg::GraphTopology& topology, uint32_t node_weight) {
+  for (uint32_t num_blocks : {1, 2, 3, 8, 64}) {
+    std::vector<uint32_t> ranges =
+        topology.EdgeBalancedNodeRanges(num_blocks, node_weight);
+    GALOIS_LOG_ASSERT(ranges.size() == num_blocks + 1);
+    GALOIS_LOG_ASSERT(ranges.front() == 0);
+    GALOIS_LOG_ASSERT(ranges.back() == topology.num_nodes());
+
+    uint64_t total = topology.num_edges() + node_weight * topology.num_nodes();
+    uint64_t max_node = 0;
+    for (uint32_t n = 0; n < topology.num_nodes(); ++n) {
+      auto [begin, end] = topology.edge_range(n);
+      max_node = std::max(max_node, end - begin + node_weight);
+    }
+
+    for (uint32_t b = 0; b < num_blocks; ++b) {
+      GALOIS_LOG_ASSERT(ranges[b] <= ranges[b + 1]);
+      uint64_t weight = 0;
+      for (uint32_t n = ranges[b]; n < ranges[b + 1]; ++n) {
+        auto [begin, end] = topology.edge_range(n);
+        weight += end - begin + node_weight;
+      }
+      GALOIS_LOG_VASSERT(
+          weight <= total / num_blocks + max_node + 1,
+          "block {} of {} has weight {} of {}", b, num_blocks, weight, total);
+    }
+
+    // A second call should be served from the cache
+    GALOIS_LOG_ASSERT(
+        topology.EdgeBalancedNodeRanges(num_blocks, node_weight) == ranges);
+  }
+}
+
+/// Tiles should visit every edge exactly once
+void
+TestTiles(const gg::GraphTopology& topology) {
+  for (uint32_t num_tiles : {1, 2, 3, 8, 64}) {
+    std::vector<std::pair<uint32_t, uint32_t>> tiles =
+        topology.EdgeTileNodeRanges(num_tiles);
+    GALOIS_LOG_ASSERT(tiles.size() == num_tiles);
+
+    std::vector<uint32_t> visits(topology.num_edges());
+    for (uint32_t t = 0; t < num_tiles; ++t) {
+      uint64_t lo = topology.num_edges() * t / num_tiles;
+      uint64_t hi = topology.num_edges() * (t + 1) / num_tiles;
+      for (uint32_t n = tiles[t].first; n < tiles[t].second; ++n) {
+        auto [begin, end] = topology.edge_range(n);
+        for (auto e = std::max(begin, lo); e < std::min(end, hi); ++e) {
+          ++visits[e];
+        }
+      }
+    }
+    for (uint64_t e = 0; e < visits.size(); ++e) {
+      GALOIS_LOG_VASSERT(
+          visits[e] == 1, "edge {} visited {} times with {} tiles", e,
+          visits[e], num_tiles);
+    }
+  }
+}
+
+/// Run the ranges through do_all
+void
+TestLoops(const gg::GraphTopology& topology) {
+  std::vector<std::atomic<uint32_t>> node_visits(topology.num_nodes());
+  galois::do_all(
+      gg::EdgeBalancedNodes(topology),
+      [&](uint32_t n) { node_visits[n].fetch_add(1); }, galois::no_stats());
+  for (uint32_t n = 0; n < topology.num_nodes(); ++n) {
+    GALOIS_LOG_VASSERT(node_visits[n] == 1, "node {} not visited once", n);
+  }
+
+  std::vector<std::atomic<uint32_t>> edge_visits(topology.num_edges());
+  galois::do_all(
+      gg::EdgeTileRange(topology),
+      [&](const gg::EdgeTile& t) {
+        for (auto e = t.begin; e < t.end; ++e) {
+          edge_visits[e].fetch_add(1);
+        }
+      },
+      galois::no_stats());
+  for (uint64_t e = 0; e < topology.num_edges(); ++e) {
+    GALOIS_LOG_VASSERT(edge_visits[e] == 1, "edge {} not visited once", e);
+  }
+}
+
+void
+Test(size_t num_nodes, Policy* policy) {
+  std::unique_ptr<gg::PropertyFileGraph> g =
+      MakeFileGraph<uint32_t>(num_nodes, 1, policy);
+  const gg::GraphTopology& topology = g->topology();
+
+  TestNodeRanges(topology, 0);
+  TestNodeRanges(topology, 1);
+  TestTiles(topology);
+  TestLoops(topology);
+}
+
+int
+main() {
+  galois::SharedMemSys sys;
+  galois::setActiveThreads(8);
+
+  LinePolicy line{3};
+  RandomPolicy random{4};
+  HubPolicy hubs{100};
+  Test(1, &line);
+  Test(1000, &line);
+  Test(1000, &random);
+  Test(1000, &hubs);
+
+  return 0;
+}
@@ -0,0 +1,192 @@
+#include "galois/graphs/Frontier.h"
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "galois/Galois.h"
+#include "galois/Logging.h"
+#include "galois/graphs/LC_CSR_CSC_Graph.h"
+#include "galois/graphs/LC_CSR_Graph.h"
+
+namespace {
+
+constexpr uint32_t kInfinity = std::numeric_limits<uint32_t>::max();
+
+using EdgeList = std::vector<std::pair<uint32_t, uint32_t>>;
+
+/// A random graph with a few hubs so that BFS frontiers grow quickly
+EdgeList
+MakeEdges(uint32_t num_nodes, uint32_t degree) {
+  std::mt19937 gen(7);
+  std::uniform_int_distribution<uint32_t> node(0, num_nodes - 1);
+  std::uniform_int_distribution<uint32_t> hub(0, 15);
+  EdgeList edges;
+  for (uint32_t src = 0; src < num_nodes; ++src) {
+    for (uint32_t i = 0; i < degree; ++i) {
+      edges.emplace_back(src, i == 0 ? hub(gen) : node(gen));
+    }
+  }
+  for (uint32_t h = 0; h < 16; ++h) {
+    for (uint32_t i = 0; i < num_nodes / 4; ++i) {
+      edges.emplace_back(h, node(gen));
+    }
+  }
+  std::sort(edges.begin(), edges.end());
+  return edges;
+}
+
+template <typename Graph>
+void
+Construct(Graph* graph, uint32_t num_nodes, const EdgeList& edges) {
+  graph->allocateFrom(num_nodes, edges.size());
+  graph->constructNodes();
+  uint64_t e = 0;
+  for (uint32_t n = 0; n < num_nodes; ++n) {
+    for (; e < edges.size() && edges[e].first == n; ++e) {
+      graph->constructEdge(e, edges[e].second);
+    }
+    graph->fixEndEdge(n, e);
+  }
+}
+
+std::vector<uint32_t>
+SerialBfs(uint32_t num_nodes, const EdgeList& edges, uint32_t source) {
+  std::vector<uint64_t> offsets(num_nodes + 1);
+  for (const auto& [src, dst] : edges) {
+    ++offsets[src + 1];
+  }
+  for (uint32_t n = 0; n < num_nodes; ++n) {
+    offsets[n + 1] += offsets[n];
+  }
+
+  std::vector<uint32_t> dist(num_nodes, kInfinity);
+  std::deque<uint32_t> queue{source};
+  dist[source] = 0;
+  while (!queue.empty()) {
+    uint32_t src = queue.front();
+    queue.pop_front();
+    for (uint64_t e = offsets[src]; e < offsets[src + 1]; ++e) {
+      uint32_t dst = edges[e].second;
+      if (dist[dst] == kInfinity) {
+        dist[dst] = dist[src] + 1;
+        queue.push_back(dst);
+      }
+    }
+  }
+  return dist;
+}
+
+struct BfsFn {
+  std::vector<std::atomic<uint32_t>>& dist;
+  uint32_t level;
+
+  bool Cond(uint32_t dst) const {
+    return dist[dst].load(std::memory_order_relaxed) == kInfinity;
+  }
+
+  bool Update(uint32_t, uint32_t dst) {
+    dist[dst].store(level, std::memory_order_relaxed);
+    return true;
+  }
+
+  bool UpdateAtomic(uint32_t, uint32_t dst) {
+    uint32_t expected = kInfinity;
+    return dist[dst].compare_exchange_strong(expected, level);
+  }
+};
+
+template <typename Graph>
+void
+TestBfs(
+    Graph& graph, uint32_t num_nodes, const EdgeList& edges,
+    galois::graphs::EdgeMapOptions options, bool expect_pull) {
+  constexpr uint32_t kSource = 100;
+  std::vector<uint32_t> expected = SerialBfs(num_nodes, edges, kSource);
+
+  std::vector<std::atomic<uint32_t>> dist(num_nodes);
+  for (auto& d : dist) {
+    d = kInfinity;
+  }
+  dist[kSource] = 0;
+
+  galois::graphs::VertexSubset<uint32_t> frontier(num_nodes, kSource);
+  bool pulled = false;
+  for (uint32_t level = 1; !frontier.Empty(); ++level) {
+    BfsFn fn{dist, level};
+    frontier = galois::graphs::EdgeMap(graph, frontier, fn, options);
+    pulled = pulled || frontier.IsDense();
+  }
+  GALOIS_LOG_ASSERT(pulled == expect_pull);
+
+  for (uint32_t n = 0; n < num_nodes; ++n) {
+    GALOIS_LOG_VASSERT(
+        dist[n] == expected[n], "node {}: {} != {}", n, dist[n].load(),
+        expected[n]);
+  }
+}
+
+void
+TestVertexSubset() {
+  constexpr uint32_t kNodes = 1000;
+  galois::graphs::VertexSubset<uint32_t> subset(kNodes);
+  GALOIS_LOG_ASSERT(subset.Empty());
+
+  galois::do_all(galois::iterate(uint32_t{0}, kNodes), [&](uint32_t n) {
+    if (n % 3 == 0) {
+      subset.Add(n);
+    }
+  });
+  GALOIS_LOG_ASSERT(!subset.IsDense());
+  GALOIS_LOG_ASSERT(subset.Size() == 334);
+
+  subset.ToDense();
+  GALOIS_LOG_ASSERT(subset.IsDense());
+  GALOIS_LOG_ASSERT(subset.Size() == 334);
+  GALOIS_LOG_ASSERT(subset.Contains(999) && !subset.Contains(998));
+
+  subset.ToSparse();
+  GALOIS_LOG_ASSERT(!subset.IsDense());
+  std::vector<uint32_t> nodes(subset.sparse().begin(), subset.sparse().end());
+  std::sort(nodes.begin(), nodes.end());
+  GALOIS_LOG_ASSERT(nodes.size() == 334);
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    GALOIS_LOG_ASSERT(nodes[i] == i * 3);
+  }
+}
+
+}  // namespace
+
+int
+main() {
+  galois::SharedMemSys sys;
+  galois::setActiveThreads(4);
+
+  TestVertexSubset();
+
+  constexpr uint32_t kNodes = 1 << 14;
+  EdgeList edges = MakeEdges(kNodes, 4);
+
+  galois::graphs::LC_CSR_CSC_Graph<uint32_t, void> bidirectional;
+  Construct(&bidirectional, kNodes, edges);
+  bidirectional.constructIncomingEdges();
+
+  galois::graphs::EdgeMapOptions options;
+  TestBfs(bidirectional, kNodes, edges, options, true);
+
+  options.direction = galois::graphs::EdgeMapDirection::kPush;
+  TestBfs(bidirectional, kNodes, edges, options, false);
+
+  options.direction = galois::graphs::EdgeMapDirection::kPull;
+  TestBfs(bidirectional, kNodes, edges, options, true);
+
+  // Without in edges, EdgeMap can only push
+  galois::graphs::LC_CSR_Graph<uint32_t, void> out_only;
+  Construct(&out_only, kNodes, edges);
+  TestBfs(out_only, kNodes, edges, galois::graphs::EdgeMapOptions(), false);
+
+  return 0;
+}
@@ -0,0 +1,109 @@
+#include "galois/Bag.h"
+
+#include <algorithm>
+#include <vector>
+
+#include <arrow/api.h>
+
+#include "galois/Galois.h"
+#include "galois/InsertBagArrow.h"
+#include "galois/Logging.h"
+
+namespace {
+
+constexpr uint64_t kNum = 1 << 20;
+
+/// The elements of bag in serial iteration order
+template <typename Bag>
+std::vector<typename Bag::value_type>
+SerialElements(const Bag& bag) {
+  return std::vector<typename Bag::value_type>(bag.begin(), bag.end());
+}
+
+template <typename Bag>
+void
+Fill(Bag* bag) {
+  galois::do_all(
+      galois::iterate(uint64_t{0}, kNum), [&](uint64_t i) { bag->push(i); },
+      galois::steal());
+}
+
+void
+TestBulk() {
+  galois::InsertBag<uint64_t> bag;
+  GALOIS_LOG_ASSERT(bag.size() == 0);
+  GALOIS_LOG_ASSERT(bag.to_vector().empty());
+
+  Fill(&bag);
+  GALOIS_LOG_ASSERT(bag.size() == kNum);
+
+  std::vector<uint64_t> flat = bag.to_vector();
+  GALOIS_LOG_ASSERT(flat == SerialElements(bag));
+  std::sort(flat.begin(), flat.end());
+  for (uint64_t i = 0; i < kNum; ++i) {
+    GALOIS_LOG_ASSERT(flat[i] == i);
+  }
+
+  std::vector<uint64_t> out(kNum + 1, 7);
+  GALOIS_LOG_ASSERT(bag.copy_to(out.begin()) == out.begin() + kNum);
+  GALOIS_LOG_ASSERT(out.back() == 7);
+
+  bag.clear();
+  GALOIS_LOG_ASSERT(bag.size() == 0);
+
+  // Small blocks, so each thread has many
+  galois::InsertBag<uint32_t, 256> small;
+  galois::do_all(galois::iterate(0u, 100000u), [&](uint32_t i) {
+    small.push(i);
+  });
+  GALOIS_LOG_ASSERT(small.size() == 100000);
+  GALOIS_LOG_ASSERT(small.to_vector() == SerialElements(small));
+}
+
+void
+TestArrow() {
+  galois::InsertBag<double> bag;
+  galois::do_all(galois::iterate(uint64_t{0}, kNum), [&](uint64_t i) {
+    bag.push(i * 0.5);
+  });
+
+  auto array_result = galois::ToArrowArray(bag);
+  GALOIS_LOG_ASSERT(array_result);
+  auto array =
+      std::static_pointer_cast<arrow::DoubleArray>(array_result.value());
+  GALOIS_LOG_ASSERT(static_cast<uint64_t>(array->length()) == kNum);
+  GALOIS_LOG_ASSERT(array->null_count() == 0);
+  std::vector<double> expected = SerialElements(bag);
+  for (uint64_t i = 0; i < kNum; ++i) {
+    GALOIS_LOG_ASSERT(array->Value(i) == expected[i]);
+  }
+
+  galois::InsertBag<uint32_t> empty;
+  auto empty_result = galois::ToArrowArray(empty);
+  GALOIS_LOG_ASSERT(empty_result);
+  GALOIS_LOG_ASSERT(empty_result.value()->length() == 0);
+  GALOIS_LOG_ASSERT(empty_result.value()->type()->Equals(arrow::uint32()));
+}
+
+}  // namespace
+
+int
+main() {
+  galois::SharedMemSys sys;
+  unsigned max_threads = galois::substrate::GetThreadPool().getMaxThreads();
+
+  for (unsigned threads : {1u, std::max(max_threads, 4u)}) {
+    galois::setActiveThreads(threads);
+    TestBulk();
+    TestArrow();
+  }
+
+  // Elements pushed by threads that are no longer active are still found
+  galois::InsertBag<uint64_t> bag;
+  Fill(&bag);
+  galois::setActiveThreads(1);
+  GALOIS_LOG_ASSERT(bag.size() == kNum);
+  GALOIS_LOG_ASSERT(bag.to_vector() == SerialElements(bag));
+
+  return 0;
+}
@@ -0,0 +1,65 @@
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "galois/Logging.h"
+#include "galois/SetIntersection.h"
+
+namespace {
+
+std::vector<uint32_t>
+MakeSet(size_t size, uint32_t range, std::mt19937* gen) {
+  std::uniform_int_distribution<uint32_t> dist(0, range - 1);
+  std::vector<uint32_t> values(size);
+  for (auto& v : values) {
+    v = dist(*gen);
+  }
+  std::sort(values.begin(), values.end());
+  values.erase(std::unique(values.begin(), values.end()), values.end());
+  return values;
+}
+
+/// Arguments are (small degree, large degree, kernel). Values are drawn from
+/// a range four times the large degree, so roughly a quarter of the smaller
+/// set is in the intersection.
+void
+MakeArguments(benchmark::internal::Benchmark* b) {
+  for (long small : {16, 256, 4096}) {
+    for (long skew : {1, 8, 64, 512}) {
+      for (long kernel = 0;
+           kernel <= static_cast<long>(galois::IntersectionKernel::kAVX512);
+           ++kernel) {
+        b->Args({small, small * skew, kernel});
+      }
+    }
+  }
+}
+
+void
+IntersectionCount(benchmark::State& state) {
+  auto [small, large, kernel_arg] =
+      std::make_tuple(state.range(0), state.range(1), state.range(2));
+  auto kernel = static_cast<galois::IntersectionKernel>(kernel_arg);
+  if (!galois::IsIntersectionKernelSupported(kernel)) {
+    state.SkipWithError("kernel not supported on this processor");
+    return;
+  }
+
+  std::mt19937 gen(small ^ large);
+  std::vector<uint32_t> a = MakeSet(small, large * 4, &gen);
+  std::vector<uint32_t> b = MakeSet(large, large * 4, &gen);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(galois::IntersectionCount(
+        a.data(), a.size(), b.data(), b.size(), kernel));
+  }
+  state.SetItemsProcessed(state.iterations() * (a.size() + b.size()));
+}
+
+BENCHMARK(IntersectionCount)->Apply(MakeArguments);
+
+}  // namespace
+
+BENCHMARK_MAIN();
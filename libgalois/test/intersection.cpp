@@ -0,0 +1,106 @@
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "galois/Logging.h"
+#include "galois/SetIntersection.h"
+
+namespace {
+
+/// MakeSet returns size distinct values drawn from [0, range) in increasing
+/// order.
+std::vector<uint32_t>
+MakeSet(size_t size, uint32_t range, std::mt19937* gen) {
+  std::vector<uint32_t> values(range);
+  for (uint32_t i = 0; i < range; ++i) {
+    values[i] = i;
+  }
+  std::shuffle(values.begin(), values.end(), *gen);
+  values.resize(std::min<size_t>(size, range));
+  std::sort(values.begin(), values.end());
+  return values;
+}
+
+void
+TestKernel(
+    galois::IntersectionKernel kernel, const std::vector<uint32_t>& a,
+    const std::vector<uint32_t>& b) {
+  std::vector<uint32_t> expected;
+  std::set_intersection(
+      a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+
+  size_t count = galois::IntersectionCount(
+      a.data(), a.size(), b.data(), b.size(), kernel);
+  GALOIS_LOG_VASSERT(
+      count == expected.size(), "kernel {}: {} != {}", int(kernel), count,
+      expected.size());
+
+  for (size_t limit : {size_t{0}, size_t{1}, expected.size() / 2,
+                       expected.size(), expected.size() + 1}) {
+    size_t bounded = galois::IntersectionCount(
+        a.data(), a.size(), b.data(), b.size(), limit, kernel);
+    GALOIS_LOG_VASSERT(
+        bounded == std::min(limit, expected.size()),
+        "kernel {} limit {}: {} != {}", int(kernel), limit, bounded,
+        std::min(limit, expected.size()));
+  }
+
+  std::vector<uint32_t> out(std::min(a.size(), b.size()));
+  size_t written = galois::Intersection(
+      a.data(), a.size(), b.data(), b.size(), out.data(), kernel);
+  out.resize(written);
+  GALOIS_LOG_VASSERT(
+      out == expected, "kernel {}: wrong intersection of sizes {} and {}",
+      int(kernel), a.size(), b.size());
+}
+
+void
+TestAllKernels(size_t a_size, size_t b_size, uint32_t range) {
+  std::mt19937 gen(a_size * 31 + b_size * 7 + range);
+
+  std::vector<uint32_t> a = MakeSet(a_size, range, &gen);
+  std::vector<uint32_t> b = MakeSet(b_size, range, &gen);
+
+  for (auto kernel :
+       {galois::IntersectionKernel::kAutomatic,
+        galois::IntersectionKernel::kScalar,
+        galois::IntersectionKernel::kGalloping,
+        galois::IntersectionKernel::kAVX2,
+        galois::IntersectionKernel::kAVX512}) {
+    if (!galois::IsIntersectionKernelSupported(kernel)) {
+      continue;
+    }
+    TestKernel(kernel, a, b);
+    TestKernel(kernel, b, a);
+  }
+}
+
+}  // namespace
+
+int
+main() {
+  // Empty and tiny inputs only exercise the scalar tails
+  TestAllKernels(0, 0, 10);
+  TestAllKernels(0, 100, 1000);
+  TestAllKernels(3, 5, 10);
+
+  // Similar sizes with dense and sparse overlap
+  for (size_t size : {8, 16, 17, 100, 1000}) {
+    TestAllKernels(size, size, size * 2);
+    TestAllKernels(size, size, size * 50);
+  }
+
+  // Skewed sizes
+  TestAllKernels(10, 10000, 20000);
+  TestAllKernels(100, 10000, 10000);
+  TestAllKernels(33, 4000, 1 << 20);
+
+  // Identical sets
+  std::vector<uint32_t> same(1000);
+  for (uint32_t i = 0; i < same.size(); ++i) {
+    same[i] = i * 3;
+  }
+  TestKernel(galois::BestIntersectionKernel(), same, same);
+
+  return 0;
+}
@@ -0,0 +1,94 @@
+#include <cstdint>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "galois/Galois.h"
+#include "galois/LargeArray.h"
+#include "galois/Reduction.h"
+#include "galois/substrate/PageAlloc.h"
+
+namespace {
+
+using galois::substrate::PageKind;
+
+void
+InitGalois() {
+  static galois::SharedMemSys sys;
+  [[maybe_unused]] static unsigned threads = galois::setActiveThreads(
+      galois::substrate::GetThreadPool().getMaxThreads());
+}
+
+uint64_t
+Mix(uint64_t x) {
+  // splitmix64 finalizer
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+/// Arguments are (log2 of the array size in bytes, allocation function,
+/// page kind). Requests for 1G pages fall back to 2M pages for arrays
+/// smaller than 1G and when no 1G pages are reserved; the fallback is
+/// logged.
+void
+MakeArguments(benchmark::internal::Benchmark* b) {
+  for (long log_bytes : {28, 31}) {
+    for (long alloc = 0; alloc < 4; ++alloc) {
+      for (long pages = 0; pages < 4; ++pages) {
+        b->Args({log_bytes, alloc, pages});
+      }
+    }
+  }
+}
+
+/// Random reads of a node-data array, as when visiting the neighbors of a
+/// node
+void
+RandomAccess(benchmark::State& state) {
+  InitGalois();
+  const char* const kAllocNames[] = {
+      "Interleaved", "Blocked", "Local", "Floating"};
+  const char* const kPageNames[] = {"4K", "THP", "2M", "1G"};
+  state.SetLabel(
+      std::string(kAllocNames[state.range(1)]) + "/" +
+      kPageNames[state.range(2)]);
+
+  const size_t size = (size_t{1} << state.range(0)) / sizeof(uint64_t);
+  const PageKind pages = static_cast<PageKind>(state.range(2));
+  galois::LargeArray<uint64_t> array;
+  switch (state.range(1)) {
+  case 0:
+    array.allocateInterleaved(size, pages);
+    break;
+  case 1:
+    array.allocateBlocked(size, pages);
+    break;
+  case 2:
+    array.allocateLocal(size, pages);
+    break;
+  case 3:
+    array.allocateFloating(size, pages);
+    break;
+  }
+  galois::do_all(
+      galois::iterate(size_t{0}, size), [&](size_t i) { array[i] = i; });
+
+  const size_t accesses = size_t{1} << 24;
+  uint64_t seed = 0;
+  for (auto _ : state) {
+    galois::GAccumulator<uint64_t> sum;
+    galois::do_all(galois::iterate(size_t{0}, accesses), [&](size_t i) {
+      sum += array[Mix(seed + i) & (size - 1)];
+    });
+    benchmark::DoNotOptimize(sum.reduce());
+    seed += accesses;
+  }
+  state.SetItemsProcessed(state.iterations() * accesses);
+}
+
+BENCHMARK(RandomAccess)->Apply(MakeArguments)->UseRealTime();
+
+}  // namespace
+
+BENCHMARK_MAIN();
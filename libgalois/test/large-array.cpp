@@ -0,0 +1,128 @@
+#include "galois/LargeArray.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include "galois/Galois.h"
+#include "galois/Logging.h"
+#include "galois/MemoryAccounting.h"
+#include "galois/substrate/PageAlloc.h"
+
+namespace {
+
+using galois::substrate::PageKind;
+
+constexpr PageKind kPageKinds[] = {
+    PageKind::kBase, PageKind::kTransparent, PageKind::kHuge2M,
+    PageKind::kHuge1G};
+
+void
+TestPageAlloc() {
+  GALOIS_LOG_ASSERT(galois::substrate::pageSize(PageKind::kBase) >= 4096);
+  GALOIS_LOG_ASSERT(
+      galois::substrate::pageSize(PageKind::kHuge2M) ==
+      galois::substrate::allocSize());
+  GALOIS_LOG_ASSERT(
+      galois::substrate::pageSize(PageKind::kHuge1G) == (size_t{1} << 30));
+
+  for (PageKind kind : kPageKinds) {
+    PageKind obtained = kind;
+    char* ptr = static_cast<char*>(
+        galois::substrate::allocPages(3, true, kind, &obtained));
+    GALOIS_LOG_ASSERT(ptr);
+    GALOIS_LOG_ASSERT(
+        reinterpret_cast<uintptr_t>(ptr) % galois::substrate::allocSize() ==
+        0);
+    // Three 2M pages are not a whole 1G page
+    GALOIS_LOG_ASSERT(obtained != PageKind::kHuge1G);
+    GALOIS_LOG_ASSERT(obtained <= kind);
+    if (kind <= PageKind::kTransparent) {
+      GALOIS_LOG_ASSERT(obtained == kind);
+    }
+    for (size_t i = 0; i < 3 * galois::substrate::allocSize(); i += 4096) {
+      GALOIS_LOG_ASSERT(ptr[i] == 0);
+      ptr[i] = 1;
+    }
+    galois::substrate::freePages(ptr, 3);
+  }
+}
+
+template <typename Allocate>
+void
+TestLargeArray(Allocate allocate) {
+  // Not a whole number of huge pages
+  const size_t size = 3 * galois::substrate::allocSize() / sizeof(uint64_t) + 5;
+  using galois::MemoryCategory;
+  const galois::MemoryUsage before =
+      galois::GetMemoryUsage(MemoryCategory::kUser);
+  for (PageKind kind : kPageKinds) {
+    galois::LargeArray<uint64_t> array;
+    allocate(array, size, kind);
+    GALOIS_LOG_ASSERT(array.size() == size);
+    // Charged to the default category in whole huge pages
+    int64_t charged =
+        galois::GetMemoryUsage(MemoryCategory::kUser).bytes - before.bytes;
+    GALOIS_LOG_ASSERT(charged >= int64_t(size * sizeof(uint64_t)));
+    GALOIS_LOG_ASSERT(charged % galois::substrate::allocSize() == 0);
+    galois::do_all(
+        galois::iterate(size_t{0}, size), [&](size_t i) { array[i] = i; });
+    for (size_t i = 0; i < size; ++i) {
+      GALOIS_LOG_ASSERT(array[i] == i);
+    }
+  }
+  GALOIS_LOG_ASSERT(
+      galois::GetMemoryUsage(MemoryCategory::kUser).bytes == before.bytes);
+
+  // Charged to the category of an enclosing scope instead
+  const galois::MemoryUsage topology =
+      galois::GetMemoryUsage(MemoryCategory::kTopology);
+  {
+    galois::MemoryCategoryScope scope(MemoryCategory::kTopology);
+    galois::LargeArray<uint64_t> array;
+    allocate(array, size, PageKind::kHuge2M);
+    GALOIS_LOG_ASSERT(
+        galois::GetMemoryUsage(MemoryCategory::kTopology).bytes >
+        topology.bytes);
+    GALOIS_LOG_ASSERT(
+        galois::GetMemoryUsage(MemoryCategory::kUser).bytes == before.bytes);
+  }
+  GALOIS_LOG_ASSERT(
+      galois::GetMemoryUsage(MemoryCategory::kTopology).bytes ==
+      topology.bytes);
+}
+
+}  // namespace
+
+int
+main() {
+  // Test the default page kind regardless of the environment; it is read once
+  unsetenv("GALOIS_HUGE_PAGES");
+  galois::SharedMemSys sys;
+  galois::setActiveThreads(galois::substrate::GetThreadPool().getMaxThreads());
+
+  GALOIS_LOG_ASSERT(galois::substrate::defaultPageKind() == PageKind::kHuge2M);
+  TestPageAlloc();
+
+  using Array = galois::LargeArray<uint64_t>;
+  TestLargeArray([](Array& a, size_t n, PageKind kind) {
+    a.allocateInterleaved(n, kind);
+  });
+  TestLargeArray(
+      [](Array& a, size_t n, PageKind kind) { a.allocateBlocked(n, kind); });
+  TestLargeArray(
+      [](Array& a, size_t n, PageKind kind) { a.allocateLocal(n, kind); });
+  TestLargeArray(
+      [](Array& a, size_t n, PageKind kind) { a.allocateFloating(n, kind); });
+  TestLargeArray([](Array& a, size_t n, PageKind kind) {
+    // Uneven ranges, including an empty one
+    unsigned threads = galois::getActiveThreads();
+    std::vector<uint64_t> ranges(threads + 1, 0);
+    for (unsigned t = 1; t <= threads; ++t) {
+      ranges[t] = t == 1 ? 0 : n * t * t / (threads * threads);
+    }
+    a.allocateSpecified(n, ranges, kind);
+  });
+
+  return 0;
+}
@@ -0,0 +1,154 @@
+#include <atomic>
+#include <functional>
+#include <queue>
+#include <random>
+#include <vector>
+
+#include "galois/AtomicHelpers.h"
+#include "galois/Galois.h"
+#include "galois/Logging.h"
+#include "galois/worklists/MultiQueue.h"
+
+namespace {
+
+struct Edge {
+  uint32_t dest;
+  uint32_t weight;
+};
+
+using Graph = std::vector<std::vector<Edge>>;
+
+struct Request {
+  uint32_t node;
+  uint32_t dist;
+};
+
+struct Indexer {
+  uint32_t operator()(const Request& r) const { return r.dist; }
+};
+
+struct IdentityIndexer {
+  uint32_t operator()(uint32_t x) const { return x; }
+};
+
+/// A width x width grid with random weights
+Graph
+MakeGrid(uint32_t width) {
+  std::mt19937 gen(width);
+  std::uniform_int_distribution<uint32_t> weight(1, 100);
+
+  Graph g(width * width);
+  for (uint32_t y = 0; y < width; ++y) {
+    for (uint32_t x = 0; x < width; ++x) {
+      uint32_t n = y * width + x;
+      if (x + 1 < width) {
+        g[n].push_back({n + 1, weight(gen)});
+        g[n + 1].push_back({n, weight(gen)});
+      }
+      if (y + 1 < width) {
+        g[n].push_back({n + width, weight(gen)});
+        g[n + width].push_back({n, weight(gen)});
+      }
+    }
+  }
+  return g;
+}
+
+std::vector<uint32_t>
+Dijkstra(const Graph& g) {
+  using Item = std::pair<uint32_t, uint32_t>;
+  std::vector<uint32_t> dist(g.size(), std::numeric_limits<uint32_t>::max());
+  std::priority_queue<Item, std::vector<Item>, std::greater<Item>> pq;
+  dist[0] = 0;
+  pq.emplace(0, 0);
+  while (!pq.empty()) {
+    auto [d, n] = pq.top();
+    pq.pop();
+    if (d > dist[n]) {
+      continue;
+    }
+    for (const Edge& e : g[n]) {
+      if (d + e.weight < dist[e.dest]) {
+        dist[e.dest] = d + e.weight;
+        pq.emplace(dist[e.dest], e.dest);
+      }
+    }
+  }
+  return dist;
+}
+
+/// Every pushed item should be popped exactly once
+void
+TestAllPopped(size_t num_items) {
+  std::vector<uint32_t> items(num_items);
+  for (size_t i = 0; i < num_items; ++i) {
+    items[i] = (i * 7919) % num_items;
+  }
+  std::vector<std::atomic<uint32_t>> visits(num_items);
+
+  galois::for_each(
+      galois::iterate(items),
+      [&](uint32_t item, auto& ctx) {
+        visits[item].fetch_add(1);
+        // Push a second generation with a larger priority
+        if (item < num_items / 2) {
+          ctx.push(item + num_items / 2 + num_items % 2);
+        }
+      },
+      galois::wl<galois::worklists::MultiQueue<IdentityIndexer>>(),
+      galois::no_stats());
+
+  for (size_t i = 0; i < num_items; ++i) {
+    uint32_t expected = i >= num_items / 2 + num_items % 2 ? 2 : 1;
+    GALOIS_LOG_VASSERT(
+        visits[i] == expected, "item {} popped {} times", i, visits[i]);
+  }
+}
+
+/// Label correcting SSSP should reach the same distances as Dijkstra
+void
+TestSssp(uint32_t width) {
+  Graph g = MakeGrid(width);
+  std::vector<std::atomic<uint32_t>> dist(g.size());
+  for (auto& d : dist) {
+    d = std::numeric_limits<uint32_t>::max();
+  }
+  dist[0] = 0;
+
+  std::vector<Request> init{{0, 0}};
+  galois::for_each(
+      galois::iterate(init),
+      [&](const Request& req, auto& ctx) {
+        if (dist[req.node] < req.dist) {
+          return;
+        }
+        for (const Edge& e : g[req.node]) {
+          uint32_t new_dist = req.dist + e.weight;
+          if (new_dist < galois::atomicMin(dist[e.dest], new_dist)) {
+            ctx.push(Request{e.dest, new_dist});
+          }
+        }
+      },
+      galois::wl<galois::worklists::MultiQueue<Indexer>>(),
+      galois::disable_conflict_detection(), galois::no_stats());
+
+  std::vector<uint32_t> expected = Dijkstra(g);
+  for (size_t n = 0; n < g.size(); ++n) {
+    GALOIS_LOG_VASSERT(
+        dist[n] == expected[n], "node {}: {} != {}", n, dist[n], expected[n]);
+  }
+}
+
+}  // namespace
+
+int
+main() {
+  galois::SharedMemSys sys;
+  galois::setActiveThreads(4);
+
+  TestAllPopped(1);
+  TestAllPopped(10000);
+  TestSssp(100);
+
+  return 0;
+}
@@ -0,0 +1,135 @@
+#include "galois/NumaMemoryPool.h"
+
+#include <cstring>
+#include <numeric>
+#include <set>
+#include <vector>
+
+#include <arrow/api.h>
+
+#include "galois/Galois.h"
+#include "galois/Logging.h"
+#include "galois/Properties.h"
+#include "galois/substrate/PageAlloc.h"
+
+namespace {
+
+int64_t
+SocketTotal(const galois::NumaMemoryPool& pool) {
+  std::vector<int64_t> bytes = pool.socket_bytes();
+  return std::accumulate(bytes.begin(), bytes.end(), int64_t{0});
+}
+
+void
+TestPool(galois::NumaMemoryPool* pool) {
+  GALOIS_LOG_ASSERT(pool->bytes_allocated() == 0);
+  GALOIS_LOG_ASSERT(!pool->backend_name().empty());
+
+  const int64_t page = galois::substrate::allocSize();
+  std::vector<int64_t> sizes{0, 1, 100, page - 1, page, 3 * page + 5};
+  std::vector<uint8_t*> buffers;
+  int64_t total = 0;
+  for (int64_t size : sizes) {
+    uint8_t* buffer = nullptr;
+    GALOIS_LOG_ASSERT(pool->Allocate(size, &buffer).ok());
+    GALOIS_LOG_ASSERT(reinterpret_cast<uintptr_t>(buffer) % 64 == 0);
+    std::memset(buffer, 0xab, size);
+    buffers.push_back(buffer);
+    total += size;
+  }
+  GALOIS_LOG_ASSERT(pool->bytes_allocated() == total);
+  GALOIS_LOG_ASSERT(SocketTotal(*pool) == total);
+
+  // Spreading one page per thread puts some on every socket that has an
+  // active thread
+  unsigned threads = galois::getActiveThreads();
+  std::set<unsigned> thread_sockets;
+  for (unsigned tid = 0; tid < threads; ++tid) {
+    thread_sockets.insert(galois::substrate::GetThreadPool().getSocket(tid));
+  }
+  uint8_t* spread = nullptr;
+  GALOIS_LOG_ASSERT(pool->Allocate(threads * page, &spread).ok());
+  if (pool->placement() != galois::NumaPlacement::kLocal) {
+    std::vector<int64_t> socket_bytes = pool->socket_bytes();
+    for (unsigned socket : thread_sockets) {
+      GALOIS_LOG_ASSERT(socket_bytes[socket] > 0);
+    }
+  }
+  pool->Free(spread, threads * page);
+
+  // Growing a small buffer into a placed one keeps its contents
+  GALOIS_LOG_ASSERT(pool->Reallocate(100, 2 * page, &buffers[2]).ok());
+  GALOIS_LOG_ASSERT(buffers[2][0] == 0xab && buffers[2][99] == 0xab);
+  sizes[2] = 2 * page;
+  total += 2 * page - 100;
+  GALOIS_LOG_ASSERT(pool->bytes_allocated() == total);
+  GALOIS_LOG_ASSERT(SocketTotal(*pool) == total);
+
+  for (size_t i = 0; i < buffers.size(); ++i) {
+    pool->Free(buffers[i], sizes[i]);
+  }
+  GALOIS_LOG_ASSERT(pool->bytes_allocated() == 0);
+  GALOIS_LOG_ASSERT(SocketTotal(*pool) == 0);
+  GALOIS_LOG_ASSERT(pool->max_memory() >= total);
+
+  // Inside a parallel loop, large buffers are placed locally
+  galois::do_all(galois::iterate(0, 1), [&](int) {
+    uint8_t* buffer = nullptr;
+    GALOIS_LOG_ASSERT(pool->Allocate(2 * page, &buffer).ok());
+    pool->Free(buffer, 2 * page);
+  });
+  GALOIS_LOG_ASSERT(pool->bytes_allocated() == 0);
+}
+
+void
+TestArrow(galois::NumaMemoryPool* pool) {
+  std::vector<uint64_t> values(1 << 20);
+  std::iota(values.begin(), values.end(), 0);
+
+  arrow::UInt64Builder builder(pool);
+  GALOIS_LOG_ASSERT(builder.AppendValues(values).ok());
+  std::shared_ptr<arrow::Array> array;
+  GALOIS_LOG_ASSERT(builder.Finish(&array).ok());
+  GALOIS_LOG_ASSERT(
+      pool->bytes_allocated() >=
+      static_cast<int64_t>(values.size() * sizeof(uint64_t)));
+  auto typed = std::static_pointer_cast<arrow::UInt64Array>(array);
+  GALOIS_LOG_ASSERT(typed->Value(12345) == 12345);
+  array.reset();
+  typed.reset();
+  GALOIS_LOG_ASSERT(pool->bytes_allocated() == 0);
+
+  galois::SetPropertyMemoryPool(pool);
+  GALOIS_LOG_ASSERT(galois::GetPropertyMemoryPool() == pool);
+  {
+    auto table = galois::AllocateTable<std::tuple<galois::UInt64Property>>(
+        1 << 20, {"value"});
+    GALOIS_LOG_ASSERT(table);
+    GALOIS_LOG_ASSERT(pool->bytes_allocated() > 0);
+  }
+  GALOIS_LOG_ASSERT(pool->bytes_allocated() == 0);
+  galois::SetPropertyMemoryPool(nullptr);
+  GALOIS_LOG_ASSERT(galois::GetPropertyMemoryPool() != pool);
+}
+
+}  // namespace
+
+int
+main() {
+  galois::SharedMemSys sys;
+  galois::setActiveThreads(galois::substrate::GetThreadPool().getMaxThreads());
+
+  for (auto placement :
+       {galois::NumaPlacement::kLocal, galois::NumaPlacement::kInterleaved,
+        galois::NumaPlacement::kBlocked}) {
+    galois::NumaMemoryPool* pool = galois::GetNumaMemoryPool(placement);
+    GALOIS_LOG_ASSERT(pool->placement() == placement);
+    TestPool(pool);
+    TestArrow(pool);
+  }
+
+  galois::GetNumaMemoryPool(galois::NumaPlacement::kBlocked)
+      ->ReportStats("NumaMemoryPool");
+
+  return 0;
+}
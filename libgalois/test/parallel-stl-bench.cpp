@@ -0,0 +1,193 @@
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "galois/Galois.h"
+#include "galois/ParallelSTL.h"
+
+namespace {
+
+void
+InitGalois() {
+  static galois::SharedMemSys sys;
+  [[maybe_unused]] static unsigned threads = galois::setActiveThreads(
+      galois::substrate::GetThreadPool().getMaxThreads());
+}
+
+std::vector<uint32_t>
+MakeInput(size_t size, uint32_t range) {
+  std::mt19937 gen(size);
+  std::uniform_int_distribution<uint32_t> dist(0, range - 1);
+  std::vector<uint32_t> values(size);
+  for (auto& v : values) {
+    v = dist(gen);
+  }
+  return values;
+}
+
+/// Arguments are (size, variant). Variant 0 is the serial STL algorithm and
+/// the others are its ParallelSTL counterparts, run on all threads.
+void
+MakeArguments(benchmark::internal::Benchmark* b, long num_variants) {
+  for (long size : {1 << 16, 1 << 20, 1 << 24}) {
+    for (long variant = 0; variant < num_variants; ++variant) {
+      b->Args({size, variant});
+    }
+  }
+}
+
+void
+Sort(benchmark::State& state) {
+  InitGalois();
+  const char* const kNames[] = {
+      "std::sort", "ParallelSTL::sort", "sample_sort", "radix_sort"};
+  state.SetLabel(kNames[state.range(1)]);
+  // Ids of a graph with as many nodes as elements
+  std::vector<uint32_t> input = MakeInput(state.range(0), state.range(0));
+  std::vector<uint32_t> values(input.size());
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    std::copy(input.begin(), input.end(), values.begin());
+    state.ResumeTiming();
+    switch (state.range(1)) {
+    case 0:
+      std::sort(values.begin(), values.end());
+      break;
+    case 1:
+      galois::ParallelSTL::sort(values.begin(), values.end());
+      break;
+    case 2:
+      galois::ParallelSTL::sample_sort(values.begin(), values.end());
+      break;
+    case 3:
+      galois::ParallelSTL::radix_sort(values.begin(), values.end());
+      break;
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * input.size());
+}
+
+void
+Scan(benchmark::State& state) {
+  InitGalois();
+  const char* const kNames[] = {
+      "std::inclusive_scan", "ParallelSTL::partial_sum",
+      "ParallelSTL::inclusive_scan"};
+  state.SetLabel(kNames[state.range(1)]);
+  std::vector<uint64_t> input(state.range(0), 3);
+  std::vector<uint64_t> output(input.size());
+
+  for (auto _ : state) {
+    switch (state.range(1)) {
+    case 0:
+      std::inclusive_scan(input.begin(), input.end(), output.begin());
+      break;
+    case 1:
+      galois::ParallelSTL::partial_sum(
+          input.begin(), input.end(), output.begin());
+      break;
+    case 2:
+      galois::ParallelSTL::inclusive_scan(
+          input.begin(), input.end(), output.begin());
+      break;
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * input.size());
+}
+
+void
+StablePartition(benchmark::State& state) {
+  InitGalois();
+  state.SetLabel(
+      state.range(1) ? "ParallelSTL::stable_partition"
+                     : "std::stable_partition");
+  std::vector<uint32_t> input = MakeInput(state.range(0), 1000);
+  std::vector<uint32_t> values(input.size());
+  auto pred = [](uint32_t v) { return v % 3 == 0; };
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    std::copy(input.begin(), input.end(), values.begin());
+    state.ResumeTiming();
+    if (state.range(1)) {
+      galois::ParallelSTL::stable_partition(values.begin(), values.end(), pred);
+    } else {
+      std::stable_partition(values.begin(), values.end(), pred);
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * input.size());
+}
+
+void
+Unique(benchmark::State& state) {
+  InitGalois();
+  state.SetLabel(state.range(1) ? "ParallelSTL::unique" : "std::unique");
+  // Sorted with about four copies of each value, like a sorted edge list
+  // with duplicate edges
+  std::vector<uint32_t> input = MakeInput(state.range(0), state.range(0) / 4);
+  std::sort(input.begin(), input.end());
+  std::vector<uint32_t> values(input.size());
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    std::copy(input.begin(), input.end(), values.begin());
+    state.ResumeTiming();
+    if (state.range(1)) {
+      benchmark::DoNotOptimize(
+          galois::ParallelSTL::unique(values.begin(), values.end()));
+    } else {
+      benchmark::DoNotOptimize(std::unique(values.begin(), values.end()));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * input.size());
+}
+
+void
+Histogram(benchmark::State& state) {
+  InitGalois();
+  state.SetLabel(state.range(1) ? "ParallelSTL::histogram" : "serial");
+  constexpr size_t kBuckets = 1024;
+  std::vector<uint32_t> input = MakeInput(state.range(0), kBuckets);
+  auto bucket = [](uint32_t v) -> size_t { return v; };
+
+  for (auto _ : state) {
+    if (state.range(1)) {
+      benchmark::DoNotOptimize(galois::ParallelSTL::histogram(
+          input.begin(), input.end(), kBuckets, bucket));
+    } else {
+      std::vector<size_t> counts(kBuckets);
+      for (uint32_t v : input) {
+        ++counts[bucket(v)];
+      }
+      benchmark::DoNotOptimize(counts);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * input.size());
+}
+
+BENCHMARK(Sort)
+    ->Apply([](benchmark::internal::Benchmark* b) { MakeArguments(b, 4); })
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(Scan)
+    ->Apply([](benchmark::internal::Benchmark* b) { MakeArguments(b, 3); })
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(StablePartition)
+    ->Apply([](benchmark::internal::Benchmark* b) { MakeArguments(b, 2); })
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(Unique)
+    ->Apply([](benchmark::internal::Benchmark* b) { MakeArguments(b, 2); })
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(Histogram)
+    ->Apply([](benchmark::internal::Benchmark* b) { MakeArguments(b, 2); })
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace
+
+BENCHMARK_MAIN();
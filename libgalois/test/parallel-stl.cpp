@@ -0,0 +1,166 @@
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "galois/Galois.h"
+#include "galois/Logging.h"
+#include "galois/ParallelSTL.h"
+
+namespace {
+
+std::vector<uint32_t>
+MakeInput(size_t size, uint32_t range) {
+  std::mt19937 gen(size);
+  std::uniform_int_distribution<uint32_t> dist(0, range - 1);
+  std::vector<uint32_t> values(size);
+  for (auto& v : values) {
+    v = dist(gen);
+  }
+  return values;
+}
+
+void
+TestScan(size_t size) {
+  std::vector<uint32_t> input = MakeInput(size, 100);
+  std::vector<uint64_t> wide(input.begin(), input.end());
+
+  std::vector<uint64_t> expected(size);
+  std::vector<uint64_t> actual(size);
+  std::inclusive_scan(wide.begin(), wide.end(), expected.begin());
+  galois::ParallelSTL::inclusive_scan(wide.begin(), wide.end(), actual.begin());
+  GALOIS_LOG_ASSERT(expected == actual);
+
+  std::exclusive_scan(wide.begin(), wide.end(), expected.begin(), uint64_t{7});
+  galois::ParallelSTL::exclusive_scan(
+      wide.begin(), wide.end(), actual.begin(), uint64_t{7});
+  GALOIS_LOG_ASSERT(expected == actual);
+
+  // In place, with a non-commutative operator
+  std::vector<std::string> strings(size);
+  for (size_t i = 0; i < size; ++i) {
+    strings[i] = std::string(1, 'a' + input[i] % 26);
+  }
+  std::vector<std::string> expected_strings(size);
+  std::inclusive_scan(
+      strings.begin(), strings.end(), expected_strings.begin(),
+      [](const std::string& a, const std::string& b) {
+        return (a + b).substr(std::max<size_t>(a.size() + b.size(), 3) - 3);
+      });
+  galois::ParallelSTL::inclusive_scan(
+      strings.begin(), strings.end(), strings.begin(),
+      [](const std::string& a, const std::string& b) {
+        return (a + b).substr(std::max<size_t>(a.size() + b.size(), 3) - 3);
+      });
+  GALOIS_LOG_ASSERT(strings == expected_strings);
+}
+
+void
+TestSort(size_t size) {
+  for (uint32_t range : {uint32_t{16}, uint32_t{1} << 31}) {
+    std::vector<uint32_t> input = MakeInput(size, range);
+    std::vector<uint32_t> expected = input;
+    std::sort(expected.begin(), expected.end());
+
+    std::vector<uint32_t> sampled = input;
+    galois::ParallelSTL::sample_sort(sampled.begin(), sampled.end());
+    GALOIS_LOG_ASSERT(sampled == expected);
+
+    std::vector<uint32_t> radix = input;
+    galois::ParallelSTL::radix_sort(radix.begin(), radix.end());
+    GALOIS_LOG_ASSERT(radix == expected);
+  }
+
+  // Radix and counting sort are stable
+  using Pair = std::pair<uint32_t, uint32_t>;
+  std::vector<uint32_t> keys = MakeInput(size, 1000);
+  std::vector<Pair> pairs(size);
+  for (uint32_t i = 0; i < size; ++i) {
+    pairs[i] = Pair(keys[i], i);
+  }
+  std::vector<Pair> expected = pairs;
+  std::stable_sort(expected.begin(), expected.end(), [](Pair a, Pair b) {
+    return a.first < b.first;
+  });
+
+  std::vector<Pair> radix = pairs;
+  galois::ParallelSTL::radix_sort(
+      radix.begin(), radix.end(), [](const Pair& p) { return p.first; });
+  GALOIS_LOG_ASSERT(radix == expected);
+
+  std::vector<Pair> counted = pairs;
+  std::vector<size_t> starts = galois::ParallelSTL::counting_sort(
+      counted.begin(), counted.end(), 1000,
+      [](const Pair& p) -> size_t { return p.first; });
+  GALOIS_LOG_ASSERT(counted == expected);
+  GALOIS_LOG_ASSERT(starts.size() == 1001 && starts.back() == size);
+  for (size_t k = 0; k < 1000; ++k) {
+    for (size_t i = starts[k]; i < starts[k + 1]; ++i) {
+      GALOIS_LOG_ASSERT(counted[i].first == k);
+    }
+  }
+
+  std::vector<Pair> descending = pairs;
+  galois::ParallelSTL::sample_sort(
+      descending.begin(), descending.end(), std::greater<Pair>());
+  GALOIS_LOG_ASSERT(std::is_sorted(
+      descending.begin(), descending.end(), std::greater<Pair>()));
+}
+
+void
+TestPartitionUnique(size_t size) {
+  std::vector<uint32_t> input = MakeInput(size, 50);
+  auto is_even = [](uint32_t v) { return v % 2 == 0; };
+
+  std::vector<uint32_t> expected = input;
+  auto expected_mid =
+      std::stable_partition(expected.begin(), expected.end(), is_even);
+  std::vector<uint32_t> actual = input;
+  auto actual_mid = galois::ParallelSTL::stable_partition(
+      actual.begin(), actual.end(), is_even);
+  GALOIS_LOG_ASSERT(actual == expected);
+  GALOIS_LOG_ASSERT(
+      actual_mid - actual.begin() == expected_mid - expected.begin());
+
+  std::vector<uint32_t> sorted = input;
+  std::sort(sorted.begin(), sorted.end());
+  for (const std::vector<uint32_t>& values : {input, sorted}) {
+    expected = values;
+    expected.erase(
+        std::unique(expected.begin(), expected.end()), expected.end());
+    actual = values;
+    actual.erase(
+        galois::ParallelSTL::unique(actual.begin(), actual.end()),
+        actual.end());
+    GALOIS_LOG_ASSERT(actual == expected);
+  }
+
+  std::vector<size_t> counts = galois::ParallelSTL::histogram(
+      input.begin(), input.end(), 50, [](uint32_t v) -> size_t { return v; });
+  for (uint32_t k = 0; k < 50; ++k) {
+    GALOIS_LOG_ASSERT(
+        counts[k] ==
+        static_cast<size_t>(std::count(input.begin(), input.end(), k)));
+  }
+}
+
+}  // namespace
+
+int
+main() {
+  galois::SharedMemSys sys;
+  unsigned max_threads = galois::substrate::GetThreadPool().getMaxThreads();
+
+  for (unsigned threads : {1u, 3u, std::max(max_threads, 4u)}) {
+    galois::setActiveThreads(threads);
+    for (size_t size : {0, 1, 1000, 5000, 100000}) {
+      TestScan(size);
+      TestSort(size);
+      TestPartitionUnique(size);
+    }
+  }
+
+  return 0;
+}
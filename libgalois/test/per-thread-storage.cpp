@@ -0,0 +1,136 @@
+#include "galois/substrate/PerThreadStorage.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "galois/Galois.h"
+#include "galois/Logging.h"
+#include "galois/PerThreadLargeArray.h"
+
+namespace {
+
+void
+TestFindSharedCacheLines() {
+  constexpr uintptr_t kLine = galois::substrate::GALOIS_CACHE_LINE_SIZE;
+  alignas(kLine) static char buffer[4 * kLine];
+  using Ranges = std::vector<std::vector<galois::substrate::MemoryRange>>;
+
+  // Adjacent ranges in different lines
+  Ranges apart{{{buffer, kLine}}, {{buffer + kLine, 2 * kLine}}};
+  GALOIS_LOG_ASSERT(galois::substrate::FindSharedCacheLines(apart).empty());
+
+  // Two threads in the second line, and a range of one thread that overlaps
+  // another of the same thread
+  Ranges shared{
+      {{buffer, kLine + 1}, {buffer + 8, 8}},
+      {{buffer + 2 * kLine - 8, 8}, {buffer + 3 * kLine, 0}}};
+  auto lines = galois::substrate::FindSharedCacheLines(shared);
+  GALOIS_LOG_ASSERT(lines.size() == 1);
+  GALOIS_LOG_ASSERT(lines[0] == reinterpret_cast<uintptr_t>(buffer + kLine));
+}
+
+/// A view of memory that a thread writes to
+struct View {
+  const char* data{nullptr};
+  size_t size{0};
+};
+
+void
+AppendSlotRanges(
+    const View& view, std::vector<galois::substrate::MemoryRange>* ranges) {
+  ranges->emplace_back(view.data, view.size);
+}
+
+void
+TestSharedSlots() {
+  constexpr size_t kLine = galois::substrate::GALOIS_CACHE_LINE_SIZE;
+
+  // Slots themselves never share cache lines
+  galois::substrate::PerThreadStorage<char> chars;
+  GALOIS_LOG_ASSERT(chars.sharedCacheLines().empty());
+
+  galois::substrate::PerThreadStorage<View> views;
+  std::vector<char> buffer((views.size() + 1) * kLine);
+  char* aligned = buffer.data() + kLine -
+                  reinterpret_cast<uintptr_t>(buffer.data()) % kLine;
+  for (unsigned t = 0; t < views.size(); ++t) {
+    *views.getRemote(t) = View{aligned + t * 16, 16};
+  }
+  GALOIS_LOG_ASSERT(views.sharedCacheLines().empty() == (views.size() == 1));
+
+  galois::on_each([&](unsigned tid, unsigned) {
+    *views.getLocal() = View{aligned + tid * kLine, kLine};
+  });
+  for (unsigned t = galois::getActiveThreads(); t < views.size(); ++t) {
+    *views.getRemote(t) = View{};
+  }
+  GALOIS_LOG_ASSERT(views.sharedCacheLines().empty());
+}
+
+void
+TestPerSocketStorage() {
+  auto& tp = galois::substrate::GetThreadPool();
+  galois::substrate::PerSocketStorage<std::vector<int>> a;
+  GALOIS_LOG_ASSERT(a.numSockets() == tp.getMaxSockets());
+  a.getRemoteByPkg(0)->push_back(1);
+
+  galois::substrate::PerSocketStorage<std::vector<int>> b(std::move(a));
+  GALOIS_LOG_ASSERT(b.getRemoteByPkg(0)->size() == 1);
+  GALOIS_LOG_ASSERT(b.getRemote(0) == b.getRemoteByPkg(tp.getSocket(0)));
+
+  galois::substrate::PerSocketStorage<std::vector<int>> c;
+  c = std::move(b);
+  GALOIS_LOG_ASSERT(c.getRemoteByPkg(0)->size() == 1);
+}
+
+void
+TestPerThreadLargeArray() {
+  constexpr size_t kSize = 1 << 20;
+  galois::PerThreadLargeArray<uint64_t> arrays(kSize, uint64_t{7});
+  GALOIS_LOG_ASSERT(arrays.size() == kSize);
+
+  galois::on_each([&](unsigned tid, unsigned) {
+    auto& local = arrays.getLocal();
+    GALOIS_LOG_ASSERT(local.size() == kSize);
+    GALOIS_LOG_ASSERT(&local == &arrays.getRemote(tid));
+    for (uint64_t& x : local) {
+      GALOIS_LOG_ASSERT(x == 7);
+      x = tid;
+    }
+  });
+
+  unsigned threads = galois::getActiveThreads();
+  for (unsigned t = 0; t < threads; ++t) {
+    GALOIS_LOG_ASSERT(arrays.getRemote(t)[kSize - 1] == t);
+  }
+  auto& tp = galois::substrate::GetThreadPool();
+  for (unsigned t = threads; t < tp.getMaxThreads(); ++t) {
+    GALOIS_LOG_ASSERT(arrays.getRemote(t).size() == 0);
+  }
+
+  // Elements with constructor arguments, and reallocation
+  galois::PerThreadLargeArray<std::vector<int>> vectors(16, 4, 1);
+  GALOIS_LOG_ASSERT(vectors.getLocal()[15].size() == 4);
+  vectors.allocate(0);
+  GALOIS_LOG_ASSERT(vectors.size() == 0);
+  GALOIS_LOG_ASSERT(vectors.getLocal().size() == 0);
+}
+
+}  // namespace
+
+int
+main() {
+  galois::SharedMemSys sys;
+  unsigned max_threads = galois::substrate::GetThreadPool().getMaxThreads();
+
+  TestFindSharedCacheLines();
+  TestPerSocketStorage();
+  for (unsigned threads : {1u, std::max(max_threads, 4u)}) {
+    galois::setActiveThreads(threads);
+    TestSharedSlots();
+    TestPerThreadLargeArray();
+  }
+
+  return 0;
+}
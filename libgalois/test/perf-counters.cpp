@@ -0,0 +1,82 @@
+#include "galois/PerfCounters.h"
+
+#include <cstdlib>
+
+#include "galois/Galois.h"
+#include "galois/Logging.h"
+#include "galois/Reduction.h"
+
+namespace {
+
+uint64_t
+Spin(uint64_t n) {
+  volatile uint64_t acc = 0;
+  for (uint64_t i = 0; i < n; ++i) {
+    acc += i;
+  }
+  return acc;
+}
+
+/// Counters either work and grow or are reported unavailable
+void
+TestRead() {
+  galois::PerfCounts begin;
+  if (!galois::PerfCounts::Read(&begin)) {
+    GALOIS_LOG_WARN("hardware counters unavailable, skipping TestRead");
+    GALOIS_LOG_ASSERT(!galois::PerfCounts::Enabled());
+    return;
+  }
+  GALOIS_LOG_ASSERT(galois::PerfCounts::Enabled());
+
+  Spin(1 << 20);
+
+  galois::PerfCounts end;
+  GALOIS_LOG_ASSERT(galois::PerfCounts::Read(&end));
+  GALOIS_LOG_ASSERT(end.time_enabled >= begin.time_enabled);
+  for (size_t i = 0; i < galois::PerfCounts::kNumEvents; ++i) {
+    GALOIS_LOG_ASSERT(begin.valid[i] == end.valid[i]);
+    GALOIS_LOG_ASSERT(end.values[i] >= begin.values[i]);
+  }
+  for (size_t i : {0, 1}) {
+    if (end.valid[i]) {
+      GALOIS_LOG_VASSERT(
+          end.values[i] > begin.values[i], "{} did not grow",
+          galois::PerfCounts::EventName(i));
+    }
+  }
+}
+
+/// Named loops count with or without counters available
+void
+TestLoops() {
+  constexpr uint64_t kItems = 1024;
+  galois::GAccumulator<uint64_t> sum;
+
+  galois::do_all(
+      galois::iterate(uint64_t{0}, kItems), [&](uint64_t i) { sum += i; },
+      galois::loopname("PerfDoAll"));
+  galois::do_all(
+      galois::iterate(uint64_t{0}, kItems), [&](uint64_t i) { sum += i; },
+      galois::steal(), galois::loopname("PerfDoAllSteal"));
+  galois::for_each(
+      galois::iterate(uint64_t{0}, kItems),
+      [&](uint64_t i, auto&) { sum += i; }, galois::loopname("PerfForEach"),
+      galois::disable_conflict_detection());
+
+  GALOIS_LOG_ASSERT(sum.reduce() == 3 * kItems * (kItems - 1) / 2);
+}
+
+}  // namespace
+
+int
+main() {
+  setenv("GALOIS_PERF_COUNTERS", "1", 1);
+
+  galois::SharedMemSys sys;
+  galois::setActiveThreads(4);
+
+  TestRead();
+  TestLoops();
+
+  return 0;
+}
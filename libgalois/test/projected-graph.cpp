@@ -0,0 +1,186 @@
+#include <arrow/api.h>
+#include <arrow/type.h>
+#include <arrow/type_traits.h>
+
+#include "TestPropertyGraph.h"
+#include "galois/Logging.h"
+#include "galois/Properties.h"
+#include "galois/SharedMemSys.h"
+#include "galois/analytics/bfs/bfs.h"
+#include "galois/graphs/ProjectedPropertyGraph.h"
+#include "galois/graphs/ProjectedTopology.h"
+
+namespace gg = galois::graphs;
+
+using DataType = int64_t;
+
+struct Field0 {
+  using ViewType = galois::PODPropertyView<int64_t>;
+  using ArrowType = arrow::CTypeTraits<int64_t>::ArrowType;
+};
+
+using NodeType = std::tuple<Field0>;
+using EdgeType = std::tuple<Field0>;
+using Graph = gg::ProjectedPropertyGraph<NodeType, EdgeType>;
+
+/// CountEdges counts the edges of a projected graph and checks that every
+/// edge satisfies the projection.
+size_t
+CountEdges(const Graph& g, size_t stride) {
+  size_t num_edges = 0;
+  for (auto node : g) {
+    GALOIS_LOG_VASSERT(
+        g.OriginalNodeId(node) % stride == 0, "{} not in projection",
+        g.OriginalNodeId(node));
+    for (auto edge : g.edges(node)) {
+      auto dest = *g.GetEdgeDest(edge);
+      GALOIS_LOG_VASSERT(dest < g.num_nodes(), "{} out of range", dest);
+      GALOIS_LOG_VASSERT(
+          g.OriginalNodeId(dest) % stride == 0, "{} not in projection",
+          g.OriginalNodeId(dest));
+      ++num_edges;
+    }
+  }
+  return num_edges;
+}
+
+/// Keep every stride-th node of a line graph where each node is connected to
+/// its next line_width nodes.
+void
+TestNodeMask(size_t num_nodes, size_t line_width, size_t stride) {
+  LinePolicy policy{line_width};
+
+  std::unique_ptr<gg::PropertyFileGraph> g =
+      MakeFileGraph<DataType>(num_nodes, 1, &policy);
+
+  auto projection_result = gg::ProjectedTopology::MakeFiltered(
+      g->topology(), [&](uint64_t n) { return n % stride == 0; },
+      [](uint64_t) { return true; });
+  GALOIS_LOG_ASSERT(projection_result);
+  std::unique_ptr<gg::ProjectedTopology> projection =
+      std::move(projection_result.value());
+
+  size_t expected_nodes = (num_nodes + stride - 1) / stride;
+  GALOIS_LOG_VASSERT(
+      projection->num_nodes() == expected_nodes, "{} != {}",
+      projection->num_nodes(), expected_nodes);
+
+  auto r = Graph::Make(g.get(), projection.get());
+  GALOIS_LOG_ASSERT(r);
+  Graph graph = r.value();
+
+  size_t num_edges = CountEdges(graph, stride);
+  GALOIS_LOG_VASSERT(
+      num_edges == projection->num_edges(), "{} != {}", num_edges,
+      projection->num_edges());
+
+  GALOIS_LOG_ASSERT(projection->Compact());
+  GALOIS_LOG_ASSERT(projection->is_compacted());
+
+  size_t compacted_edges = CountEdges(graph, stride);
+  GALOIS_LOG_VASSERT(
+      compacted_edges == num_edges, "{} != {}", compacted_edges, num_edges);
+  GALOIS_LOG_VASSERT(
+      projection->compacted_topology().num_edges() == num_edges, "{} != {}",
+      projection->compacted_topology().num_edges(), num_edges);
+}
+
+/// Drop every other edge and check that the edge properties are still read
+/// from their original positions.
+void
+TestEdgeMask(size_t num_nodes, size_t line_width) {
+  LinePolicy policy{line_width};
+
+  std::unique_ptr<gg::PropertyFileGraph> g =
+      MakeFileGraph<DataType>(num_nodes, 1, &policy);
+
+  auto projection_result = gg::ProjectedTopology::MakeEdgeFiltered(
+      g->topology(), [](uint64_t e) { return e % 2 == 0; });
+  GALOIS_LOG_ASSERT(projection_result);
+  std::unique_ptr<gg::ProjectedTopology> projection =
+      std::move(projection_result.value());
+
+  size_t expected_edges = (g->topology().num_edges() + 1) / 2;
+  GALOIS_LOG_VASSERT(
+      projection->num_edges() == expected_edges, "{} != {}",
+      projection->num_edges(), expected_edges);
+
+  auto r = Graph::Make(g.get(), projection.get());
+  GALOIS_LOG_ASSERT(r);
+  Graph graph = r.value();
+
+  // Properties from MakeFileGraph are all ones
+  size_t sum = 0;
+  for (auto node : graph) {
+    for (auto edge : graph.edges(node)) {
+      sum += graph.GetEdgeData<Field0>(edge);
+    }
+  }
+  GALOIS_LOG_VASSERT(sum == expected_edges, "{} != {}", sum, expected_edges);
+}
+
+void
+TestBadMask(size_t num_nodes) {
+  LinePolicy policy{1};
+
+  std::unique_ptr<gg::PropertyFileGraph> g =
+      MakeFileGraph<DataType>(num_nodes, 1, &policy);
+
+  galois::DynamicBitset node_mask;
+  node_mask.resize(num_nodes + 1);
+
+  auto r = gg::ProjectedTopology::Make(
+      g->topology(), std::move(node_mask), galois::DynamicBitset{});
+  GALOIS_LOG_VASSERT(
+      !r && r.error() == galois::ErrorCode::InvalidArgument,
+      "Should return InvalidArgument when mask size does not match");
+}
+
+/// Run BFS on the even nodes of a line graph of width two: every even node
+/// reaches the next even node in one step.
+void
+TestBfs(size_t num_nodes) {
+  LinePolicy policy{2};
+
+  std::unique_ptr<gg::PropertyFileGraph> g =
+      MakeFileGraph<DataType>(num_nodes, 1, &policy);
+
+  auto projection_result = gg::ProjectedTopology::MakeFiltered(
+      g->topology(), [](uint64_t n) { return n % 2 == 0; },
+      [](uint64_t) { return true; });
+  GALOIS_LOG_ASSERT(projection_result);
+  std::unique_ptr<gg::ProjectedTopology> projection =
+      std::move(projection_result.value());
+
+  auto bfs_result = galois::analytics::Bfs(
+      g.get(), *projection, 0, "level", galois::analytics::BfsPlan::Sync());
+  GALOIS_LOG_ASSERT(bfs_result);
+
+  auto levels_result = g->NodePropertyTyped<uint32_t>("level");
+  GALOIS_LOG_ASSERT(levels_result);
+  auto levels = levels_result.value();
+
+  for (size_t i = 0; i < num_nodes; ++i) {
+    if (i % 2 == 0) {
+      GALOIS_LOG_VASSERT(
+          levels->Value(i) == i / 2, "{}: {} != {}", i, levels->Value(i),
+          i / 2);
+    } else {
+      GALOIS_LOG_VASSERT(
+          levels->Value(i) > num_nodes, "{} should be unreachable", i);
+    }
+  }
+}
+
+int
+main() {
+  galois::SharedMemSys sys;
+
+  TestNodeMask(10, 3, 2);
+  TestNodeMask(1000, 5, 3);
+  TestEdgeMask(100, 3);
+  TestBadMask(10);
+  TestBfs(100);
+
+  return 0;
+}
@@ -3,6 +3,8 @@
 #include <algorithm>
 #include <functional>
 #include <iostream>
+#include <map>
+#include <vector>
 
 #include "galois/Galois.h"
 #include "galois/SharedMemSys.h"
@@ -87,6 +89,106 @@ test_accum() {
   GALOIS_ASSERT(accum.reduce() == num);
 }
 
+void
+test_array_accum() {
+  constexpr size_t size = 10000;
+  constexpr int rounds = 3;
+
+  // Small blocks, so the merge crosses many of them; unblocked; default
+  for (size_t block_size : {size_t{7}, size_t{0}, size_t{1} << 12}) {
+    galois::GArrayAccumulator<int64_t> accum(size, block_size);
+    for (int round = 1; round <= rounds; ++round) {
+      galois::do_all(galois::iterate(size_t{0}, 4 * size), [&](size_t i) {
+        accum.update(i % size, i);
+      });
+      std::vector<int64_t>& result = accum.reduce();
+      GALOIS_ASSERT(result.size() == size);
+      for (size_t k = 0; k < size; ++k) {
+        // Sum of k, k + size, k + 2 size, k + 3 size, once per round
+        int64_t expected = round * (4 * int64_t(k) + 6 * int64_t(size));
+        GALOIS_ASSERT(result[k] == expected);
+      }
+    }
+    accum.reset();
+    for (int64_t v : accum.reduce()) {
+      GALOIS_ASSERT(v == 0);
+    }
+  }
+
+  auto r = galois::make_array_reducible(
+      size, galois::gmax<int>(), galois::identity_value_min<int>());
+  galois::do_all(galois::iterate(0, int(size)), [&](int i) {
+    r.update(i, i);
+    r.update(size - 1 - i, i);
+  });
+  std::vector<int>& result = r.reduce();
+  for (size_t k = 0; k < size; ++k) {
+    GALOIS_ASSERT(result[k] == int(std::max(k, size - 1 - k)));
+  }
+}
+
+void
+test_histogram() {
+  constexpr int num = 123456;
+  constexpr size_t bins = 17;
+
+  galois::GHistogram<> hist(bins);
+  galois::do_all(galois::iterate(0, num), [&](int i) { hist.add(i % bins); });
+
+  std::vector<uint64_t>& counts = hist.reduce();
+  uint64_t total = 0;
+  for (size_t b = 0; b < bins; ++b) {
+    GALOIS_ASSERT(counts[b] == num / bins + (b < num % bins));
+    total += counts[b];
+  }
+  GALOIS_ASSERT(total == num);
+}
+
+void
+test_sparse_accum() {
+  constexpr uint64_t num = 100000;
+  // Keys spread over a range far larger than the number of updates
+  auto key_of = [](uint64_t i) { return (i % 1000) * 1000003; };
+
+  galois::GSparseAccumulator<uint64_t, uint64_t> accum;
+  for (int round = 1; round <= 2; ++round) {
+    galois::do_all(galois::iterate(uint64_t{0}, num), [&](uint64_t i) {
+      accum.update(key_of(i), 1);
+    });
+    auto& result = accum.reduce();
+    GALOIS_ASSERT(result.size() == 1000);
+    std::map<uint64_t, uint64_t> seen(result.begin(), result.end());
+    GALOIS_ASSERT(seen.size() == 1000);
+    for (uint64_t k = 0; k < 1000; ++k) {
+      GALOIS_ASSERT(seen[key_of(k)] == round * num / 1000);
+    }
+  }
+  accum.reset();
+  GALOIS_ASSERT(accum.reduce().empty());
+
+  auto r = galois::make_sparse_reducible<std::string>(
+      galois::gmin<int>(), galois::identity_value_max<int>());
+  galois::do_all(galois::iterate(0, 1000), [&](int i) {
+    r.update(std::to_string(i % 10), i);
+  });
+  for (auto& kv : r.reduce()) {
+    GALOIS_ASSERT(kv.second == std::stoi(kv.first));
+  }
+}
+
+// Array and sparse reducers merge per-thread copies, so run them with one
+// thread and with several
+void
+test_merging_reducers() {
+  unsigned max_threads = galois::substrate::GetThreadPool().getMaxThreads();
+  for (unsigned threads : {1u, std::max(max_threads, 4u)}) {
+    galois::setActiveThreads(threads);
+    test_array_accum();
+    test_histogram();
+    test_sparse_accum();
+  }
+}
+
 int
 main() {
   galois::SharedMemSys sys;
@@ -101,5 +203,7 @@ main() {
   test_max();
   test_accum();
 
+  test_merging_reducers();
+
   return 0;
 }
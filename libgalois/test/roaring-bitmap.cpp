@@ -0,0 +1,247 @@
+#include "galois/RoaringBitmap.h"
+
+#include <algorithm>
+#include <mutex>
+#include <random>
+#include <set>
+#include <vector>
+
+#include <arrow/api.h>
+
+#include "galois/Galois.h"
+#include "galois/Logging.h"
+
+namespace {
+
+using Type = galois::internal::RoaringContainer::Type;
+
+/// A mix of sparse, dense and run-like values over several containers
+std::set<uint32_t>
+MakeValues(unsigned seed) {
+  std::mt19937 gen(seed);
+  std::set<uint32_t> values;
+  std::uniform_int_distribution<uint32_t> any;
+  for (int i = 0; i < 1000; ++i) {
+    values.insert(any(gen));
+  }
+  std::uniform_int_distribution<uint32_t> dense(0, 3 << 16);
+  for (int i = 0; i < 50000; ++i) {
+    values.insert(dense(gen));
+  }
+  uint32_t start = (7 << 16) + seed * 1000;
+  for (uint32_t v = start; v < start + 100000; ++v) {
+    values.insert(v);
+  }
+  values.insert(0xFFFFFFFF);
+  return values;
+}
+
+std::vector<uint32_t>
+ToVector(const std::set<uint32_t>& values) {
+  return std::vector<uint32_t>(values.begin(), values.end());
+}
+
+void
+AssertEqual(
+    const galois::RoaringBitmap& bitmap, const std::set<uint32_t>& set) {
+  std::vector<uint32_t> expected = ToVector(set);
+  GALOIS_LOG_ASSERT(bitmap.Cardinality() == expected.size());
+  GALOIS_LOG_ASSERT(bitmap.ToVector() == expected);
+  std::vector<uint32_t> iterated(bitmap.begin(), bitmap.end());
+  GALOIS_LOG_ASSERT(iterated == expected);
+  for (uint32_t v : {uint32_t{0}, uint32_t{1} << 16, uint32_t{12345678}}) {
+    GALOIS_LOG_ASSERT(bitmap.Contains(v) == (set.count(v) > 0));
+  }
+  if (!expected.empty()) {
+    GALOIS_LOG_ASSERT(bitmap.Maximum() == expected.back());
+  }
+}
+
+void
+TestBuild() {
+  std::set<uint32_t> set = MakeValues(1);
+  std::vector<uint32_t> values = ToVector(set);
+
+  galois::RoaringBitmap bitmap = galois::RoaringBitmap::FromSorted(values);
+  AssertEqual(bitmap, set);
+  for (uint32_t v : values) {
+    GALOIS_LOG_ASSERT(bitmap.Contains(v));
+    GALOIS_LOG_ASSERT(!bitmap.Contains(v + 1) || set.count(v + 1));
+  }
+
+  galois::RoaringBitmap added;
+  std::vector<uint32_t> shuffled = values;
+  std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937(0));
+  for (uint32_t v : shuffled) {
+    GALOIS_LOG_ASSERT(added.Add(v));
+    GALOIS_LOG_ASSERT(!added.Add(v));
+  }
+  AssertEqual(added, set);
+  GALOIS_LOG_ASSERT(added == bitmap);
+  added.RunOptimize();
+  GALOIS_LOG_ASSERT(added.SizeInBytes() <= bitmap.SizeInBytes());
+
+  // Ranges become runs, across container boundaries
+  galois::RoaringBitmap range;
+  range.AddRange(100, 1000000);
+  range.AddRange(uint64_t{1} << 32, uint64_t{1} << 32);
+  GALOIS_LOG_ASSERT(range.Cardinality() == 1000000 - 100);
+  GALOIS_LOG_ASSERT(!range.Contains(99) && range.Contains(100));
+  GALOIS_LOG_ASSERT(range.Contains(999999) && !range.Contains(1000000));
+  GALOIS_LOG_ASSERT(range.SizeInBytes() < 2000);
+  std::vector<uint32_t> range_values = range.ToVector();
+  GALOIS_LOG_ASSERT(range_values.front() == 100);
+  GALOIS_LOG_ASSERT(range_values.back() == 999999);
+
+  // Small sets stay small
+  galois::RoaringBitmap sparse =
+      galois::RoaringBitmap::FromSorted({3, 70000, 4000000000});
+  GALOIS_LOG_ASSERT(sparse.Cardinality() == 3);
+  GALOIS_LOG_ASSERT(sparse.SizeInBytes() < 512);
+
+  // Every container type stays correct through Add
+  galois::RoaringBitmap full;
+  full.AddRange(0, 1 << 16);
+  GALOIS_LOG_ASSERT(!full.Add(5));
+  full.AddRange(1 << 16, (1 << 16) + 10);
+  GALOIS_LOG_ASSERT(full.Add(1 << 17));
+  GALOIS_LOG_ASSERT(full.Cardinality() == (1 << 16) + 11);
+
+  // Adding to runs extends, merges or inserts runs in place
+  galois::RoaringBitmap runs;
+  runs.AddRange(10, 20);
+  runs.AddRange(30, 40);
+  GALOIS_LOG_ASSERT(!runs.Add(15));
+  GALOIS_LOG_ASSERT(runs.Add(20) && runs.Add(9) && runs.Add(29));
+  for (uint32_t v = 21; v < 28; ++v) {
+    GALOIS_LOG_ASSERT(runs.Add(v));
+  }
+  GALOIS_LOG_ASSERT(runs.Add(28) && runs.Add(50) && runs.Add(0));
+  GALOIS_LOG_ASSERT(runs.Add(65535));
+  GALOIS_LOG_ASSERT(runs.Cardinality() == 20 + 14);
+  GALOIS_LOG_ASSERT(runs.Contains(28) && !runs.Contains(49));
+  GALOIS_LOG_ASSERT(runs.SizeInBytes() < 512);
+
+  galois::RoaringBitmap empty = galois::RoaringBitmap::FromSorted({});
+  GALOIS_LOG_ASSERT(empty.Empty() && empty.Cardinality() == 0);
+  GALOIS_LOG_ASSERT(empty.begin() == empty.end());
+}
+
+void
+TestSetOperations() {
+  std::set<uint32_t> a = MakeValues(2);
+  std::set<uint32_t> b = MakeValues(3);
+  galois::RoaringBitmap bitmap_a =
+      galois::RoaringBitmap::FromSorted(ToVector(a));
+  galois::RoaringBitmap bitmap_b =
+      galois::RoaringBitmap::FromSorted(ToVector(b));
+
+  std::set<uint32_t> expected;
+  std::set_intersection(
+      a.begin(), a.end(), b.begin(), b.end(),
+      std::inserter(expected, expected.end()));
+  AssertEqual(galois::RoaringBitmap::And(bitmap_a, bitmap_b), expected);
+
+  expected.clear();
+  std::set_union(
+      a.begin(), a.end(), b.begin(), b.end(),
+      std::inserter(expected, expected.end()));
+  AssertEqual(galois::RoaringBitmap::Or(bitmap_a, bitmap_b), expected);
+
+  expected.clear();
+  std::set_difference(
+      a.begin(), a.end(), b.begin(), b.end(),
+      std::inserter(expected, expected.end()));
+  AssertEqual(galois::RoaringBitmap::AndNot(bitmap_a, bitmap_b), expected);
+
+  expected.clear();
+  std::set_symmetric_difference(
+      a.begin(), a.end(), b.begin(), b.end(),
+      std::inserter(expected, expected.end()));
+  AssertEqual(galois::RoaringBitmap::Xor(bitmap_a, bitmap_b), expected);
+
+  GALOIS_LOG_ASSERT(galois::RoaringBitmap::Xor(bitmap_a, bitmap_a).Empty());
+  GALOIS_LOG_ASSERT(galois::RoaringBitmap::And(bitmap_a, bitmap_a) == bitmap_a);
+}
+
+void
+TestIterate() {
+  std::set<uint32_t> set = MakeValues(4);
+  galois::RoaringBitmap bitmap =
+      galois::RoaringBitmap::FromSorted(ToVector(set));
+
+  std::mutex mutex;
+  std::vector<uint32_t> seen;
+  galois::do_all(galois::iterate(bitmap), [&](uint32_t v) {
+    std::lock_guard<std::mutex> lock(mutex);
+    seen.push_back(v);
+  });
+  std::sort(seen.begin(), seen.end());
+  GALOIS_LOG_ASSERT(seen == ToVector(set));
+
+  galois::GAccumulator<uint64_t> count;
+  galois::do_all(
+      galois::iterate(bitmap), [&](uint32_t) { count += 1; }, galois::steal());
+  GALOIS_LOG_ASSERT(count.reduce() == set.size());
+
+  uint64_t rank = set.size() / 3;
+  GALOIS_LOG_ASSERT(
+      *bitmap.IteratorAt(rank) == *std::next(set.begin(), rank));
+  GALOIS_LOG_ASSERT(bitmap.IteratorAt(set.size()) == bitmap.end());
+}
+
+void
+TestConversions() {
+  std::set<uint32_t> set;
+  for (uint32_t v : MakeValues(5)) {
+    if (v < (10 << 16)) {
+      set.insert(v);
+    }
+  }
+  galois::RoaringBitmap bitmap =
+      galois::RoaringBitmap::FromSorted(ToVector(set));
+
+  galois::DynamicBitset bitset;
+  bitset.resize((10 << 16) + 5);
+  bitmap.ToBitset(&bitset);
+  GALOIS_LOG_ASSERT(bitset.count() == set.size());
+  GALOIS_LOG_ASSERT(galois::RoaringBitmap::FromBitset(bitset) == bitmap);
+
+  std::vector<uint8_t> bytes = bitmap.Serialize();
+  auto read = galois::RoaringBitmap::Deserialize(bytes.data(), bytes.size());
+  GALOIS_LOG_ASSERT(read);
+  GALOIS_LOG_ASSERT(read.value() == bitmap);
+  GALOIS_LOG_ASSERT(
+      !galois::RoaringBitmap::Deserialize(bytes.data(), bytes.size() - 1));
+  bytes[0] ^= 1;
+  GALOIS_LOG_ASSERT(
+      !galois::RoaringBitmap::Deserialize(bytes.data(), bytes.size()));
+
+  uint64_t num_nodes = bitset.size();
+  auto table = bitmap.ToNodeProperty("mask", num_nodes);
+  GALOIS_LOG_ASSERT(table);
+  GALOIS_LOG_ASSERT(table.value()->num_rows() == int64_t(num_nodes));
+  auto column = table.value()->GetColumnByName("mask");
+  auto from_property = galois::RoaringBitmap::FromNodeProperty(*column);
+  GALOIS_LOG_ASSERT(from_property);
+  GALOIS_LOG_ASSERT(from_property.value() == bitmap);
+  GALOIS_LOG_ASSERT(!bitmap.ToNodeProperty("mask", *set.rbegin()));
+}
+
+}  // namespace
+
+int
+main() {
+  galois::SharedMemSys sys;
+  unsigned max_threads = galois::substrate::GetThreadPool().getMaxThreads();
+
+  for (unsigned threads : {1u, std::max(max_threads, 4u)}) {
+    galois::setActiveThreads(threads);
+    TestBuild();
+    TestSetOperations();
+    TestIterate();
+    TestConversions();
+  }
+
+  return 0;
+}
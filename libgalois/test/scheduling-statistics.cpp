@@ -0,0 +1,115 @@
+#include <unistd.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <string>
+#include <utility>
+
+#include <nlohmann/json.hpp>
+
+#include "galois/Galois.h"
+#include "galois/Logging.h"
+
+namespace {
+
+using StatKey = std::pair<std::string, std::string>;
+
+std::map<StatKey, nlohmann::json>
+ReadStats(const std::string& path) {
+  galois::SetStatFile(path);
+  galois::PrintStats();
+
+  std::ifstream in(path);
+  nlohmann::json obj = nlohmann::json::parse(in);
+  std::map<StatKey, nlohmann::json> stats;
+  for (const auto& stat : obj["stats"]) {
+    stats[{stat["region"], stat["category"]}] = stat;
+  }
+  return stats;
+}
+
+uint64_t
+Spin(uint64_t n) {
+  volatile uint64_t acc = 0;
+  for (uint64_t i = 0; i < n; ++i) {
+    acc += i;
+  }
+  return acc;
+}
+
+}  // namespace
+
+int
+main() {
+  galois::SharedMemSys sys;
+  unsigned threads = galois::setActiveThreads(4);
+
+  constexpr uint64_t kItems = 4096;
+
+  // Most of the work is at the start of the range so that threads have to
+  // steal to balance it
+  galois::do_all(
+      galois::iterate(uint64_t{0}, kItems),
+      [](uint64_t i) { Spin(i < kItems / 8 ? 1000 : 10); }, galois::steal(),
+      galois::chunk_size<16>(), galois::more_stats(),
+      galois::loopname("Steal"));
+  galois::do_all(
+      galois::iterate(uint64_t{0}, kItems), [](uint64_t) {},
+      galois::more_stats(), galois::loopname("NoSteal"));
+  galois::for_each(
+      galois::iterate(uint64_t{0}, kItems),
+      [](uint64_t i, auto& ctx) {
+        if (i % 2 == 0) {
+          ctx.push(i + 1);
+        }
+      },
+      galois::disable_conflict_detection(), galois::more_stats(),
+      galois::loopname("ForEach"));
+  // Without more_stats, nothing is collected
+  galois::do_all(
+      galois::iterate(uint64_t{0}, kItems), [](uint64_t) {},
+      galois::steal(), galois::loopname("Plain"));
+
+  char path[] = "/tmp/galois-stats-XXXXXX.json";
+  int fd = mkstemps(path, 5);
+  GALOIS_LOG_ASSERT(fd >= 0);
+  close(fd);
+  auto stats = ReadStats(path);
+  unlink(path);
+
+  auto get = [&](const char* region, const char* category) {
+    auto it = stats.find({region, category});
+    GALOIS_LOG_VASSERT(
+        it != stats.end(), "missing stat {} {}", region, category);
+    return it->second;
+  };
+
+  GALOIS_LOG_ASSERT(get("Steal", "WorkItems")["total"] == kItems);
+  GALOIS_LOG_ASSERT(get("Steal", "Chunks")["total"] >= kItems / 16);
+  GALOIS_LOG_ASSERT(get("Steal", "ChunkSize16")["total"] >= 1);
+  GALOIS_LOG_ASSERT(
+      get("Steal", "WorkItems")["thread_values"].size() == threads);
+  if (threads > 1) {
+    GALOIS_LOG_ASSERT(
+        get("Steal", "Steals")["total"] <=
+        get("Steal", "StealAttempts")["total"]);
+  }
+
+  for (const char* loop : {"Steal", "NoSteal", "ForEach"}) {
+    double imbalance = get(loop, "WorkItemsImbalance")["total"];
+    GALOIS_LOG_VASSERT(
+        imbalance >= 1.0 && imbalance <= threads, "{}: {}", loop, imbalance);
+    double idle = get(loop, "IdleFraction")["total"];
+    GALOIS_LOG_VASSERT(idle >= 0.0 && idle <= 1.0, "{}: {}", loop, idle);
+    get(loop, "BusyTimeImbalance");
+  }
+
+  GALOIS_LOG_ASSERT(get("NoSteal", "WorkItems")["total"] == kItems);
+  GALOIS_LOG_ASSERT(get("ForEach", "WorkItems")["total"] == kItems * 3 / 2);
+  GALOIS_LOG_ASSERT(get("Plain", "Iterations")["total"] == kItems);
+  GALOIS_LOG_ASSERT(!stats.count({"Plain", "WorkItems"}));
+
+  galois::SetStatFile("");
+  return 0;
+}
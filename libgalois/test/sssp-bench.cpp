@@ -0,0 +1,153 @@
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <arrow/api.h>
+#include <benchmark/benchmark.h>
+
+#include "galois/ArrowInterchange.h"
+#include "galois/Logging.h"
+#include "galois/SharedMemSys.h"
+#include "galois/Threads.h"
+#include "galois/analytics/sssp/sssp.h"
+#include "galois/graphs/PropertyFileGraph.h"
+#include "galois/substrate/ThreadPool.h"
+
+namespace {
+
+using galois::analytics::SsspPlan;
+
+enum GraphKind {
+  /// 2D grid with uniform weights; large diameter like road networks
+  kRoad,
+  /// Skewed random graph with small weights; small diameter like social
+  /// networks
+  kSocial,
+};
+
+std::unique_ptr<galois::graphs::PropertyFileGraph>
+MakeGraph(GraphKind kind, size_t num_nodes) {
+  std::mt19937 gen(num_nodes);
+  std::vector<uint64_t> indices;
+  std::vector<uint32_t> dests;
+  std::vector<uint32_t> weights;
+
+  if (kind == kRoad) {
+    std::uniform_int_distribution<uint32_t> weight(1, 1000);
+    constexpr int64_t kOffsets[][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
+    auto width = static_cast<int64_t>(std::sqrt(num_nodes));
+    for (int64_t y = 0; y < width; ++y) {
+      for (int64_t x = 0; x < width; ++x) {
+        for (const auto& offset : kOffsets) {
+          int64_t nx = x + offset[0];
+          int64_t ny = y + offset[1];
+          if (nx < 0 || nx >= width || ny < 0 || ny >= width) {
+            continue;
+          }
+          dests.emplace_back(ny * width + nx);
+          weights.emplace_back(weight(gen));
+        }
+        indices.emplace_back(dests.size());
+      }
+    }
+  } else {
+    constexpr int kDegree = 16;
+    std::uniform_int_distribution<uint32_t> weight(1, 100);
+    std::uniform_real_distribution<double> uniform(0, 1);
+    for (size_t n = 0; n < num_nodes; ++n) {
+      for (int i = 0; i < kDegree; ++i) {
+        // Cubing skews destinations towards low ids, which become hubs
+        double u = uniform(gen);
+        dests.emplace_back(static_cast<uint32_t>(num_nodes * u * u * u));
+        weights.emplace_back(weight(gen));
+      }
+      indices.emplace_back(dests.size());
+    }
+  }
+
+  auto g = std::make_unique<galois::graphs::PropertyFileGraph>();
+  auto set_result = g->SetTopology(galois::graphs::GraphTopology{
+      .out_indices = std::static_pointer_cast<arrow::UInt64Array>(
+          galois::BuildArray(indices)),
+      .out_dests = std::static_pointer_cast<arrow::UInt32Array>(
+          galois::BuildArray(dests)),
+  });
+  GALOIS_LOG_ASSERT(set_result);
+
+  auto table = arrow::Table::Make(
+      arrow::schema({arrow::field("weight", arrow::uint32())}),
+      {galois::BuildArray(weights)});
+  if (auto r = g->AddEdgeProperties(table); !r) {
+    GALOIS_LOG_FATAL("could not add edge property: {}", r.error());
+  }
+
+  return g;
+}
+
+/// Plans compared by the benchmark; delta stepping is run with a few deltas
+/// to show its sensitivity to the parameter
+SsspPlan
+MakePlan(int64_t index) {
+  switch (index) {
+  case 0:
+    return SsspPlan::DeltaStep(0);
+  case 1:
+    return SsspPlan::DeltaStep(8);
+  case 2:
+    return SsspPlan::DeltaStep(13);
+  case 3:
+    return SsspPlan::DeltaStepAdaptive();
+  case 4:
+    return SsspPlan::MultiQueue();
+  default:
+    GALOIS_LOG_FATAL("unknown plan {}", index);
+  }
+  return {};
+}
+
+const char* const kPlanNames[] = {
+    "DeltaStep(0)", "DeltaStep(8)", "DeltaStep(13)", "DeltaStepAdaptive",
+    "MultiQueue"};
+
+/// Arguments are (graph kind, plan)
+void
+MakeArguments(benchmark::internal::Benchmark* b) {
+  for (long kind : {kRoad, kSocial}) {
+    for (long plan = 0; plan < 5; ++plan) {
+      b->Args({kind, plan});
+    }
+  }
+}
+
+void
+Sssp(benchmark::State& state) {
+  static galois::SharedMemSys sys;
+  [[maybe_unused]] static unsigned threads = galois::setActiveThreads(
+      galois::substrate::GetThreadPool().getMaxThreads());
+
+  auto kind = static_cast<GraphKind>(state.range(0));
+  SsspPlan plan = MakePlan(state.range(1));
+  std::unique_ptr<galois::graphs::PropertyFileGraph> g =
+      MakeGraph(kind, 1 << 20);
+  state.SetLabel(kPlanNames[state.range(1)]);
+
+  for (auto _ : state) {
+    if (auto r = galois::analytics::Sssp(g.get(), 0, "weight", "dist", plan);
+        !r) {
+      GALOIS_LOG_FATAL("sssp failed: {}", r.error());
+    }
+    state.PauseTiming();
+    if (auto r = g->RemoveNodeProperty("dist"); !r) {
+      GALOIS_LOG_FATAL("could not remove property: {}", r.error());
+    }
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * g->topology().num_edges());
+}
+
+BENCHMARK(Sssp)->Apply(MakeArguments)->Unit(benchmark::kMillisecond);
+
+}  // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,102 @@
+#include <atomic>
+#include <functional>
+#include <vector>
+
+#include "galois/Galois.h"
+#include "galois/Logging.h"
+#include "galois/Reduction.h"
+#include "galois/TaskGroup.h"
+
+namespace {
+
+size_t
+Sum(size_t n, size_t grain) {
+  return galois::TaskReduce(
+      0, n, grain, size_t{0}, [](size_t i) { return i; }, std::plus<size_t>());
+}
+
+/// Task groups outside of parallel loops run serially
+void
+TestSerial() {
+  constexpr size_t kN = 100000;
+  GALOIS_LOG_ASSERT(Sum(kN, 16) == kN * (kN - 1) / 2);
+  GALOIS_LOG_ASSERT(Sum(0, 16) == 0);
+
+  int ran = 0;
+  {
+    galois::TaskGroup tg;
+    tg.run([&] { ran += 1; });
+    tg.run([&] { ran += 2; });
+  }
+  GALOIS_LOG_ASSERT(ran == 3);
+}
+
+/// A few items of a loop are much more expensive than the rest and split
+/// their work into tasks
+void
+TestHubs() {
+  constexpr size_t kItems = 1000;
+  constexpr size_t kHubSize = 1 << 20;
+  galois::GAccumulator<size_t> total;
+  std::vector<size_t> results(kItems);
+
+  galois::do_all(
+      galois::iterate(size_t{0}, kItems),
+      [&](size_t item) {
+        size_t n = item % 100 == 0 ? kHubSize : item;
+        results[item] = Sum(n, 1024);
+        total += results[item];
+      },
+      galois::steal(), galois::no_stats());
+
+  size_t expected_total = 0;
+  for (size_t item = 0; item < kItems; ++item) {
+    size_t n = item % 100 == 0 ? kHubSize : item;
+    size_t expected = n * (n - 1) / 2;
+    GALOIS_LOG_VASSERT(
+        results[item] == expected, "item {}: {} != {}", item, results[item],
+        expected);
+    expected_total += expected;
+  }
+  GALOIS_LOG_ASSERT(total.reduce() == expected_total);
+}
+
+/// Task groups also work inside for_each and nest
+void
+TestNested() {
+  std::vector<int> items(64);
+  std::atomic<size_t> leaves{0};
+
+  galois::for_each(
+      galois::iterate(items),
+      [&](int, auto&) {
+        galois::TaskGroup outer;
+        for (int i = 0; i < 4; ++i) {
+          outer.run([&] {
+            galois::TaskGroup inner;
+            for (int j = 0; j < 4; ++j) {
+              inner.run([&] { leaves += 1; });
+            }
+          });
+        }
+      },
+      galois::disable_conflict_detection(), galois::no_stats());
+
+  GALOIS_LOG_ASSERT(leaves == items.size() * 16);
+}
+
+}  // namespace
+
+int
+main() {
+  galois::SharedMemSys sys;
+
+  TestSerial();
+
+  galois::setActiveThreads(4);
+  TestHubs();
+  TestNested();
+  TestSerial();
+
+  return 0;
+}
@@ -0,0 +1,54 @@
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "galois/Galois.h"
+#include "galois/Logging.h"
+#include "galois/substrate/ThreadPool.h"
+
+namespace {
+
+/// Run rounds parallel sections separated by gap and return the wakeup
+/// statistics
+galois::substrate::ThreadPool::WakeupStats
+RunRounds(unsigned rounds, std::chrono::microseconds gap) {
+  auto& tp = galois::substrate::GetThreadPool();
+  tp.resetWakeupStats();
+
+  unsigned num = galois::getActiveThreads();
+  std::atomic<unsigned> visits{0};
+  for (unsigned r = 0; r < rounds; ++r) {
+    galois::on_each([&](unsigned, unsigned) { visits += 1; });
+    std::this_thread::sleep_for(gap);
+  }
+  GALOIS_LOG_VASSERT(
+      visits == rounds * num, "{} != {}", visits.load(), rounds * num);
+
+  return tp.getWakeupStats();
+}
+
+}  // namespace
+
+int
+main() {
+  galois::SharedMemSys sys;
+  unsigned num = galois::setActiveThreads(4);
+  if (num < 2) {
+    return 0;
+  }
+
+  // Every thread but the master is woken once per round
+  constexpr unsigned kRounds = 50;
+  auto stats = RunRounds(kRounds, std::chrono::microseconds(0));
+  GALOIS_LOG_VASSERT(
+      stats.wakeups == kRounds * (num - 1), "{} != {}", stats.wakeups,
+      kRounds * (num - 1));
+  GALOIS_LOG_ASSERT(stats.latency_max_ns * stats.wakeups >= stats.latency_sum_ns);
+
+  // Gaps much longer than any spin should leave threads parked
+  stats = RunRounds(10, std::chrono::milliseconds(5));
+  GALOIS_LOG_VASSERT(
+      stats.parks > 0, "no parks in {} wakeups", stats.wakeups);
+
+  return 0;
+}
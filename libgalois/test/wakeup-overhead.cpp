@@ -84,11 +84,17 @@ runExplicitThread(int num) {
 
 void
 run(std::function<void(int)> fn, std::string name) {
+  auto& tp = galois::substrate::GetThreadPool();
+  tp.resetWakeupStats();
   galois::Timer t;
   t.start();
   fn(size);
   t.stop();
-  std::cout << name << " time: " << t.get() << "\n";
+  galois::substrate::ThreadPool::WakeupStats stats = tp.getWakeupStats();
+  std::cout << name << " time: " << t.get() << " wakeups: " << stats.wakeups
+            << " parks: " << stats.parks << " avg wakeup latency (ns): "
+            << (stats.wakeups ? stats.latency_sum_ns / stats.wakeups : 0)
+            << "\n";
 }
 
 std::atomic<int> EXIT;
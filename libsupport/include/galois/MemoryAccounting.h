@@ -0,0 +1,91 @@
+#ifndef GALOIS_LIBSUPPORT_GALOIS_MEMORYACCOUNTING_H_
+#define GALOIS_LIBSUPPORT_GALOIS_MEMORYACCOUNTING_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "galois/config.h"
+
+namespace galois {
+
+/// What memory is used for. Each allocator that takes part in memory
+/// accounting charges its memory to a category:
+///
+/// - kTopology: graph topology
+/// - kProperties: property arrays (GetPropertyMemoryPool)
+/// - kWorklists: the page pool, which backs worklists, bags and other
+///   runtime containers
+/// - kIOBuffers: file mappings and buffers of tsuba::FileView and
+///   tsuba::FileFrame
+/// - kUser: everything else, e.g., LargeArrays of an application
+///
+/// Allocators that serve several purposes, like substrate::largeMalloc*
+/// (and so LargeArray) and the property memory pools, charge the category of
+/// the innermost MemoryCategoryScope of the allocating thread, if any.
+enum class MemoryCategory : uint8_t {
+  kTopology,
+  kProperties,
+  kWorklists,
+  kIOBuffers,
+  kUser,
+};
+
+constexpr size_t kNumMemoryCategories = 5;
+
+/// The name of category, e.g., "Topology"
+GALOIS_EXPORT const char* MemoryCategoryName(MemoryCategory category);
+
+/// The socket of memory that is not placed on a particular socket, e.g.,
+/// file mappings; it counts towards its category but no socket
+constexpr int kAnySocket = -1;
+
+/// Memory on sockets beyond this many is counted on the last socket
+constexpr int kMaxAccountedSockets = 16;
+
+/// Bytes in use now, and the most bytes in use at once since the start of
+/// the process or the last ResetMemoryPeaks
+struct MemoryUsage {
+  int64_t bytes{0};
+  int64_t peak_bytes{0};
+};
+
+/// Charge bytes of memory on socket to category; bytes is negative when the
+/// memory is freed, which must be charged to the same category and socket
+GALOIS_EXPORT void AccountMemory(
+    MemoryCategory category, int64_t bytes, int socket = kAnySocket);
+
+/// The memory usage of category over all sockets
+GALOIS_EXPORT MemoryUsage GetMemoryUsage(MemoryCategory category);
+
+/// The memory usage of category on socket
+GALOIS_EXPORT MemoryUsage GetMemoryUsage(MemoryCategory category, int socket);
+
+/// The memory usage of all categories together
+GALOIS_EXPORT MemoryUsage GetTotalMemoryUsage();
+
+/// Start tracking peaks from the current usage, e.g., to find the peak of
+/// one phase of a program
+GALOIS_EXPORT void ResetMemoryPeaks();
+
+/// The category of the innermost MemoryCategoryScope of the calling thread,
+/// or fallback if there is none
+GALOIS_EXPORT MemoryCategory CurrentMemoryCategory(MemoryCategory fallback);
+
+/// Charges the memory that the calling thread allocates from allocators that
+/// charge the current category (see MemoryCategory) to category while the
+/// scope is alive. Scopes nest.
+class GALOIS_EXPORT MemoryCategoryScope {
+public:
+  explicit MemoryCategoryScope(MemoryCategory category);
+  ~MemoryCategoryScope();
+
+  MemoryCategoryScope(const MemoryCategoryScope&) = delete;
+  MemoryCategoryScope& operator=(const MemoryCategoryScope&) = delete;
+
+private:
+  int previous_;
+};
+
+}  // namespace galois
+
+#endif
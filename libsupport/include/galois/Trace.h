@@ -0,0 +1,119 @@
+#ifndef GALOIS_LIBSUPPORT_GALOIS_TRACE_H_
+#define GALOIS_LIBSUPPORT_GALOIS_TRACE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#include "galois/Result.h"
+#include "galois/config.h"
+
+/// Opt-in timeline tracing.
+///
+/// When tracing is started, each thread records events into its own ring
+/// buffer, keeping only the most recent events if the buffer fills up.
+/// WriteTrace dumps the buffers as Chrome trace-event JSON, which can be
+/// opened with Perfetto (ui.perfetto.dev) or chrome://tracing. When tracing
+/// is off, each trace point costs one relaxed atomic load.
+///
+/// Setting the environment variable GALOIS_TRACE_FILE makes
+/// galois::SharedMemSys trace the whole program and write the trace to that
+/// file at exit. GALOIS_TRACE_EVENTS sets the capacity of each ring buffer.
+
+namespace galois {
+
+/// Default number of events kept per thread
+constexpr size_t kDefaultTraceEvents = 1 << 16;
+
+struct TraceEvent {
+  /// Names and categories are not copied; they must outlive the trace (see
+  /// TraceIntern)
+  const char* name;
+  const char* category;
+  uint64_t begin_ns;
+  uint64_t duration_ns;
+  /// Event specific value, e.g., the number of bytes read
+  uint64_t value;
+  /// 'X' for a span, 'i' for an instant
+  char phase;
+};
+
+namespace internal {
+
+GALOIS_EXPORT extern std::atomic<bool> trace_enabled;
+
+GALOIS_EXPORT void TraceRecord(const TraceEvent& event);
+
+}  // namespace internal
+
+inline bool
+TraceEnabled() {
+  return internal::trace_enabled.load(std::memory_order_relaxed);
+}
+
+/// Monotonic time in nanoseconds used for trace events
+GALOIS_EXPORT uint64_t TraceNow();
+
+/// Return a copy of name that lives until the program exits. Repeated calls
+/// with the same name return the same pointer.
+GALOIS_EXPORT const char* TraceIntern(const std::string& name);
+
+/// Name the calling thread in traces
+GALOIS_EXPORT void TraceSetThreadName(const std::string& name);
+
+/// Record a point in time, e.g., a successful steal
+inline void
+TraceInstant(const char* name, const char* category, uint64_t value = 0) {
+  if (TraceEnabled()) {
+    internal::TraceRecord({name, category, TraceNow(), 0, value, 'i'});
+  }
+}
+
+/// Record the lifetime of this object as a span
+class TraceScope {
+public:
+  TraceScope(const char* name, const char* category, uint64_t value = 0)
+      : name_(name),
+        category_(category),
+        value_(value),
+        begin_ns_(TraceEnabled() ? TraceNow() : 0) {}
+
+  ~TraceScope() {
+    if (begin_ns_ && TraceEnabled()) {
+      internal::TraceRecord(
+          {name_, category_, begin_ns_, TraceNow() - begin_ns_, value_, 'X'});
+    }
+  }
+
+  TraceScope(const TraceScope&) = delete;
+  TraceScope& operator=(const TraceScope&) = delete;
+
+  /// Do not record this span, e.g., because it turned out to do no work
+  void Discard() { begin_ns_ = 0; }
+
+private:
+  const char* name_;
+  const char* category_;
+  uint64_t value_;
+  uint64_t begin_ns_;
+};
+
+/// Start recording, discarding previously recorded events
+GALOIS_EXPORT void StartTracing(size_t events_per_thread = kDefaultTraceEvents);
+
+GALOIS_EXPORT void StopTracing();
+
+/// Stop recording and write recorded events as Chrome trace-event JSON.
+/// Threads should not be recording events concurrently.
+GALOIS_EXPORT Result<void> WriteTrace(const std::string& path);
+
+/// Start tracing if GALOIS_TRACE_FILE is set
+GALOIS_EXPORT void TraceInitFromEnv();
+
+/// Write the trace to GALOIS_TRACE_FILE if tracing was started by
+/// TraceInitFromEnv
+GALOIS_EXPORT Result<void> TraceFiniFromEnv();
+
+}  // namespace galois
+
+#endif
@@ -0,0 +1,131 @@
+#include "galois/MemoryAccounting.h"
+
+#include <algorithm>
+#include <atomic>
+
+#include "galois/Logging.h"
+
+namespace {
+
+// Padded to a (prefetched pair of) cache lines, since threads update
+// counters concurrently
+struct alignas(128) Counter {
+  std::atomic<int64_t> bytes{0};
+  std::atomic<int64_t> peak_bytes{0};
+
+  void Add(int64_t delta) {
+    int64_t now = bytes.fetch_add(delta, std::memory_order_relaxed) + delta;
+    int64_t peak = peak_bytes.load(std::memory_order_relaxed);
+    while (now > peak && !peak_bytes.compare_exchange_weak(
+                             peak, now, std::memory_order_relaxed)) {
+    }
+  }
+
+  galois::MemoryUsage Get() const {
+    return galois::MemoryUsage{
+        bytes.load(std::memory_order_relaxed),
+        peak_bytes.load(std::memory_order_relaxed)};
+  }
+
+  void ResetPeak() {
+    peak_bytes.store(
+        bytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+  }
+};
+
+struct CategoryCounters {
+  Counter total;
+  Counter sockets[galois::kMaxAccountedSockets];
+};
+
+// Plain globals rather than function statics, since memory may be freed
+// during static destruction
+CategoryCounters counters[galois::kNumMemoryCategories];
+Counter total;
+
+thread_local int current_category = -1;
+
+CategoryCounters&
+CountersOf(galois::MemoryCategory category) {
+  auto index = static_cast<size_t>(category);
+  GALOIS_LOG_ASSERT(index < galois::kNumMemoryCategories);
+  return counters[index];
+}
+
+}  // namespace
+
+const char*
+galois::MemoryCategoryName(MemoryCategory category) {
+  switch (category) {
+  case MemoryCategory::kTopology:
+    return "Topology";
+  case MemoryCategory::kProperties:
+    return "Properties";
+  case MemoryCategory::kWorklists:
+    return "Worklists";
+  case MemoryCategory::kIOBuffers:
+    return "IOBuffers";
+  case MemoryCategory::kUser:
+    return "User";
+  }
+  return "Unknown";
+}
+
+void
+galois::AccountMemory(MemoryCategory category, int64_t bytes, int socket) {
+  if (bytes == 0) {
+    return;
+  }
+  CategoryCounters& c = CountersOf(category);
+  if (socket != kAnySocket) {
+    c.sockets[std::clamp(socket, 0, kMaxAccountedSockets - 1)].Add(bytes);
+  }
+  c.total.Add(bytes);
+  total.Add(bytes);
+}
+
+galois::MemoryUsage
+galois::GetMemoryUsage(MemoryCategory category) {
+  return CountersOf(category).total.Get();
+}
+
+galois::MemoryUsage
+galois::GetMemoryUsage(MemoryCategory category, int socket) {
+  if (socket < 0 || socket >= kMaxAccountedSockets) {
+    return MemoryUsage{};
+  }
+  return CountersOf(category).sockets[socket].Get();
+}
+
+galois::MemoryUsage
+galois::GetTotalMemoryUsage() {
+  return total.Get();
+}
+
+void
+galois::ResetMemoryPeaks() {
+  for (CategoryCounters& c : counters) {
+    c.total.ResetPeak();
+    for (Counter& s : c.sockets) {
+      s.ResetPeak();
+    }
+  }
+  total.ResetPeak();
+}
+
+galois::MemoryCategory
+galois::CurrentMemoryCategory(MemoryCategory fallback) {
+  if (current_category < 0) {
+    return fallback;
+  }
+  return static_cast<MemoryCategory>(current_category);
+}
+
+galois::MemoryCategoryScope::MemoryCategoryScope(MemoryCategory category)
+    : previous_(current_category) {
+  current_category = static_cast<int>(category);
+}
+
+galois::MemoryCategoryScope::~MemoryCategoryScope() {
+  current_category = previous_;
+}
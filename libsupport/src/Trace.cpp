@@ -0,0 +1,212 @@
+#include "galois/Trace.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+
+#include "galois/Env.h"
+
+std::atomic<bool> galois::internal::trace_enabled{false};
+
+namespace {
+
+struct ThreadBuffer {
+  /// Tracing session the buffer holds events of
+  uint64_t session{0};
+  /// Events recorded in this session, including overwritten ones
+  uint64_t count{0};
+  std::vector<galois::TraceEvent> ring;
+  uint32_t tid{0};
+  std::string thread_name;
+};
+
+struct TraceState {
+  std::mutex mutex;
+  /// Buffers are never freed so that events of exited threads can still be
+  /// written and so that threads can keep their pointer without locking
+  std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+  std::unordered_set<std::string> names;
+  std::atomic<uint64_t> session{0};
+  size_t capacity{galois::kDefaultTraceEvents};
+  bool from_env{false};
+};
+
+TraceState&
+State() {
+  // Leaked so that threads still running at exit can record safely
+  static TraceState* state = new TraceState();
+  return *state;
+}
+
+ThreadBuffer*
+LocalBuffer() {
+  thread_local ThreadBuffer* buffer = nullptr;
+  if (!buffer) {
+    TraceState& state = State();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.buffers.emplace_back(std::make_unique<ThreadBuffer>());
+    buffer = state.buffers.back().get();
+    buffer->tid = state.buffers.size();
+  }
+  return buffer;
+}
+
+std::string
+Quote(const char* str) {
+  return nlohmann::json(str ? str : "").dump();
+}
+
+}  // namespace
+
+uint64_t
+galois::TraceNow() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void
+galois::internal::TraceRecord(const TraceEvent& event) {
+  ThreadBuffer* buffer = LocalBuffer();
+  TraceState& state = State();
+  uint64_t session = state.session.load(std::memory_order_acquire);
+  if (buffer->session != session) {
+    // First event of this thread in a new session
+    buffer->ring.assign(state.capacity, TraceEvent{});
+    buffer->count = 0;
+    buffer->session = session;
+  }
+  if (buffer->ring.empty()) {
+    return;
+  }
+  buffer->ring[buffer->count % buffer->ring.size()] = event;
+  ++buffer->count;
+}
+
+const char*
+galois::TraceIntern(const std::string& name) {
+  TraceState& state = State();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  return state.names.emplace(name).first->c_str();
+}
+
+void
+galois::TraceSetThreadName(const std::string& name) {
+  ThreadBuffer* buffer = LocalBuffer();
+  std::lock_guard<std::mutex> lock(State().mutex);
+  buffer->thread_name = name;
+}
+
+void
+galois::StartTracing(size_t events_per_thread) {
+  TraceState& state = State();
+  {
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.capacity = events_per_thread;
+    state.session.fetch_add(1, std::memory_order_release);
+  }
+  internal::trace_enabled.store(true, std::memory_order_release);
+}
+
+void
+galois::StopTracing() {
+  internal::trace_enabled.store(false, std::memory_order_release);
+}
+
+galois::Result<void>
+galois::WriteTrace(const std::string& path) {
+  StopTracing();
+
+  std::unique_ptr<FILE, decltype(&fclose)> file(
+      fopen(path.c_str(), "w"), &fclose);
+  if (!file) {
+    return ResultErrno();
+  }
+
+  TraceState& state = State();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  uint64_t session = state.session.load(std::memory_order_acquire);
+  int pid = getpid();
+  bool first = true;
+  auto separator = [&]() {
+    const char* sep = first ? "\n" : ",\n";
+    first = false;
+    return sep;
+  };
+
+  fmt::print(file.get(), "{{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+  for (const auto& buffer : state.buffers) {
+    if (!buffer->thread_name.empty()) {
+      fmt::print(
+          file.get(),
+          "{}{{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":{},\"tid\":{},"
+          "\"args\":{{\"name\":{}}}}}",
+          separator(), pid, buffer->tid, Quote(buffer->thread_name.c_str()));
+    }
+    if (buffer->session != session || buffer->ring.empty()) {
+      continue;
+    }
+
+    uint64_t size = buffer->ring.size();
+    uint64_t begin = buffer->count > size ? buffer->count - size : 0;
+    for (uint64_t i = begin; i < buffer->count; ++i) {
+      const TraceEvent& event = buffer->ring[i % size];
+      // Timestamps are in microseconds
+      fmt::print(
+          file.get(),
+          "{}{{\"ph\":\"{}\",\"name\":{},\"cat\":{},\"pid\":{},\"tid\":{},"
+          "\"ts\":{:.3f}",
+          separator(), event.phase, Quote(event.name), Quote(event.category),
+          pid, buffer->tid, event.begin_ns / 1000.0);
+      if (event.phase == 'X') {
+        fmt::print(file.get(), ",\"dur\":{:.3f}", event.duration_ns / 1000.0);
+      } else {
+        fmt::print(file.get(), ",\"s\":\"t\"");
+      }
+      fmt::print(file.get(), ",\"args\":{{\"value\":{}}}}}", event.value);
+    }
+  }
+  fmt::print(file.get(), "\n]}}\n");
+
+  if (ferror(file.get())) {
+    return std::error_code(EIO, std::system_category());
+  }
+  return ResultSuccess();
+}
+
+void
+galois::TraceInitFromEnv() {
+  std::string path;
+  if (!GetEnv("GALOIS_TRACE_FILE", &path) || path.empty()) {
+    return;
+  }
+  int events = kDefaultTraceEvents;
+  GetEnv("GALOIS_TRACE_EVENTS", &events);
+
+  State().from_env = true;
+  StartTracing(std::max(events, 0));
+}
+
+galois::Result<void>
+galois::TraceFiniFromEnv() {
+  TraceState& state = State();
+  if (!state.from_env) {
+    return ResultSuccess();
+  }
+  state.from_env = false;
+
+  std::string path;
+  GetEnv("GALOIS_TRACE_FILE", &path);
+  return WriteTrace(path);
+}
@@ -0,0 +1,117 @@
+#include "galois/MemoryAccounting.h"
+
+#include <thread>
+#include <vector>
+
+#include "galois/Logging.h"
+
+namespace {
+
+void
+TestCharges() {
+  using galois::MemoryCategory;
+
+  galois::AccountMemory(MemoryCategory::kTopology, 100, 1);
+  galois::AccountMemory(MemoryCategory::kTopology, 50);
+  galois::AccountMemory(MemoryCategory::kTopology, -100, 1);
+
+  galois::MemoryUsage topology =
+      galois::GetMemoryUsage(MemoryCategory::kTopology);
+  GALOIS_LOG_ASSERT(topology.bytes == 50);
+  GALOIS_LOG_ASSERT(topology.peak_bytes == 150);
+
+  galois::MemoryUsage on_socket =
+      galois::GetMemoryUsage(MemoryCategory::kTopology, 1);
+  GALOIS_LOG_ASSERT(on_socket.bytes == 0);
+  GALOIS_LOG_ASSERT(on_socket.peak_bytes == 100);
+  GALOIS_LOG_ASSERT(
+      galois::GetMemoryUsage(MemoryCategory::kTopology, 0).peak_bytes == 0);
+  GALOIS_LOG_ASSERT(
+      galois::GetMemoryUsage(MemoryCategory::kProperties).peak_bytes == 0);
+
+  // Sockets beyond the last accounted one count as the last one
+  galois::AccountMemory(MemoryCategory::kUser, 8, 1000);
+  GALOIS_LOG_ASSERT(
+      galois::GetMemoryUsage(
+          MemoryCategory::kUser, galois::kMaxAccountedSockets - 1)
+          .bytes == 8);
+  GALOIS_LOG_ASSERT(
+      galois::GetMemoryUsage(MemoryCategory::kUser, 1000).bytes == 0);
+  galois::AccountMemory(MemoryCategory::kUser, -8, 1000);
+
+  galois::MemoryUsage total = galois::GetTotalMemoryUsage();
+  GALOIS_LOG_ASSERT(total.bytes == 50);
+  GALOIS_LOG_ASSERT(total.peak_bytes == 150);
+
+  galois::ResetMemoryPeaks();
+  topology = galois::GetMemoryUsage(MemoryCategory::kTopology);
+  GALOIS_LOG_ASSERT(topology.peak_bytes == 50);
+  GALOIS_LOG_ASSERT(
+      galois::GetMemoryUsage(MemoryCategory::kTopology, 1).peak_bytes == 0);
+
+  galois::AccountMemory(MemoryCategory::kTopology, -50);
+  GALOIS_LOG_ASSERT(galois::GetTotalMemoryUsage().bytes == 0);
+}
+
+void
+TestConcurrentCharges() {
+  constexpr int kThreads = 8;
+  constexpr int kCharges = 10000;
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kThreads; ++i) {
+    threads.emplace_back([i]() {
+      for (int j = 0; j < kCharges; ++j) {
+        galois::AccountMemory(galois::MemoryCategory::kWorklists, 16, i);
+      }
+    });
+  }
+  for (std::thread& t : threads) {
+    t.join();
+  }
+
+  galois::MemoryUsage usage =
+      galois::GetMemoryUsage(galois::MemoryCategory::kWorklists);
+  GALOIS_LOG_ASSERT(usage.bytes == kThreads * kCharges * 16);
+  GALOIS_LOG_ASSERT(usage.peak_bytes == usage.bytes);
+  galois::AccountMemory(galois::MemoryCategory::kWorklists, -usage.bytes);
+}
+
+void
+TestScopes() {
+  using galois::MemoryCategory;
+
+  constexpr MemoryCategory kFallback = MemoryCategory::kUser;
+  GALOIS_LOG_ASSERT(galois::CurrentMemoryCategory(kFallback) == kFallback);
+  {
+    galois::MemoryCategoryScope topology(MemoryCategory::kTopology);
+    GALOIS_LOG_ASSERT(
+        galois::CurrentMemoryCategory(kFallback) == MemoryCategory::kTopology);
+    {
+      galois::MemoryCategoryScope io(MemoryCategory::kIOBuffers);
+      GALOIS_LOG_ASSERT(
+          galois::CurrentMemoryCategory(kFallback) ==
+          MemoryCategory::kIOBuffers);
+    }
+    GALOIS_LOG_ASSERT(
+        galois::CurrentMemoryCategory(kFallback) == MemoryCategory::kTopology);
+
+    // Scopes are per thread
+    std::thread other([]() {
+      GALOIS_LOG_ASSERT(galois::CurrentMemoryCategory(kFallback) == kFallback);
+    });
+    other.join();
+  }
+  GALOIS_LOG_ASSERT(galois::CurrentMemoryCategory(kFallback) == kFallback);
+}
+
+}  // namespace
+
+int
+main() {
+  TestCharges();
+  TestConcurrentCharges();
+  TestScopes();
+
+  return 0;
+}
@@ -0,0 +1,151 @@
+#include "galois/Trace.h"
+
+#include <unistd.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "galois/Logging.h"
+
+namespace {
+
+std::string
+TempPath() {
+  char path[] = "/tmp/galois-trace-XXXXXX";
+  int fd = mkstemp(path);
+  GALOIS_LOG_ASSERT(fd >= 0);
+  close(fd);
+  return path;
+}
+
+nlohmann::json
+WriteAndParse() {
+  std::string path = TempPath();
+  auto write_good = galois::WriteTrace(path);
+  GALOIS_LOG_VASSERT(write_good, "WriteTrace: {}", write_good.error());
+
+  std::ifstream in(path);
+  nlohmann::json trace = nlohmann::json::parse(in);
+  unlink(path.c_str());
+  return trace;
+}
+
+size_t
+Count(const nlohmann::json& trace, const std::string& phase) {
+  size_t count = 0;
+  for (const auto& event : trace["traceEvents"]) {
+    if (event["ph"] == phase) {
+      ++count;
+    }
+  }
+  return count;
+}
+
+void
+TestThreads() {
+  constexpr int kThreads = 4;
+  constexpr int kSpans = 10;
+
+  galois::StartTracing();
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([t] {
+      galois::TraceSetThreadName("worker-" + std::to_string(t));
+      for (int i = 0; i < kSpans; ++i) {
+        galois::TraceScope scope(
+            galois::TraceIntern("span-" + std::to_string(i)), "test", i);
+      }
+      galois::TraceInstant("instant", "test", t);
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  nlohmann::json trace = WriteAndParse();
+  GALOIS_LOG_ASSERT(Count(trace, "X") == kThreads * kSpans);
+  GALOIS_LOG_ASSERT(Count(trace, "i") == kThreads);
+  GALOIS_LOG_ASSERT(Count(trace, "M") == kThreads);
+
+  for (const auto& event : trace["traceEvents"]) {
+    if (event["ph"] == "X") {
+      GALOIS_LOG_ASSERT(event["dur"].get<double>() >= 0);
+      GALOIS_LOG_ASSERT(event["cat"] == "test");
+    }
+  }
+
+  // Tracing is stopped after writing
+  GALOIS_LOG_ASSERT(!galois::TraceEnabled());
+}
+
+void
+TestOverwrite() {
+  constexpr size_t kCapacity = 8;
+
+  galois::StartTracing(kCapacity);
+  for (int i = 0; i < 100; ++i) {
+    galois::TraceInstant("old", "test", i);
+  }
+  galois::TraceInstant("new", "test", 100);
+
+  nlohmann::json trace = WriteAndParse();
+  GALOIS_LOG_ASSERT(Count(trace, "i") == kCapacity);
+  // Only the most recent events are kept, oldest first
+  uint64_t prev = 0;
+  for (const auto& event : trace["traceEvents"]) {
+    if (event["ph"] != "i") {
+      continue;
+    }
+    uint64_t value = event["args"]["value"];
+    GALOIS_LOG_ASSERT(value >= 93 && value > prev);
+    prev = value;
+  }
+  GALOIS_LOG_ASSERT(prev == 100);
+}
+
+void
+TestDisabled() {
+  galois::StartTracing();
+  galois::StopTracing();
+  galois::TraceInstant("ignored", "test");
+  { galois::TraceScope scope("ignored", "test"); }
+
+  nlohmann::json trace = WriteAndParse();
+  GALOIS_LOG_ASSERT(Count(trace, "i") == 0);
+  GALOIS_LOG_ASSERT(Count(trace, "X") == 0);
+}
+
+void
+TestDiscard() {
+  galois::StartTracing();
+  { galois::TraceScope scope("kept", "test"); }
+  {
+    galois::TraceScope scope("discarded", "test");
+    scope.Discard();
+  }
+
+  nlohmann::json trace = WriteAndParse();
+  GALOIS_LOG_ASSERT(Count(trace, "X") == 1);
+  for (const auto& event : trace["traceEvents"]) {
+    if (event["ph"] == "X") {
+      GALOIS_LOG_ASSERT(event["name"] == "kept");
+    }
+  }
+}
+
+}  // namespace
+
+int
+main() {
+  TestThreads();
+  TestOverwrite();
+  TestDisabled();
+  TestDiscard();
+
+  return 0;
+}
@@ -27,6 +27,8 @@ class GALOIS_EXPORT FileView : public arrow::io::RandomAccessFile {
   int64_t mem_start_;
   std::string filename_;
   bool valid_ = false;
+  // Bytes of the filled pages, charged to MemoryCategory::kIOBuffers
+  int64_t charged_bytes_{0};
   std::vector<uint64_t> filling_;
   std::unique_ptr<std::vector<FillingRange>> fetches_;
 
@@ -43,9 +45,11 @@ public:
         mem_start_(other.mem_start_),
         filename_(std::move(other.filename_)),
         valid_(other.valid_),
+        charged_bytes_(other.charged_bytes_),
         filling_(std::move(other.filling_)),
         fetches_(std::move(other.fetches_)) {
     other.valid_ = false;
+    other.charged_bytes_ = 0;
   }
 
   FileView& operator=(FileView&& other) noexcept {
@@ -60,10 +64,12 @@ public:
       mem_start_ = other.mem_start_;
       filename_ = std::move(other.filename_);
       valid_ = other.valid_;
+      charged_bytes_ = other.charged_bytes_;
       filling_ = std::move(other.filling_);
       fetches_ =
           std::unique_ptr<std::vector<FillingRange>>(std::move(other.fetches_));
       other.valid_ = false;
+      other.charged_bytes_ = 0;
     }
     return *this;
   }
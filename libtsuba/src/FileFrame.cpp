@@ -3,6 +3,7 @@
 #include <sys/mman.h>
 
 #include "galois/Logging.h"
+#include "galois/MemoryAccounting.h"
 #include "galois/Platform.h"
 #include "galois/Result.h"
 #include "tsuba/Errors.h"
@@ -21,6 +22,8 @@ FileFrame::Destroy() {
   if (valid_) {
     int err = munmap(map_start_, map_size_);
     valid_ = false;
+    galois::AccountMemory(
+        galois::MemoryCategory::kIOBuffers, -static_cast<int64_t>(map_size_));
     if (err) {
       return galois::ResultErrno();
     }
@@ -41,6 +44,7 @@ FileFrame::Init(uint64_t reserved_size) {
   if (auto res = Destroy(); !res) {
     GALOIS_LOG_ERROR("Destroy: {}", res.error());
   }
+  galois::AccountMemory(galois::MemoryCategory::kIOBuffers, map_size);
   path_ = "";
   map_size_ = map_size;
   map_start_ = static_cast<uint8_t*>(ptr);
@@ -90,6 +94,8 @@ FileFrame::GrowBuffer(int64_t accomodate) {
     }
     map_start_ = static_cast<uint8_t*>(ptr);
   }
+  galois::AccountMemory(
+      galois::MemoryCategory::kIOBuffers, new_size - map_size_);
   map_size_ = new_size;
   return galois::ResultSuccess();
 }
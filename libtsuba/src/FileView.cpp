@@ -3,11 +3,13 @@
 #include <sys/mman.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <cassert>
 #include <cstdio>
 #include <string>
 
 #include "galois/Logging.h"
+#include "galois/MemoryAccounting.h"
 #include "galois/Result.h"
 #include "tsuba/Errors.h"
 #include "tsuba/file.h"
@@ -30,6 +32,29 @@
  * somehow and also tell users to not modify our files?
  */
 
+namespace {
+
+/// The bytes of the pages in [first_page, last_page] that are not yet marked
+/// in bitmap (in the bit order of FileView::MarkFilled), where the last page
+/// of the file may be partial
+int64_t
+UnfilledBytes(
+    const uint64_t* bitmap, uint64_t first_page, uint64_t last_page,
+    uint8_t page_shift, int64_t file_size) {
+  int64_t bytes = 0;
+  for (uint64_t page = first_page; page <= last_page; ++page) {
+    if (bitmap[page / 64] & (UINT64_C(1) << (63 - page % 64))) {
+      continue;
+    }
+    int64_t begin = page << page_shift;
+    int64_t end = std::min<int64_t>((page + 1) << page_shift, file_size);
+    bytes += end - begin;
+  }
+  return bytes;
+}
+
+}  // namespace
+
 namespace tsuba {
 
 FileView::~FileView() {
@@ -41,6 +66,9 @@ FileView::~FileView() {
 galois::Result<void>
 FileView::Unbind() {
   galois::Result<void> res = galois::ResultSuccess();
+  // Also release the charge of a Bind that failed after filling
+  galois::AccountMemory(galois::MemoryCategory::kIOBuffers, -charged_bytes_);
+  charged_bytes_ = 0;
   if (valid_) {
     // Resolve all outstanding reads so they don't write to the memory we are
     // about to unmap
@@ -138,6 +166,12 @@ FileView::Fill(uint64_t begin, uint64_t end, bool resolve) {
         GALOIS_LOG_ERROR("mprotect: {}", std::strerror(errno));
         return galois::ResultErrno();
       }
+      // The region may include pages that are already filled; charge only the
+      // ones that MarkFilled is about to mark
+      int64_t charge = UnfilledBytes(
+          &filling_[0], first_page, last_page, page_shift_, file_size_);
+      galois::AccountMemory(galois::MemoryCategory::kIOBuffers, charge);
+      charged_bytes_ += charge;
 
       auto peek_fut =
           FileGetAsync(filename_, map_start_ + file_off, file_off, map_size);
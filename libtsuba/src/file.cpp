@@ -18,16 +18,20 @@
 #include "galois/Logging.h"
 #include "galois/Platform.h"
 #include "galois/Result.h"
+#include "galois/Trace.h"
 #include "tsuba/Errors.h"
 
 galois::Result<void>
 tsuba::FileStore(const std::string& uri, const uint8_t* data, uint64_t size) {
+  galois::TraceScope trace("FileStore", "tsuba", size);
   return FS(uri)->PutMultiSync(uri, data, size);
 }
 
 std::future<galois::Result<void>>
 tsuba::FileStoreAsync(
     const std::string& uri, const uint8_t* data, uint64_t size) {
+  // Only the launch; the transfer finishes when the future is ready
+  galois::TraceScope trace("FileStoreAsyncLaunch", "tsuba", size);
   return FS(uri)->PutAsync(uri, data, size);
 }
 
@@ -35,6 +39,7 @@ galois::Result<void>
 tsuba::FileGet(
     const std::string& uri, uint8_t* result_buffer, uint64_t begin,
     uint64_t size) {
+  galois::TraceScope trace("FileGet", "tsuba", size);
   return FS(uri)->GetMultiSync(uri, begin, size, result_buffer);
 }
 
@@ -42,11 +47,14 @@ std::future<galois::Result<void>>
 tsuba::FileGetAsync(
     const std::string& uri, uint8_t* result_buffer, uint64_t begin,
     uint64_t size) {
+  // Only the launch; the transfer finishes when the future is ready
+  galois::TraceScope trace("FileGetAsyncLaunch", "tsuba", size);
   return FS(uri)->GetAsync(uri, begin, size, result_buffer);
 }
 
 galois::Result<void>
 tsuba::FileStat(const std::string& uri, StatBuf* s_buf) {
+  galois::TraceScope trace("FileStat", "tsuba");
   return FS(uri)->Stat(uri, s_buf);
 }
 
@@ -54,6 +62,7 @@ std::future<galois::Result<void>>
 tsuba::FileListAsync(
     const std::string& directory, std::vector<std::string>* list,
     std::vector<uint64_t>* size) {
+  galois::TraceScope trace("FileListAsync", "tsuba");
   return FS(directory)->ListAsync(directory, list, size);
 }
 
@@ -61,5 +70,6 @@ galois::Result<void>
 tsuba::FileDelete(
     const std::string& directory,
     const std::unordered_set<std::string>& files) {
+  galois::TraceScope trace("FileDelete", "tsuba", files.size());
   return FS(directory)->Delete(directory, files);
 }
@@ -8,6 +8,7 @@
 
 #include "Lonestar/BoilerPlate.h"
 #include "galois/Galois.h"
+#include "galois/PerThreadLargeArray.h"
 
 using NodeDataOuter = std::tuple<>;
 using EdgeDataOuter = std::tuple<>;
@@ -21,35 +22,37 @@ class BCOuter {
   const OuterGraph& graph_;
   int num_nodes_;
 
-  galois::substrate::PerThreadStorage<double*>
+  // Per-thread arrays of num_nodes_ elements, each on the socket of its
+  // thread
+  galois::PerThreadLargeArray<double>
       centrality_measure_;  // betweeness measure
-  galois::substrate::PerThreadStorage<double*> per_thread_sigma_;
-  galois::substrate::PerThreadStorage<int*> per_thread_distance_;
-  galois::substrate::PerThreadStorage<double*> per_thread_delta_;
-  galois::substrate::PerThreadStorage<galois::gdeque<OuterGNode>*>
-      per_thread_successor_;
+  galois::PerThreadLargeArray<double> per_thread_sigma_;
+  galois::PerThreadLargeArray<int> per_thread_distance_;
+  galois::PerThreadLargeArray<double> per_thread_delta_;
+  galois::PerThreadLargeArray<galois::gdeque<OuterGNode>> per_thread_successor_;
 
 public:
   /**
    * Constructor initializes thread local storage.
    */
-  BCOuter(const OuterGraph& g) : graph_(g), num_nodes_(g.num_nodes()) {
-    InitializeLocal();
-  }
-
-  /**
-   * Constructor destroys thread local storage.
-   */
-  ~BCOuter(void) { DeleteLocal(); }
+  BCOuter(const OuterGraph& g)
+      : graph_(g),
+        num_nodes_(g.num_nodes()),
+        centrality_measure_(num_nodes_),
+        per_thread_sigma_(num_nodes_),
+        per_thread_distance_(num_nodes_),
+        per_thread_delta_(num_nodes_),
+        per_thread_successor_(num_nodes_) {}
 
   //! Function that does BC for a single source; called by a thread
   void ComputeBC(const OuterGNode current_source) {
     galois::gdeque<OuterGNode> source_queue;
 
-    double* sigma = *per_thread_sigma_.getLocal();
-    int* distance = *per_thread_distance_.getLocal();
-    double* delta = *per_thread_delta_.getLocal();
-    galois::gdeque<OuterGNode>* successor = *per_thread_successor_.getLocal();
+    double* sigma = per_thread_sigma_.getLocal().data();
+    int* distance = per_thread_distance_.getLocal().data();
+    double* delta = per_thread_delta_.getLocal().data();
+    galois::gdeque<OuterGNode>* successor =
+        per_thread_successor_.getLocal().data();
 
     sigma[current_source] = 1;
     distance[current_source] = 1;
@@ -98,7 +101,7 @@ public:
 
     // save result of this source's BC, reset all local values for next
     // source
-    double* Vec = *centrality_measure_.getLocal();
+    double* Vec = centrality_measure_.getLocal().data();
     for (int i = 0; i < num_nodes_; ++i) {
       Vec[i] += delta[i];
       delta[i] = 0;
@@ -149,10 +152,10 @@ public:
     double sample_bc = 0.0;
     bool first_time = true;
     for (int i = 0; i < num_nodes_; ++i) {
-      double bc = (*centrality_measure_.getRemote(0))[i];
+      double bc = centrality_measure_.getRemote(0)[i];
 
       for (unsigned j = 1; j < galois::getActiveThreads(); ++j)
-        bc += (*centrality_measure_.getRemote(j))[i];
+        bc += centrality_measure_.getRemote(j)[i];
 
       if (first_time) {
         sample_bc = bc;
@@ -180,10 +183,10 @@ public:
   void PrintBCValues(
       size_t begin, size_t end, std::ostream& out, int precision = 6) {
     for (; begin != end; ++begin) {
-      double bc = (*centrality_measure_.getRemote(0))[begin];
+      double bc = centrality_measure_.getRemote(0)[begin];
 
       for (unsigned j = 1; j < galois::getActiveThreads(); ++j)
-        bc += (*centrality_measure_.getRemote(j))[begin];
+        bc += centrality_measure_.getRemote(j)[begin];
 
       out << begin << " " << std::setiosflags(std::ios::fixed)
           << std::setprecision(precision) << bc << "\n";
@@ -192,10 +195,10 @@ public:
 
   void PrintBCValues(size_t begin, size_t end, std::vector<double>& out) {
     for (; begin != end; ++begin) {
-      double bc = (*centrality_measure_.getRemote(0))[begin];
+      double bc = centrality_measure_.getRemote(0)[begin];
 
       for (unsigned j = 1; j < galois::getActiveThreads(); ++j) {
-        bc += (*centrality_measure_.getRemote(j))[begin];
+        bc += centrality_measure_.getRemote(j)[begin];
       }
 
       out.push_back(bc);
@@ -243,10 +246,10 @@ public:
     galois::do_all(
         galois::iterate(graph),
         [&](LevelGNode n) {
-          double bc = (*centrality_measure_.getRemote(0))[n];
+          double bc = centrality_measure_.getRemote(0)[n];
 
           for (unsigned j = 1; j < galois::getActiveThreads(); ++j)
-            bc += (*centrality_measure_.getRemote(j))[n];
+            bc += centrality_measure_.getRemote(j)[n];
 
           accum_max.update(bc);
           accum_min.update(bc);
@@ -258,53 +261,6 @@ public:
     galois::gPrint("Min BC is ", accum_min.reduce(), "\n");
     galois::gPrint("BC sum is ", accum_sum.reduce(), "\n");
   }
-
-private:
-  /**
-   * Initialize an array at some provided address.
-   *
-   * @param addr Address to initialize array at
-   */
-  template <typename T>
-  void InitArray(T** addr) {
-    *addr = new T[num_nodes_]();
-  }
-
-  /**
-   * Destroy an array at some provided address.
-   *
-   * @param addr Address to destroy array at
-   */
-  template <typename T>
-  void DeleteArray(T** addr) {
-    delete[] * addr;
-  }
-
-  /**
-   * Initialize local thread storage.
-   */
-  void InitializeLocal(void) {
-    galois::on_each([this](unsigned, unsigned) {
-      this->InitArray(centrality_measure_.getLocal());
-      this->InitArray(per_thread_sigma_.getLocal());
-      this->InitArray(per_thread_distance_.getLocal());
-      this->InitArray(per_thread_delta_.getLocal());
-      this->InitArray(per_thread_successor_.getLocal());
-    });
-  }
-
-  /**
-   * Destroy local thread storage.
-   */
-  void DeleteLocal(void) {
-    galois::on_each([this](unsigned, unsigned) {
-      this->DeleteArray(centrality_measure_.getLocal());
-      this->DeleteArray(per_thread_sigma_.getLocal());
-      this->DeleteArray(per_thread_distance_.getLocal());
-      this->DeleteArray(per_thread_delta_.getLocal());
-      this->DeleteArray(per_thread_successor_.getLocal());
-    });
-  }
 };
 
 /**
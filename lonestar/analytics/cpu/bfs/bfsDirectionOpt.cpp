@@ -35,6 +35,7 @@
 #include "galois/Timer.h"
 #include "galois/analytics/BfsSsspImplementationBase.h"
 #include "galois/graphs/LCGraph.h"
+#include "galois/graphs/Frontier.h"
 #include "galois/graphs/LC_CSR_CSC_Graph.h"
 #include "galois/graphs/TypeTraits.h"
 #include "galois/gstl.h"
@@ -87,9 +88,9 @@ static cll::opt<unsigned int> numPrint(
 
 enum Exec { SERIAL, PARALLEL };
 
-enum Algo { SyncDO = 0, Async, AutoAlgo };
+enum Algo { SyncDO = 0, Async, EdgeMapDO, AutoAlgo };
 
-const char* const ALGO_NAMES[] = {"SyncDO", "Async", "Auto"};
+const char* const ALGO_NAMES[] = {"SyncDO", "Async", "EdgeMapDO", "Auto"};
 
 static cll::opt<Exec> execution(
     "exec",
@@ -101,6 +102,9 @@ static cll::opt<Algo> algo(
     "algo", cll::desc("Choose an algorithm (default value Auto):"),
     cll::values(
         clEnumVal(SyncDO, "SyncDO"), clEnumVal(Async, "Async"),
+        clEnumVal(
+            EdgeMapDO,
+            "EdgeMapDO: direction optimization with galois::graphs::EdgeMap"),
         clEnumVal(
             AutoAlgo, "Auto: choose between SyncDO and Async automatically")),
     cll::init(AutoAlgo));
@@ -187,17 +191,10 @@ WlToBitset(WL& wl, galois::DynamicBitset& bitset) {
 
 template <typename WL>
 void
-BitsetToWl(const Graph& graph, const galois::DynamicBitset& bitset, WL& wl) {
+BitsetToWl(const galois::DynamicBitset& bitset, WL& wl) {
   wl.clear();
-  galois::do_all(
-      galois::iterate(graph),
-      [&](const GNode& src) {
-        if (bitset.test(src))
-          // pushWrap(wl, src);
-          wl.push(src);
-      },
-      galois::steal(), galois::chunk_size<CHUNK_SIZE>(),
-      galois::loopname("BitsetToWl"));
+  // Skips empty words of the frontier rather than testing every node
+  bitset.parallel_for_each_set([&](size_t src) { wl.push(src); });
 }
 
 template <bool CONCURRENT, typename T, typename P, typename R>
@@ -297,7 +294,7 @@ syncDOAlgo(
       } while (work_items.reduce() >= old_workItemNum ||
                (work_items.reduce() > numNodes / beta));
 
-      BitsetToWl(graph, front_bitset, *next);
+      BitsetToWl(front_bitset, *next);
       scout_count = 1;
     } else {
       // c_push++;
@@ -387,6 +384,41 @@ asyncAlgo(
       galois::disable_conflict_detection());
 }
 
+/// Assigns each node reached by a frontier its parent
+struct ParentFn {
+  Graph& graph;
+
+  bool Cond(GNode dst) const {
+    return graph.getData(dst, galois::MethodFlag::UNPROTECTED) ==
+           BFS::kDistanceInfinity;
+  }
+
+  bool Update(GNode src, GNode dst) {
+    graph.getData(dst, galois::MethodFlag::UNPROTECTED) = src;
+    return true;
+  }
+
+  bool UpdateAtomic(GNode src, GNode dst) {
+    auto& ddata = graph.getData(dst, galois::MethodFlag::UNPROTECTED);
+    Dist oldDist = BFS::kDistanceInfinity;
+    return __sync_bool_compare_and_swap(&ddata, oldDist, src);
+  }
+};
+
+void
+edgeMapAlgo(Graph& graph, GNode source) {
+  galois::graphs::EdgeMapOptions options;
+  options.threshold = alpha;
+
+  graph.getData(source) = 0;
+
+  ParentFn fn{graph};
+  galois::graphs::VertexSubset<GNode> frontier(graph.size(), source);
+  while (!frontier.Empty()) {
+    frontier = galois::graphs::EdgeMap(graph, frontier, fn, options);
+  }
+}
+
 template <bool CONCURRENT>
 void
 runAlgo(Graph& graph, const GNode& source, const uint32_t runID) {
@@ -399,6 +431,9 @@ runAlgo(Graph& graph, const GNode& source, const uint32_t runID) {
     asyncAlgo<CONCURRENT, GNode>(
         graph, source, NodePushWrap(), OutEdgeRangeFn{graph});
     break;
+  case EdgeMapDO:
+    edgeMapAlgo(graph, source);
+    break;
 
   default:
     std::cerr << "ERROR: unkown algo type\n";
@@ -410,6 +445,12 @@ main(int argc, char** argv) {
   std::unique_ptr<galois::SharedMemSys> G =
       LonestarStart(argc, argv, name, desc, url, &inputFile);
 
+  if (algo == EdgeMapDO && execution == SERIAL) {
+    // galois::graphs::EdgeMap always runs in parallel
+    std::cerr << "ERROR: EdgeMapDO does not support -exec SERIAL\n";
+    std::abort();
+  }
+
   galois::StatTimer totalTime("TimerTotal");
   totalTime.start();
 
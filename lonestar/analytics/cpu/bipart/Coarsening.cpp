@@ -700,7 +700,7 @@ ParallelCreateEdges(
     hnum[i] = num_wip_hg[i].reduce();  ///< # of hedges.
     // # of the representative nodes of the
     // coarsened match inside of i-th hedge.
-    nodes[i] = std::distance(nodes_bag->at(i).begin(), nodes_bag->at(i).end());
+    nodes[i] = nodes_bag->at(i).size();
     newval[i] = hnum[i]; /* # of hedges. */
     idmap[i].resize(num_hnodes);
     new_weight[i].resize(nodes[i]);
@@ -186,16 +186,11 @@ PartitionCoarsestGraphs(
     }
     GNodeBag& node_bag = (process_zero_partition) ? zero_partition_nodes[i]
                                                   : nzero_partition_nodes[i];
-    uint32_t node_bag_size = std::distance(node_bag.begin(), node_bag.end());
-    std::vector<GNode> node_vec(node_bag_size);
-    uint32_t idx{0};
+    std::vector<GNode> node_vec = node_bag.to_vector();
+    uint32_t idx = node_vec.size();
     WeightTy moved_weight = (process_zero_partition) ? first_partition_weights
                                                      : zero_partition_weights;
 
-    for (auto& item : node_bag) {
-      node_vec[idx++] = item;
-    }
-
     galois::StatTimer init_gain_timer("Partitioning-Init-Gains");
     galois::StatTimer aggregate_node_timer("Partitioning-Aggregate-Nodes");
     galois::StatTimer sort_timer("Partitioning-Sort");
@@ -220,10 +215,7 @@ PartitionCoarsestGraphs(
           galois::loopname("Partitioning-Aggregate-Nodes"));
 
       aggregate_node_timer.start();
-      idx = 0;
-      for (auto& item : node_bag) {
-        node_vec[idx++] = item;
-      }
+      idx = node_bag.copy_to(node_vec.begin()) - node_vec.begin();
       aggregate_node_timer.stop();
 
       sort_timer.start();
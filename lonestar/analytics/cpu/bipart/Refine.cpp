@@ -124,10 +124,8 @@ ParallelSwaps(
           },
           galois::loopname("Refining-Find-Partition-Nodes"));
 
-      num_partition_zero_nodes = std::distance(
-          partition_zero_nodes.begin(), partition_zero_nodes.end());
-      num_partition_one_nodes =
-          std::distance(partition_one_nodes.begin(), partition_one_nodes.end());
+      num_partition_zero_nodes = partition_zero_nodes.size();
+      num_partition_one_nodes = partition_one_nodes.size();
 
       for (uint32_t n : partition_zero_nodes) {
         partition_zero_nodes_bag.push_back(n);
@@ -22,13 +22,18 @@
 
 #include <fstream>
 #include <iostream>
+#include <map>
 #include <random>
+#include <vector>
 
 #include <llvm/Support/CommandLine.h>
 
 #include "galois/AtomicHelpers.h"
+#include "galois/ConcurrentHashMap.h"
 #include "galois/Galois.h"
 #include "galois/LargeArray.h"
+#include "galois/Mem.h"
+#include "galois/ParallelSTL.h"
 
 namespace cll = llvm::cl;
 static cll::opt<bool> enable_VF(
@@ -86,6 +91,16 @@ typedef float EdgeTy;
 // typedef uint32_t EdgeTy;
 typedef galois::LargeArray<EdgeTy> largeArrayEdgeTy;
 
+/*
+ * Per-node scratch of the cluster moving operators, allocated from a
+ * galois::Arena so that the operators do not call malloc
+ */
+typedef std::map<
+    uint64_t, uint64_t, std::less<uint64_t>,
+    galois::ArenaAllocator<std::pair<const uint64_t, uint64_t>>>
+    ClusterLocalMap;
+typedef std::vector<EdgeTy, galois::ArenaAllocator<EdgeTy>> ClusterCounter;
+
 template <typename GraphTy>
 void
 printGraphCharateristics(GraphTy& graph) {
@@ -104,8 +119,8 @@ template <typename GraphTy>
 void
 findNeighboringClusters(
     GraphTy& graph, typename GraphTy::GraphNode& n,
-    std::map<uint64_t, uint64_t>& cluster_local_map,
-    std::vector<EdgeTy>& counter, EdgeTy& self_loop_wt) {
+    ClusterLocalMap& cluster_local_map, ClusterCounter& counter,
+    EdgeTy& self_loop_wt) {
   using GNode = typename GraphTy::GraphNode;
   for (auto ii = graph.edge_begin(n); ii != graph.edge_end(n); ++ii) {
     graph.getData(graph.getEdgeDst(ii), flag_write_lock);
@@ -253,9 +268,8 @@ calConstantForSecondTerm(GraphTy& graph) {
 template <typename GraphTy, typename CommArrayTy>
 uint64_t
 maxCPMQuality(
-    std::map<uint64_t, uint64_t>& cluster_local_map,
-    std::vector<EdgeTy>& counter, EdgeTy self_loop_wt, CommArrayTy& c_info,
-    uint64_t node_wt, uint64_t sc) {
+    ClusterLocalMap& cluster_local_map, ClusterCounter& counter,
+    EdgeTy self_loop_wt, CommArrayTy& c_info, uint64_t node_wt, uint64_t sc) {
   uint64_t max_index = sc;  // Assign the initial value as self community
   double cur_gain = 0;
   double max_gain = 0;
@@ -339,9 +353,9 @@ calCPMQuality(
 template <typename CommArrayTy>
 uint64_t
 maxModularity(
-    std::map<uint64_t, uint64_t>& cluster_local_map,
-    std::vector<EdgeTy>& counter, EdgeTy self_loop_wt, CommArrayTy& c_info,
-    EdgeTy degree_wt, uint64_t sc, double constant) {
+    ClusterLocalMap& cluster_local_map, ClusterCounter& counter,
+    EdgeTy self_loop_wt, CommArrayTy& c_info, EdgeTy degree_wt, uint64_t sc,
+    double constant) {
   uint64_t max_index = sc;  // Assign the intial value as self community
   double cur_gain = 0;
   double max_gain = 0;
@@ -379,9 +393,9 @@ maxModularity(
 template <typename CommArrayTy>
 uint64_t
 maxModularityWithoutSwaps(
-    std::map<uint64_t, uint64_t>& cluster_local_map,
-    std::vector<EdgeTy>& counter, uint64_t self_loop_wt, CommArrayTy& c_info,
-    EdgeTy degree_wt, uint64_t sc, double constant) {
+    ClusterLocalMap& cluster_local_map, ClusterCounter& counter,
+    uint64_t self_loop_wt, CommArrayTy& c_info, EdgeTy degree_wt, uint64_t sc,
+    double constant) {
   uint64_t max_index = sc;  // Assign the intial value as self community
   double cur_gain = 0;
   double max_gain = 0;
@@ -581,75 +595,86 @@ calModularityFinal(GraphTy& graph) {
         a2_x * (double)constant_for_second_term;
   return mod;
 }
-template <typename GraphTy>
+/*
+ * Renumbers the clusters cluster_of(n) of the nodes n in [0, num_nodes) to
+ * 0, 1, ... in the order of the first node of each cluster, passing the new
+ * number to set_cluster(n, number). Nodes whose cluster is UNASSIGNED are
+ * skipped. Returns the number of clusters.
+ */
+template <typename ClusterFn, typename SetClusterFn>
 uint64_t
-renumberClustersContiguously(GraphTy& graph) {
-  using GNode = typename GraphTy::GraphNode;
-  std::map<uint64_t, uint64_t> cluster_local_map;
-  uint64_t num_unique_clusters = 0;
+renumberClusters(
+    uint64_t num_nodes, const ClusterFn& cluster_of,
+    const SetClusterFn& set_cluster) {
+  // Cluster --> its first node, and then its new number
+  galois::ConcurrentHashMap<uint64_t, uint64_t> cluster_map(
+      num_nodes, UNASSIGNED);
+  galois::do_all(galois::iterate(uint64_t{0}, num_nodes), [&](uint64_t n) {
+    uint64_t cluster = cluster_of(n);
+    if (cluster != UNASSIGNED) {
+      cluster_map.Upsert(cluster, n, galois::gmin<uint64_t>());
+    }
+  });
 
-  for (GNode n = 0; n < graph.size(); ++n) {
-    auto& n_data = graph.getData(n, flag_no_lock);
-    if (n_data.curr_comm_ass != UNASSIGNED) {
-      assert(n_data.curr_comm_ass < graph.size());
-      auto stored_already = cluster_local_map.find(n_data.curr_comm_ass);
-      if (stored_already != cluster_local_map.end()) {
-        n_data.curr_comm_ass = stored_already->second;
-      } else {
-        cluster_local_map[n_data.curr_comm_ass] = num_unique_clusters;
-        n_data.curr_comm_ass = num_unique_clusters;
-        num_unique_clusters++;
-      }
+  std::vector<std::pair<uint64_t, uint64_t>> clusters = cluster_map.ToVector();
+  galois::ParallelSTL::sort(
+      clusters.begin(), clusters.end(),
+      [](const auto& a, const auto& b) { return a.second < b.second; });
+  cluster_map.Clear();
+  galois::do_all(
+      galois::iterate(size_t{0}, clusters.size()),
+      [&](size_t i) { cluster_map.Insert(clusters[i].first, i); });
+
+  galois::do_all(galois::iterate(uint64_t{0}, num_nodes), [&](uint64_t n) {
+    uint64_t cluster = cluster_of(n);
+    if (cluster != UNASSIGNED) {
+      set_cluster(n, *cluster_map.Find(cluster));
     }
-  }
-  return num_unique_clusters;
+  });
+  return clusters.size();
 }
 
 template <typename GraphTy>
 uint64_t
-renumberClustersContiguouslySubcomm(GraphTy& graph) {
-  using GNode = typename GraphTy::GraphNode;
-  std::map<uint64_t, uint64_t> cluster_local_map;
-  uint64_t num_unique_clusters = 0;
-
-  for (GNode n = 0; n < graph.size(); ++n) {
-    auto& n_data = graph.getData(n, flag_no_lock);
-    assert(n_data.curr_subcomm_ass != UNASSIGNED);
-    assert(n_data.curr_subcomm_ass < graph.size());
-    auto stored_already = cluster_local_map.find(n_data.curr_subcomm_ass);
-    if (stored_already != cluster_local_map.end()) {
-      n_data.curr_subcomm_ass = stored_already->second;
-    } else {
-      cluster_local_map[n_data.curr_subcomm_ass] = num_unique_clusters;
-      n_data.curr_subcomm_ass = num_unique_clusters;
-      num_unique_clusters++;
-    }
-  }
+renumberClustersContiguously(GraphTy& graph) {
+  return renumberClusters(
+      graph.size(),
+      [&](uint64_t n) {
+        uint64_t cluster = graph.getData(n, flag_no_lock).curr_comm_ass;
+        assert(cluster == UNASSIGNED || cluster < graph.size());
+        return cluster;
+      },
+      [&](uint64_t n, uint64_t cluster) {
+        graph.getData(n, flag_no_lock).curr_comm_ass = cluster;
+      });
+}
 
-  return num_unique_clusters;
+template <typename GraphTy>
+uint64_t
+renumberClustersContiguouslySubcomm(GraphTy& graph) {
+  return renumberClusters(
+      graph.size(),
+      [&](uint64_t n) {
+        uint64_t cluster = graph.getData(n, flag_no_lock).curr_subcomm_ass;
+        assert(cluster != UNASSIGNED);
+        assert(cluster < graph.size());
+        return cluster;
+      },
+      [&](uint64_t n, uint64_t cluster) {
+        graph.getData(n, flag_no_lock).curr_subcomm_ass = cluster;
+      });
 }
 
 template <typename GraphTy>
 uint64_t
 renumberClustersContiguouslyArray(largeArray& arr) {
-  using GNode = typename GraphTy::GraphNode;
-  std::map<uint64_t, uint64_t> cluster_local_map;
-  uint64_t num_unique_clusters = 0;
-
-  for (GNode n = 0; n < arr.size(); ++n) {
-    if (arr[n] != UNASSIGNED) {
-      assert(arr[n] < arr.size());
-      auto stored_already = cluster_local_map.find(arr[n]);
-      if (stored_already != cluster_local_map.end()) {
-        arr[n] = stored_already->second;
-      } else {
-        cluster_local_map[arr[n]] = num_unique_clusters;
-        arr[n] = num_unique_clusters;
-        num_unique_clusters++;
-      }
-    }
-  }
-  return num_unique_clusters;
+  return renumberClusters(
+      arr.size(),
+      [&](uint64_t n) {
+        assert(arr[n] == UNASSIGNED || arr[n] < arr.size());
+        return arr[n];
+      },
+      [&](uint64_t n, uint64_t cluster) { arr[n] = cluster; });
 }
 
 template <typename GraphTy>
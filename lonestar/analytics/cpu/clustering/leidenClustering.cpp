@@ -141,18 +141,18 @@ algoLeidenWithLocking(
 
     galois::for_each(
         galois::iterate(graph),
-        [&](GNode n, auto&) {
+        [&](GNode n, auto& ctx) {
           auto& n_data = graph.getData(n, flag_write_lock);
           uint64_t degree = std::distance(
               graph.edge_begin(n, flag_write_lock),
               graph.edge_end(n, flag_write_lock));
 
           uint64_t local_target = UNASSIGNED;
-          std::map<uint64_t, uint64_t>
-              cluster_local_map;  // Map each neighbor's cluster to local number:
-                                  // Community --> Index
-          std::vector<EdgeTy>
-              counter;  // Number of edges to each unique cluster
+          ClusterLocalMap cluster_local_map(
+              ctx.getPerIterAlloc());  // Map each neighbor's cluster to local
+                                       // number: Community --> Index
+          ClusterCounter counter(
+              ctx.getPerIterAlloc());  // Number of edges to each unique cluster
           EdgeTy self_loop_wt = 0;
 
           if (degree > 0) {
@@ -186,7 +186,8 @@ algoLeidenWithLocking(
             n_data.curr_comm_ass = local_target;
           }
         },
-        galois::loopname("leiden algo: Phase 1"), galois::no_pushes());
+        galois::loopname("leiden algo: Phase 1"), galois::no_pushes(),
+        galois::per_iter_alloc());
 
     /* Calculate the overall modularity */
     double e_xx = 0;
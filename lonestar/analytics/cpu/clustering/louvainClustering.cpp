@@ -69,6 +69,21 @@ struct Comm {
 
 typedef galois::LargeArray<Comm> CommArray;
 
+// Change to the information of a community from the nodes that moved in or
+// out of it; sizes wrap around like the atomic updates to Comm::size
+struct CommDelta {
+  EdgeTy degree_wt{0};
+  uint64_t size{0};
+
+  CommDelta operator+(const CommDelta& other) const {
+    return CommDelta{degree_wt + other.degree_wt, size + other.size};
+  }
+};
+
+// Per-thread community deltas, merged after each color so that threads
+// moving nodes into the same (large) community do not contend on it
+using CommDeltaAccumulator = galois::GSparseAccumulator<uint64_t, CommDelta>;
+
 // Graph Node information
 struct Node {
   uint64_t prev_comm_ass;
@@ -140,17 +155,17 @@ algoLouvainWithLocking(
 
     galois::for_each(
         galois::iterate(graph),
-        [&](GNode n, auto&) {
+        [&](GNode n, auto& ctx) {
           auto& n_data = graph.getData(n, flag_write_lock);
           uint64_t degree = std::distance(
               graph.edge_begin(n, flag_write_lock),
               graph.edge_end(n, flag_write_lock));
           uint64_t local_target = UNASSIGNED;
-          std::map<uint64_t, uint64_t>
-              cluster_local_map;  // Map each neighbor's cluster to local number:
-                                  // Community --> Index
-          std::vector<EdgeTy>
-              counter;  // Number of edges to each unique cluster
+          ClusterLocalMap cluster_local_map(
+              ctx.getPerIterAlloc());  // Map each neighbor's cluster to local
+                                       // number: Community --> Index
+          ClusterCounter counter(
+              ctx.getPerIterAlloc());  // Number of edges to each unique cluster
           EdgeTy self_loop_wt = 0;
           if (degree > 0) {
             findNeighboringClusters(
@@ -178,7 +193,8 @@ algoLouvainWithLocking(
             n_data.curr_comm_ass = local_target;
           }
         },
-        galois::loopname("louvain algo: Phase 1"), galois::no_pushes());
+        galois::loopname("louvain algo: Phase 1"), galois::no_pushes(),
+        galois::per_iter_alloc());
 
     /* Calculate the overall modularity */
     double e_xx = 0;
@@ -264,6 +280,7 @@ algoLouvainWithoutLockingDoAll(
       "============================================================="
       "===========================================\n");
 
+  galois::PerThreadArena arenas;
   galois::StatTimer TimerClusteringWhile("Timer_Clustering_While");
   TimerClusteringWhile.start();
   while (true) {
@@ -282,11 +299,15 @@ algoLouvainWithoutLockingDoAll(
               graph.edge_begin(n, flag_no_lock),
               graph.edge_end(n, flag_no_lock));
           uint64_t local_target = UNASSIGNED;
-          std::map<uint64_t, uint64_t>
-              cluster_local_map;  // Map each neighbor's cluster to local number:
-                                  // Community --> Index
-          std::vector<EdgeTy>
-              counter;  // Number of edges to each unique cluster
+          // The scratch of the previous node on this thread is dead
+          galois::Arena& arena = arenas.getLocal();
+          arena.clear();
+          galois::ArenaAllocator<char> alloc(&arena);
+          ClusterLocalMap cluster_local_map(
+              alloc);  // Map each neighbor's cluster to local number:
+                       // Community --> Index
+          ClusterCounter counter(
+              alloc);  // Number of edges to each unique cluster
           EdgeTy self_loop_wt = 0;
 
           if (degree > 0) {
@@ -401,6 +422,7 @@ algoLouvainWithLockingDelayUpdate(
       "============================================================="
       "===========================================\n");
 
+  galois::PerThreadArena arenas;
   galois::StatTimer TimerClusteringWhile("Timer_Clustering_While");
   TimerClusteringWhile.start();
   while (true) {
@@ -420,11 +442,15 @@ algoLouvainWithLockingDelayUpdate(
           uint64_t degree = std::distance(
               graph.edge_begin(n, flag_no_lock),
               graph.edge_end(n, flag_no_lock));
-          std::map<uint64_t, uint64_t>
-              cluster_local_map;  // Map each neighbor's cluster to local number:
-                                  // Community --> Index
-          std::vector<EdgeTy>
-              counter;  // Number of edges to each unique cluster
+          // The scratch of the previous node on this thread is dead
+          galois::Arena& arena = arenas.getLocal();
+          arena.clear();
+          galois::ArenaAllocator<char> alloc(&arena);
+          ClusterLocalMap cluster_local_map(
+              alloc);  // Map each neighbor's cluster to local number:
+                       // Community --> Index
+          ClusterCounter counter(
+              alloc);  // Number of edges to each unique cluster
           EdgeTy self_loop_wt = 0;
 
           if (degree > 0) {
@@ -592,8 +618,8 @@ algoLouvainWithColoring(
 
   galois::gPrint("Inside algoLouvainWithColoring\n");
 
-  CommArray c_info;    // Community info
-  CommArray c_update;  // Used for updating community
+  CommArray c_info;               // Community info
+  CommDeltaAccumulator c_update;  // Used for updating community
 
   /* Variables needed for Modularity calculation */
   double constant_for_second_term;
@@ -604,7 +630,6 @@ algoLouvainWithColoring(
 
   /*** Initialization ***/
   c_info.allocateBlocked(graph.size());
-  c_update.allocateBlocked(graph.size());
 
   /* Initialization each node to its own cluster */
   galois::do_all(galois::iterate(graph), [&graph](GNode n) {
@@ -637,11 +662,7 @@ algoLouvainWithColoring(
       "============================================================="
       "===========================================\n");
 
-  galois::do_all(galois::iterate(graph), [&](GNode n) {
-    c_update[n].degree_wt = 0;
-    c_update[n].size = 0;
-  });
-
+  galois::PerThreadArena arenas;
   galois::StatTimer TimerClusteringWhile("Timer_Clustering_While");
   TimerClusteringWhile.start();
   while (true) {
@@ -658,11 +679,15 @@ algoLouvainWithColoring(
                   graph.edge_begin(n, flag_no_lock),
                   graph.edge_end(n, flag_no_lock));
               uint64_t local_target = UNASSIGNED;
-              std::map<uint64_t, uint64_t>
-                  cluster_local_map;  // Map each neighbor's cluster to local
-                                      // number: Community --> Index
-              std::vector<EdgeTy>
-                  counter;  // Number of edges to each unique cluster
+              // The scratch of the previous node on this thread is dead
+              galois::Arena& arena = arenas.getLocal();
+              arena.clear();
+              galois::ArenaAllocator<char> alloc(&arena);
+              ClusterLocalMap cluster_local_map(
+                  alloc);  // Map each neighbor's cluster to local number:
+                           // Community --> Index
+              ClusterCounter counter(
+                  alloc);  // Number of edges to each unique cluster
               EdgeTy self_loop_wt = 0;
 
               if (degree > 0) {
@@ -679,13 +704,10 @@ algoLouvainWithColoring(
               /* Update cluster info */
               if (local_target != n_data.curr_comm_ass &&
                   local_target != UNASSIGNED) {
-                galois::atomicAdd(
-                    c_update[local_target].degree_wt, n_data.degree_wt);
-                galois::atomicAdd(c_update[local_target].size, (uint64_t)1);
-                galois::atomicSub(
-                    c_update[n_data.curr_comm_ass].degree_wt, n_data.degree_wt);
-                galois::atomicSub(
-                    c_update[n_data.curr_comm_ass].size, (uint64_t)1);
+                c_update.update(local_target, CommDelta{n_data.degree_wt, 1});
+                c_update.update(
+                    n_data.curr_comm_ass,
+                    CommDelta{-n_data.degree_wt, ~uint64_t{0}});
                 /* Set the new cluster id */
                 n_data.curr_comm_ass = local_target;
               }
@@ -693,12 +715,14 @@ algoLouvainWithColoring(
           },
           galois::loopname("louvain algo: Phase 1"));
 
-      galois::do_all(galois::iterate(graph), [&](GNode n) {
-        galois::atomicAdd(c_info[n].size, c_update[n].size.load());
-        galois::atomicAdd(c_info[n].degree_wt, c_update[n].degree_wt.load());
-        c_update[n].size = 0;
-        c_update[n].degree_wt = 0;
+      // Each community appears once among the merged deltas
+      auto& deltas = c_update.reduce();
+      galois::do_all(galois::iterate(deltas), [&](const auto& delta) {
+        Comm& comm = c_info[delta.first];
+        comm.size.store(comm.size.load() + delta.second.size);
+        comm.degree_wt.store(comm.degree_wt.load() + delta.second.degree_wt);
       });
+      c_update.reset();
     }
 
     /* Calculate the overall modularity */
@@ -729,9 +753,6 @@ algoLouvainWithColoring(
   c_info.destroy();
   c_info.deallocate();
 
-  c_update.destroy();
-  c_update.deallocate();
-
   TimerClusteringTotal.stop();
   return prev_mod;
 }
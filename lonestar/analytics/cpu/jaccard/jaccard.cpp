@@ -20,9 +20,10 @@
 #include <deque>
 #include <iostream>
 #include <type_traits>
-#include <unordered_set>
+#include <utility>
 
 #include "Lonestar/BoilerPlate.h"
+#include "galois/SetIntersection.h"
 
 namespace cll = llvm::cl;
 
@@ -52,34 +53,36 @@ using EdgeData = std::tuple<>;
 typedef galois::graphs::PropertyGraph<NodeData, EdgeData> Graph;
 typedef typename Graph::Node GNode;
 
+/**
+ * Destinations of the edges of n as a contiguous range of node ids. Edges must
+ * be sorted by destination (see SortAllEdgesByDest).
+ */
+std::pair<const uint32_t*, const uint32_t*>
+neighbors(const Graph& graph, GNode n) {
+  const galois::graphs::GraphTopology& topology =
+      graph.GetPropertyFileGraph().topology();
+  auto [begin, end] = topology.edge_range(n);
+  const uint32_t* dests = topology.out_dests->raw_values();
+  return std::make_pair(dests + begin, dests + end);
+}
+
 void
 algo(Graph* graph, const GNode& base) {
-  std::unordered_set<GNode> base_neighbors;
-
-  // Collect all the neighbors of the base node into a hash set.
-  for (const auto& e : graph->edges(base)) {
-    auto dest = graph->GetEdgeDest(e);
-    base_neighbors.emplace(*dest);
-  }
+  auto [base_begin, base_end] = neighbors(*graph, base);
+  uint32_t base_size = base_end - base_begin;
 
   // Compute the similarity for each node
   galois::do_all(
       galois::iterate(*graph),
       [&](const GNode& n2) {
         double& n2_data = graph->GetData<NodeValue>(n2);
-        uint32_t n2_size = 0, intersection_size = 0;
-        // TODO: Using a sorted edge list would allow a much faster intersection
-        // operation. Use that here.
         // Count the number of neighbors of n2 and the number that are shared
         // with base
-        for (const auto& e : graph->edges(n2)) {
-          auto neighbor = graph->GetEdgeDest(e);
-          if (base_neighbors.count(*neighbor) > 0)
-            intersection_size++;
-          n2_size++;
-        }
-        uint32_t union_size =
-            base_neighbors.size() + n2_size - intersection_size;
+        auto [n2_begin, n2_end] = neighbors(*graph, n2);
+        uint32_t n2_size = n2_end - n2_begin;
+        uint32_t intersection_size = galois::IntersectionCount(
+            base_begin, base_size, n2_begin, n2_size);
+        uint32_t union_size = base_size + n2_size - intersection_size;
         double similarity =
             union_size > 0 ? (double)intersection_size / union_size : 1;
         // Store the similarity back into the graph.
@@ -100,6 +103,10 @@ main(int argc, char** argv) {
   std::unique_ptr<galois::graphs::PropertyFileGraph> pfg =
       MakeFileGraph(inputFile, edge_property_name);
 
+  if (auto r = galois::graphs::SortAllEdgesByDest(pfg.get()); !r) {
+    GALOIS_LOG_FATAL("Sorting edge destination failed: {}", r.error());
+  }
+
   auto result = ConstructNodeProperties<NodeData>(pfg.get());
   if (!result) {
     GALOIS_LOG_FATAL("failed to construct node properties: {}", result.error());
@@ -19,10 +19,12 @@
 
 #include <iostream>
 #include <map>
+#include <type_traits>
 
 #include "Lonestar/BoilerPlate.h"
 #include "Lonestar/K_SSSP.h"
 #include "galois/AtomicHelpers.h"
+#include "galois/Mem.h"
 
 namespace cll = llvm::cl;
 
@@ -50,15 +52,17 @@ static cll::opt<unsigned int> numPaths(
               "value 10)"),
     cll::init(10));
 
-enum Algo { deltaTile = 0, deltaStep, deltaStepBarrier };
+enum Algo { deltaTile = 0, deltaStep, deltaStepBarrier, multiQueue };
 
-const char* const ALGO_NAMES[] = {"deltaTile", "deltaStep", "deltaStepBarrier"};
+const char* const ALGO_NAMES[] = {
+    "deltaTile", "deltaStep", "deltaStepBarrier", "multiQueue"};
 
 static cll::opt<Algo> algo(
     "algo", cll::desc("Choose an algorithm:"),
     cll::values(
         clEnumVal(deltaTile, "deltaTile"), clEnumVal(deltaStep, "deltaStep"),
-        clEnumVal(deltaStepBarrier, "deltaStepBarrier")),
+        clEnumVal(deltaStepBarrier, "deltaStepBarrier"),
+        clEnumVal(multiQueue, "multiQueue")),
     cll::init(deltaTile));
 
 struct Path {
@@ -105,6 +109,7 @@ using PSchunk = gwl::PerSocketChunkFIFO<kChunkSize>;
 using OBIM = gwl::OrderedByIntegerMetric<UpdateRequestIndexer, PSchunk>;
 using OBIM_Barrier = gwl::OrderedByIntegerMetric<
     UpdateRequestIndexer, PSchunk>::with_barrier<true>::type;
+using MultiQueue = gwl::MultiQueue<UpdateRequestIndexer>;
 
 //delta stepping implementation for finding a shortest path from source to report node
 template <typename Item, typename OBIMTy, typename PushWrap, typename EdgeRange>
@@ -126,12 +131,13 @@ DeltaStepAlgo(
   graph->GetData<NodeDist>(source) = 0;
 
   galois::InsertBag<Item> init_bag;
-  galois::InsertBag<Path*> paths_bag;
+  // Paths live until the end of this search, so they come from per-thread
+  // arenas that are released all at once
+  galois::PerThreadArena paths;
 
-  Path* path = new Path();
+  Path* path = paths.getLocal().create<Path>();
   path->last = NULL;
   path->w = 0;
-  paths_bag.push(path);
 
   pushWrap(init_bag, source, 0, path, "parallel");
 
@@ -151,13 +157,11 @@ DeltaStepAlgo(
     if (remove_edges.find(*dest) == remove_edges.end()) {
       auto wt = graph->GetEdgeData<EdgeWeight>(edge);
       Path* path_dest;
-      path_dest = new Path();
+      path_dest = paths.getLocal().create<Path>();
       path_dest->parent = source;
       path_dest->last = path;
       path_dest->w = wt;
 
-      paths_bag.push(path_dest);
-
       pushWrap(init_bag, *dest, wt, path_dest);
 
       graph->GetData<NodeDist>(dest) = wt;
@@ -205,13 +209,11 @@ DeltaStepAlgo(
             }
 
             Path* path;
-            path = new Path();
+            path = paths.getLocal().create<Path>();
             path->parent = item.src;
             path->last = item.path;
             path->w = new_dist;
 
-            paths_bag.push(path);
-
             const Path* const_path = path;
             pushWrap(ctx, *dest, new_dist, const_path);
 
@@ -221,7 +223,11 @@ DeltaStepAlgo(
           }
         }
       },
-      galois::wl<OBIM>(UpdateRequestIndexer{stepShift}),
+      galois::wl<OBIMTy>(
+          UpdateRequestIndexer{
+              std::is_same_v<OBIMTy, MultiQueue>
+                  ? 0U
+                  : static_cast<unsigned>(stepShift)}),
       galois::disable_conflict_detection(), galois::loopname("SSSP"));
 
   if (kTrackWork) {
@@ -259,12 +265,6 @@ DeltaStepAlgo(
     }
   }
 
-  galois::do_all(galois::iterate(paths_bag), [&](Path* path) {
-    if (path != NULL) {
-      delete (path);
-    }
-  });
-
   return path_exists;
 }
 
@@ -292,6 +292,11 @@ FindShortestPath(
         graph, source, report, ReqPushWrap(), OutEdgeRangeFn{graph},
         shortest_path, prefix_wt, remove_edges);
     break;
+  case multiQueue:
+    path_exists = DeltaStepAlgo<UpdateRequest, MultiQueue>(
+        graph, source, report, ReqPushWrap(), OutEdgeRangeFn{graph},
+        shortest_path, prefix_wt, remove_edges);
+    break;
 
   default:
     std::abort();
@@ -22,8 +22,10 @@
 #include <fstream>
 #include <iostream>
 #include <memory>
+#include <vector>
 
 #include "Lonestar/BoilerPlate.h"
+#include "galois/SetIntersection.h"
 
 enum Algo {
   bspJacobi,
@@ -149,6 +151,25 @@ isValidDegreeNoLessThanJ(const Graph& g, GNode n, unsigned int j) {
   return numValid >= j;
 }
 
+/**
+ * Collect the destinations of the valid edges of node n. Edges are sorted by
+ * destination, so the result is sorted as well.
+ *
+ * @param g
+ * @param n the node to collect the neighbors of
+ * @param neighbors output vector, cleared before use
+ */
+void
+gatherValidNeighbors(
+    const Graph& g, GNode n, std::vector<uint32_t>* neighbors) {
+  neighbors->clear();
+  for (auto e : g.edges(n)) {
+    if (!(g.GetEdgeData<EdgeFlag>(e) & removed)) {
+      neighbors->push_back(*g.GetEdgeDest(e));
+    }
+  }
+}
+
 /**
  * Measure the number of intersected edges between the src and the dest nodes.
  *
@@ -161,39 +182,23 @@ isValidDegreeNoLessThanJ(const Graph& g, GNode n, unsigned int j) {
  */
 bool
 isSupportNoLessThanJ(const Graph& g, GNode src, GNode dest, unsigned int j) {
-  size_t numValidEqual = 0;
-  auto srcI = g.edge_begin(src), srcE = g.edge_end(src),
-       dstI = g.edge_begin(dest), dstE = g.edge_end(dest);
-
-  while (true) {
-    //! Find the first valid edge.
-    while (srcI != srcE && (g.GetEdgeData<EdgeFlag>(srcI) & removed)) {
-      ++srcI;
-    }
-    while (dstI != dstE && (g.GetEdgeData<EdgeFlag>(dstI) & removed)) {
-      ++dstI;
-    }
-
-    if (srcI == srcE || dstI == dstE) {
-      return numValidEqual >= j;
-    }
+  //! Reused across calls to avoid allocating per edge.
+  thread_local std::vector<uint32_t> srcNeighbors;
+  thread_local std::vector<uint32_t> dstNeighbors;
 
-    //! Check for intersection.
-    auto sN = *g.GetEdgeDest(srcI), dN = *g.GetEdgeDest(dstI);
-    if (sN < dN) {
-      ++srcI;
-    } else if (dN < sN) {
-      ++dstI;
-    } else {
-      numValidEqual += 1;
-      if (numValidEqual >= j) {
-        return true;
-      }
-      ++srcI;
-      ++dstI;
-    }
+  gatherValidNeighbors(g, src, &srcNeighbors);
+  if (srcNeighbors.size() < j) {
+    return false;
+  }
+  gatherValidNeighbors(g, dest, &dstNeighbors);
+  if (dstNeighbors.size() < j) {
+    return false;
   }
 
+  //! Stop intersecting as soon as j common neighbors are found.
+  size_t numValidEqual = galois::IntersectionCount(
+      srcNeighbors.data(), srcNeighbors.size(), dstNeighbors.data(),
+      dstNeighbors.size(), j);
   return numValidEqual >= j;
 }
 
@@ -250,7 +255,7 @@ struct BSPTrussJacobiAlgo {
           galois::iterate(*cur),
           PickUnsupportedEdges{g, k - 2, unsupported, *next}, galois::steal());
 
-      if (std::distance(unsupported.begin(), unsupported.end()) == 0) {
+      if (unsupported.empty()) {
         break;
       }
 
@@ -278,10 +278,8 @@ main(int argc, char** argv) {
       },
       galois::steal());
 
-  auto numShouldBeInvalid =
-      std::distance(shouldBeInvalid.begin(), shouldBeInvalid.end());
-  auto numShouldBeValid =
-      std::distance(shouldBeValid.begin(), shouldBeValid.end());
+  auto numShouldBeInvalid = shouldBeInvalid.size();
+  auto numShouldBeValid = shouldBeValid.size();
   if (!numShouldBeInvalid && !numShouldBeValid) {
     std::cout << "Verification succeeded\n";
   } else {
@@ -67,6 +67,12 @@ static cll::opt<unsigned> THRESHOLD_LS(
               "(default 500000)"),
     cll::init(500000));
 
+static cll::opt<bool> useWorkStealing(
+    "workStealing",
+    cll::desc("Schedule the main loop with lock-free work stealing deques "
+              "instead of chunked FIFOs (default false)"),
+    cll::init(false));
+
 ////////////////////////////////////////////////////////////////////////////////
 // Declaration of strutures, types, and variables
 ////////////////////////////////////////////////////////////////////////////////
@@ -726,6 +732,23 @@ public:
  * Concurrent points to executor.
  */
 class PTAConcurrent : public PTABase<true> {
+  template <typename WL>
+  void propagateUpdates(galois::InsertBag<unsigned>& updates, WL wl) {
+    galois::for_each(
+        galois::iterate(updates),
+        [this](unsigned req, auto& ctx) {
+          for (auto dst = this->outgoingEdges[req].begin();
+               dst != this->outgoingEdges[req].end(); dst++) {
+            unsigned newPtsTo = this->propagate(req, *dst);
+
+            if (newPtsTo)
+              ctx.push(this->ocd.getFinalRepresentative(*dst));
+          }
+        },
+        galois::loopname("PointsToMainUpdateLoop"),
+        galois::disable_conflict_detection(), wl);
+  }
+
 public:
   /**
    * Run points-to-analysis using galois::for_each as the main loop.
@@ -742,20 +765,13 @@ public:
     processLoadStore<galois::DoAll>(loadStoreConstraints, updates);
 
     while (!updates.empty()) {
-      galois::for_each(
-          galois::iterate(updates),
-          [this](unsigned req, auto& ctx) {
-            for (auto dst = this->outgoingEdges[req].begin();
-                 dst != this->outgoingEdges[req].end(); dst++) {
-              unsigned newPtsTo = this->propagate(req, *dst);
-
-              if (newPtsTo)
-                ctx.push(this->ocd.getFinalRepresentative(*dst));
-            }
-          },
-          galois::loopname("PointsToMainUpdateLoop"),
-          galois::disable_conflict_detection(),
-          galois::wl<galois::worklists::PerSocketChunkFIFO<8>>());
+      if (useWorkStealing) {
+        propagateUpdates(
+            updates, galois::wl<galois::worklists::ChaseLevStealing<>>());
+      } else {
+        propagateUpdates(
+            updates, galois::wl<galois::worklists::PerSocketChunkFIFO<8>>());
+      }
 
       galois::gDebug("No of points-to facts computed = ", countPointsToFacts());
 
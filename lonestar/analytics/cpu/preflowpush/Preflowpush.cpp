@@ -54,6 +54,11 @@ static cll::opt<bool> useSymmetricDirectly(
     "useSymmetricDirectly",
     cll::desc("Assume input graph is symmetric and has unit capacities"),
     cll::init(false));
+static cll::opt<bool> useWorkStealing(
+    "workStealing",
+    cll::desc("Schedule discharge with lock-free work stealing deques "
+              "instead of chunked FIFOs (ignored with useHLOrder)"),
+    cll::init(false));
 static cll::opt<int> relabelInt(
     "relabel",
     cll::desc("relabel interval X: relabel every X iterations "
@@ -513,6 +518,10 @@ struct PreflowPush {
       case nondet:
         if (useHLOrder) {
           nonDetDischarge(initial, counter, galois::wl<OBIM>(obimIndexer));
+        } else if (useWorkStealing) {
+          nonDetDischarge(
+              initial, counter,
+              galois::wl<galois::worklists::ChaseLevStealing<>>());
         } else {
           nonDetDischarge(initial, counter, galois::wl<Chunk>());
         }
@@ -285,7 +285,7 @@ struct ParallelAlgo {
     });
 
     unsigned numRoots = roots.reduce();
-    unsigned numEdges = std::distance(mst.begin(), mst.end());
+    unsigned numEdges = mst.size();
 
     if (graph.size() - numRoots != numEdges) {
       std::cerr << "Generated graph is not a forest. "
@@ -50,12 +50,14 @@ static cll::opt<SsspPlan::Algorithm> algo(
         clEnumVal(SsspPlan::kDeltaTile, "DeltaTile"),
         clEnumVal(SsspPlan::kDeltaStep, "DeltaStep"),
         clEnumVal(SsspPlan::kDeltaStepBarrier, "DeltaStepBarrier"),
+        clEnumVal(SsspPlan::kDeltaStepAdaptive, "DeltaStepAdaptive"),
         clEnumVal(SsspPlan::kSerialDeltaTile, "SerialDeltaTile"),
         clEnumVal(SsspPlan::kSerialDelta, "SerialDelta"),
         clEnumVal(SsspPlan::kDijkstraTile, "DijkstraTile"),
         clEnumVal(SsspPlan::kDijkstra, "Dijkstra"),
         clEnumVal(SsspPlan::kTopo, "Topo"),
         clEnumVal(SsspPlan::kTopoTile, "TopoTile"),
+        clEnumVal(SsspPlan::kMultiQueue, "MultiQueue"),
         clEnumVal(
             SsspPlan::kAutomatic,
             "Automatic: choose among the algorithms automatically")),
@@ -74,6 +76,8 @@ AlgorithmName(SsspPlan::Algorithm algorithm) {
     return "DeltaStep";
   case SsspPlan::kDeltaStepBarrier:
     return "DeltaStepBarrier";
+  case SsspPlan::kDeltaStepAdaptive:
+    return "DeltaStepAdaptive";
   case SsspPlan::kSerialDeltaTile:
     return "SerialDeltaTile";
   case SsspPlan::kSerialDelta:
@@ -86,6 +90,8 @@ AlgorithmName(SsspPlan::Algorithm algorithm) {
     return "Topo";
   case SsspPlan::kTopoTile:
     return "TopoTile";
+  case SsspPlan::kMultiQueue:
+    return "MultiQueue";
   case SsspPlan::kAutomatic:
     return "Automatic";
   default:
@@ -151,6 +157,9 @@ main(int argc, char** argv) {
   case SsspPlan::kDeltaStepBarrier:
     plan = SsspPlan::DeltaStepBarrier(stepShift);
     break;
+  case SsspPlan::kDeltaStepAdaptive:
+    plan = SsspPlan::DeltaStepAdaptive(stepShift);
+    break;
   case SsspPlan::kSerialDeltaTile:
     plan = SsspPlan::SerialDeltaTile(stepShift);
     break;
@@ -169,6 +178,9 @@ main(int argc, char** argv) {
   case SsspPlan::kTopoTile:
     plan = SsspPlan::TopoTile();
     break;
+  case SsspPlan::kMultiQueue:
+    plan = SsspPlan::MultiQueue();
+    break;
   case SsspPlan::kAutomatic:
     plan = SsspPlan::Automatic();
     break;
@@ -19,6 +19,7 @@
 
 #include <algorithm>
 #include <fstream>
+#include <functional>
 #include <iostream>
 #include <utility>
 #include <vector>
@@ -26,12 +27,16 @@
 #include <boost/iterator/transform_iterator.hpp>
 
 #include "Lonestar/BoilerPlate.h"
+#include "galois/SetIntersection.h"
+#include "galois/TaskGroup.h"
 #include "galois/runtime/Profile.h"
 
 const char* name = "Triangles";
 const char* desc = "Counts the triangles in a graph";
 
 constexpr static const unsigned CHUNK_SIZE = 64U;
+//! Nodes with more lower neighbors than this split their work into tasks
+constexpr static const size_t HUB_DEGREE = 4096U;
 enum Algo { nodeiterator, edgeiterator, orderedCount };
 
 namespace cll = llvm::cl;
@@ -89,28 +94,17 @@ LowerBound(Iterator first, Iterator last, Compare comp) {
 }
 
 /**
- * std::set_intersection over edge_iterators.
+ * Destinations of the edges of n as a contiguous range of node ids. After
+ * SortAllEdgesByDest, the range is sorted and can be passed to
+ * galois::IntersectionCount.
  */
-template <typename G>
-size_t
-CountEqual(
-    const G& g, typename G::edge_iterator aa, typename G::edge_iterator ea,
-    typename G::edge_iterator bb, typename G::edge_iterator eb) {
-  size_t retval = 0;
-  while (aa != ea && bb != eb) {
-    typename G::Node a = *g.GetEdgeDest(aa);
-    typename G::Node b = *g.GetEdgeDest(bb);
-    if (a < b) {
-      ++aa;
-    } else if (b < a) {
-      ++bb;
-    } else {
-      retval += 1;
-      ++aa;
-      ++bb;
-    }
-  }
-  return retval;
+std::pair<const uint32_t*, const uint32_t*>
+Neighbors(const Graph& g, GNode n) {
+  const galois::graphs::GraphTopology& topology =
+      g.GetPropertyFileGraph().topology();
+  auto [begin, end] = topology.edge_range(n);
+  const uint32_t* dests = topology.out_dests->raw_values();
+  return std::make_pair(dests + begin, dests + end);
 }
 
 template <typename G>
@@ -235,25 +229,20 @@ NodeIteratingAlgo(const Graph& graph) {
 void
 OrderedCountFunc(
     const Graph& graph, GNode n, galois::GAccumulator<size_t>& numTriangles) {
-  size_t numTriangles_local = 0;
-  for (auto it_v : graph.edges(n)) {
-    auto v = *graph.GetEdgeDest(it_v);
-    if (v > n)
-      break;
-    Graph::edge_iterator it_n = graph.edge_begin(n);
-
-    for (auto it_vv : graph.edges(v)) {
-      auto vv = *graph.GetEdgeDest(it_vv);
-      if (vv > v)
-        break;
-      while (*graph.GetEdgeDest(it_n) < vv)
-        it_n++;
-      if (vv == *graph.GetEdgeDest(it_n)) {
-        numTriangles_local += 1;
-      }
-    }
-  }
-  numTriangles += numTriangles_local;
+  auto [n_begin, n_end] = Neighbors(graph, n);
+  size_t num_lower = std::upper_bound(n_begin, n_end, n) - n_begin;
+  auto count = [&, n_begin = n_begin](size_t i) -> size_t {
+    GNode v = n_begin[i];
+    // Neighbors of v and of n that are not greater than v
+    auto [v_begin, v_end] = Neighbors(graph, v);
+    const uint32_t* v_last = std::upper_bound(v_begin, v_end, v);
+    return galois::IntersectionCount(
+        n_begin, i + 1, v_begin, v_last - v_begin);
+  };
+  // Hubs split their neighbors into tasks that idle threads can steal
+  size_t grain = num_lower > HUB_DEGREE ? HUB_DEGREE / 8 : num_lower;
+  numTriangles += galois::TaskReduce(
+      0, num_lower, grain, size_t{0}, count, std::plus<size_t>());
 }
 
 /*
@@ -315,21 +304,16 @@ EdgeIteratingAlgo(const Graph& graph) {
             [&](const WorkItem& w) {
               // Compute intersection of range (w.src, w.dst) in neighbors of
               // w.src and w.dst
-              Graph::edge_iterator abegin = graph.edge_begin(w.src);
-              Graph::edge_iterator aend = graph.edge_end(w.src);
-              Graph::edge_iterator bbegin = graph.edge_begin(w.dst);
-              Graph::edge_iterator bend = graph.edge_end(w.dst);
+              auto [abegin, aend] = Neighbors(graph, w.src);
+              auto [bbegin, bend] = Neighbors(graph, w.dst);
 
-              Graph::edge_iterator aa = LowerBound(
-                  abegin, aend, GreaterThanOrEqual<Graph>(graph, w.src));
-              Graph::edge_iterator ea =
-                  LowerBound(abegin, aend, LessThan<Graph>(graph, w.dst));
-              Graph::edge_iterator bb = LowerBound(
-                  bbegin, bend, GreaterThanOrEqual<Graph>(graph, w.src));
-              Graph::edge_iterator eb =
-                  LowerBound(bbegin, bend, LessThan<Graph>(graph, w.dst));
+              const uint32_t* aa = std::upper_bound(abegin, aend, w.src);
+              const uint32_t* ea = std::lower_bound(aa, aend, w.dst);
+              const uint32_t* bb = std::upper_bound(bbegin, bend, w.src);
+              const uint32_t* eb = std::lower_bound(bb, bend, w.dst);
 
-              numTriangles += CountEqual(graph, aa, ea, bb, eb);
+              numTriangles +=
+                  galois::IntersectionCount(aa, ea - aa, bb, eb - bb);
             },
             galois::loopname("EdgeIteratingAlgo"),
             galois::chunk_size<CHUNK_SIZE>(), galois::steal());
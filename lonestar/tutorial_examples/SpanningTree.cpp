@@ -241,7 +241,7 @@ main(int argc, char** argv) {
         roots += 1;
     });
     unsigned numRoots = roots.reduce();
-    unsigned numEdges = std::distance(mst.begin(), mst.end());
+    unsigned numEdges = mst.size();
     if (graph.size() - numRoots != numEdges) {
       std::cerr << "Generated graph is not a forest. "
                 << "Expected " << graph.size() - numRoots << " edges but "
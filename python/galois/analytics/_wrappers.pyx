@@ -125,12 +125,14 @@ cdef extern from "galois/Analytics.h" namespace "galois::analytics" nogil:
             kDeltaTile "galois::analytics::SsspPlan::kDeltaTile"
             kDeltaStep "galois::analytics::SsspPlan::kDeltaStep"
             kDeltaStepBarrier "galois::analytics::SsspPlan::kDeltaStepBarrier"
+            kDeltaStepAdaptive "galois::analytics::SsspPlan::kDeltaStepAdaptive"
             kSerialDeltaTile "galois::analytics::SsspPlan::kSerialDeltaTile"
             kSerialDelta "galois::analytics::SsspPlan::kSerialDelta"
             kDijkstraTile "galois::analytics::SsspPlan::kDijkstraTile"
             kDijkstra "galois::analytics::SsspPlan::kDijkstra"
             kTopo "galois::analytics::SsspPlan::kTopo"
             kTopoTile "galois::analytics::SsspPlan::kTopoTile"
+            kMultiQueue "galois::analytics::SsspPlan::kMultiQueue"
             kAutomatic "galois::analytics::SsspPlan::kAutomatic"
 
         _SsspPlan.Algorithm algorithm() const
@@ -149,6 +151,10 @@ cdef extern from "galois/Analytics.h" namespace "galois::analytics" nogil:
         _SsspPlan DeltaStepBarrier()
         @staticmethod
         _SsspPlan DeltaStepBarrier_1 "DeltaStepBarrier"(unsigned delta)
+        @staticmethod
+        _SsspPlan DeltaStepAdaptive()
+        @staticmethod
+        _SsspPlan DeltaStepAdaptive_1 "DeltaStepAdaptive"(unsigned delta)
 
         @staticmethod
         _SsspPlan SerialDeltaTile()
@@ -175,6 +181,9 @@ cdef extern from "galois/Analytics.h" namespace "galois::analytics" nogil:
         @staticmethod
         _SsspPlan TopoTile_1 "TopoTile"(ptrdiff_t edge_tile_size)
 
+        @staticmethod
+        _SsspPlan MultiQueue()
+
         @staticmethod
         _SsspPlan Automatic()
         @staticmethod
@@ -190,12 +199,14 @@ class _SsspAlgorithm(Enum):
     DeltaTile = _SsspPlan.Algorithm.kDeltaTile
     DeltaStep = _SsspPlan.Algorithm.kDeltaStep
     DeltaStepBarrier = _SsspPlan.Algorithm.kDeltaStepBarrier
+    DeltaStepAdaptive = _SsspPlan.Algorithm.kDeltaStepAdaptive
     SerialDeltaTile = _SsspPlan.Algorithm.kSerialDeltaTile
     SerialDelta = _SsspPlan.Algorithm.kSerialDelta
     DijkstraTile = _SsspPlan.Algorithm.kDijkstraTile
     Dijkstra = _SsspPlan.Algorithm.kDijkstra
     Topo = _SsspPlan.Algorithm.kTopo
     TopoTile = _SsspPlan.Algorithm.kTopoTile
+    MultiQueue = _SsspPlan.Algorithm.kMultiQueue
     Automatic = _SsspPlan.Algorithm.kAutomatic
 
 
@@ -254,6 +265,12 @@ cdef class SsspPlan:
             return SsspPlan.make(_SsspPlan.DeltaStepBarrier())
         return SsspPlan.make(_SsspPlan.DeltaStepBarrier_1(delta))
 
+    @staticmethod
+    def delta_step_adaptive(delta=None):
+        if delta is None:
+            return SsspPlan.make(_SsspPlan.DeltaStepAdaptive())
+        return SsspPlan.make(_SsspPlan.DeltaStepAdaptive_1(delta))
+
     @staticmethod
     def serial_delta_tile(delta=None, edge_tile_size=None):
         default = _SsspPlan.SerialDeltaTile()
@@ -287,6 +304,10 @@ cdef class SsspPlan:
     def topo():
         return SsspPlan.make(_SsspPlan.Topo())
 
+    @staticmethod
+    def multi_queue():
+        return SsspPlan.make(_SsspPlan.MultiQueue())
+
     @staticmethod
     def automatic(graph = None):
         if graph is None:
@@ -35,6 +35,7 @@
 
 #include "galois/Galois.h"
 #include "galois/LargeArray.h"
+#include "galois/ParallelSTL.h"
 #include "galois/graphs/FileGraph.h"
 
 // TODO: move these enums to a common location for all graph convert tools
@@ -1478,8 +1479,8 @@ struct BipartiteSortByDegree : public Conversion {
     };
 
     std::copy(ingraph.begin(), ingraph.end(), perm.begin());
-    std::sort(perm.begin(), perm.end(), [&](GNode lhs, GNode rhs) -> bool {
-      return getDistance(lhs) < getDistance(rhs);
+    galois::ParallelSTL::radix_sort(perm.begin(), perm.end(), [&](GNode x) {
+      return static_cast<uint64_t>(getDistance(x));
     });
 
     // Finalize by taking the transpose/inverse
@@ -1511,9 +1512,9 @@ struct SortByDegree : public Conversion {
     perm.create(ingraph.size());
 
     std::copy(ingraph.begin(), ingraph.end(), perm.begin());
-    std::sort(perm.begin(), perm.end(), [&](GNode lhs, GNode rhs) -> bool {
-      return std::distance(ingraph.edge_begin(lhs), ingraph.edge_end(lhs)) <
-             std::distance(ingraph.edge_begin(rhs), ingraph.edge_end(rhs));
+    galois::ParallelSTL::radix_sort(perm.begin(), perm.end(), [&](GNode x) {
+      return static_cast<uint64_t>(
+          std::distance(ingraph.edge_begin(x), ingraph.edge_end(x)));
     });
 
     // Finalize by taking the transpose/inverse
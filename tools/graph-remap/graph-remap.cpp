@@ -17,6 +17,7 @@
  * Documentation, or loss or inaccuracy of data of any kind.
  */
 
+#include "galois/ConcurrentHashMap.h"
 #include "galois/Galois.h"
 #include "galois/graphs/BufferedGraph.h"
 #include "galois/graphs/FileGraph.h"
@@ -32,11 +33,12 @@ static cll::opt<std::string> outputFilename(
     cll::Positional, cll::desc("<output file>"), cll::Required);
 
 using Writer = galois::graphs::FileGraphWriter;
+using NodeMap = galois::ConcurrentHashMap<uint32_t, uint32_t>;
 
 /**
  * Create node map from file
  */
-std::map<uint32_t, uint32_t>
+NodeMap
 createNodeMap() {
   galois::gInfo("Creating node map");
   // read new mapping
@@ -53,20 +55,24 @@ createNodeMap() {
     GALOIS_DIE("failed to read file");
   }
 
-  // remap node listed on line n in the mapping to node n
-  std::map<uint32_t, uint32_t> remapper;
-  uint64_t counter = 0;
+  std::vector<uint32_t> nodeIDs;
   while (((int64_t)mapFile.tellg() + 1) != endOfFile) {
     uint64_t nodeID;
     mapFile >> nodeID;
     if (!mapFile) {
       GALOIS_DIE("failed to read file");
     }
-    remapper[nodeID] = counter++;
+    nodeIDs.push_back(nodeID);
   }
 
-  GALOIS_ASSERT(remapper.size() == counter);
-  galois::gInfo("Remapping ", counter, " nodes");
+  // remap node listed on line n in the mapping to node n
+  NodeMap remapper(nodeIDs.size());
+  galois::do_all(galois::iterate(size_t{0}, nodeIDs.size()), [&](size_t n) {
+    GALOIS_ASSERT(remapper.Insert(nodeIDs[n], n), "duplicate node in mapping");
+  });
+
+  GALOIS_ASSERT(remapper.Size() == nodeIDs.size());
+  galois::gInfo("Remapping ", nodeIDs.size(), " nodes");
 
   galois::gInfo("Node map created");
 
@@ -78,7 +84,8 @@ main(int argc, char** argv) {
   galois::SharedMemSys G;
   llvm::cl::ParseCommandLineOptions(argc, argv);
 
-  std::map<uint32_t, uint32_t> remapper = createNodeMap();
+  NodeMap remapper = createNodeMap();
+  size_t numMappedNodes = remapper.Size();
 
   galois::gInfo("Loading graph to remap");
   galois::graphs::BufferedGraph<void> graphToRemap;
@@ -86,7 +93,7 @@ main(int argc, char** argv) {
   galois::gInfo("Graph loaded");
 
   Writer graphWriter;
-  graphWriter.setNumNodes(remapper.size());
+  graphWriter.setNumNodes(numMappedNodes);
   graphWriter.setNumEdges(graphToRemap.sizeEdges());
 
   // phase 1: count degrees
@@ -96,8 +103,9 @@ main(int argc, char** argv) {
   size_t nodeIDCounter = 0;
   for (size_t i = 0; i < prevNumNodes; i++) {
     // see if current node is to be remapped, i.e. exists in the map
-    if (remapper.find(i) != remapper.end()) {
-      GALOIS_ASSERT(nodeIDCounter == remapper[i]);
+    std::optional<uint32_t> newID = remapper.Find(i);
+    if (newID) {
+      GALOIS_ASSERT(nodeIDCounter == *newID);
       for (auto e = graphToRemap.edgeBegin(i); e < graphToRemap.edgeEnd(i);
            e++) {
         graphWriter.incrementDegree(nodeIDCounter);
@@ -105,7 +113,7 @@ main(int argc, char** argv) {
       nodeIDCounter++;
     }
   }
-  GALOIS_ASSERT(nodeIDCounter == remapper.size());
+  GALOIS_ASSERT(nodeIDCounter == numMappedNodes);
 
   // phase 2: edge construction
   graphWriter.phase2();
@@ -113,18 +121,20 @@ main(int argc, char** argv) {
   nodeIDCounter = 0;
   for (size_t i = 0; i < prevNumNodes; i++) {
     // see if current node is to be remapped, i.e. exists in the map
-    if (remapper.find(i) != remapper.end()) {
-      GALOIS_ASSERT(nodeIDCounter == remapper[i]);
+    std::optional<uint32_t> newID = remapper.Find(i);
+    if (newID) {
+      GALOIS_ASSERT(nodeIDCounter == *newID);
       for (auto e = graphToRemap.edgeBegin(i); e < graphToRemap.edgeEnd(i);
            e++) {
         uint32_t dst = graphToRemap.edgeDestination(*e);
-        GALOIS_ASSERT(remapper.find(dst) != remapper.end());
-        graphWriter.addNeighbor(nodeIDCounter, remapper[dst]);
+        std::optional<uint32_t> newDst = remapper.Find(dst);
+        GALOIS_ASSERT(newDst);
+        graphWriter.addNeighbor(nodeIDCounter, *newDst);
       }
       nodeIDCounter++;
     }
   }
-  GALOIS_ASSERT(nodeIDCounter == remapper.size());
+  GALOIS_ASSERT(nodeIDCounter == numMappedNodes);
 
   galois::gInfo("Finishing up: outputting graph shortly");
 